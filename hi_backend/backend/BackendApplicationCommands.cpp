@@ -149,6 +149,8 @@ void BackendCommandTarget::getAllCommands(Array<CommandID>& commands)
 		MenuToolsUnloadAllAudioFiles,
 		MenuToolsRecordOneSecond,
 		MenuToolsEnableDebugLogging,
+		MenuToolsEnableAudioProfiler,
+		MenuToolsExportAudioProfile,
 		MenuToolsImportArchivedSamples,
 		MenuToolsCreateRSAKeys,
 		MenuToolsCreateDummyLicenseFile,
@@ -451,6 +453,12 @@ void BackendCommandTarget::getCommandInfo(CommandID commandID, ApplicationComman
 	case MenuToolsRecordOneSecond:
 		setCommandTarget(result, "Record one second audio file", true, false, 'X', false);
 		break;
+	case MenuToolsEnableAudioProfiler:
+		setCommandTarget(result, "Enable Audio Profiler", true, bpe->owner->getAudioProfiler().isEnabled(), 'X', false);
+		break;
+	case MenuToolsExportAudioProfile:
+		setCommandTarget(result, "Show profiler report & export Chrome trace", true, false, 'X', false);
+		break;
 	case MenuToolsCreateRSAKeys:
 		setCommandTarget(result, "Create RSA Key pair", true, false, 'X', false);
 		break;
@@ -610,6 +618,8 @@ bool BackendCommandTarget::perform(const InvocationInfo &info)
 	case MenuToolsImportArchivedSamples: Actions::importArchivedSamples(bpe); return true;
 	case MenuToolsRecordOneSecond:		bpe->owner->getDebugLogger().startRecording(); return true;
 	case MenuToolsEnableDebugLogging:	bpe->owner->getDebugLogger().toggleLogging(), updateCommands(); return true;
+	case MenuToolsEnableAudioProfiler:	bpe->owner->getAudioProfiler().setEnabled(!bpe->owner->getAudioProfiler().isEnabled()); updateCommands(); return true;
+	case MenuToolsExportAudioProfile:	Actions::exportAudioProfile(bpe); return true;
     case MenuViewFullscreen:            Actions::toggleFullscreen(bpe); updateCommands(); return true;
 	case MenuViewBack:					bpe->mainEditor->getViewUndoManager()->undo(); updateCommands(); return true;
 	case MenuViewReset:				    bpe->resetInterface(); updateCommands(); return true;
@@ -821,6 +831,11 @@ PopupMenu BackendCommandTarget::getMenuForIndex(int topLevelMenuIndex, const Str
 
 		ADD_DESKTOP_ONLY(MenuToolsCreateUIDataFromDesktop);
 
+		p.addSeparator();
+		p.addSectionHeader("Performance");
+		ADD_DESKTOP_ONLY(MenuToolsEnableAudioProfiler);
+		ADD_DESKTOP_ONLY(MenuToolsExportAudioProfile);
+
 		p.addSeparator();
 		p.addSectionHeader("Sample Management");
 		
@@ -2300,6 +2315,21 @@ void BackendCommandTarget::Actions::unloadAllAudioFiles(BackendRootWindow * bpe)
 }
 
 
+void BackendCommandTarget::Actions::exportAudioProfile(BackendRootWindow * bpe)
+{
+	auto& profiler = bpe->owner->getAudioProfiler();
+
+	debugToConsole(bpe->getMainSynthChain(), profiler.createReport());
+
+	FileChooser fc("Export Chrome trace", File::getSpecialLocation(File::userDesktopDirectory).getChildFile("HISE_Profile.json"), "*.json");
+
+	if (fc.browseForFileToSave(true))
+	{
+		if (!profiler.exportChromeTrace(fc.getResult()))
+			PresetHandler::showMessageWindow("Export failed", "The trace file couldn't be written", PresetHandler::IconType::Error);
+	}
+}
+
 void BackendCommandTarget::Actions::createUIDataFromDesktop(BackendRootWindow * bpe)
 {
 	auto mp = JavascriptMidiProcessor::getFirstInterfaceScriptProcessor(bpe->getBackendProcessor());
@@ -2330,13 +2360,9 @@ juce::String BackendCommandTarget::Actions::createWindowsInstallerTemplate(MainC
 
 void BackendCommandTarget::Actions::convertSampleMapToWavetableBanks(BackendRootWindow* bpe)
 {
-#if USE_IPP
 	WavetableConverterDialog *converter = new WavetableConverterDialog(bpe->getMainSynthChain());
 
 	converter->setModalBaseWindowComponent(bpe);
-#else
-	PresetHandler::showMessageWindow("IPP required", "You need to build HISE with enabled IPP in order to use the resynthesis features", PresetHandler::IconType::Error);
-#endif
 }
 
 #undef REPLACE_WILDCARD
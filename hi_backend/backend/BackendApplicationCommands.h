@@ -188,6 +188,8 @@ public:
 		MenuToolsEnableAutoSaving,
 		MenuToolsEnableDebugLogging,
 		MenuToolsRecordOneSecond,
+		MenuToolsEnableAudioProfiler,
+		MenuToolsExportAudioProfile,
 		MenuToolsDeviceSimulatorOffset,
 		MenuHelpShowAboutPage = 0x70000,
         MenuHelpCheckVersion,
@@ -343,6 +345,7 @@ public:
 		static void importArchivedSamples(BackendRootWindow * bpe);
 		static void checkCyclicReferences(BackendRootWindow * bpe);
 		static void unloadAllAudioFiles(BackendRootWindow * bpe);
+		static void exportAudioProfile(BackendRootWindow * bpe);
 		static void createUIDataFromDesktop(BackendRootWindow * bpe);
 
 		static String createWindowsInstallerTemplate(MainController* mc, bool includeAAX);
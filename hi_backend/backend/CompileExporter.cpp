@@ -570,11 +570,12 @@ CompileExporter::ErrorCodes CompileExporter::exportInternal(TargetTypes type, Bu
 			}
 			else
 			{
+				// Write indexed resource files so that the plugin only decodes the files that it uses
 				File appFolder = ProjectHandler::Frontend::getAppDataDirectory(chainToExport).getChildFile("AudioResources.dat");
-				PresetHandler::writeValueTreeAsFile(exportReferencedAudioFiles(), appFolder.getFullPathName());
+				EmbeddedResourceFile::writeFromPoolValueTree(exportReferencedAudioFiles(), appFolder);
 
 				File imageFolder = ProjectHandler::Frontend::getAppDataDirectory(chainToExport).getChildFile("ImageResources.dat");
-				PresetHandler::writeValueTreeAsFile(exportReferencedImageFiles(), imageFolder.getFullPathName());
+				EmbeddedResourceFile::writeFromPoolValueTree(exportReferencedImageFiles(), imageFolder);
 			}
 		}
 
@@ -0,0 +1,474 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if JUCE_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#if JUCE_MSVC
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+namespace hise { using namespace juce;
+
+OfflineRenderBenchmark::OfflineRenderBenchmark(BackendProcessor* bp_, const Settings& settings_) :
+	Thread("Offline Render Thread"),
+	bp(bp_),
+	settings(settings_)
+{
+}
+
+OfflineRenderBenchmark::~OfflineRenderBenchmark()
+{
+	stopThread(5000);
+}
+
+Result OfflineRenderBenchmark::runBenchmark()
+{
+	auto chain = bp->getMainSynthChain();
+	auto& handler = GET_PROJECT_HANDLER(chain);
+
+	const File previousProject = handler.getWorkDirectory();
+	const File projectDirectory = settings.presetFile.getParentDirectory().getParentDirectory();
+
+	const bool switchBack = previousProject != projectDirectory;
+
+	if (switchBack)
+		handler.setWorkingProject(projectDirectory, nullptr);
+
+	Result r = loadMidiFile();
+
+	if (r.wasOk())
+		r = loadPreset();
+
+	if (r.wasOk())
+	{
+		bp->setNonRealtime(true);
+		bp->prepareToPlay(settings.sampleRate, settings.blockSize);
+
+		errorMessage = String();
+
+		startThread(9);
+
+		while (isThreadRunning())
+		{
+#if JUCE_MODAL_LOOPS_PERMITTED
+			MessageManager::getInstance()->runDispatchLoopUntil(50);
+#else
+			Thread::sleep(50);
+#endif
+		}
+
+		if (errorMessage.isNotEmpty())
+			r = Result::fail(errorMessage);
+	}
+
+	if (r.wasOk() && settings.outputFile != File())
+	{
+		settings.outputFile.deleteFile();
+
+		WavAudioFormat waf;
+		StringPairArray metadata;
+
+		ScopedPointer<AudioFormatWriter> writer = waf.createWriterFor(new FileOutputStream(settings.outputFile), settings.sampleRate, renderedAudio.getNumChannels(), 24, metadata, 0);
+
+		if (writer != nullptr)
+			writer->writeFromAudioSampleBuffer(renderedAudio, 0, renderedAudio.getNumSamples());
+		else
+			r = Result::fail("Can't write the audio file " + settings.outputFile.getFullPathName());
+	}
+
+	if (r.wasOk() && settings.reportFile != File())
+	{
+		if (!settings.reportFile.replaceWithText(JSON::toString(createJSONReport())))
+			r = Result::fail("Can't write the report file " + settings.reportFile.getFullPathName());
+	}
+
+	if (switchBack)
+		handler.setWorkingProject(previousProject, nullptr);
+
+	return r;
+}
+
+Result OfflineRenderBenchmark::loadPreset()
+{
+	const File& f = settings.presetFile;
+
+	if (!f.existsAsFile())
+		return Result::fail(f.getFullPathName() + " doesn't exist");
+
+	if (f.getFileExtension() == ".hip")
+	{
+		bp->loadPresetFromFile(f);
+	}
+	else if (f.getFileExtension() == ".xml")
+	{
+		ScopedPointer<XmlElement> xml = XmlDocument::parse(f);
+
+		if (xml == nullptr)
+			return Result::fail(f.getFullPathName() + " is not a valid XML file");
+
+		XmlBackupFunctions::restoreAllScripts(*xml, bp->getMainSynthChain(), xml->getStringAttribute("ID"));
+
+		bp->loadPresetFromValueTree(ValueTree::fromXml(*xml));
+	}
+	else
+	{
+		return Result::fail("The preset must be a .hip or .xml file");
+	}
+
+	// The preloading is done by the sample loading thread...
+	waitForBackgroundJobs(60000 * 5);
+
+	if (bp->getSampleManager().isPreloading())
+		return Result::fail("Timeout while preloading the samples");
+
+	return Result::ok();
+}
+
+Result OfflineRenderBenchmark::loadMidiFile()
+{
+	sequence.clear();
+
+	if (settings.midiFile == File())
+		return Result::ok();
+
+	FileInputStream fis(settings.midiFile);
+
+	MidiFile mf;
+
+	if (fis.failedToOpen() || !mf.readFrom(fis))
+		return Result::fail(settings.midiFile.getFullPathName() + " is not a valid MIDI file");
+
+	mf.convertTimestampTicksToSeconds();
+
+	for (int i = 0; i < mf.getNumTracks(); i++)
+		sequence.addSequence(*mf.getTrack(i), 0.0);
+
+	sequence.sort();
+
+	return Result::ok();
+}
+
+void OfflineRenderBenchmark::waitForBackgroundJobs(int timeoutMilliseconds)
+{
+	auto pool = bp->getSampleManager().getGlobalSampleThreadPool();
+
+	const uint32 start = Time::getMillisecondCounter();
+
+	while (pool->getNumPendingJobs() > 0 || bp->getSampleManager().isPreloading())
+	{
+		if (Time::getMillisecondCounter() - start > (uint32)timeoutMilliseconds)
+			break;
+
+		if (MessageManager::getInstance()->isThisTheMessageThread())
+		{
+#if JUCE_MODAL_LOOPS_PERMITTED
+			MessageManager::getInstance()->runDispatchLoopUntil(10);
+#else
+			Thread::sleep(10);
+#endif
+		}
+		else
+		{
+			Thread::yield();
+		}
+	}
+}
+
+void OfflineRenderBenchmark::run()
+{
+	const int blockSize = settings.blockSize;
+	const double lastEventTime = sequence.getNumEvents() > 0 ? sequence.getEndTime() : 0.0;
+	const int numSamplesToRender = roundToInt((lastEventTime + settings.tailSeconds) * settings.sampleRate);
+	const int numBlocks = (numSamplesToRender + blockSize - 1) / blockSize;
+
+	const int numChannels = jmax<int>(2, bp->getTotalNumOutputChannels());
+
+	AudioSampleBuffer buffer(numChannels, blockSize);
+	MidiBuffer midiBuffer;
+
+	renderedAudio.setSize(2, numBlocks * blockSize);
+	renderedAudio.clear();
+
+	blockDurations.clearQuick();
+	blockDurations.ensureStorageAllocated(numBlocks);
+
+	totalRenderMilliseconds = 0.0;
+	totalWaitMilliseconds = 0.0;
+	peakVoices = 0;
+
+	int64 voiceSum = 0;
+	int nextEventIndex = 0;
+
+	auto pool = bp->getSampleManager().getGlobalSampleThreadPool();
+	const int64 streamedBytesAtStart = pool->getNumStreamedBytes();
+
+	for (int i = 0; i < numBlocks; i++)
+	{
+		if (threadShouldExit())
+		{
+			errorMessage = "The rendering was cancelled";
+			return;
+		}
+
+		const int blockStart = i * blockSize;
+
+		midiBuffer.clear();
+
+		while (nextEventIndex < sequence.getNumEvents())
+		{
+			auto& m = sequence.getEventPointer(nextEventIndex)->message;
+			const int samplePosition = roundToInt(m.getTimeStamp() * settings.sampleRate);
+
+			if (samplePosition >= blockStart + blockSize)
+				break;
+
+			if (!m.isMetaEvent())
+				midiBuffer.addEvent(m, jlimit<int>(0, blockSize - 1, samplePosition - blockStart));
+
+			nextEventIndex++;
+		}
+
+		buffer.clear();
+
+		const int64 renderStart = Time::getHighResolutionTicks();
+
+		bp->processBlock(buffer, midiBuffer);
+
+		const int64 renderEnd = Time::getHighResolutionTicks();
+
+		waitForBackgroundJobs(10000);
+
+		const int64 waitEnd = Time::getHighResolutionTicks();
+
+		const double renderMs = Time::highResolutionTicksToSeconds(renderEnd - renderStart) * 1000.0;
+
+		blockDurations.add((float)renderMs);
+		totalRenderMilliseconds += renderMs;
+		totalWaitMilliseconds += Time::highResolutionTicksToSeconds(waitEnd - renderEnd) * 1000.0;
+
+		const int numVoices = bp->getNumActiveVoices();
+		peakVoices = jmax<int>(peakVoices, numVoices);
+		voiceSum += numVoices;
+
+		for (int c = 0; c < 2; c++)
+			renderedAudio.copyFrom(c, blockStart, buffer, jmin<int>(c, numChannels - 1), 0, blockSize);
+	}
+
+	renderedSeconds = (double)(numBlocks * blockSize) / settings.sampleRate;
+	averageVoices = numBlocks > 0 ? (double)voiceSum / (double)numBlocks : 0.0;
+	numStreamedBytes = pool->getNumStreamedBytes() - streamedBytesAtStart;
+	peakMemory = getPeakMemoryUsage();
+	sampleMemory = bp->getSampleManager().getModulatorSamplerSoundPool()->getMemoryUsageForAllSamples();
+
+	voiceBufferMemory = 0;
+	voiceBufferMemoryWithoutPooling = 0;
+
+	Processor::Iterator<ModulatorSynth> iter(bp->getMainSynthChain());
+
+	while (auto synth = iter.getNextProcessor())
+	{
+		const auto m = synth->getVoiceBufferMemory();
+
+		voiceBufferMemory += m.pooledBytes;
+		voiceBufferMemoryWithoutPooling += m.unpooledBytes;
+	}
+}
+
+Array<double> OfflineRenderBenchmark::getHistogramLimits()
+{
+	return { 5.0, 10.0, 25.0, 50.0, 75.0, 100.0, std::numeric_limits<double>::infinity() };
+}
+
+int OfflineRenderBenchmark::getNumRenderingThreads() const
+{
+	if (auto pool = bp->getParallelRenderingPool())
+		return pool->getNumThreads();
+
+	return 1;
+}
+
+var OfflineRenderBenchmark::createJSONReport() const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	const double blockMs = 1000.0 * (double)settings.blockSize / settings.sampleRate;
+	const double realtimeFactor = totalRenderMilliseconds > 0.0 ? renderedSeconds * 1000.0 / totalRenderMilliseconds : 0.0;
+
+	Array<float> sorted(blockDurations);
+	sorted.sort();
+
+	auto getPercentile = [&sorted](double p)
+	{
+		if (sorted.isEmpty())
+			return 0.0;
+
+		return (double)sorted[jlimit<int>(0, sorted.size() - 1, roundToInt(p * (double)(sorted.size() - 1)))];
+	};
+
+	obj->setProperty("Preset", settings.presetFile.getFileName());
+	obj->setProperty("SampleRate", settings.sampleRate);
+	obj->setProperty("BlockSize", settings.blockSize);
+	obj->setProperty("NumBlocks", blockDurations.size());
+	obj->setProperty("RenderedSeconds", renderedSeconds);
+	obj->setProperty("RenderMilliseconds", totalRenderMilliseconds);
+	obj->setProperty("StreamingWaitMilliseconds", totalWaitMilliseconds);
+	obj->setProperty("RealtimeFactor", realtimeFactor);
+	obj->setProperty("BlockMillisecondsAverage", blockDurations.isEmpty() ? 0.0 : totalRenderMilliseconds / (double)blockDurations.size());
+	obj->setProperty("BlockMillisecondsMedian", getPercentile(0.5));
+	obj->setProperty("BlockMillisecondsP99", getPercentile(0.99));
+	obj->setProperty("BlockMillisecondsMax", getPercentile(1.0));
+
+	Array<var> histogram;
+	const auto limits = getHistogramLimits();
+
+	for (int i = 0; i < limits.size(); i++)
+	{
+		const double lower = i == 0 ? 0.0 : limits[i - 1];
+		const double upper = limits[i];
+
+		int numInBucket = 0;
+
+		for (auto d : blockDurations)
+		{
+			const double percentage = 100.0 * (double)d / blockMs;
+
+			if (percentage >= lower && percentage < upper)
+				numInBucket++;
+		}
+
+		DynamicObject::Ptr bucket = new DynamicObject();
+		bucket->setProperty("MaxPercentage", std::isinf(upper) ? var("inf") : var(upper));
+		bucket->setProperty("NumBlocks", numInBucket);
+		histogram.add(var(bucket));
+	}
+
+	obj->setProperty("Histogram", histogram);
+
+	const int numThreads = getNumRenderingThreads();
+
+	obj->setProperty("PeakVoices", peakVoices);
+	obj->setProperty("AverageVoices", averageVoices);
+	obj->setProperty("RenderingThreads", numThreads);
+	obj->setProperty("VoicesPerCore", averageVoices * realtimeFactor / (double)numThreads);
+
+	const double wallSeconds = (totalRenderMilliseconds + totalWaitMilliseconds) / 1000.0;
+
+	obj->setProperty("StreamedMegabytes", (double)numStreamedBytes / 1024.0 / 1024.0);
+	obj->setProperty("StreamingMegabytesPerSecond", wallSeconds > 0.0 ? (double)numStreamedBytes / 1024.0 / 1024.0 / wallSeconds : 0.0);
+	obj->setProperty("SampleMemoryMegabytes", (double)sampleMemory / 1024.0 / 1024.0);
+	obj->setProperty("PeakMemoryMegabytes", (double)peakMemory / 1024.0 / 1024.0);
+	obj->setProperty("VoiceBufferMegabytes", (double)voiceBufferMemory / 1024.0 / 1024.0);
+	obj->setProperty("VoiceBufferMegabytesWithoutPooling", (double)voiceBufferMemoryWithoutPooling / 1024.0 / 1024.0);
+
+	return var(obj);
+}
+
+String OfflineRenderBenchmark::createReport() const
+{
+	auto r = createJSONReport();
+
+	const String nl = "\n";
+	String s;
+
+	auto ms = [](const var& v) { return String((double)v, 3) + "ms"; };
+	auto mb = [](const var& v) { return String((double)v, 1) + "MB"; };
+
+	s << "Benchmark: " << r["Preset"].toString() << nl;
+	s << "Rendered " << String((double)r["RenderedSeconds"], 2) << "s in " << String((double)r["RenderMilliseconds"] / 1000.0, 2) << "s (";
+	s << String((double)r["RealtimeFactor"], 1) << "x realtime, " << String((double)r["StreamingWaitMilliseconds"] / 1000.0, 2) << "s waiting for the streaming)" << nl;
+	s << nl;
+
+	s << "Block time (" << r["BlockSize"].toString() << " samples @ " << r["SampleRate"].toString() << "Hz):" << nl;
+	s << "  Average: " << ms(r["BlockMillisecondsAverage"]) << nl;
+	s << "  Median:  " << ms(r["BlockMillisecondsMedian"]) << nl;
+	s << "  p99:     " << ms(r["BlockMillisecondsP99"]) << nl;
+	s << "  Max:     " << ms(r["BlockMillisecondsMax"]) << nl;
+	s << nl;
+
+	s << "Histogram (percentage of the available block time):" << nl;
+
+	if (auto histogram = r["Histogram"].getArray())
+	{
+		String lower = "0";
+
+		for (const auto& bucket : *histogram)
+		{
+			const String upper = bucket["MaxPercentage"].toString();
+
+			s << "  " << (lower + "% - " + upper + (upper == "inf" ? "" : "%")).paddedRight(' ', 16);
+			s << bucket["NumBlocks"].toString() << nl;
+
+			lower = upper;
+		}
+	}
+
+	s << nl;
+	s << "Voices: " << r["PeakVoices"].toString() << " peak, " << String((double)r["AverageVoices"], 1) << " average" << nl;
+	s << "Voices per core: " << String((double)r["VoicesPerCore"], 1) << " (" << r["RenderingThreads"].toString() << " rendering threads)" << nl;
+	s << "Streaming: " << mb(r["StreamedMegabytes"]) << " (" << mb(r["StreamingMegabytesPerSecond"]) << "/s)" << nl;
+	s << "Memory: " << mb(r["SampleMemoryMegabytes"]) << " preload buffers, " << mb(r["PeakMemoryMegabytes"]) << " peak" << nl;
+	s << "Voice buffers: " << mb(r["VoiceBufferMegabytes"]) << " (" << mb(r["VoiceBufferMegabytesWithoutPooling"]) << " without pooling)" << nl;
+
+	return s;
+}
+
+int64 OfflineRenderBenchmark::getPeakMemoryUsage()
+{
+#if JUCE_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return (int64)counters.PeakWorkingSetSize;
+
+	return 0;
+#else
+	rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#if JUCE_MAC || JUCE_IOS
+	return (int64)usage.ru_maxrss; // bytes
+#else
+	return (int64)usage.ru_maxrss * 1024; // kilobytes
+#endif
+#endif
+}
+
+} // namespace hise
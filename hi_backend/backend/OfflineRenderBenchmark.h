@@ -0,0 +1,131 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef OFFLINERENDERBENCHMARK_H_INCLUDED
+#define OFFLINERENDERBENCHMARK_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** Renders a preset with a MIDI file faster than realtime and measures the performance.
+*
+*	This is used by the `benchmark` command line action, so that the rendering cost of a preset can be tracked
+*	without a host or an audio device. The processBlock() calls are made on a dedicated thread, one block after
+*	another. After each block it waits until the sample streaming jobs are finished so that the voices never run
+*	out of data (this time is measured separately and not counted as rendering time).
+*
+*	The result contains the timing of every block, the voice count, the streaming throughput, the peak memory
+*	of the process and the memory of the voice buffers (with and without the pooling of the ModulatorSynth).
+*/
+class OfflineRenderBenchmark : public Thread
+{
+public:
+
+	struct Settings
+	{
+		File presetFile;
+		File midiFile;
+		File outputFile;
+		File reportFile;
+
+		double sampleRate = 44100.0;
+		int blockSize = 512;
+
+		/** The time that will be rendered after the last MIDI event. */
+		double tailSeconds = 2.0;
+	};
+
+	/** Creates a benchmark for the given processor. */
+	OfflineRenderBenchmark(BackendProcessor* bp, const Settings& settings);
+
+	~OfflineRenderBenchmark();
+
+	/** Loads the preset, renders the MIDI file and writes the audio and the report files.
+	*
+	*	Call this from the message thread. It returns when the rendering is finished.
+	*/
+	Result runBenchmark();
+
+	/** Creates a human readable summary of the last run. */
+	String createReport() const;
+
+	/** Creates a JSON object with the results of the last run (for regression checks). */
+	var createJSONReport() const;
+
+	/** Returns the peak memory usage of this process in bytes (or 0 if it can't be determined). */
+	static int64 getPeakMemoryUsage();
+
+	void run() override;
+
+private:
+
+	Result loadPreset();
+	Result loadMidiFile();
+
+	void waitForBackgroundJobs(int timeoutMilliseconds);
+
+	/** The upper limits of the histogram buckets in percent of the available block time. */
+	static Array<double> getHistogramLimits();
+
+	int getNumRenderingThreads() const;
+
+	BackendProcessor* bp;
+	const Settings settings;
+
+	MidiMessageSequence sequence;
+
+	AudioSampleBuffer renderedAudio;
+
+	Array<float> blockDurations;
+
+	double totalRenderMilliseconds = 0.0;
+	double totalWaitMilliseconds = 0.0;
+	double renderedSeconds = 0.0;
+
+	int peakVoices = 0;
+	double averageVoices = 0.0;
+
+	int64 numStreamedBytes = 0;
+	int64 peakMemory = 0;
+	size_t sampleMemory = 0;
+
+	// The memory of the voice buffers and voice modulation values of all synths
+	size_t voiceBufferMemory = 0;
+	size_t voiceBufferMemoryWithoutPooling = 0;
+
+	String errorMessage;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderBenchmark)
+};
+
+} // namespace hise
+
+#endif  // OFFLINERENDERBENCHMARK_H_INCLUDED
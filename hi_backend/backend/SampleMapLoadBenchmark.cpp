@@ -0,0 +1,114 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+SampleMapLoadBenchmark::SampleMapLoadBenchmark(MainController* mc_) :
+	mc(mc_)
+{
+}
+
+SampleMapLoadBenchmark::Result SampleMapLoadBenchmark::run(int numZones)
+{
+	auto pool = mc->getSampleManager().getModulatorSamplerSoundPool();
+
+	const ValueTree sampleMap = createSampleMap(numZones);
+
+	OwnedArray<ModulatorSamplerSound> sounds;
+	sounds.ensureStorageAllocated(numZones);
+
+	const int numSoundsBefore = pool->getNumSoundsInPool();
+
+	pool->setUpdatePool(false);
+
+	const double start = Time::getMillisecondCounterHiRes();
+
+	for (int i = 0; i < sampleMap.getNumChildren(); i++)
+		sounds.add(pool->addSound(sampleMap.getChild(i), i));
+
+	Result r;
+
+	r.milliseconds = Time::getMillisecondCounterHiRes() - start;
+	r.numZones = numZones;
+	r.numSoundsInPool = pool->getNumSoundsInPool() - numSoundsBefore;
+
+	sounds.clear();
+
+	pool->setUpdatePool(true);
+	pool->clearUnreferencedSamples();
+
+	return r;
+}
+
+String SampleMapLoadBenchmark::createReport(const Array<Result>& results)
+{
+	const String nl = "\n";
+	String s;
+
+	s << "Sample map loading (without disk access):" << nl;
+	s << "Zones | Sounds in pool | Total | Per zone" << nl;
+
+	for (const auto& r : results)
+	{
+		s << String(r.numZones) << " | ";
+		s << String(r.numSoundsInPool) << " | ";
+		s << String(r.milliseconds, 1) << "ms | ";
+		s << String(1000.0 * r.milliseconds / (double)jmax<int>(1, r.numZones), 2) << "us" << nl;
+	}
+
+	return s;
+}
+
+ValueTree SampleMapLoadBenchmark::createSampleMap(int numZones)
+{
+	static const Identifier fileName("FileName");
+	static const Identifier duplicate("Duplicate");
+
+	ValueTree sampleMap("samplemap");
+
+	// Use a unique folder for every run so that the sounds of the last run are not reused
+	const String folder = "{PROJECT_FOLDER}Benchmark_" + String(numZones) + "_" + String(Time::currentTimeMillis()) + "/";
+
+	for (int i = 0; i < numZones; i++)
+	{
+		ValueTree sample("sample");
+
+		sample.setProperty(fileName, folder + "Sample_" + String(i / 2) + ".wav", nullptr);
+		sample.setProperty(duplicate, true, nullptr);
+
+		sampleMap.addChild(sample, -1, nullptr);
+	}
+
+	return sampleMap;
+}
+
+} // namespace hise
@@ -0,0 +1,75 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef SAMPLEMAPLOADBENCHMARK_H_INCLUDED
+#define SAMPLEMAPLOADBENCHMARK_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** Measures how long it takes to add the sounds of a sample map to the global sample pool.
+*
+*	This is used by the `benchmark_samplemap` command line action. It creates sample maps with the given amount of 
+*	zones (every sample file is used by two zones, so half of the sounds are reused from the pool) and adds them to
+*	the ModulatorSamplerSoundPool. The sample files don't exist, so the result is the time that is spent in the
+*	pool management without any disk access.
+*/
+class SampleMapLoadBenchmark
+{
+public:
+
+	struct Result
+	{
+		int numZones = 0;
+		int numSoundsInPool = 0;
+		double milliseconds = 0.0;
+	};
+
+	SampleMapLoadBenchmark(MainController* mc);
+
+	/** Adds a sample map with the given amount of zones to the pool and removes it again. */
+	Result run(int numZones);
+
+	/** Creates a table with the load time per sample map size. */
+	static String createReport(const Array<Result>& results);
+
+private:
+
+	static ValueTree createSampleMap(int numZones);
+
+	MainController* mc;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleMapLoadBenchmark)
+};
+
+} // namespace hise
+
+#endif  // SAMPLEMAPLOADBENCHMARK_H_INCLUDED
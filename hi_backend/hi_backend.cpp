@@ -67,5 +67,7 @@
 
 
 #include "backend/CompileExporter.cpp"
+#include "backend/OfflineRenderBenchmark.cpp"
+#include "backend/SampleMapLoadBenchmark.cpp"
 #include "backend/HisePlayerExporter.cpp"
 
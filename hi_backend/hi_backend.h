@@ -80,6 +80,8 @@ END_JUCE_MODULE_DECLARATION
 #include "backend/BackendEditor.h"
 #include "backend/BackendRootWindow.h"
 #include "backend/CompileExporter.h"
+#include "backend/OfflineRenderBenchmark.h"
+#include "backend/SampleMapLoadBenchmark.h"
 #include "backend/HisePlayerExporter.h"
 
 
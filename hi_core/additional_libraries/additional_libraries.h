@@ -51,6 +51,7 @@
 namespace hise
 {
 	class IppFFT;
+	class HiseFFT;
 }
 
 #include "icst/MathDefs.h"
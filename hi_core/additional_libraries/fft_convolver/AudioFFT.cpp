@@ -21,10 +21,6 @@
 
 #include "AudioFFT.h"
 
-#if USE_IPP
-#include "../../hi_core/IppFFT.h"
-#endif
-
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -43,12 +39,12 @@
 #elif defined (AUDIOFFT_FFTW3)
   #define AUDIOFFT_FFTW3_USED
   #include <fftw3.h>
-#else
-  #if !defined(AUDIOFFT_OOURA)
-    #define AUDIOFFT_OOURA
-  #endif
+#elif defined (AUDIOFFT_OOURA)
   #define AUDIOFFT_OOURA_USED
   #include <vector>
+#else
+  #define AUDIOFFT_HISE_USED
+  #include <vector>
 #endif
 
 
@@ -103,7 +99,6 @@ namespace audiofft
 
 
 #ifdef AUDIOFFT_OOURA_USED
-#if !USE_IPP
 
   /**
    * @internal
@@ -776,7 +771,6 @@ namespace audiofft
    */
   typedef OouraFFT AudioFFTImplementation;
 
-#endif
 #endif // AUDIOFFT_OOURA_USED
 
 
@@ -888,80 +882,86 @@ namespace audiofft
 #endif // AUDIOFFT_APPLE_ACCELERATE_USED
 
 
-#if USE_IPP
-
-#include <ipp.h>
+#ifdef AUDIOFFT_HISE_USED
 
-  class IPP_FFT : public detail::AudioFFTImpl
+  /**
+   * @internal
+   * @class HiseFFTImpl
+   * @brief FFT implementation using hise::HiseFFT (which uses IPP if it's available)
+   */
+  class HiseFFTImpl : public detail::AudioFFTImpl
   {
   public:
+    HiseFFTImpl() :
+      detail::AudioFFTImpl(),
+      _fft(hise::HiseFFT::DataType::RealFloat),
+      _size(0),
+      _buffer()
+    {
+    }
 
-	  IPP_FFT() :
-		  detail::AudioFFTImpl()
-	  {
-		  tempBuffer = ippsMalloc_32fc(44100);
-	  };
-
-	  virtual ~IPP_FFT()
-	  {
-		  ippFree(tempBuffer);
-		  fft_ = nullptr;
-	  }
-
-	  void init(size_t size) override
-	  {
-		  numSamples = size;
+    HiseFFTImpl(const HiseFFTImpl&) = delete;
+    HiseFFTImpl& operator=(const HiseFFTImpl&) = delete;
 
-		  
+    virtual void init(size_t size) override
+    {
+      if (_size != size)
+      {
+        _buffer.resize(size);
+        _size = size;
+      }
+    }
 
-		  if (numSamples != 0)
-		  {
-			  order = roundDoubleToInt(log2((double)numSamples));
+    virtual void fft(const float* data, float* re, float* im) override
+    {
+      const size_t size2 = _size / 2;
 
-			  fft_ = new IppFFT(hise::IppFFT::DataType::ComplexFloat);
-		  }
-		  else
-		  {
-			  order = -1;
-			  fft_ = nullptr;
-		  }
+      _fft.realFFT(data, _buffer.data(), static_cast<int>(_size));
 
-		  
-	  }
+      // unpack re[0],re[size/2],re[1],im[1],...
+      re[0] = _buffer[0];
+      im[0] = 0.0f;
+      re[size2] = _buffer[1];
+      im[size2] = 0.0f;
 
-	  virtual void fft(const float* data, float* re, float* im) override
-	  {
-		  jassert(fft_ != nullptr);
+      for (size_t i=1; i<size2; ++i)
+      {
+        re[i] = _buffer[2 * i];
+        im[i] = _buffer[2 * i + 1];
+      }
+    }
 
-		  fft_->complexFFT(data, (float*)tempBuffer, (int)numSamples/2);
+    virtual void ifft(float* data, const float* re, const float* im) override
+    {
+      const size_t size2 = _size / 2;
 
-		  ippsCplxToReal_32fc(tempBuffer, re, im, (int)numSamples/2);
-	  }
+      _buffer[0] = re[0];
+      _buffer[1] = re[size2];
 
-	  virtual void ifft(float* data, const float* re, const float* im) override
-	  {
-		  jassert(fft_ != nullptr);
+      for (size_t i=1; i<size2; ++i)
+      {
+        _buffer[2 * i] = re[i];
+        _buffer[2 * i + 1] = im[i];
+      }
 
-		  ippsRealToCplx_32f(re, im, tempBuffer, (int)numSamples/2);
-		  fft_->complexFFTInverse((float*)tempBuffer, data, (int)numSamples/2);
-          
-          FloatVectorOperations::multiply(data, 1.0f / (float)numSamples, (int)numSamples);
-	  }
+      _fft.realFFTInverse(_buffer.data(), data, static_cast<int>(_size));
+      detail::ScaleBuffer(data, data, 1.0f / static_cast<float>(_size), _size);
+    }
 
   private:
-
-	  juce::ScopedPointer<hise::IppFFT> fft_;
-
-	  Ipp32fc* tempBuffer;
-
-	  size_t numSamples;
-	  int order;
-
+    hise::HiseFFT _fft;
+    size_t _size;
+    std::vector<float> _buffer;
   };
 
-  typedef IPP_FFT AudioFFTImplementation;
 
-#endif
+  /**
+   * @internal
+   * @brief Concrete FFT implementation
+   */
+  typedef HiseFFTImpl AudioFFTImplementation;
+
+#endif // AUDIOFFT_HISE_USED
 
   // ================================================================
 
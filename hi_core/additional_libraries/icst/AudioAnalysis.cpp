@@ -18,12 +18,10 @@
 
 	AudioAnalysisBase::AudioAnalysisBase()
 	{
-#if USE_IPP
-		realFloatFFTs = new FFTProcessor((int)hise::IppFFT::DataType::RealFloat);
-		realDoubleFFTs = new FFTProcessor((int)hise::IppFFT::DataType::RealDouble);
-		complexFloatFFTs = new FFTProcessor((int)hise::IppFFT::DataType::ComplexFloat);
-		complexDoubleFFTs = new FFTProcessor((int)hise::IppFFT::DataType::ComplexDouble);
-#endif
+		realFloatFFTs = new FFTProcessor((int)hise::HiseFFT::DataType::RealFloat);
+		realDoubleFFTs = new FFTProcessor((int)hise::HiseFFT::DataType::RealDouble);
+		complexFloatFFTs = new FFTProcessor((int)hise::HiseFFT::DataType::ComplexFloat);
+		complexDoubleFFTs = new FFTProcessor((int)hise::HiseFFT::DataType::ComplexDouble);
 	}
 
 	AudioAnalysisBase::~AudioAnalysisBase()
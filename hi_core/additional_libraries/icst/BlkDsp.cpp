@@ -26,23 +26,13 @@
 
 FFTProcessor::FFTProcessor(int fftDataType)
 {
-#if USE_IPP
-	fftData = new hise::IppFFT((hise::IppFFT::DataType)fftDataType);
-#else
-	ignoreUnused(fftDataType);
-	jassertfalse;
-#endif
+	fftData = new hise::HiseFFT((hise::HiseFFT::DataType)fftDataType);
 }
 
 
-hise::IppFFT * FFTProcessor::getFFTObject()
+hise::HiseFFT * FFTProcessor::getFFTObject()
 {
-#if USE_IPP
 	return fftData.get();
-#else
-	jassertfalse;
-	return nullptr;
-#endif
 }
 
 //******************************************************************************
@@ -52,97 +42,24 @@ hise::IppFFT * FFTProcessor::getFFTObject()
 // d[] = re[0],im[0],..,re[size-1],im[size-1].
 void FFTProcessor::fft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->complexFFTInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftfSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTFwd_CToC_32fc_I((Ipp32fc*)d, fftfSpec[order], NULL);
-	}
-	else 
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-
-#else
-	cdft(2*size, -1, d);
-#endif
 }
 
 void FFTProcessor::fft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->complexFFTInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftdSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTFwd_CToC_64fc_I((Ipp64fc*)d, fftdSpec[order], NULL);
-	}
-	else 
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-
-#else
-	cdft(2*size, -1, d);
-#endif
 }
 
 // standard IFFT. size is a power of 2.
 // d[] = re[0],im[0],..,re[size-1],im[size-1].
 void FFTProcessor::ifft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->complexFFTInverseInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftfSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTInv_CToC_32fc_I((Ipp32fc*)d, fftfSpec[order], NULL);
-	}
-	else
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-#else
-	cdft(2*size, 1, d);
-	VectorFunctions::mul(d, 1.0f / static_cast<float>(size), 2 * size);
-#endif
 }
 
 void FFTProcessor::ifft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->complexFFTInverseInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftdSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTInv_CToC_64fc_I((Ipp64fc*)d, fftdSpec[order], NULL);
-	}
-	else
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-#else
-	double norm = 1.0/static_cast<double>(size);
-	cdft(2*size, 1, d);
-	for (int i=0; i<(2*size); i++) {d[i] *= norm;}
-#endif
 }
 
 // FFT of real data. size is a power of 2.
@@ -150,49 +67,12 @@ void FFTProcessor::ifft(double* d, int size)
 // out: d[] = re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1].
 void FFTProcessor::realfft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->realFFTInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftfSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTFwd_RToPerm_32f_I((Ipp32f*)d, rfftfSpec[order], NULL);
-	}
-	else 
-	{
-		// Must be initialised
-		jassertfalse;
-	}
-#endif
-#else
-	rdft(size, 1, d);		
-	VectorFunctions::cpxconj(d, size>>1);	// preserve aligned processing if d aligned
-	d[1] = -d[1];			//
-#endif
 }
 
 void FFTProcessor::realfft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->realFFTInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftfSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTFwd_RToPerm_64f_I((Ipp64f*)d, rfftdSpec[order], NULL);
-	}
-	else 
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-#else
-	rdft(size, 1, d);
-	for (int i=3; i<size; i+=2) {d[i] = -d[i];}
-#endif
 }
 
 // IFFT to real data. size is a power of 2.
@@ -200,53 +80,12 @@ void FFTProcessor::realfft(double* d, int size)
 // out: d[] = re[0],re[1],..,re[size-1].
 void FFTProcessor::realifft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->realFFTInverseInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftfSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTInv_PermToR_32f_I((Ipp32f*)d, rfftfSpec[order], NULL);
-	}
-	else 
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-#else
-	VectorFunctions::mul(d, 2.0f/static_cast<float>(size), size);
-	VectorFunctions::cpxconj(d, size >> 1);	// preserve aligned processing if d aligned
-	d[1] = -d[1];			//
-	rdft(size, -1, d);
-#endif
 }
 
 void FFTProcessor::realifft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
-
 	fftData->realFFTInverseInplace(d, size);
-
-#if 0
-	int order = twopownton(size);
-	if ((fftfSpec != NULL) && (order <= IPP_FFT_MAX_POWER_OF_TWO)) {
-		ippsFFTInv_PermToR_64f_I((Ipp64f*)d, rfftdSpec[order], NULL);
-	}
-	else 
-	{
-		// Must be initialised!
-		jassertfalse;
-	}
-#endif
-#else
-	int i; double norm = 2.0/static_cast<double>(size); double mnorm = -norm;
-	for (i=0; i<size; i+=2) {d[i] *= norm;}
-	d[1] *= norm;
-	for (i=3; i<size; i+=2) {d[i] *= mnorm;}
-	rdft(size, -1, d);
-#endif
 }
 
 // FFT of symmetrical real data. size is a power of 2.
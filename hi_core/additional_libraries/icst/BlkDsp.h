@@ -23,7 +23,7 @@ public:
 
 	FFTProcessor(int dataType);
 
-	hise::IppFFT *getFFTObject();
+	hise::HiseFFT *getFFTObject();
 
 	// Direct FFT functions
 
@@ -57,9 +57,7 @@ public:
 
 private:
 
-#if USE_IPP
-	juce::ScopedPointer<hise::IppFFT> fftData;
-#endif
+	juce::ScopedPointer<hise::HiseFFT> fftData;
 
 };
 
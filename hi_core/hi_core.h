@@ -191,6 +191,32 @@ If this is set to 1, the application will crash instantly if there is a drop out
 #define ENABLE_SCRIPTING_BREAKPOINTS 0
 #endif
 
+/** Config: ENABLE_SCRIPTING_BYTECODE
+
+Set this to 0 to execute the script callbacks with the tree interpreter instead of compiling them to bytecode.
+*/
+#ifndef ENABLE_SCRIPTING_BYTECODE
+#define ENABLE_SCRIPTING_BYTECODE 1
+#endif
+
+/** Config: ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+
+If this is set to 1, the compiled script callbacks will compare their results with the tree interpreter and report every mismatch to the console.
+*/
+#ifndef ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+#define ENABLE_SCRIPTING_BYTECODE_VERIFICATION 0
+#endif
+
+/** Config: ENABLE_SCRIPTING_ALLOCATION_COUNTER
+
+If this is set to 1, the global operator new will be replaced to count the heap allocations of every script callback.
+The number is shown in the debug value of the callback and the first allocation of a callback is reported to the console.
+This is only a diagnostic tool, the allocations are not redirected to a per-callback arena.
+*/
+#ifndef ENABLE_SCRIPTING_ALLOCATION_COUNTER
+#define ENABLE_SCRIPTING_ALLOCATION_COUNTER 0
+#endif
+
 /** Config: ENABLE_ALL_PEAK_METERS
 
 Set this to 0 to deactivate peak collection for any other processor than the main synth chain
@@ -247,6 +273,14 @@ Set this to 1 to enable hard clipping of the output (brickwall everything over 1
 #define USE_HARD_CLIPPER 0
 #endif
 
+/** Config: NUM_PARALLEL_RENDERING_THREADS
+
+The maximum number of worker threads that help the audio thread if parallel voice rendering is enabled.
+*/
+#ifndef NUM_PARALLEL_RENDERING_THREADS
+#define NUM_PARALLEL_RENDERING_THREADS 3
+#endif
+
 /** Config: USE_SPLASH_SCREEN
 
 If your project contains a SplashScreen.png image file, it will use this as splash screen while loading the instrument in the background.
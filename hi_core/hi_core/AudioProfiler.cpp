@@ -0,0 +1,392 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+AudioProfiler::ThreadRing::ThreadRing() :
+	owner(nullptr),
+	readIndex(0),
+	writeIndex(0)
+{
+	events.insertMultiple(0, Event(), RingSize);
+}
+
+bool AudioProfiler::ThreadRing::push(Event&& e) noexcept
+{
+	const int index = writeIndex.load(std::memory_order_relaxed);
+	const int nextIndex = (index + 1) % RingSize;
+
+	if (nextIndex == readIndex.load(std::memory_order_acquire))
+		return false;
+
+	events.getReference(index) = std::move(e);
+	writeIndex.store(nextIndex, std::memory_order_release);
+
+	return true;
+}
+
+bool AudioProfiler::ThreadRing::pop(Event& e) noexcept
+{
+	const int index = readIndex.load(std::memory_order_relaxed);
+
+	if (index == writeIndex.load(std::memory_order_acquire))
+		return false;
+
+	// Leaves the slot empty, so that the last reference to a deleted processor is released here
+	e = std::move(events.getReference(index));
+	readIndex.store((index + 1) % RingSize, std::memory_order_release);
+
+	return true;
+}
+
+AudioProfiler::AudioProfiler(MainController* mc_) :
+	Thread("Audio Profiler"),
+	mc(mc_),
+	enabled(false)
+{
+	for (int i = 0; i < NumThreadRings; i++)
+		rings.add(new ThreadRing());
+
+	traceEvents.insertMultiple(0, TraceEvent(), NumTraceEvents);
+}
+
+AudioProfiler::~AudioProfiler()
+{
+	enabled.store(false);
+	stopThread(1000);
+}
+
+void AudioProfiler::setEnabled(bool shouldBeEnabled)
+{
+	if (shouldBeEnabled == isEnabled())
+		return;
+
+	if (shouldBeEnabled)
+	{
+		clear();
+		enabled.store(true);
+		startThread(3);
+	}
+	else
+	{
+		enabled.store(false);
+		stopThread(1000);
+		drainRings();
+	}
+}
+
+AudioProfiler::ThreadRing* AudioProfiler::beginScope() noexcept
+{
+	if (!enabled.load(std::memory_order_relaxed))
+		return nullptr;
+
+	const Thread::ThreadID id = Thread::getCurrentThreadId();
+
+	// A nested scope uses the ring of the outer scope
+	for (auto r : rings)
+	{
+		if (r->owner.load(std::memory_order_relaxed) == id)
+		{
+			r->depth++;
+			return r;
+		}
+	}
+
+	for (auto r : rings)
+	{
+		Thread::ThreadID unclaimed = nullptr;
+
+		if (r->owner.compare_exchange_strong(unclaimed, id, std::memory_order_acquire))
+		{
+			r->depth++;
+			return r;
+		}
+	}
+
+	// More threads inside a profiled scope than rings. This scope will not be profiled...
+	return nullptr;
+}
+
+void AudioProfiler::endScope(ThreadRing* ring, const WeakReference<Processor>& p, int location, int64 startTicks) noexcept
+{
+	ring->depth--;
+
+	Event e;
+	e.processor = p;
+	e.threadId = ring->owner.load(std::memory_order_relaxed);
+	e.startTicks = startTicks;
+	e.endTicks = Time::getHighResolutionTicks();
+	e.location = location;
+	e.depth = ring->depth;
+
+	ring->push(std::move(e));
+
+	// Releases the ring when the outermost scope ends, so that threads that have finished don't keep it
+	if (ring->depth == 0)
+		ring->owner.store(nullptr, std::memory_order_release);
+}
+
+void AudioProfiler::run()
+{
+	while (!threadShouldExit())
+	{
+		drainRings();
+		wait(20);
+	}
+}
+
+void AudioProfiler::clear()
+{
+	jassert(!isThreadRunning());
+
+	drainRings();
+
+	ScopedLock sl(statisticsLock);
+
+	statistics.clear();
+	threadIds.clear();
+	traceWriteIndex = 0;
+	numTraceEvents = 0;
+}
+
+void AudioProfiler::drainRings()
+{
+	Event e;
+
+	for (auto r : rings)
+	{
+		while (r->pop(e))
+			addEvent(e);
+	}
+}
+
+int AudioProfiler::getThreadIndex(Thread::ThreadID id)
+{
+	const int index = threadIds.indexOf(id);
+
+	if (index != -1)
+		return index;
+
+	threadIds.add(id);
+	return threadIds.size() - 1;
+}
+
+void AudioProfiler::addEvent(const Event& e)
+{
+	ScopedLock sl(statisticsLock);
+
+	const Processor* key = e.processor.get();
+
+	int statisticsIndex = -1;
+
+	for (int i = 0; i < statistics.size(); i++)
+	{
+		auto s = statistics.getUnchecked(i);
+
+		if (s->key == key && s->location == e.location)
+		{
+			statisticsIndex = i;
+			break;
+		}
+	}
+
+	if (statisticsIndex == -1)
+	{
+		auto s = new Statistics();
+		s->processor = e.processor;
+		s->key = key;
+		s->location = e.location;
+		s->depth = e.depth;
+
+		statisticsIndex = statistics.size();
+		statistics.add(s);
+	}
+
+	auto s = statistics.getUnchecked(statisticsIndex);
+
+	const double milliseconds = 1000.0 * Time::highResolutionTicksToSeconds(e.endTicks - e.startTicks);
+
+	s->numCalls++;
+	s->totalMilliseconds += milliseconds;
+	s->maxMilliseconds = jmax(s->maxMilliseconds, milliseconds);
+	s->recentDurations[s->recentIndex] = (float)milliseconds;
+	s->recentIndex = (s->recentIndex + 1) % NumRecentDurations;
+	s->numRecentDurations = jmin<int>(s->numRecentDurations + 1, NumRecentDurations);
+
+	auto& t = traceEvents.getReference(traceWriteIndex);
+
+	t.statisticsIndex = statisticsIndex;
+	t.threadIndex = getThreadIndex(e.threadId);
+	t.startTicks = e.startTicks;
+	t.endTicks = e.endTicks;
+
+	traceWriteIndex = (traceWriteIndex + 1) % NumTraceEvents;
+	numTraceEvents = jmin<int>(numTraceEvents + 1, NumTraceEvents);
+}
+
+double AudioProfiler::Statistics::getAverageMilliseconds() const
+{
+	return numCalls > 0 ? totalMilliseconds / (double)numCalls : 0.0;
+}
+
+double AudioProfiler::Statistics::getPercentileMilliseconds(double percentile) const
+{
+	if (numRecentDurations == 0)
+		return 0.0;
+
+	float sorted[NumRecentDurations];
+	memcpy(sorted, recentDurations, sizeof(float) * numRecentDurations);
+
+	const int index = jlimit<int>(0, numRecentDurations - 1, roundToInt(percentile * (double)(numRecentDurations - 1)));
+
+	std::nth_element(sorted, sorted + index, sorted + numRecentDurations);
+
+	return (double)sorted[index];
+}
+
+static String getProcessorNameForProfiler(const WeakReference<Processor>& p)
+{
+	return p.get() != nullptr ? p->getId() : "Deleted Processor";
+}
+
+String AudioProfiler::createReport() const
+{
+	ScopedLock sl(statisticsLock);
+
+	auto chain = mc->getMainSynthChain();
+
+	const double bufferMs = chain->getSampleRate() > 0.0 ? 1000.0 * (double)chain->getBlockSize() / chain->getSampleRate() : 0.0;
+
+	Array<const Statistics*> sorted;
+
+	for (auto s : statistics)
+		sorted.add(s);
+
+	struct P99Sorter
+	{
+		static int compareElements(const Statistics* first, const Statistics* second)
+		{
+			const double p1 = first->getPercentileMilliseconds(0.99);
+			const double p2 = second->getPercentileMilliseconds(0.99);
+
+			if (p1 > p2) return -1;
+			if (p1 < p2) return 1;
+			return 0;
+		}
+	};
+
+	P99Sorter sorter;
+	sorted.sort(sorter);
+
+	const String nl = "\n";
+	String report;
+
+	report << "Audio Profiler (" << String(bufferMs, 2) << "ms buffer)" << nl;
+	report << "Processor | Location | Depth | Calls | Average | p99 | Max" << nl;
+
+	for (auto s : sorted)
+	{
+		auto formatTime = [bufferMs](double ms)
+		{
+			String t = String(ms, 3) + "ms";
+
+			if (bufferMs > 0.0)
+				t << " (" << String(100.0 * ms / bufferMs, 1) << "%)";
+
+			return t;
+		};
+
+		report << getProcessorNameForProfiler(s->processor) << " | ";
+		report << DebugLogger::getNameForLocation((DebugLogger::Location)s->location) << " | ";
+		report << String(s->depth) << " | ";
+		report << String(s->numCalls) << " | ";
+		report << formatTime(s->getAverageMilliseconds()) << " | ";
+		report << formatTime(s->getPercentileMilliseconds(0.99)) << " | ";
+		report << formatTime(s->maxMilliseconds) << nl;
+	}
+
+	return report;
+}
+
+bool AudioProfiler::exportChromeTrace(const File& targetFile) const
+{
+	ScopedLock sl(statisticsLock);
+
+	targetFile.deleteFile();
+
+	FileOutputStream fos(targetFile);
+
+	if (fos.failedToOpen())
+		return false;
+
+	StringArray names;
+	StringArray categories;
+
+	for (auto s : statistics)
+	{
+		names.add(JSON::toString(getProcessorNameForProfiler(s->processor)));
+		categories.add(JSON::toString(DebugLogger::getNameForLocation((DebugLogger::Location)s->location)));
+	}
+
+	const int firstIndex = (traceWriteIndex - numTraceEvents + NumTraceEvents) % NumTraceEvents;
+	const int64 firstTicks = numTraceEvents > 0 ? traceEvents.getReference(firstIndex).startTicks : 0;
+
+	auto toMicroSeconds = [](int64 ticks)
+	{
+		return String(1000000.0 * Time::highResolutionTicksToSeconds(ticks), 1);
+	};
+
+	fos << "{\"traceEvents\":[\n";
+
+	for (int i = 0; i < numTraceEvents; i++)
+	{
+		const auto& t = traceEvents.getReference((firstIndex + i) % NumTraceEvents);
+
+		fos << "{\"name\":" << names[t.statisticsIndex];
+		fos << ",\"cat\":" << categories[t.statisticsIndex];
+		fos << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << String(t.threadIndex);
+		fos << ",\"ts\":" << toMicroSeconds(t.startTicks - firstTicks);
+		fos << ",\"dur\":" << toMicroSeconds(t.endTicks - t.startTicks) << "}";
+
+		if (i != numTraceEvents - 1)
+			fos << ",";
+
+		fos << "\n";
+	}
+
+	fos << "],\"displayTimeUnit\":\"ms\"}\n";
+	fos.flush();
+
+	return true;
+}
+
+} // namespace hise
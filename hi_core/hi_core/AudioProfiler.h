@@ -0,0 +1,186 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef AUDIOPROFILER_H_INCLUDED
+#define AUDIOPROFILER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+class MainController;
+class Processor;
+
+/** A lock free profiler for the audio rendering.
+*
+*	Every scope that is measured with ADD_GLITCH_DETECTOR writes its processor, location, nesting depth and
+*	timestamps into a ring buffer that is claimed by the current thread until its outermost scope ends.
+*	The audio threads never lock or allocate: if the ring is full, the event is dropped.
+*
+*	A background thread drains the rings, accumulates the statistics for every processor / location pair
+*	and keeps the most recent events so that they can be exported as Chrome trace (open the file with
+*	chrome://tracing or https://ui.perfetto.dev).
+*/
+class AudioProfiler : public Thread
+{
+public:
+
+	enum
+	{
+		NumThreadRings = 16,
+		RingSize = 4096,
+		NumRecentDurations = 1024,
+		NumTraceEvents = 65536
+	};
+
+	/** A measured scope. */
+	struct Event
+	{
+		WeakReference<Processor> processor;
+		Thread::ThreadID threadId = nullptr;
+		int64 startTicks = 0;
+		int64 endTicks = 0;
+		int location = 0;
+		int depth = 0;
+	};
+
+	/** A single producer / single consumer queue that is claimed by one thread while it is inside a profiled scope. */
+	class ThreadRing
+	{
+	public:
+
+		ThreadRing();
+
+		/** Moves the event into the ring. Returns false (and drops the event) if the ring is full.
+		*
+		*	The slots are empty until they are written, so the producer never releases a processor reference.
+		*/
+		bool push(Event&& e) noexcept;
+
+		/** Moves the oldest event out of the ring. This must only be called by the draining thread. */
+		bool pop(Event& e) noexcept;
+
+		std::atomic<Thread::ThreadID> owner;
+
+		/** The nesting depth of the profiled scopes. This is only accessed by the owning thread. */
+		int depth = 0;
+
+	private:
+
+		Array<Event> events;
+
+		std::atomic<int> readIndex;
+		std::atomic<int> writeIndex;
+	};
+
+	AudioProfiler(MainController* mc);
+	~AudioProfiler();
+
+	/** Starts or stops the profiling. Enabling clears the statistics of the last session. */
+	void setEnabled(bool shouldBeEnabled);
+
+	bool isEnabled() const noexcept { return enabled.load(); }
+
+	/** Call this at the start of a profiled scope.
+	*
+	*	Returns the ring of the current thread or nullptr if the profiler is disabled.
+	*/
+	ThreadRing* beginScope() noexcept;
+
+	/** Call this at the end of a profiled scope with the ring that was returned by beginScope(). */
+	void endScope(ThreadRing* ring, const WeakReference<Processor>& p, int location, int64 startTicks) noexcept;
+
+	/** Creates a table with the call count, the average and the 99th percentile of every processor and location. */
+	String createReport() const;
+
+	/** Writes the recorded events as Chrome trace JSON file. */
+	bool exportChromeTrace(const File& targetFile) const;
+
+	void run() override;
+
+private:
+
+	struct Statistics
+	{
+		double getAverageMilliseconds() const;
+		double getPercentileMilliseconds(double percentile) const;
+
+		WeakReference<Processor> processor;
+		const Processor* key = nullptr;
+		int location = 0;
+		int depth = 0;
+
+		int64 numCalls = 0;
+		double totalMilliseconds = 0.0;
+		double maxMilliseconds = 0.0;
+
+		float recentDurations[NumRecentDurations];
+		int numRecentDurations = 0;
+		int recentIndex = 0;
+	};
+
+	struct TraceEvent
+	{
+		int statisticsIndex;
+		int threadIndex;
+		int64 startTicks;
+		int64 endTicks;
+	};
+
+	void clear();
+
+	void drainRings();
+
+	void addEvent(const Event& e);
+
+	int getThreadIndex(Thread::ThreadID id);
+
+	MainController* mc;
+
+	std::atomic<bool> enabled;
+
+	OwnedArray<ThreadRing> rings;
+
+	CriticalSection statisticsLock;
+	OwnedArray<Statistics> statistics;
+
+	Array<Thread::ThreadID> threadIds;
+
+	Array<TraceEvent> traceEvents;
+	int traceWriteIndex = 0;
+	int numTraceEvents = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioProfiler)
+};
+
+} // namespace hise
+
+#endif  // AUDIOPROFILER_H_INCLUDED
@@ -32,6 +32,122 @@
 
 namespace hise { using namespace juce;
 
+EmbeddedResourceFile::EmbeddedResourceFile(const File& f)
+{
+	mappedFile = new MemoryMappedFile(f, MemoryMappedFile::readOnly);
+
+	if (mappedFile->getData() != nullptr)
+	{
+		data = static_cast<const char*>(mappedFile->getData());
+		dataSize = mappedFile->getSize();
+	}
+	else
+	{
+		mappedFile = nullptr;
+
+		if (!f.loadFileAsData(fileData))
+			return;
+
+		data = static_cast<const char*>(fileData.getData());
+		dataSize = fileData.getSize();
+	}
+
+	MemoryInputStream table(data, dataSize, false);
+
+	if (dataSize < 12 || table.readInt() != MagicNumber || table.readInt() != Version)
+		return;
+
+	const int numEntries = table.readInt();
+
+	for (int i = 0; i < numEntries; i++)
+	{
+		// The table is truncated (the last entry may end exactly at the end of the file if there is no data)
+		if (table.isExhausted())
+			return;
+
+		Entry e;
+
+		e.id = Identifier(table.readString());
+		e.fileName = table.readString();
+		e.additionalData = var::readFromStream(table);
+
+		if (table.getNumBytesRemaining() < (int64)(2 * sizeof(int64)))
+			return;
+
+		e.offset = table.readInt64();
+		e.size = table.readInt64();
+
+		entryIndexes.set(e.id.toString(), entries.size());
+		entries.add(e);
+	}
+
+	dataStart = table.getPosition();
+
+	for (const auto& e : entries)
+	{
+		// The file is truncated
+		if (dataStart + e.offset + e.size > (int64)dataSize)
+			return;
+	}
+
+	valid = true;
+}
+
+int EmbeddedResourceFile::indexOf(const Identifier& id) const
+{
+	const String key = id.toString();
+
+	return entryIndexes.contains(key) ? entryIndexes[key] : -1;
+}
+
+MemoryInputStream* EmbeddedResourceFile::createInputStream(int index) const
+{
+	const auto& e = getEntry(index);
+
+	return new MemoryInputStream(data + dataStart + e.offset, (size_t)e.size, false);
+}
+
+bool EmbeddedResourceFile::writeFromPoolValueTree(const ValueTree& exportedPool, const File& targetFile)
+{
+	targetFile.deleteFile();
+
+	FileOutputStream fos(targetFile);
+
+	if (fos.failedToOpen())
+		return false;
+
+	fos.writeInt(MagicNumber);
+	fos.writeInt(Version);
+	fos.writeInt(exportedPool.getNumChildren());
+
+	int64 offset = 0;
+
+	for (int i = 0; i < exportedPool.getNumChildren(); i++)
+	{
+		auto child = exportedPool.getChild(i);
+		auto mb = child.getProperty("Data").getBinaryData();
+		const int64 size = mb != nullptr ? (int64)mb->getSize() : 0;
+
+		fos.writeString(child.getProperty("ID").toString());
+		fos.writeString(child.getProperty("FileName").toString());
+		child.getProperty("AdditionalData").writeToStream(fos);
+		fos.writeInt64(offset);
+		fos.writeInt64(size);
+
+		offset += size;
+	}
+
+	for (int i = 0; i < exportedPool.getNumChildren(); i++)
+	{
+		if (auto mb = exportedPool.getChild(i).getProperty("Data").getBinaryData())
+			fos.write(mb->getData(), mb->getSize());
+	}
+
+	fos.flush();
+
+	return fos.getStatus().wasOk();
+}
+
 ImagePool::ImagePool(MainController* mc_) :
 	SharedPoolBase(mc_)
 {
@@ -45,35 +161,52 @@ ImagePool::~ImagePool()
 
 int ImagePool::getNumLoadedFiles() const
 {
+	ScopedLock sl(poolLock);
+
 	return loadedImages.size();
 }
 
 Identifier ImagePool::getIdForIndex(int index) const
 {
+	ScopedLock sl(poolLock);
+
 	return loadedImages[index].id;
 }
 
 String ImagePool::getFileNameForId(Identifier identifier) const
 {
+	ScopedLock sl(poolLock);
+
 	auto index = loadedImages.indexOf(identifier);
 	if (index != -1)
 		return loadedImages[index].fileName;
 
+	auto resourceIndex = getResourceIndex(identifier);
+	if (resourceIndex != -1)
+		return resourceFile->getEntry(resourceIndex).fileName;
+
 	return String();
 }
 
 void ImagePool::clearData()
 {
+	ScopedLock sl(poolLock);
+
 	loadedImages.clear();
+	resourceFile = nullptr;
 }
 
 StringArray ImagePool::getTextDataForId(int index) const
 {
+	ScopedLock sl(poolLock);
+
 	return loadedImages[index].getTextData(getFileTypeName());
 }
 
 void ImagePool::storeItemInValueTree(ValueTree& child, int i) const
 {
+	ScopedLock sl(poolLock);
+
 	auto e = loadedImages[i];
 
 	child.setProperty("ID", e.id.toString(), nullptr);
@@ -90,6 +223,8 @@ void ImagePool::storeItemInValueTree(ValueTree& child, int i) const
 
 void ImagePool::restoreItemFromValueTree(ValueTree& child)
 {
+	ScopedLock sl(poolLock);
+
 	Identifier id = Identifier(child.getProperty("ID", String()).toString());
 
 	if (loadedImages.indexOf(id) != -1)
@@ -172,6 +307,8 @@ Image ImagePool::loadImageFromReference(MainController* mc, const String referen
 
 StringArray ImagePool::getFileNameList() const
 {
+	ScopedLock sl(poolLock);
+
 	StringArray sa;
 
 	for (auto e : loadedImages)
@@ -182,6 +319,8 @@ StringArray ImagePool::getFileNameList() const
 
 Image ImagePool::loadFileIntoPool(const String& fileName)
 {
+	ScopedLock sl(poolLock);
+
 	Identifier idForFileName = getIdForFileName(fileName);
 
 	const int existingIndex = loadedImages.indexOf(idForFileName);
@@ -191,6 +330,13 @@ Image ImagePool::loadFileIntoPool(const String& fileName)
 		return loadedImages[existingIndex].data;
 	}
 
+	const int resourceIndex = loadFromResourceFile(idForFileName);
+
+	if (resourceIndex != -1)
+	{
+		return loadedImages[resourceIndex].data;
+	}
+
 	ImageEntry ne;
 	ne.id = idForFileName;
 	ne.fileName = fileName;
@@ -204,6 +350,33 @@ Image ImagePool::loadFileIntoPool(const String& fileName)
 	return ne.data;
 }
 
+int ImagePool::loadFromResourceFile(const Identifier& id)
+{
+	ScopedLock sl(poolLock);
+
+	const int resourceIndex = getResourceIndex(id);
+
+	if (resourceIndex == -1)
+		return -1;
+
+	const auto& e = resourceFile->getEntry(resourceIndex);
+	ScopedPointer<MemoryInputStream> mis = resourceFile->createInputStream(resourceIndex);
+
+	ImageEntry ne;
+
+	ne.id = id;
+	ne.fileName = e.fileName;
+	ne.data = ImageFileFormat::loadFrom(mis->getData(), mis->getDataSize());
+
+	ImageCache::addImageToCache(ne.data, ne.fileName.hashCode64());
+
+	loadedImages.add(ne);
+
+	notifyTable();
+
+	return loadedImages.size() - 1;
+}
+
 void SharedPoolBase::notifyTable()
 {
 #if USE_BACKEND
@@ -282,6 +455,8 @@ Identifier SharedPoolBase::getIdForFileName(const String &absoluteFileName) cons
 
 ValueTree SharedPoolBase::exportAsValueTree() const
 {
+	ScopedLock sl(poolLock);
+
 	ValueTree v(getFileTypeName());
 
 	for (int i = 0; i < getNumLoadedFiles(); i++)
@@ -298,6 +473,8 @@ ValueTree SharedPoolBase::exportAsValueTree() const
 
 void SharedPoolBase::restoreFromValueTree(const ValueTree &v)
 {
+	ScopedLock sl(poolLock);
+
 	clearData();
 
 	for (int i = 0; i < v.getNumChildren(); i++)
@@ -312,6 +489,22 @@ void SharedPoolBase::restoreFromValueTree(const ValueTree &v)
 #endif
 }
 
+void SharedPoolBase::setResourceFile(EmbeddedResourceFile* newResourceFile)
+{
+	ScopedLock sl(poolLock);
+
+	clearData();
+
+	resourceFile = newResourceFile;
+
+	notifyTable();
+}
+
+int SharedPoolBase::getResourceIndex(const Identifier& id) const
+{
+	return resourceFile != nullptr ? resourceFile->indexOf(id) : -1;
+}
+
 ProjectHandler& SharedPoolBase::getProjectHandler()
 {
 	return GET_PROJECT_HANDLER(mc->getMainSynthChain());
@@ -342,30 +535,45 @@ Identifier AudioSampleBufferPool::getFileTypeName() const
 
 Identifier AudioSampleBufferPool::getIdForIndex(int index) const
 {
+	ScopedLock sl(poolLock);
+
 	return loadedSamples[index].id;
 }
 
 String AudioSampleBufferPool::getFileNameForId(Identifier identifier) const
 {
+	ScopedLock sl(poolLock);
+
 	auto index = loadedSamples.indexOf(identifier);
 	if (index != -1)
 		return loadedSamples[index].fileName;
 
+	auto resourceIndex = getResourceIndex(identifier);
+	if (resourceIndex != -1)
+		return resourceFile->getEntry(resourceIndex).fileName;
+
 	return String();
 }
 
 StringArray AudioSampleBufferPool::getTextDataForId(int index) const
 {
+	ScopedLock sl(poolLock);
+
 	return loadedSamples[index].getTextData(getFileTypeName());
 }
 
 void AudioSampleBufferPool::clearData()
 {
+	ScopedLock sl(poolLock);
+
 	loadedSamples.clear();
+	resourceFile = nullptr;
 }
 
 void AudioSampleBufferPool::storeItemInValueTree(ValueTree& child, int i) const
 {
+	ScopedLock sl(poolLock);
+
 	auto e = loadedSamples[i];
 
 	child.setProperty("ID", e.id.toString(), nullptr);
@@ -383,6 +591,8 @@ void AudioSampleBufferPool::storeItemInValueTree(ValueTree& child, int i) const
 
 void AudioSampleBufferPool::restoreItemFromValueTree(ValueTree& child)
 {
+	ScopedLock sl(poolLock);
+
 	Identifier id = Identifier(child.getProperty("ID", String()).toString());
 
 	if (loadedSamples.indexOf(id) != -1)
@@ -411,6 +621,8 @@ void AudioSampleBufferPool::restoreItemFromValueTree(ValueTree& child)
 
 AudioSampleBuffer AudioSampleBufferPool::loadFileIntoPool(const String& fileName)
 {
+	ScopedLock sl(poolLock);
+
 	Identifier idForFileName = getIdForFileName(fileName);
 
 	const int existingIndex = loadedSamples.indexOf(idForFileName);
@@ -420,6 +632,13 @@ AudioSampleBuffer AudioSampleBufferPool::loadFileIntoPool(const String& fileName
 		return loadedSamples[existingIndex].data;
 	}
 
+	const int resourceIndex = loadFromResourceFile(idForFileName);
+
+	if (resourceIndex != -1)
+	{
+		return loadedSamples[resourceIndex].data;
+	}
+
 	BufferEntry be;
 	be.id = idForFileName;
 	be.fileName = fileName;
@@ -438,6 +657,8 @@ AudioSampleBuffer AudioSampleBufferPool::loadFileIntoPool(const String& fileName
 
 double AudioSampleBufferPool::getSampleRateForFile(const Identifier& id)
 {
+	ScopedLock sl(poolLock);
+
 	auto index = loadedSamples.indexOf(id);
 
 	if (index != -1)
@@ -450,6 +671,32 @@ double AudioSampleBufferPool::getSampleRateForFile(const Identifier& id)
 	return 0.0;
 }
 
+int AudioSampleBufferPool::loadFromResourceFile(const Identifier& id)
+{
+	ScopedLock sl(poolLock);
+
+	const int resourceIndex = getResourceIndex(id);
+
+	if (resourceIndex == -1)
+		return -1;
+
+	const auto& e = resourceFile->getEntry(resourceIndex);
+
+	BufferEntry ne;
+
+	ne.id = id;
+	ne.fileName = e.fileName;
+	ne.additionalData = e.additionalData;
+
+	loadFromStream(ne, resourceFile->createInputStream(resourceIndex));
+
+	loadedSamples.add(ne);
+
+	notifyTable();
+
+	return loadedSamples.size() - 1;
+}
+
 void AudioSampleBufferPool::loadFromStream(BufferEntry& ne, InputStream* ownedStream)
 {
 	ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(ownedStream);
@@ -59,6 +59,70 @@ public:
 };
 
 
+/** An indexed file that contains the embedded audio files or images of a compiled project.
+*
+*	The file starts with a table that contains the ID, the file name, the additional data and the position of every entry 
+*	followed by the raw file data. The file is memory mapped, so opening it only reads the table and the data of an
+*	entry is decoded by the pool when it is used for the first time (see SharedPoolBase::setResourceFile()).
+*/
+class EmbeddedResourceFile
+{
+public:
+
+	struct Entry
+	{
+		Identifier id;
+		String fileName;
+		var additionalData;
+		int64 offset = 0;
+		int64 size = 0;
+	};
+
+	/** Opens the file and reads the table. If the file has the old format (a ValueTree), isValid() returns false. */
+	EmbeddedResourceFile(const File& f);
+
+	bool isValid() const noexcept { return valid; }
+
+	int getNumEntries() const noexcept { return entries.size(); }
+
+	/** Returns the index of the entry with the given ID or -1. */
+	int indexOf(const Identifier& id) const;
+
+	const Entry& getEntry(int index) const { return entries.getReference(index); }
+
+	/** Creates a stream that reads the data of the entry directly from the mapped file. */
+	MemoryInputStream* createInputStream(int index) const;
+
+	/** Writes the ValueTree that was created by SharedPoolBase::exportAsValueTree() as resource file. */
+	static bool writeFromPoolValueTree(const ValueTree& exportedPool, const File& targetFile);
+
+private:
+
+	enum
+	{
+		MagicNumber = 0x53455248, // "HRES"
+		Version = 1
+	};
+
+	ScopedPointer<MemoryMappedFile> mappedFile;
+
+	// Used if the file can't be mapped
+	MemoryBlock fileData;
+
+	const char* data = nullptr;
+	size_t dataSize = 0;
+
+	int64 dataStart = 0;
+
+	Array<Entry> entries;
+	HashMap<String, int> entryIndexes;
+
+	bool valid = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EmbeddedResourceFile)
+};
+
+
 class SharedPoolBase : public RestorableObject,
 					   public SafeChangeBroadcaster
 {
@@ -99,8 +163,24 @@ public:
 
 	const ProjectHandler& getProjectHandler() const;
 
+	/** Replaces the pool content with the entries of the resource file. 
+	*
+	*	The entries are not decoded here, but when loadFileIntoPool() is called with their ID for the first time. 
+	*/
+	void setResourceFile(EmbeddedResourceFile* newResourceFile);
+
 protected:
 
+	/** Returns the index of the entry in the resource file or -1. */
+	int getResourceIndex(const Identifier& id) const;
+
+	/** Guards the loaded entries. The resource entries are decoded lazily from the sample loading thread, 
+	*	the scripting thread and the message thread. 
+	*/
+	CriticalSection poolLock;
+
+	ScopedPointer<EmbeddedResourceFile> resourceFile;
+
 	template <class DataType> struct PoolEntry
 	{
 		PoolEntry() :
@@ -160,6 +240,7 @@ public:
 
 	int getNumLoadedFiles() const override
 	{
+		ScopedLock sl(poolLock);
 		return loadedSamples.size();
 	}
 
@@ -185,6 +266,9 @@ private:
 
 	void loadFromStream(BufferEntry& ne, InputStream* ownedStream);
 
+	/** Decodes the entry from the resource file and adds it to the loaded samples. Returns the index or -1. */
+	int loadFromResourceFile(const Identifier& id);
+
 	AudioFormatManager afm;
 
 	Array<BufferEntry> loadedSamples;
@@ -226,7 +310,8 @@ public:
 
 protected:
 
-	
+	/** Decodes the entry from the resource file and adds it to the loaded images. Returns the index or -1. */
+	int loadFromResourceFile(const Identifier& id);
 
 	Array<ImageEntry> loadedImages;
 };
@@ -0,0 +1,509 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+#if !USE_IPP
+
+/** The tables for one FFT size.
+*
+*	The twiddle factors of each radix-2 stage are stored contiguously (the stage with the half size h starts at
+*	index h-1) and every complex value is duplicated so that the butterflies can multiply an interleaved pair
+*	of complex numbers with two SIMD multiplications.
+*/
+template <typename FloatType> class HiseFFT::Plan : public ReferenceCountedObject
+{
+public:
+
+	typedef ReferenceCountedObjectPtr<Plan> Ptr;
+
+	Plan(int order_) :
+		order(order_),
+		size(1 << order_)
+	{
+		bitReverse.calloc(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			int reversed = 0;
+
+			for (int b = 0; b < order; b++)
+			{
+				if (i & (1 << b))
+					reversed |= 1 << (order - 1 - b);
+			}
+
+			bitReverse[i] = reversed;
+		}
+
+		// twiddleRe = { cos, cos }, twiddleIm = { -sin, sin } for every butterfly
+		twiddleRe.calloc(2 * size);
+		twiddleIm.calloc(2 * size);
+
+		for (int h = 1; h < size; h *= 2)
+		{
+			for (int j = 0; j < h; j++)
+			{
+				const double phase = -double_Pi * (double)j / (double)h;
+				const int index = 2 * (h - 1 + j);
+
+				twiddleRe[index] = (FloatType)std::cos(phase);
+				twiddleRe[index + 1] = (FloatType)std::cos(phase);
+				twiddleIm[index] = (FloatType)-std::sin(phase);
+				twiddleIm[index + 1] = (FloatType)std::sin(phase);
+			}
+		}
+
+		// The twiddles that split the spectrum of a real FFT with this size
+		const int numRealTwiddles = size / 4 + 1;
+
+		realTwiddles.calloc(2 * numRealTwiddles);
+
+		for (int k = 0; k < numRealTwiddles; k++)
+		{
+			const double phase = -2.0 * double_Pi * (double)k / (double)size;
+
+			realTwiddles[2 * k] = (FloatType)std::cos(phase);
+			realTwiddles[2 * k + 1] = (FloatType)std::sin(phase);
+		}
+	}
+
+	const int order;
+	const int size;
+
+	HeapBlock<int> bitReverse;
+	HeapBlock<FloatType> twiddleRe;
+	HeapBlock<FloatType> twiddleIm;
+	HeapBlock<FloatType> realTwiddles;
+
+	JUCE_DECLARE_NON_COPYABLE(Plan)
+};
+
+/** The plans that are shared between all HiseFFT instances. */
+struct HiseFFT::PlanCache
+{
+	template <typename FloatType> static Plan<FloatType>* getOrCreatePlan(ReferenceCountedArray<Plan<FloatType>>& plans, int order)
+	{
+		while (plans.size() <= order)
+			plans.add(nullptr);
+
+		if (plans[order] == nullptr)
+			plans.set(order, new Plan<FloatType>(order));
+
+		return plans.getUnchecked(order).get();
+	}
+
+	CriticalSection lock;
+
+	ReferenceCountedArray<Plan<float>> floatPlans;
+	ReferenceCountedArray<Plan<double>> doublePlans;
+};
+
+#endif
+
+HiseFFT::HiseFFT(DataType typeToUse, int maxPowerOfTwo /*= HISE_FFT_MAX_POWER_OF_TWO*/, int flagToUse /*= NoDivision*/) :
+	type(typeToUse),
+	maxOrder(jlimit<int>(1, HISE_FFT_MAX_POWER_OF_TWO, maxPowerOfTwo)),
+	flag(flagToUse)
+{
+#if USE_IPP
+	ippFFT = new IppFFT((IppFFT::DataType)type, maxOrder, flag);
+#else
+	const bool isDouble = type == DataType::ComplexDouble || type == DataType::RealDouble;
+
+	ScopedLock sl(cache->lock);
+
+	for (int i = 0; i < maxOrder; i++)
+	{
+		if (isDouble)
+			doublePlans.add(PlanCache::getOrCreatePlan(cache->doublePlans, i));
+		else
+			floatPlans.add(PlanCache::getOrCreatePlan(cache->floatPlans, i));
+	}
+#endif
+}
+
+HiseFFT::~HiseFFT()
+{
+#if USE_IPP
+	ippFFT = nullptr;
+#else
+	ScopedLock sl(cache->lock);
+
+	floatPlans.clear();
+	doublePlans.clear();
+#endif
+}
+
+int HiseFFT::getPowerOfTwo(int size) const
+{
+	if (isPowerOfTwo(size) && size > 1)
+	{
+		const int N = roundToInt(log2((double)size));
+
+		if (N < maxOrder)
+			return N;
+	}
+
+	// Not a power of two or larger than the maximum size...
+	jassertfalse;
+	return -1;
+}
+
+#if USE_IPP
+
+void HiseFFT::realFFTInplace(float *data, int size) const { ippFFT->realFFTInplace(data, size); }
+void HiseFFT::realFFTInverseInplace(float *data, int size) const { ippFFT->realFFTInverseInplace(data, size); }
+void HiseFFT::complexFFTInplace(float *data, int size) const { ippFFT->complexFFTInplace(data, size); }
+void HiseFFT::complexFFTInverseInplace(float *data, int size) const { ippFFT->complexFFTInverseInplace(data, size); }
+void HiseFFT::realFFT(const float *in, float* out, int size) const { ippFFT->realFFT(in, out, size); }
+void HiseFFT::realFFTInverse(const float *in, float* out, int size) const { ippFFT->realFFTInverse(in, out, size); }
+void HiseFFT::complexFFT(const float *in, float* out, int size) const { ippFFT->complexFFT(in, out, size); }
+void HiseFFT::complexFFTInverse(const float* in, float *out, int size) const { ippFFT->complexFFTInverse(in, out, size); }
+void HiseFFT::realFFTInplace(double *data, int size) const { ippFFT->realFFTInplace(data, size); }
+void HiseFFT::realFFTInverseInplace(double *data, int size) const { ippFFT->realFFTInverseInplace(data, size); }
+void HiseFFT::complexFFTInplace(double *data, int size) const { ippFFT->complexFFTInplace(data, size); }
+void HiseFFT::complexFFTInverseInplace(double *data, int size) const { ippFFT->complexFFTInverseInplace(data, size); }
+
+#else
+
+const HiseFFT::Plan<float>& HiseFFT::getPlan(int order, const float*) const
+{
+	return *floatPlans.getUnchecked(order);
+}
+
+const HiseFFT::Plan<double>& HiseFFT::getPlan(int order, const double*) const
+{
+	return *doublePlans.getUnchecked(order);
+}
+
+namespace FFTKernels
+{
+
+/** Computes the butterflies of one block: a' = a + w * b, b' = a - w * b. */
+template <typename FloatType> static void butterflies(FloatType* a, FloatType* b, const FloatType* wr, const FloatType* wi, int h)
+{
+	for (int j = 0; j < 2 * h; j += 2)
+	{
+		const FloatType tr = b[j] * wr[j] + b[j + 1] * wi[j];
+		const FloatType ti = b[j + 1] * wr[j + 1] + b[j] * wi[j + 1];
+
+		b[j] = a[j] - tr;
+		b[j + 1] = a[j + 1] - ti;
+		a[j] += tr;
+		a[j + 1] += ti;
+	}
+}
+
+#if JUCE_USE_SSE_INTRINSICS
+
+/** The SSE version computes two butterflies at once (h must be a multiple of 2). */
+static void butterflies(float* a, float* b, const float* wr, const float* wi, int h)
+{
+	for (int j = 0; j < 2 * h; j += 4)
+	{
+		const __m128 av = _mm_loadu_ps(a + j);
+		const __m128 bv = _mm_loadu_ps(b + j);
+		const __m128 swapped = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(2, 3, 0, 1));
+		const __m128 t = _mm_add_ps(_mm_mul_ps(bv, _mm_loadu_ps(wr + j)), _mm_mul_ps(swapped, _mm_loadu_ps(wi + j)));
+
+		_mm_storeu_ps(a + j, _mm_add_ps(av, t));
+		_mm_storeu_ps(b + j, _mm_sub_ps(av, t));
+	}
+}
+
+#endif
+
+template <typename FloatType> static void swapRealAndImag(FloatType* data, int size)
+{
+	for (int i = 0; i < 2 * size; i += 2)
+		std::swap(data[i], data[i + 1]);
+}
+
+/** The unscaled forward transform of interleaved complex data. */
+template <typename FloatType> static void complexForward(FloatType* data, int size, const int* bitReverse, const FloatType* twiddleRe, const FloatType* twiddleIm)
+{
+	if (size < 2)
+		return;
+
+	for (int i = 0; i < size; i++)
+	{
+		const int j = bitReverse[i];
+
+		if (i < j)
+		{
+			std::swap(data[2 * i], data[2 * j]);
+			std::swap(data[2 * i + 1], data[2 * j + 1]);
+		}
+	}
+
+	// The first stage doesn't need any twiddles...
+	for (int i = 0; i < 2 * size; i += 4)
+	{
+		const FloatType ar = data[i];
+		const FloatType ai = data[i + 1];
+		const FloatType br = data[i + 2];
+		const FloatType bi = data[i + 3];
+
+		data[i] = ar + br;
+		data[i + 1] = ai + bi;
+		data[i + 2] = ar - br;
+		data[i + 3] = ai - bi;
+	}
+
+	for (int h = 2; h < size; h *= 2)
+	{
+		const FloatType* wr = twiddleRe + 2 * (h - 1);
+		const FloatType* wi = twiddleIm + 2 * (h - 1);
+
+		for (int block = 0; block < size; block += 2 * h)
+			butterflies(data + 2 * block, data + 2 * (block + h), wr, wi, h);
+	}
+}
+
+/** Calculates the real spectrum from the complex FFT of the even / odd samples (in the packed layout). */
+template <typename FloatType> static void splitRealSpectrum(FloatType* data, const FloatType* w, int halfSize)
+{
+	const FloatType z0r = data[0];
+	const FloatType z0i = data[1];
+
+	data[0] = z0r + z0i;
+	data[1] = z0r - z0i;
+
+	const FloatType half = (FloatType)0.5;
+
+	for (int k = 1; k <= halfSize / 2; k++)
+	{
+		const int l = halfSize - k;
+
+		const FloatType ar = data[2 * k];
+		const FloatType ai = data[2 * k + 1];
+		const FloatType br = data[2 * l];
+		const FloatType bi = -data[2 * l + 1];
+
+		const FloatType er = (ar + br) * half;
+		const FloatType ei = (ai + bi) * half;
+		const FloatType or_ = (ai - bi) * half;
+		const FloatType oi = (br - ar) * half;
+
+		const FloatType tr = or_ * w[2 * k] - oi * w[2 * k + 1];
+		const FloatType ti = or_ * w[2 * k + 1] + oi * w[2 * k];
+
+		data[2 * k] = er + tr;
+		data[2 * k + 1] = ei + ti;
+		data[2 * l] = er - tr;
+		data[2 * l + 1] = ti - ei;
+	}
+}
+
+/** The inverse of splitRealSpectrum() (scaled by 2 so that the inverse transform returns size * x). */
+template <typename FloatType> static void mergeRealSpectrum(FloatType* data, const FloatType* w, int halfSize)
+{
+	const FloatType x0 = data[0];
+	const FloatType xm = data[1];
+
+	data[0] = x0 + xm;
+	data[1] = x0 - xm;
+
+	for (int k = 1; k <= halfSize / 2; k++)
+	{
+		const int l = halfSize - k;
+
+		const FloatType ar = data[2 * k];
+		const FloatType ai = data[2 * k + 1];
+		const FloatType br = data[2 * l];
+		const FloatType bi = -data[2 * l + 1];
+
+		const FloatType er = ar + br;
+		const FloatType ei = ai + bi;
+		const FloatType dr = ar - br;
+		const FloatType di = ai - bi;
+
+		const FloatType or_ = dr * w[2 * k] + di * w[2 * k + 1];
+		const FloatType oi = di * w[2 * k] - dr * w[2 * k + 1];
+
+		data[2 * k] = er - oi;
+		data[2 * k + 1] = ei + or_;
+		data[2 * l] = er + oi;
+		data[2 * l + 1] = or_ - ei;
+	}
+}
+
+} // namespace FFTKernels
+
+template <typename FloatType> void HiseFFT::performComplexFFT(FloatType* data, int size, bool isInverse) const
+{
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		const auto& plan = getPlan(N, data);
+
+		if (isInverse)
+			FFTKernels::swapRealAndImag(data, size);
+
+		FFTKernels::complexForward(data, size, plan.bitReverse.getData(), plan.twiddleRe.getData(), plan.twiddleIm.getData());
+
+		if (isInverse)
+			FFTKernels::swapRealAndImag(data, size);
+
+		applyScaling(data, 2 * size, size, isInverse);
+	}
+}
+
+template <typename FloatType> void HiseFFT::performRealFFT(FloatType* data, int size, bool isInverse) const
+{
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		// The real data is transformed as complex FFT with the half size (even samples = re, odd samples = im)
+		const auto& halfPlan = getPlan(N - 1, data);
+		const FloatType* w = getPlan(N, data).realTwiddles.getData();
+
+		const int halfSize = size / 2;
+
+		if (isInverse)
+		{
+			FFTKernels::mergeRealSpectrum(data, w, halfSize);
+			FFTKernels::swapRealAndImag(data, halfSize);
+		}
+
+		FFTKernels::complexForward(data, halfSize, halfPlan.bitReverse.getData(), halfPlan.twiddleRe.getData(), halfPlan.twiddleIm.getData());
+
+		if (isInverse)
+			FFTKernels::swapRealAndImag(data, halfSize);
+		else
+			FFTKernels::splitRealSpectrum(data, w, halfSize);
+
+		applyScaling(data, size, size, isInverse);
+	}
+}
+
+template <typename FloatType> void HiseFFT::applyScaling(FloatType* data, int numValues, int size, bool isInverse) const
+{
+	double factor = 1.0;
+
+	if (flag & DivideBySqrtN)
+		factor = 1.0 / std::sqrt((double)size);
+	else if (!isInverse && (flag & DivideForwardByN))
+		factor = 1.0 / (double)size;
+	else if (isInverse && (flag & DivideInverseByN))
+		factor = 1.0 / (double)size;
+
+	if (factor != 1.0)
+		FloatVectorOperations::multiply(data, (FloatType)factor, numValues);
+}
+
+void HiseFFT::realFFTInplace(float *data, int size) const
+{
+	jassert(type == DataType::RealFloat);
+	performRealFFT(data, size, false);
+}
+
+void HiseFFT::realFFTInverseInplace(float *data, int size) const
+{
+	jassert(type == DataType::RealFloat);
+	performRealFFT(data, size, true);
+}
+
+void HiseFFT::complexFFTInplace(float *data, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+	performComplexFFT(data, size, false);
+}
+
+void HiseFFT::complexFFTInverseInplace(float *data, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+	performComplexFFT(data, size, true);
+}
+
+void HiseFFT::realFFT(const float *in, float* out, int size) const
+{
+	if (in != out)
+		FloatVectorOperations::copy(out, in, size);
+
+	realFFTInplace(out, size);
+}
+
+void HiseFFT::realFFTInverse(const float *in, float* out, int size) const
+{
+	if (in != out)
+		FloatVectorOperations::copy(out, in, size);
+
+	realFFTInverseInplace(out, size);
+}
+
+void HiseFFT::complexFFT(const float *in, float* out, int size) const
+{
+	if (in != out)
+		FloatVectorOperations::copy(out, in, 2 * size);
+
+	complexFFTInplace(out, size);
+}
+
+void HiseFFT::complexFFTInverse(const float* in, float *out, int size) const
+{
+	if (in != out)
+		FloatVectorOperations::copy(out, in, 2 * size);
+
+	complexFFTInverseInplace(out, size);
+}
+
+void HiseFFT::realFFTInplace(double *data, int size) const
+{
+	jassert(type == DataType::RealDouble);
+	performRealFFT(data, size, false);
+}
+
+void HiseFFT::realFFTInverseInplace(double *data, int size) const
+{
+	jassert(type == DataType::RealDouble);
+	performRealFFT(data, size, true);
+}
+
+void HiseFFT::complexFFTInplace(double *data, int size) const
+{
+	jassert(type == DataType::ComplexDouble);
+	performComplexFFT(data, size, false);
+}
+
+void HiseFFT::complexFFTInverseInplace(double *data, int size) const
+{
+	jassert(type == DataType::ComplexDouble);
+	performComplexFFT(data, size, true);
+}
+
+#endif
+
+} // namespace hise
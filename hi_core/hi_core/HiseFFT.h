@@ -0,0 +1,169 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef HISEFFT_H_INCLUDED
+#define HISEFFT_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+#define HISE_FFT_MAX_POWER_OF_TWO 16
+
+/** The FFT that is used throughout HISE.
+*
+*	It has the same interface and data layout as the IppFFT class, but it doesn't require IPP: if USE_IPP is enabled,
+*	it just forwards the calls to the IPP routines, otherwise it uses a vectorised radix-2 implementation. This way
+*	the analyser, the convolution, the wavetable resynthesis and the scripting FFT are available on every platform.
+*
+*	The twiddle factors and the bit reversal tables are calculated once for every size and shared between all
+*	instances, so creating a HiseFFT is cheap after the first one. All tables up to the given maximum size are
+*	created in the constructor, so the FFT routines never allocate and can be called from the audio thread.
+*
+*	The data layout:
+*
+*	- complex data is interleaved: re[0],im[0],re[1],im[1],..,re[size-1],im[size-1]
+*	- real spectra are packed: re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1]
+*/
+class HiseFFT
+{
+public:
+
+	enum class DataType
+	{
+		ComplexFloat = 0,
+		ComplexDouble,
+		RealFloat,
+		RealDouble
+	};
+
+	/** The scaling of the results. The values are compatible with the IPP flags. */
+	enum ScalingFlags
+	{
+		DivideForwardByN = 1,
+		DivideInverseByN = 2,
+		DivideBySqrtN = 4,
+		NoDivision = 8
+	};
+
+	// =============================================================================================================================
+
+	/** Creates a FFT object for the given data type that can process sizes up to 2^(maxPowerOfTwo - 1). */
+	HiseFFT(DataType typeToUse=DataType::ComplexFloat, int maxPowerOfTwo = HISE_FFT_MAX_POWER_OF_TWO, int flagToUse=NoDivision);
+	~HiseFFT();
+
+	// ==================================================================================================================================== float FFTs
+
+	/** Real inplace FFT (size is power of two.)
+	*
+	*	Input: d[] = re[0],re[1],..,re[size-1].
+	*	Output: d[] = re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1].
+	*/
+	void realFFTInplace(float *data, int size) const;
+
+	/** Real inplace inverse FFT (size is power of two.) */
+	void realFFTInverseInplace(float *data, int size) const;
+
+	/** Complex inplace FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFTInplace(float *data, int size) const;
+
+	/** Complex inverse inplace FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFTInverseInplace(float *data, int size) const;
+
+	/** Real FFT (size is power of two.) */
+	void realFFT(const float *in, float* out, int size) const;
+
+	/** Real inverse FFT (size is power of two.) */
+	void realFFTInverse(const float *in, float* out, int size) const;
+
+	/** Complex FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFT(const float *in, float* out, int size) const;
+
+	/** Complex inverse FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFTInverse(const float* in, float *out, int size) const;
+
+	// ==================================================================================================================================== double FFTs
+
+	/** Real inplace FFT (size is power of two.) */
+	void realFFTInplace(double *data, int size) const;
+
+	/** Real inplace inverse FFT (size is power of two.) */
+	void realFFTInverseInplace(double *data, int size) const;
+
+	/** Complex inplace FFT (input is a Complex<double> array, size is power of two.) */
+	void complexFFTInplace(double *data, int size) const;
+
+	/** Complex inverse inplace FFT (input is a Complex<double> array, size is power of two.) */
+	void complexFFTInverseInplace(double *data, int size) const;
+
+	DataType getDataType() const noexcept { return type; }
+
+private:
+
+	// =============================================================================================================================
+
+	/** @internal Returns the power of two for the size or -1 if the size can't be processed. */
+	int getPowerOfTwo(int size) const;
+
+	const DataType type;
+	const int maxOrder;
+	const int flag;
+
+#if USE_IPP
+
+	ScopedPointer<IppFFT> ippFFT;
+
+#else
+
+	template <typename FloatType> class Plan;
+	struct PlanCache;
+
+	const Plan<float>& getPlan(int order, const float*) const;
+	const Plan<double>& getPlan(int order, const double*) const;
+
+	template <typename FloatType> void performComplexFFT(FloatType* data, int size, bool isInverse) const;
+	template <typename FloatType> void performRealFFT(FloatType* data, int size, bool isInverse) const;
+	template <typename FloatType> void applyScaling(FloatType* data, int numValues, int size, bool isInverse) const;
+
+	SharedResourcePointer<PlanCache> cache;
+
+	ReferenceCountedArray<Plan<float>> floatPlans;
+	ReferenceCountedArray<Plan<double>> doublePlans;
+
+#endif
+
+	// =============================================================================================================================
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HiseFFT)
+};
+
+} // namespace hise
+
+#endif  // HISEFFT_H_INCLUDED
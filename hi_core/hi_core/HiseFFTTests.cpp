@@ -0,0 +1,213 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+/** Checks the HiseFFT routines against a naive DFT and the inverse transforms against the input. */
+class HiseFFTTest : public UnitTest
+{
+public:
+
+	HiseFFTTest() :
+		UnitTest("Testing HiseFFT")
+	{};
+
+	void runTest() override
+	{
+		for (int order = 1; order < 12; order++)
+		{
+			testComplex<float>(order, 1e-3);
+			testComplex<double>(order, 1e-9);
+			testReal<float>(order, 1e-3);
+			testReal<double>(order, 1e-9);
+			testRealOutOfPlace(order, 1e-3);
+		}
+	}
+
+private:
+
+	static HiseFFT::DataType getDataType(bool isReal, const float*) { return isReal ? HiseFFT::DataType::RealFloat : HiseFFT::DataType::ComplexFloat; }
+	static HiseFFT::DataType getDataType(bool isReal, const double*) { return isReal ? HiseFFT::DataType::RealDouble : HiseFFT::DataType::ComplexDouble; }
+
+	/** Calculates the spectrum of the interleaved complex data with the definition. */
+	static void naiveDFT(const double* in, double* out, int size)
+	{
+		for (int k = 0; k < size; k++)
+		{
+			double re = 0.0;
+			double im = 0.0;
+
+			for (int n = 0; n < size; n++)
+			{
+				const double phase = -2.0 * double_Pi * (double)((int64)k * n % size) / (double)size;
+
+				re += in[2 * n] * std::cos(phase) - in[2 * n + 1] * std::sin(phase);
+				im += in[2 * n] * std::sin(phase) + in[2 * n + 1] * std::cos(phase);
+			}
+
+			out[2 * k] = re;
+			out[2 * k + 1] = im;
+		}
+	}
+
+	template <typename FloatType> void testComplex(int order, double tolerance)
+	{
+		const int size = 1 << order;
+
+		beginTest("Complex FFT with size " + String(size));
+
+		HeapBlock<FloatType> data(2 * size);
+		HeapBlock<double> input(2 * size);
+		HeapBlock<double> expected(2 * size);
+
+		for (int i = 0; i < 2 * size; i++)
+		{
+			input[i] = r.nextDouble() * 2.0 - 1.0;
+			data[i] = (FloatType)input[i];
+		}
+
+		naiveDFT(input, expected, size);
+
+		HiseFFT fft(getDataType(false, data.getData()), order + 1);
+
+		fft.complexFFTInplace(data, size);
+
+		for (int i = 0; i < 2 * size; i++)
+			expectWithinAbsoluteError<double>((double)data[i], expected[i], tolerance * size);
+
+		fft.complexFFTInverseInplace(data, size);
+
+		for (int i = 0; i < 2 * size; i++)
+			expectWithinAbsoluteError<double>((double)data[i] / (double)size, input[i], tolerance);
+	}
+
+	template <typename FloatType> void testReal(int order, double tolerance)
+	{
+		const int size = 1 << order;
+
+		beginTest("Real FFT with size " + String(size));
+
+		HeapBlock<FloatType> data(size);
+		HeapBlock<double> input(2 * size);
+		HeapBlock<double> expected(2 * size);
+
+		for (int i = 0; i < size; i++)
+		{
+			input[2 * i] = r.nextDouble() * 2.0 - 1.0;
+			input[2 * i + 1] = 0.0;
+			data[i] = (FloatType)input[2 * i];
+		}
+
+		naiveDFT(input, expected, size);
+
+		HiseFFT fft(getDataType(true, data.getData()), order + 1);
+
+		fft.realFFTInplace(data, size);
+
+		expectWithinAbsoluteError<double>((double)data[0], expected[0], tolerance * size);
+		expectWithinAbsoluteError<double>((double)data[1], expected[size], tolerance * size);
+
+		for (int i = 2; i < size; i++)
+			expectWithinAbsoluteError<double>((double)data[i], expected[i], tolerance * size);
+
+		fft.realFFTInverseInplace(data, size);
+
+		for (int i = 0; i < size; i++)
+			expectWithinAbsoluteError<double>((double)data[i] / (double)size, input[2 * i], tolerance);
+	}
+
+	/** Checks that the out of place real FFT uses the same layout and size as the inplace version.
+	*
+	*	With USE_IPP this runs the IPP routines, so they are compared against the naive DFT and the packed layout
+	*	of the radix-2 fallback. The values after the spectrum must not be written.
+	*/
+	void testRealOutOfPlace(int order, double tolerance)
+	{
+		const int size = 1 << order;
+
+		beginTest("Out of place real FFT with size " + String(size));
+
+		const float guardValue = 1234.0f;
+
+		HeapBlock<float> in(size);
+		HeapBlock<float> spectrum(size + 2);
+		HeapBlock<float> inplace(size);
+		HeapBlock<float> out(size + 2);
+		HeapBlock<double> input(2 * size);
+		HeapBlock<double> expected(2 * size);
+
+		for (int i = 0; i < size; i++)
+		{
+			input[2 * i] = r.nextDouble() * 2.0 - 1.0;
+			input[2 * i + 1] = 0.0;
+			in[i] = (float)input[2 * i];
+			inplace[i] = in[i];
+		}
+
+		spectrum[size] = guardValue;
+		spectrum[size + 1] = guardValue;
+		out[size] = guardValue;
+		out[size + 1] = guardValue;
+
+		naiveDFT(input, expected, size);
+
+		HiseFFT fft(HiseFFT::DataType::RealFloat, order + 1);
+
+		fft.realFFT(in, spectrum, size);
+		fft.realFFTInplace(inplace, size);
+
+		expectEquals<float>(spectrum[size], guardValue, "The spectrum exceeds the size");
+		expectEquals<float>(spectrum[size + 1], guardValue, "The spectrum exceeds the size");
+
+		expectWithinAbsoluteError<double>((double)spectrum[0], expected[0], tolerance * size);
+		expectWithinAbsoluteError<double>((double)spectrum[1], expected[size], tolerance * size);
+
+		for (int i = 2; i < size; i++)
+			expectWithinAbsoluteError<double>((double)spectrum[i], expected[i], tolerance * size);
+
+		for (int i = 0; i < size; i++)
+			expectWithinAbsoluteError<float>(spectrum[i], inplace[i], (float)(tolerance * size));
+
+		fft.realFFTInverse(spectrum, out, size);
+
+		expectEquals<float>(out[size], guardValue, "The inverse FFT exceeds the size");
+
+		for (int i = 0; i < size; i++)
+			expectWithinAbsoluteError<double>((double)out[i] / (double)size, input[2 * i], tolerance);
+	}
+
+	Random r;
+};
+
+static HiseFFTTest hiseFFTTest;
+
+} // namespace hise
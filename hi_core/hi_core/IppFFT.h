@@ -83,14 +83,14 @@ public:
 	/** Complex inverse inplace FFT (input is aligned float array, size is power of two.) */
 	void complexFFTInverseInplace(float *data, int size) const;
 
-	/** Real inplace FFT (input is aligned float array, size is power of two.)
+	/** Real FFT (input is aligned float array, size is power of two.)
 	*
-	*	Input: d[] = re[0],re[1],..,re[size-1].
-	*	Output: d[] = re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1].
+	*	Input: in[] = re[0],re[1],..,re[size-1].
+	*	Output: out[] = re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1] (the same layout as realFFTInplace()).
 	*/
 	void realFFT(const float *in, float* out, int size) const;
 
-	/** Real inplace FFT (input is aligned float array, size is power of two.) */
+	/** Real inverse FFT (input is a spectrum with the layout of realFFT(), size is power of two.) */
 	void realFFTInverse(const float *in, float* out, int size) const;
 
 	/** Complex inplace FFT (input is aligned Complex<float> array, size is power of two.) */
@@ -65,6 +65,7 @@ MainController::MainController():
 	processorChangeHandler(this),
 	killStateHandler(this),
 	debugLogger(this),
+	audioProfiler(this),
 	//presetLoadRampFlag(OldUserPresetHandler::Active),
 	suspendIndex(0),
 	controlUndoManager(new UndoManager())
@@ -88,13 +89,21 @@ MainController::MainController():
     
 #if HI_RUN_UNIT_TESTS
 
-	UnitTestRunner runner;
+	// Some tests create their own MainController, so they must not start the tests again
+	static bool testsAreRunning = false;
 
-	runner.setAssertOnFailure(false);
+	if (!testsAreRunning)
+	{
+		testsAreRunning = true;
 
-	runner.runAllTests();
+		UnitTestRunner runner;
 
-	
+		runner.setAssertOnFailure(false);
+
+		runner.runAllTests();
+
+		testsAreRunning = false;
+	}
 
 #endif
 };
@@ -125,6 +134,19 @@ const CriticalSection & MainController::getLock() const
 	return processLock;
 }
 
+ParallelRenderingPool* MainController::getOrCreateParallelRenderingPool()
+{
+	if (parallelRenderingPool == nullptr)
+	{
+		ScopedPointer<ParallelRenderingPool> newPool = new ParallelRenderingPool();
+
+		ScopedLock sl(getLock());
+		parallelRenderingPool.swapWith(newPool);
+	}
+
+	return parallelRenderingPool;
+}
+
 void MainController::loadPresetFromFile(const File &f, Component* /*mainEditor*/)
 {
 	auto f2 = [f](Processor* p)
@@ -101,6 +101,12 @@ public:
 		/** returns a pointer to the thread pool that streams the samples from disk. */
 		SampleThreadPool *getGlobalSampleThreadPool() { return samplerLoaderThreadPool; }
 
+		/** Returns the worker pool that is used by the sample loading thread to preload samples in parallel.
+		*
+		*	It will be created the first time you call this method, so only call it from the sample loading thread.
+		*/
+		ThreadPool* getPreloadWorkerPool();
+
 		/** returns a pointer to the global sample pool */
 		ModulatorSamplerSoundPool *getModulatorSamplerSoundPool() const { return globalSamplerSoundPool; }
 
@@ -215,6 +221,7 @@ public:
 		ScopedPointer<AudioSampleBufferPool> globalAudioSampleBufferPool;
 		ScopedPointer<ImagePool> globalImagePool;
 		ScopedPointer<ModulatorSamplerSoundPool> globalSamplerSoundPool;
+		ScopedPointer<ThreadPool> preloadWorkerPool; // must be destroyed after the loading thread
 		ScopedPointer<SampleThreadPool> samplerLoaderThreadPool;
 
 		bool hddMode = false;
@@ -712,6 +719,12 @@ public:
 
 	KillStateHandler& getKillStateHandler() { return killStateHandler; };
 	const KillStateHandler& getKillStateHandler() const { return killStateHandler; };
+
+	/** Returns the pool of real time threads that is used for the parallel voice rendering (or nullptr if no synth uses it). */
+	ParallelRenderingPool* getParallelRenderingPool() noexcept { return parallelRenderingPool; }
+
+	/** Creates the parallel rendering pool if it doesn't exist yet. This starts the worker threads, so don't call it from the audio thread. */
+	ParallelRenderingPool* getOrCreateParallelRenderingPool();
 #if USE_BACKEND
 	/** Writes to the console. */
 	void writeToConsole(const String &message, int warningLevel, const Processor *p=nullptr, Colour c=Colours::transparentBlack);
@@ -781,6 +794,10 @@ public:
 
 	DebugLogger& getDebugLogger() { return debugLogger; }
 	const DebugLogger& getDebugLogger() const { return debugLogger; }
+
+	/** Returns the profiler that measures the ADD_GLITCH_DETECTOR scopes of the audio rendering. */
+	AudioProfiler& getAudioProfiler() { return audioProfiler; }
+	const AudioProfiler& getAudioProfiler() const { return audioProfiler; }
     
 	void setBufferToPlay(const AudioSampleBuffer& buffer)
 	{
@@ -1179,6 +1196,8 @@ private:
 
 	KillStateHandler killStateHandler;
 
+	ScopedPointer<ParallelRenderingPool> parallelRenderingPool;
+
 	Component::SafePointer<Plotter> plotter;
 
 	Atomic<int> bufferSize;
@@ -1207,6 +1226,8 @@ private:
 
 	DebugLogger debugLogger;
 
+	AudioProfiler audioProfiler;
+
 #if USE_BACKEND
     
 	
@@ -0,0 +1,181 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+ParallelRenderingPool::ParallelRenderingPool(int numWorkersToUse) :
+	claimState(0),
+	numFinishedTasks(0),
+	busy(false)
+{
+	const int numCores = SystemStats::getNumCpus();
+	const int numWorkers = jlimit<int>(0, jmax<int>(0, numCores - 1), numWorkersToUse);
+
+	for (int i = 0; i < numWorkers; i++)
+	{
+		workers.add(new Worker(*this, i + 1));
+
+		// Leave the first core for the audio thread & the rest of the system
+		if (i + 1 < 32)
+			workers.getLast()->setAffinityMask(1u << (uint32)(i + 1));
+
+		workers.getLast()->startThread(Thread::realtimeAudioPriority);
+	}
+}
+
+ParallelRenderingPool::~ParallelRenderingPool()
+{
+	for (auto w : workers)
+	{
+		w->signalThreadShouldExit();
+		w->signal();
+	}
+
+	for (auto w : workers)
+		w->stopThread(1000);
+
+	workers.clear();
+}
+
+void ParallelRenderingPool::run(Task& task, int numTasks)
+{
+	if (numTasks <= 0)
+		return;
+
+	bool expected = false;
+
+	if (numTasks == 1 || workers.isEmpty() || !busy.compare_exchange_strong(expected, true))
+	{
+		for (int i = 0; i < numTasks; i++)
+			task.runTask(i, 0);
+
+		return;
+	}
+
+	jassert(numTasks <= 0xffff);
+
+	currentTask = &task;
+	numFinishedTasks.store(0);
+
+	// A new generation makes sure that a late worker can't claim a task with the state of the last batch
+	claimState.store(ClaimState::create(++currentGeneration, numTasks, 0));
+
+	// The calling thread renders too, so one worker less is needed
+	const int numWorkersToWake = jmin<int>(workers.size(), numTasks - 1);
+
+	for (int i = 0; i < numWorkersToWake; i++)
+		workers.getUnchecked(i)->signal();
+
+	processBatch(0);
+
+	// All tasks are claimed now, so the only tasks left are the ones that a worker is currently rendering.
+	// A task that was started can't be taken over, but a worker that is asleep or was descheduled before it
+	// claimed a task can't hold up the calling thread.
+	while (numFinishedTasks.load() < numTasks)
+		Thread::yield();
+
+	busy.store(false);
+}
+
+void ParallelRenderingPool::processBatch(int threadIndex)
+{
+	uint64 state = claimState.load();
+
+	for (;;)
+	{
+		const int taskIndex = ClaimState::getNextIndex(state);
+		const int numTasks = ClaimState::getNumTasks(state);
+
+		if (taskIndex >= numTasks)
+			return;
+
+		const uint64 nextState = ClaimState::create(ClaimState::getGeneration(state), numTasks, taskIndex + 1);
+
+		// This fails if another thread has claimed the task or a new batch was started
+		if (!claimState.compare_exchange_weak(state, nextState))
+			continue;
+
+		// The calling thread doesn't return before this task is finished, so the task is still valid
+		currentTask->runTask(taskIndex, threadIndex);
+
+		numFinishedTasks.fetch_add(1);
+
+		state = nextState;
+	}
+}
+
+ParallelRenderingPool::Worker::Worker(ParallelRenderingPool& parent_, int threadIndex_) :
+	Thread("Parallel Rendering Thread " + String(threadIndex_)),
+	wakeState(Idle),
+	parent(parent_),
+	threadIndex(threadIndex_)
+{
+
+}
+
+void ParallelRenderingPool::Worker::run()
+{
+	while (!threadShouldExit())
+	{
+		// A worker that wakes up too late for a batch finds no tasks left and goes back to sleep
+		if (waitForSignal())
+			parent.processBatch(threadIndex);
+	}
+}
+
+void ParallelRenderingPool::Worker::signal()
+{
+	if (wakeState.exchange(Signalled) == Parked)
+		notify();
+}
+
+bool ParallelRenderingPool::Worker::waitForSignal()
+{
+	for (int i = 0; i < NumSpinsBeforeParking; i++)
+	{
+		if (wakeState.load() == Signalled)
+			return wakeState.exchange(Idle) == Signalled;
+
+		Thread::yield();
+	}
+
+	int expected = Idle;
+
+	// If the worker was signalled in the meantime, the exchange fails and it doesn't park
+	if (wakeState.compare_exchange_strong(expected, Parked))
+		wait(-1);
+
+	return wakeState.exchange(Idle) == Signalled;
+}
+
+} // namespace hise
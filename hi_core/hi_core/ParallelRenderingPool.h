@@ -0,0 +1,157 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef PARALLELRENDERINGPOOL_H_INCLUDED
+#define PARALLELRENDERINGPOOL_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A pool of real time worker threads that help the audio thread to render independent parts of a buffer.
+*
+*	The workers are pinned to their own CPU core and run with the real time audio priority. After a batch they spin
+*	for a short while (so that the next batch of the same audio callback finds them awake) and then park on their 
+*	thread event, so an idle pool doesn't take any CPU time from the system. The wake up is a lock free flag per 
+*	worker, and the thread event is only signalled if the worker is actually parked.
+*
+*	The distribution of the tasks is lock free: every thread claims the next index with a compare and swap that also
+*	checks the generation of the batch, so a worker that wakes up too late can't claim a task of a finished batch.
+*	The calling thread works on the batch too and takes over every task that no worker has claimed yet, so run() 
+*	only waits for tasks that a worker is rendering at this moment, never for a worker that is still asleep or was
+*	descheduled before it claimed a task.
+*
+*	The pool can only be used by one thread at a time. If run() is called while the pool is busy (or from one of the
+*	worker threads), the batch will be executed on the calling thread, so it is safe to nest parallel sections.
+*/
+class ParallelRenderingPool
+{
+public:
+
+	/** A batch of independent tasks. runTask() is called exactly once for each task index. */
+	class Task
+	{
+	public:
+
+		virtual ~Task() {};
+
+		/** Overwrite this method and render the task with the given index.
+		*
+		*	@param taskIndex the index of the task (0 ... numTasks - 1)
+		*	@param threadIndex the index of the thread that runs the task: 0 is the calling thread, 1 ... N are the workers.
+		*	                   You can use this to pick a scratch buffer that is not used by another thread at the same time.
+		*/
+		virtual void runTask(int taskIndex, int threadIndex) = 0;
+	};
+
+	/** Creates a pool with the given amount of worker threads (the amount will be limited to the number of available cores - 1). */
+	ParallelRenderingPool(int numWorkersToUse = NUM_PARALLEL_RENDERING_THREADS);
+
+	~ParallelRenderingPool();
+
+	/** Executes all tasks and returns when they are finished. 
+	*
+	*	The amount of tasks is limited to 65535. 
+	*/
+	void run(Task& task, int numTasks);
+
+	/** Returns the amount of threads that can run a task at the same time (including the calling thread). 
+	*
+	*	Use this to allocate the per thread scratch buffers.
+	*/
+	int getNumThreads() const noexcept { return workers.size() + 1; }
+
+private:
+
+	/** The claim state packs the generation of the batch, the number of tasks and the next task index into one
+		atomic value, so that a task can only be claimed for the batch that is currently running. */
+	struct ClaimState
+	{
+		static uint64 create(uint32 generation, int numTasks, int nextIndex) noexcept
+		{
+			return ((uint64)generation << 32) | ((uint64)(uint16)numTasks << 16) | (uint64)(uint16)nextIndex;
+		}
+
+		static uint32 getGeneration(uint64 state) noexcept { return (uint32)(state >> 32); }
+		static int getNumTasks(uint64 state) noexcept { return (int)((state >> 16) & 0xffff); }
+		static int getNextIndex(uint64 state) noexcept { return (int)(state & 0xffff); }
+	};
+
+	class Worker : public Thread
+	{
+	public:
+
+		Worker(ParallelRenderingPool& parent_, int threadIndex_);
+
+		void run() override;
+
+		/** Wakes up the worker. This only signals the thread event if the worker is parked. */
+		void signal();
+
+	private:
+
+		enum WakeState
+		{
+			Idle = 0,
+			Signalled,
+			Parked
+		};
+
+		/** Spins for a while and parks the thread if no batch arrives. Returns true if the worker was signalled. */
+		bool waitForSignal();
+
+		static constexpr int NumSpinsBeforeParking = 1000;
+
+		std::atomic<int> wakeState;
+
+		ParallelRenderingPool& parent;
+		const int threadIndex;
+	};
+
+	/** Claims and runs tasks of the current batch until there are none left. */
+	void processBatch(int threadIndex);
+
+	/** Set by the calling thread before the batch is published. */
+	Task* currentTask = nullptr;
+	uint32 currentGeneration = 0;
+
+	std::atomic<uint64> claimState;
+	std::atomic<int> numFinishedTasks;
+	std::atomic<bool> busy;
+
+	OwnedArray<Worker> workers;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelRenderingPool)
+};
+
+} // namespace hise
+
+#endif  // PARALLELRENDERINGPOOL_H_INCLUDED
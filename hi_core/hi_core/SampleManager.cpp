@@ -109,6 +109,14 @@ void MainController::SampleManager::setDiskMode(DiskMode mode) noexcept
 }
 
 
+ThreadPool* MainController::SampleManager::getPreloadWorkerPool()
+{
+	if (preloadWorkerPool == nullptr)
+		preloadWorkerPool = new ThreadPool(jlimit<int>(1, 8, SystemStats::getNumCpus()));
+
+	return preloadWorkerPool;
+}
+
 void MainController::SampleManager::PreloadListenerUpdater::handleAsyncUpdate()
 {
 	for (int i = 0; i < manager->preloadListeners.size(); i++)
@@ -126,6 +134,8 @@ MainController::SampleManager::PreloadJob::PreloadJob(MainController* mc_) :
 	SampleThreadPoolJob("Internal Preloading"),
 	mc(mc_)
 {
+	// The kill state handler expects the preloading to happen on the sample loading thread
+	setNeedsSampleLoadingThread(true);
 
 }
 
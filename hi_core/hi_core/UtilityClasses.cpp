@@ -52,15 +52,20 @@ struct FileLimitInitialiser
 static FileLimitInitialiser fileLimitInitialiser;
 #endif
 
-double ScopedGlitchDetector::locationTimeSum[30] = { .0,.0,.0,.0,.0,.0,.0,.0,.0,.0, .0,.0,.0,.0,.0,.0,.0,.0,.0,.0, .0,.0,.0,.0,.0,.0,.0,.0,.0,.0};
-int ScopedGlitchDetector::locationIndex[30] = { 0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0, };
+double ScopedGlitchDetector::locationTimeSum[(int)DebugLogger::Location::numLocations] = {};
+int ScopedGlitchDetector::locationIndex[(int)DebugLogger::Location::numLocations] = {};
 int ScopedGlitchDetector::lastPositiveId = 0;
 
 ScopedGlitchDetector::ScopedGlitchDetector(Processor* const processor, int location_) :
 	location(location_),
 	startTime(processor->getMainController()->getDebugLogger().isLogging() ? Time::getMillisecondCounterHiRes() : 0.0),
-	p(processor)
+	p(processor),
+	profiler(&processor->getMainController()->getAudioProfiler()),
+	profilerRing(profiler->beginScope())
 {
+	if (profilerRing != nullptr)
+		profilerStartTicks = Time::getHighResolutionTicks();
+
 	if (lastPositiveId == location)
 	{
 		// Resets the identifier if a GlitchDetector is recreated...
@@ -70,6 +75,9 @@ ScopedGlitchDetector::ScopedGlitchDetector(Processor* const processor, int locat
 
 ScopedGlitchDetector::~ScopedGlitchDetector() 
 {
+	if (profilerRing != nullptr)
+		profiler->endScope(profilerRing, p, location, profilerStartTicks);
+
 	if (p.get() == nullptr)
 		return;
 
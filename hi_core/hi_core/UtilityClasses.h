@@ -370,8 +370,9 @@ private:
     
 	int location = 0;
 
-	static double locationTimeSum[30];
-	static int locationIndex[30];
+	// One slot for each DebugLogger::Location
+	static double locationTimeSum[];
+	static int locationIndex[];
 
     const double startTime;
     
@@ -379,6 +380,10 @@ private:
 
 	WeakReference<Processor> p;
 
+	AudioProfiler* profiler;
+	AudioProfiler::ThreadRing* profilerRing;
+	int64 profilerStartTicks = 0;
+
     // =================================================================================================================================
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScopedGlitchDetector)
@@ -63,8 +63,11 @@
 #include "IppFFT.cpp"
 #endif
 
+#include "HiseFFT.cpp"
+
 #include "UtilityClasses.cpp"
 #include "DebugLogger.cpp"
+#include "AudioProfiler.cpp"
 #include "ThreadWithQuasiModalProgressWindow.cpp"
 #include "HI_LookAndFeels.cpp"
 #include "Tables.cpp"
@@ -82,6 +85,7 @@
 #include "Popup.cpp"
 #include "Console.cpp"
 #include "BackgroundThreads.cpp"
+#include "ParallelRenderingPool.cpp"
 #include "Markdown.cpp"
 #include "HiseSettings.cpp"
 #include "SettingsWindows.cpp"
@@ -94,6 +98,7 @@
 
 #if HI_RUN_UNIT_TESTS
 //#include "HiseEventBufferUnitTests.cpp"
+#include "HiseFFTTests.cpp"
 #endif
 
 
@@ -60,6 +60,8 @@ struct TestGlobalNamespace
 #include "IppFFT.h"
 #endif
 
+#include "HiseFFT.h"
+
 
 #include "CustomDataContainers.h"
 
@@ -71,6 +73,7 @@ struct TestGlobalNamespace
 /** @defgroup core Core Classes
 *	A collection of basic classes.
 */
+#include "AudioProfiler.h"
 #include "UtilityClasses.h"
 #include "HI_LookAndFeels.h"
 #include "HiseEventBuffer.h"
@@ -84,6 +87,7 @@ struct TestGlobalNamespace
 #include "ExternalFilePool.h"
 #include "Markdown.h"
 #include "BackgroundThreads.h"
+#include "ParallelRenderingPool.h"
 #include "HiseSettings.h"
 #include "SettingsWindows.h"
 
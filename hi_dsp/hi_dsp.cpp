@@ -61,5 +61,9 @@
 #include "modules/ModulatorSynthChain.cpp"
 #include "modules/ModulatorSynthGroup.cpp"
 
+#if HI_RUN_UNIT_TESTS
+#include "modules/ModulatorChainTests.cpp"
+#endif
+
 #include "plugin_parameter/PluginParameterProcessor.cpp"
 
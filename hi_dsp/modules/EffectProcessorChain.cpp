@@ -124,6 +124,8 @@ Processor* EffectProcessorChainFactoryType::createProcessor	(int typeIndex, cons
 
 void EffectProcessorChain::EffectChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
+	ModulatorSynthChain::ScopedDependencyUpdater sdu(chain);
+
 	//ScopedLock sl(chain->getMainController()->getLock());
 
 	jassert(dynamic_cast<EffectProcessor*>(newProcessor) != nullptr);
@@ -194,5 +196,25 @@ void EffectProcessorChain::EffectChainHandler::add(Processor *newProcessor, Proc
 	sendChangeMessage();
 }
 
+void EffectProcessorChain::EffectChainHandler::remove(Processor *processorToBeRemoved, bool removeEffect)
+{
+	ModulatorSynthChain::ScopedDependencyUpdater sdu(chain);
+
+	ScopedLock sl(chain->getMainController()->getLock());
+
+	jassert(dynamic_cast<EffectProcessor*>(processorToBeRemoved) != nullptr);
+	
+	chain->allEffects.removeAllInstancesOf(dynamic_cast<EffectProcessor*>(processorToBeRemoved));
+
+	if(VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved)) chain->voiceEffects.removeObject(vep, removeEffect);
+	else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved)) chain->masterEffects.removeObject(mep, removeEffect);
+	else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved)) chain->monoEffects.removeObject(moep, removeEffect);
+	else jassertfalse;
+
+	jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
+
+	sendChangeMessage();
+}
+
 
 } // namespace hise
\ No newline at end of file
@@ -210,23 +210,7 @@ public:
 		*/
 		void add(Processor *newProcessor, Processor *siblingToInsertBefore) override;
 
-		void remove(Processor *processorToBeRemoved, bool removeEffect=true) override
-		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
-			jassert(dynamic_cast<EffectProcessor*>(processorToBeRemoved) != nullptr);
-			
-			chain->allEffects.removeAllInstancesOf(dynamic_cast<EffectProcessor*>(processorToBeRemoved));
-
-			if(VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved)) chain->voiceEffects.removeObject(vep, removeEffect);
-			else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved)) chain->masterEffects.removeObject(mep, removeEffect);
-			else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved)) chain->monoEffects.removeObject(moep, removeEffect);
-			else jassertfalse;
-
-			jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
-
-			sendChangeMessage();
-		}
+		void remove(Processor *processorToBeRemoved, bool removeEffect=true) override;
 
 		void moveProcessor(Processor *processorInChain, int delta)
 		{
@@ -240,6 +240,8 @@ bool MidiProcessorFactoryType::allowType(const Identifier &typeName) const
 
 void MidiProcessorChain::MidiProcessorChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
+	ModulatorSynthChain::ScopedDependencyUpdater sdu(chain);
+
 	ScopedLock sl(chain->getMainController()->getLock());
 
 	MidiProcessor *m = dynamic_cast<MidiProcessor*>(newProcessor);
@@ -262,4 +264,23 @@ void MidiProcessorChain::MidiProcessorChainHandler::add(Processor *newProcessor,
 	sendChangeMessage();
 }
 
+void MidiProcessorChain::MidiProcessorChainHandler::remove(Processor *processorToBeRemoved, bool deleteMp)
+{
+	ModulatorSynthChain::ScopedDependencyUpdater sdu(chain);
+
+	ScopedLock sl(chain->getMainController()->getLock());
+
+	jassert(dynamic_cast<MidiProcessor*>(processorToBeRemoved) != nullptr);
+	for(int i = 0; i < chain->processors.size(); i++)
+	{
+		if (chain->processors[i] == processorToBeRemoved)
+		{
+			chain->processors.remove(i, deleteMp);
+			break;
+		}
+	}
+
+	sendChangeMessage();
+}
+
 } // namespace hise
\ No newline at end of file
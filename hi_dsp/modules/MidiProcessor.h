@@ -231,22 +231,7 @@ public:
 
 		void add(Processor *newProcessor, Processor *siblingToInsertBefore);
 
-		void remove(Processor *processorToBeRemoved, bool deleteMp=true)
-		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
-			jassert(dynamic_cast<MidiProcessor*>(processorToBeRemoved) != nullptr);
-			for(int i = 0; i < chain->processors.size(); i++)
-			{
-				if (chain->processors[i] == processorToBeRemoved)
-				{
-					chain->processors.remove(i, deleteMp);
-					break;
-				}
-			}
-
-			sendChangeMessage();
-		};
+		void remove(Processor *processorToBeRemoved, bool deleteMp=true);
 
 		const Processor *getProcessor(int processorIndex) const override
 		{
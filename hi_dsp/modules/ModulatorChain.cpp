@@ -47,6 +47,14 @@ ModulatorChain::ModulatorChain(MainController *mc, const String &uid, int numVoi
 	setFactoryType(new ModulatorChainFactoryType(numVoices, m, p));
 
 	FloatVectorOperations::fill(lastVoiceValues, 1.0, NUM_POLYPHONIC_VOICES);
+	FloatVectorOperations::fill(lastControlValues, 1.0f, NUM_POLYPHONIC_VOICES + 1);
+
+	for (int i = 0; i < NUM_POLYPHONIC_VOICES; i++)
+		voiceBlockConstant[i] = true;
+
+	controlRateStartFlags.setRange(0, NUM_POLYPHONIC_VOICES + 1, true);
+
+	parameterNames.add("ControlRate");
 
 	if (Identifier::isValidIdentifier(uid))
 	{
@@ -161,6 +169,8 @@ void ModulatorChain::startVoice(int voiceIndex)
 
 	polyManager.setLastStartedVoice(voiceIndex);
 
+	controlRateStartFlags.setBit(voiceIndex, true);
+
 	for (int i = 0; i < voiceStartModulators.size(); i++) voiceStartModulators[i]->startVoice(voiceIndex);
 
 	for (int i = 0; i < envelopeModulators.size(); i++)
@@ -203,15 +213,121 @@ void ModulatorChain::prepareToPlay(double sampleRate, int samplesPerBlock)
 	EnvelopeModulator::prepareToPlay(sampleRate, samplesPerBlock);
 	blockSize = samplesPerBlock;
 
+	activeControlRateFactor = (samplesPerBlock % controlRateFactor == 0) ? controlRateFactor : 1;
+	controlRateStartFlags.setRange(0, NUM_POLYPHONIC_VOICES + 1, true);
+
 	ProcessorHelpers::increaseBufferIfNeeded(internalVoiceBuffer, samplesPerBlock);
 	ProcessorHelpers::increaseBufferIfNeeded(envelopeTempBuffer, samplesPerBlock);
+	ProcessorHelpers::increaseBufferIfNeeded(controlRateBuffer, samplesPerBlock);
 
-	for(int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
-	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
+	for(int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->prepareToPlay(getSampleRateForModulator(envelopeModulators[i]), samplesPerBlock);
+	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->prepareToPlay(getSampleRateForModulator(variantModulators[i]), samplesPerBlock);
 
 	jassert(checkModulatorStructure());
 };
 
+ValueTree ModulatorChain::exportAsValueTree() const
+{
+	ValueTree v = EnvelopeModulator::exportAsValueTree();
+
+	if (controlRateFactor != 1)
+		v.setProperty("ControlRate", controlRateFactor, nullptr);
+
+	return v;
+}
+
+void ModulatorChain::restoreFromValueTree(const ValueTree &v)
+{
+	EnvelopeModulator::restoreFromValueTree(v);
+
+	setControlRateDownsamplingFactor(v.getProperty("ControlRate", 1));
+}
+
+void ModulatorChain::setInternalAttribute(int parameterIndex, float newValue)
+{
+	if (parameterIndex < EnvelopeModulator::Parameters::numParameters)
+	{
+		EnvelopeModulator::setInternalAttribute(parameterIndex, newValue);
+		return;
+	}
+
+	switch (parameterIndex)
+	{
+	case ControlRate:	setControlRateDownsamplingFactor(roundToInt(newValue)); break;
+	default:			jassertfalse;
+	}
+}
+
+float ModulatorChain::getAttribute(int parameterIndex) const
+{
+	if (parameterIndex < EnvelopeModulator::Parameters::numParameters)
+	{
+		return EnvelopeModulator::getAttribute(parameterIndex);
+	}
+
+	switch (parameterIndex)
+	{
+	case ControlRate:	return (float)controlRateFactor;
+	default:			jassertfalse; return -1.0f;
+	}
+}
+
+float ModulatorChain::getDefaultValue(int parameterIndex) const
+{
+	if (parameterIndex < EnvelopeModulator::Parameters::numParameters)
+	{
+		return EnvelopeModulator::getDefaultValue(parameterIndex);
+	}
+
+	switch (parameterIndex)
+	{
+	case ControlRate:	return 1.0f;
+	default:			jassertfalse; return -1.0f;
+	}
+}
+
+void ModulatorChain::setControlRateDownsamplingFactor(int newFactor)
+{
+	newFactor = jlimit<int>(1, 8, nextPowerOfTwo(jmax<int>(1, newFactor)));
+
+	if (newFactor == controlRateFactor)
+		return;
+
+	MainController::ScopedSuspender ss(getMainController());
+
+	controlRateFactor = newFactor;
+
+	// The modulators need to be prepared with the new samplerate
+	if (isInitialized())
+		prepareToPlay(getSampleRate(), blockSize);
+}
+
+void ModulatorChain::setNumConcurrentVoices(int numConcurrentVoices)
+{
+	const int numVoices = polyManager.getVoiceAmount();
+
+	// Either one row for all voices or one row per voice
+	const int numRows = numConcurrentVoices > 1 ? numVoices : 1;
+
+	if (numRows != internalVoiceBuffer.getNumChannels())
+		internalVoiceBuffer.setSize(numRows, internalVoiceBuffer.getNumSamples());
+}
+
+bool ModulatorChain::usesControlRate(const TimeModulation* m) const
+{
+	return activeControlRateFactor > 1 && m->canBeCalculatedAtControlRate();
+}
+
+double ModulatorChain::getSampleRateForModulator(const Modulator* m) const
+{
+	auto tm = dynamic_cast<const TimeModulation*>(m);
+
+	if (tm != nullptr && usesControlRate(tm))
+		return getSampleRate() / (double)activeControlRateFactor;
+
+	return getSampleRate();
+}
+
 float ModulatorChain::calculateNewValue()
 {
 	jassertfalse;
@@ -249,7 +365,7 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 	newModulator->setConstrainerForAllInternalChains(chain->getFactoryType()->getConstrainer());
 
 	if (chain->isInitialized())
-		newModulator->prepareToPlay(chain->getSampleRate(), chain->blockSize);
+		newModulator->prepareToPlay(chain->getSampleRateForModulator(newModulator), chain->blockSize);
 	
 	const int index = siblingToInsertBefore == nullptr ? -1 : chain->allModulators.indexOf(dynamic_cast<Modulator*>(siblingToInsertBefore));
 
@@ -291,6 +407,8 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 
 void ModulatorChain::ModulatorChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
+	ModulatorSynthChain::ScopedDependencyUpdater sdu(chain);
+
 	//ScopedLock sl(chain->getMainController()->getLock());
 
 	jassert(dynamic_cast<Modulator*>(newProcessor) != nullptr);
@@ -341,6 +459,8 @@ void ModulatorChain::ModulatorChainHandler::deleteModulator(Modulator *modulator
 
 void ModulatorChain::ModulatorChainHandler::remove(Processor *processorToBeRemoved, bool deleteMod)
 {
+	ModulatorSynthChain::ScopedDependencyUpdater sdu(chain);
+
 	ScopedLock sl(chain->getMainController()->getLock());
 
 	jassert(dynamic_cast<Modulator*>(processorToBeRemoved) != nullptr);
@@ -442,13 +562,16 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 
 		lastVoiceValues[voiceIndex] = constantVoiceValue;
 
+		if (activeControlRateFactor > 1)
+			renderControlRateModulators(voiceIndex, startSample, numSamples);
+
 		for(int i = 0; i < envelopeModulators.size(); i++)
 		{
 			EnvelopeModulator *m = envelopeModulators[i];
 		
 			if(m->isBypassed() ) continue;
 
-			if (m->isInMonophonicMode())
+			if (m->isInMonophonicMode() || usesControlRate(m))
 				continue;
 			
 			m->polyManager.setCurrentVoice(voiceIndex);
@@ -471,8 +594,10 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 	if(getMode() != Modulation::PitchMode)
 		FloatVectorOperations::clip(internalBuffer.getWritePointer(0, startIndex), internalBuffer.getReadPointer(0, startIndex), (getMode() == Modulation::GainMode ? 0.0f : -1.0f), 1.0f, sampleAmount);
 
+	voiceBlockConstant[voiceIndex] = isConstant(internalBuffer.getReadPointer(0, startIndex), sampleAmount);
+
 	// Copy the result to the voice buffer
-	FloatVectorOperations::copy(internalVoiceBuffer.getWritePointer(voiceIndex, startIndex), internalBuffer.getReadPointer(0, startIndex), sampleAmount);
+	FloatVectorOperations::copy(internalVoiceBuffer.getWritePointer(getVoiceValueRow(voiceIndex), startIndex), internalBuffer.getReadPointer(0, startIndex), sampleAmount);
 
 #if ENABLE_PLOTTER
 	if(voiceIndex == polyManager.getLastStartedVoice())
@@ -500,20 +625,26 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
 
 		initializeBuffer(internalBuffer, startSample, numSamples);
 
+		bool somethingRendered = activeControlRateFactor > 1 && renderControlRateModulators(-1, startSample, numSamples);
+
 		for (auto v : variantModulators)
 		{
-			if (v->isBypassed()) continue;
+			if (v->isBypassed() || usesControlRate(v)) continue;
 			v->renderNextBlock(internalBuffer, startSample, numSamples);
+			somethingRendered = true;
 		}
 
 		for (auto m : envelopeModulators)
 		{
-			if (m->isBypassed()) continue;
+			if (m->isBypassed() || usesControlRate(m)) continue;
 			if (!m->isInMonophonicMode()) continue;
 
 			m->renderNextBlock(internalBuffer, startSample, numSamples);
+			somethingRendered = true;
 		}
 
+		timeVariantBlockConstant = !somethingRendered || isConstant(internalBuffer.getReadPointer(0, startSample), numSamples);
+
 #if ENABLE_PLOTTER
 		updatePlotter(internalBuffer, startSample, numSamples);
 #elif ENABLE_ALL_PEAK_METERS
@@ -528,6 +659,120 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
     
 }
 
+namespace ControlRateHelpers
+{
+
+/** Multiplies the destination with a linear ramp between the control values. 
+*
+*	The first ramp starts at lastValue and every ramp reaches its control value at the last sample of its
+*	control period. The factor is a template argument so that the inner loop can be unrolled and vectorised.
+*/
+template <int Factor> static void multiplyWithRamp(float* destination, const float* controlValues, int numSamples, float& lastValue)
+{
+	const float rampFactor = 1.0f / (float)Factor;
+	const int numControlValues = numSamples / Factor;
+
+	for (int i = 0; i < numControlValues; i++)
+	{
+		const float target = controlValues[i];
+		const float start = lastValue;
+		const float delta = (target - start) * rampFactor;
+
+		for (int j = 0; j < Factor; j++)
+			destination[j] *= start + delta * (float)(j + 1);
+
+		destination += Factor;
+		lastValue = target;
+	}
+
+	// This only happens if the block can't be divided by the factor
+	const int numRemaining = numSamples - numControlValues * Factor;
+
+	if (numRemaining > 0)
+	{
+		const float delta = (controlValues[numControlValues] - lastValue) * rampFactor;
+
+		for (int j = 0; j < numRemaining; j++)
+			destination[j] *= lastValue + delta * (float)(j + 1);
+
+		lastValue += delta * (float)numRemaining;
+	}
+}
+
+}
+
+bool ModulatorChain::renderControlRateModulators(int voiceIndex, int startSample, int numSamples)
+{
+	const int factor = activeControlRateFactor;
+	const bool renderPolyphonicEnvelopes = voiceIndex != -1;
+
+	// The event raster of the ModulatorSynth should prevent this...
+	jassert(startSample % factor == 0 && numSamples % factor == 0);
+
+	const int controlStart = startSample / factor;
+	const int numControlValues = (numSamples + factor - 1) / factor;
+
+	float* controlValues = controlRateBuffer.getWritePointer(0);
+
+	FloatVectorOperations::fill(controlValues + controlStart, 1.0f, numControlValues);
+
+	AudioSampleBuffer b(&controlValues, 1, controlStart + numControlValues);
+
+	bool somethingRendered = false;
+
+	if (!renderPolyphonicEnvelopes)
+	{
+		for (auto v : variantModulators)
+		{
+			if (v->isBypassed() || !usesControlRate(v)) continue;
+
+			v->renderNextBlock(b, controlStart, numControlValues);
+			somethingRendered = true;
+		}
+	}
+
+	for (auto m : envelopeModulators)
+	{
+		if (m->isBypassed() || !usesControlRate(m)) continue;
+		if (m->isInMonophonicMode() == renderPolyphonicEnvelopes) continue;
+
+		if (renderPolyphonicEnvelopes)
+			m->polyManager.setCurrentVoice(voiceIndex);
+
+		m->renderNextBlock(b, controlStart, numControlValues);
+
+		if (renderPolyphonicEnvelopes)
+			m->polyManager.clearCurrentVoice();
+
+		somethingRendered = true;
+	}
+
+	if (!somethingRendered)
+		return false;
+
+	const int stateIndex = renderPolyphonicEnvelopes ? voiceIndex : NUM_POLYPHONIC_VOICES;
+	float& lastValue = lastControlValues[stateIndex];
+
+	if (controlRateStartFlags[stateIndex])
+	{
+		lastValue = controlValues[controlStart];
+		controlRateStartFlags.setBit(stateIndex, false);
+	}
+
+	float* destination = internalBuffer.getWritePointer(0, startSample);
+	const float* source = controlValues + controlStart;
+
+	switch (factor)
+	{
+	case 2: ControlRateHelpers::multiplyWithRamp<2>(destination, source, numSamples, lastValue); break;
+	case 4: ControlRateHelpers::multiplyWithRamp<4>(destination, source, numSamples, lastValue); break;
+	case 8: ControlRateHelpers::multiplyWithRamp<8>(destination, source, numSamples, lastValue); break;
+	default: jassertfalse; break;
+	}
+
+	return true;
+}
+
 bool ModulatorChain::checkModulatorStructure()
 {
 	
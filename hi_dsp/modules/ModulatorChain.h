@@ -70,6 +70,12 @@ public:
 
 	SET_PROCESSOR_NAME("ModulatorChain", "Modulator Chain")
 
+	enum SpecialParameters
+	{
+		ControlRate = EnvelopeModulator::Parameters::numParameters, ///< the control rate downsampling factor (1, 2, 4 or 8)
+		numTotalParameters
+	};
+
 	class ModulatorChainHandler;
 
 	/** Creates a new modulator chain. You have to specify the voice amount and the Modulation::Mode */
@@ -109,6 +115,34 @@ public:
 
 	/** Sets the sample rate for all modulators in the chain and initialized the UpdateMerger. */
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+
+	ValueTree exportAsValueTree() const override;
+
+	void restoreFromValueTree(const ValueTree &v) override;
+
+	/** Calculates the envelopes and time variant modulators of this chain with a reduced rate.
+	*
+	*	This is also available as ControlRate attribute, so you can set it with setAttribute() from a script.
+	*
+	*	The modulators are prepared with the samplerate divided by this factor and render less samples. The product of 
+	*	all modulators is then upsampled with a linear ramp, which adds a latency of one control period.
+	*
+	*	The factor must be a power of two up to 8, so that it divides the event raster of the ModulatorSynth 
+	*	(if the block size can't be divided by the factor, the control rate is disabled). Modulators that return false
+	*	in TimeModulation::canBeCalculatedAtControlRate() are always calculated with the full samplerate.
+	*/
+	void setControlRateDownsamplingFactor(int newFactor);
+
+	int getControlRateDownsamplingFactor() const noexcept { return controlRateFactor; }
+
+	/** Returns true if the time variant values of the last renderNextBlock() call were the same for the whole block. 
+	*
+	*	You can use this to replace the multiplication with the buffer by a single gain value (or skip it if the value is 1.0f).
+	*/
+	bool isTimeVariantBlockConstant() const noexcept { return timeVariantBlockConstant; }
+
+	/** Returns true if the values of the last renderVoice() call for the given voice were the same for the whole block. */
+	bool isVoiceBlockConstant(int voiceIndex) const noexcept { return voiceBlockConstant[voiceIndex]; }
 	
 	/** Checks if the chain is bypassed or contains no modulators. 
 	*
@@ -158,9 +192,11 @@ public:
 	/** Calls the stopVoice function for all envelope modulators. */
 	void stopVoice(int voiceIndex) override;
 
-	void setInternalAttribute(int, float) override { jassertfalse; }; // nothing to do here!
+	void setInternalAttribute(int parameterIndex, float newValue) override;
+
+	float getAttribute(int parameterIndex) const override;
 
-	float getAttribute(int) const override { jassertfalse; return -1.0; }; // nothing to do here!
+	float getDefaultValue(int parameterIndex) const override;
 
 	/** Iterates all VoiceStartModulators and EnvelopeModulators and stores their values in the internal voice buffer.
 	*
@@ -168,13 +204,33 @@ public:
 	*/
 	void renderVoice(int voiceIndex, int startSample, int numSamples);
 
-	/** Returns a read pointer to the calculated voice values. The array size is supposed to be the size of the internal buffer. */
+	/** Returns a read pointer to the calculated voice values. The array size is supposed to be the size of the internal buffer. 
+	*
+	*	The values are only valid until another voice is rendered (unless every voice has its own row, see setNumConcurrentVoices()).
+	*/
 	float *getVoiceValues(int voiceIndex) noexcept
-	{ return internalVoiceBuffer.getWritePointer(voiceIndex); };
+	{ return internalVoiceBuffer.getWritePointer(getVoiceValueRow(voiceIndex)); };
 
 	/** Returns a write pointer to the calculated voice values. You can change them and the array size should be known. */
 	const float *getVoiceValues(int voiceIndex) const noexcept
-	{ return internalVoiceBuffer.getReadPointer(voiceIndex); }
+	{ return internalVoiceBuffer.getReadPointer(getVoiceValueRow(voiceIndex)); }
+
+	/** Sets the number of voices that are rendered at the same time.
+	*
+	*	The voice values are consumed by the voice before the next voice is rendered, so if the voices are rendered one
+	*	after another, they can share a single row instead of allocating one row per voice. If the voices are rendered in 
+	*	parallel, pass the number of voices. The ModulatorSynth calls this for all its chains in its prepareToPlay().
+	*/
+	void setNumConcurrentVoices(int numConcurrentVoices);
+
+	/** Returns the size of the voice value buffer in bytes. */
+	size_t getVoiceValueMemory() const noexcept { return sizeof(float) * (size_t)(internalVoiceBuffer.getNumChannels() * internalVoiceBuffer.getNumSamples()); }
+
+	/** Returns true if every voice has its own row of voice values (so the values of a voice survive the rendering of the next voice). */
+	bool hasVoiceValueRowForEachVoice() const noexcept { return internalVoiceBuffer.getNumChannels() >= polyManager.getVoiceAmount(); }
+
+	/** Returns the size that the voice value buffer would need with one row per voice. */
+	size_t getVoiceValueMemoryWithoutPooling() const noexcept { return sizeof(float) * (size_t)(polyManager.getVoiceAmount() * internalVoiceBuffer.getNumSamples()); }
 
 	/** This ocverrides the TimeVariant::renderNextBlock method and only calculates the TimeVariant modulators.
 	*
@@ -282,6 +338,37 @@ private:
 	// Checks if the Modulators are initialized correctly and are set to the right voices */
 	bool checkModulatorStructure();
 
+	/** Returns true if the modulator is calculated with the control rate. */
+	bool usesControlRate(const TimeModulation* m) const;
+
+	double getSampleRateForModulator(const Modulator* m) const;
+
+	/** Renders the control rate modulators (either the polyphonic envelopes of the given voice or the monophonic
+	*	modulators if voiceIndex is -1) and multiplies the upsampled result with the internal buffer.
+	*
+	*	Returns false if no modulator was rendered.
+	*/
+	bool renderControlRateModulators(int voiceIndex, int startSample, int numSamples);
+
+	int getVoiceValueRow(int voiceIndex) const noexcept { return internalVoiceBuffer.getNumChannels() == 1 ? 0 : voiceIndex; }
+
+	int controlRateFactor = 1;
+
+	// The control rate factor that is actually used (it's 1 if the block size can't be divided by controlRateFactor)
+	int activeControlRateFactor = 1;
+
+	AudioSampleBuffer controlRateBuffer;
+
+	// The last control rate values that are used as start of the ramp (index 0 ... NUM_POLYPHONIC_VOICES-1 for the voices,
+	// the last one for the monophonic modulators)
+	float lastControlValues[NUM_POLYPHONIC_VOICES + 1];
+
+	// Set when a voice starts so that the first ramp doesn't start from the value of the last note
+	BigInteger controlRateStartFlags;
+
+	bool timeVariantBlockConstant = true;
+	bool voiceBlockConstant[NUM_POLYPHONIC_VOICES];
+
 	BigInteger activeVoices;
 
 	// Saves 4 values of the envelope modulation result for later
@@ -323,7 +410,7 @@ private:
 
 	ScopedPointer<FactoryType> modulatorFactory;
 	
-	// A AudioSampleBuffer with one channel per voice
+	// A AudioSampleBuffer with one channel per voice (or a single channel that is shared by all voices)
 	AudioSampleBuffer internalVoiceBuffer;
 	
 	AudioSampleBuffer envelopeTempBuffer;
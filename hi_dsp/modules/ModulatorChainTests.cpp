@@ -0,0 +1,233 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+/** Renders the voices of a modulator chain with pooled and unpooled voice values. */
+class ModulatorChainTest : public UnitTest
+{
+public:
+
+	ModulatorChainTest() :
+		UnitTest("Testing ModulatorChain voice rendering")
+	{};
+
+	void runTest() override
+	{
+		TestController mc;
+
+		ModulatorChain parent(&mc, "Parent", NumVoices, Modulation::GainMode, nullptr);
+		ModulatorChain chain(&mc, "GainModulation", NumVoices, Modulation::GainMode, &parent);
+
+		beginTest("Serial rendering with a shared row");
+
+		chain.setNumConcurrentVoices(1);
+		chain.prepareToPlay(44100.0, BlockSize);
+
+		expectEquals<int>((int)chain.getVoiceValueMemory(), (int)(sizeof(float) * BlockSize), "Memory of a single row");
+
+		renderAllVoices(chain);
+
+		expect(chain.getVoiceValues(NumVoices - 1) == chain.getVoiceValues(0), "The voices share one row");
+
+		beginTest("Parallel rendering with a row per voice");
+
+		chain.setNumConcurrentVoices(NumVoices);
+		chain.prepareToPlay(44100.0, BlockSize);
+
+		expectEquals<int>((int)chain.getVoiceValueMemory(), (int)(sizeof(float) * BlockSize * NumVoices), "Memory of all rows");
+
+		renderAllVoices(chain);
+
+		expect(chain.getVoiceValues(NumVoices - 1) != chain.getVoiceValues(0), "Every voice has its own row");
+
+		auto handler = static_cast<ModulatorChain::ModulatorChainHandler*>(chain.getHandler());
+		handler->addModulator(new NoteNumberModulator(&mc, NumVoices), nullptr);
+
+		beginTest("Serial rendering with different voice values");
+
+		chain.setNumConcurrentVoices(1);
+		chain.prepareToPlay(44100.0, BlockSize);
+
+		renderVoicesWithDifferentValues(chain, false);
+
+		beginTest("Parallel rendering with different voice values");
+
+		chain.setNumConcurrentVoices(NumVoices);
+		chain.prepareToPlay(44100.0, BlockSize);
+
+		renderVoicesWithDifferentValues(chain, true);
+	}
+
+private:
+
+	enum
+	{
+		NumVoices = 8,
+		BlockSize = 256,
+		FirstNoteNumber = 60
+	};
+
+	/** A voice start modulator that returns a different value for every note number. */
+	class NoteNumberModulator : public VoiceStartModulator
+	{
+	public:
+
+		SET_PROCESSOR_NAME("NoteNumberTestModulator", "Note Number Test Modulator")
+
+		NoteNumberModulator(MainController* mc, int numVoices) :
+			VoiceStartModulator(mc, "NoteNumber", numVoices, Modulation::GainMode),
+			Modulation(Modulation::GainMode)
+		{};
+
+		ProcessorEditorBody* createEditor(ProcessorEditor* /*parentEditor*/) override { return nullptr; }
+
+		void setInternalAttribute(int, float) override {};
+
+		float getAttribute(int) const override { return 0.0f; };
+
+		float calculateVoiceStartValue(const HiseEvent& m) override
+		{
+			return getExpectedValue(m.getNoteNumber() - FirstNoteNumber);
+		};
+	};
+
+	static float getExpectedValue(int voiceIndex)
+	{
+		return (float)(FirstNoteNumber + voiceIndex) / 127.0f;
+	}
+
+	/** A MainController without a synth chain. 
+	*
+	*	It needs to be an AudioProcessor, because adding a modulator suspends the processing.
+	*/
+	struct TestController : public MainController,
+							public AudioProcessor
+	{
+		ModulatorSynthChain* getMainSynthChain() override { return nullptr; }
+		const ModulatorSynthChain* getMainSynthChain() const override { return nullptr; }
+
+		const String getName() const override { return "TestController"; }
+		void prepareToPlay(double, int) override {}
+		void releaseResources() override {}
+		void processBlock(AudioSampleBuffer&, MidiBuffer&) override {}
+		double getTailLengthSeconds() const override { return 0.0; }
+		bool acceptsMidi() const override { return false; }
+		bool producesMidi() const override { return false; }
+		AudioProcessorEditor* createEditor() override { return nullptr; }
+		bool hasEditor() const override { return false; }
+		int getNumPrograms() override { return 1; }
+		int getCurrentProgram() override { return 0; }
+		void setCurrentProgram(int) override {}
+		const String getProgramName(int) override { return {}; }
+		void changeProgramName(int, const String&) override {}
+		void getStateInformation(MemoryBlock&) override {}
+		void setStateInformation(const void*, int) override {}
+	};
+
+	/** Renders one voice after another and checks the values before the next voice is rendered. */
+	void renderAllVoices(ModulatorChain& chain)
+	{
+		AudioSampleBuffer timeVariantBuffer(1, BlockSize);
+
+		chain.renderNextBlock(timeVariantBuffer, 0, BlockSize);
+
+		for (int i = 0; i < NumVoices; i++)
+		{
+			chain.startVoice(i);
+			chain.renderVoice(i, 0, BlockSize);
+
+			const float* values = chain.getVoiceValues(i);
+
+			for (int s = 0; s < BlockSize; s++)
+			{
+				if (values[s] != 1.0f)
+				{
+					expectEquals<float>(values[s], 1.0f, "Voice " + String(i) + " at sample " + String(s));
+					break;
+				}
+			}
+
+			chain.stopVoice(i);
+		}
+	}
+
+	/** Starts every voice with another note number and checks the values of every row.
+	*
+	*	If checkAfterAllVoices is true, the rows are checked after all voices were rendered, so a voice that writes
+	*	into the row of another voice will be detected.
+	*/
+	void renderVoicesWithDifferentValues(ModulatorChain& chain, bool checkAfterAllVoices)
+	{
+		AudioSampleBuffer timeVariantBuffer(1, BlockSize);
+
+		chain.renderNextBlock(timeVariantBuffer, 0, BlockSize);
+
+		for (int i = 0; i < NumVoices; i++)
+		{
+			chain.handleHiseEvent(HiseEvent(HiseEvent::Type::NoteOn, (uint8)(FirstNoteNumber + i), 100));
+			chain.startVoice(i);
+			chain.renderVoice(i, 0, BlockSize);
+
+			if (!checkAfterAllVoices)
+				expectVoiceValues(chain, i);
+		}
+
+		for (int i = 0; i < NumVoices; i++)
+		{
+			if (checkAfterAllVoices)
+				expectVoiceValues(chain, i);
+
+			chain.stopVoice(i);
+		}
+	}
+
+	void expectVoiceValues(ModulatorChain& chain, int voiceIndex)
+	{
+		const float* values = chain.getVoiceValues(voiceIndex);
+		const float expected = getExpectedValue(voiceIndex);
+
+		for (int s = 0; s < BlockSize; s++)
+		{
+			if (std::abs(values[s] - expected) > 0.0001f)
+			{
+				expectEquals<float>(values[s], expected, "Voice " + String(voiceIndex) + " at sample " + String(s));
+				break;
+			}
+		}
+	}
+};
+
+static ModulatorChainTest modulatorChainTest;
+
+} // namespace hise
@@ -75,7 +75,8 @@ bypassState(false)
 {
 	setVoiceLimit(numVoices);
 
-	
+	soundsToBeStarted.ensureStorageAllocated(256);
+	parallelVoices.ensureStorageAllocated(NUM_POLYPHONIC_VOICES);
 
 	for (int i = 0; i < 4; i++)
 	{
@@ -469,6 +470,12 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 {
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthVoiceRendering);
     
+	if (useParallelVoiceRendering && activeVoices.size() > 1 && getMainController()->getParallelRenderingPool() != nullptr)
+	{
+		renderVoicesInParallel(startSample, numThisTime);
+		return;
+	}
+
 	for (int i = 0; i < activeVoices.size(); i++)
 	{
 		//jassert(!activeVoices[i]->isInactive());
@@ -482,6 +489,140 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 	}
 };
 
+
+void ModulatorSynth::renderVoicesInParallel(int startSample, int numThisTime)
+{
+	struct VoiceTask : public ParallelRenderingPool::Task
+	{
+		VoiceTask(const Array<ModulatorSynthVoice*>& voices_, int startSample_, int numSamples_) :
+			voices(voices_),
+			startSample(startSample_),
+			numSamples(numSamples_)
+		{};
+
+		void runTask(int taskIndex, int threadIndex) override
+		{
+			voices.getUnchecked(taskIndex)->renderParallelBlock(startSample, numSamples, threadIndex);
+		}
+
+		const Array<ModulatorSynthVoice*>& voices;
+		const int startSample;
+		const int numSamples;
+	};
+
+	// The voices keep the pointers to their modulation values until endParallelRendering()
+	jassert(gainChain->hasVoiceValueRowForEachVoice());
+
+	parallelVoices.clearQuick();
+
+	// Calculate the modulation for all voices on the audio thread...
+	for (int i = 0; i < activeVoices.size(); i++)
+	{
+		if (activeVoices[i]->beginParallelRendering(startSample, numThisTime))
+			parallelVoices.add(activeVoices[i]);
+	}
+
+	// ... render the voices concurrently ...
+	VoiceTask task(parallelVoices, startSample, numThisTime);
+	getMainController()->getParallelRenderingPool()->run(task, parallelVoices.size());
+
+	// ... and sum them up in the same order as the serial rendering.
+	for (int i = 0; i < activeVoices.size(); i++)
+	{
+		activeVoices[i]->endParallelRendering(internalBuffer, startSample, numThisTime);
+
+		if (activeVoices[i]->isInactive())
+		{
+			activeVoices.removeElement(i--);
+		}
+	}
+}
+
+void ModulatorSynth::setUseParallelVoiceRendering(bool shouldRenderInParallel)
+{
+	if (shouldRenderInParallel)
+		getMainController()->getOrCreateParallelRenderingPool();
+
+	if (shouldRenderInParallel == useParallelVoiceRendering)
+		return;
+
+	MainController::ScopedSuspender ss(getMainController());
+
+	useParallelVoiceRendering = shouldRenderInParallel;
+
+	// The voices need their own buffers now (or can share them again)
+	if (getSampleRate() > 0.0)
+		prepareToPlay(getSampleRate(), getBlockSize());
+}
+
+namespace VoiceScratchHelpers
+{
+
+/** Calls the function for every child processor that belongs to the synth (it skips the child synths and their children). */
+template <typename ProcessorType, typename F> static void forEachProcessorOfSynth(ProcessorType* p, const F& f)
+{
+	for (int i = 0; i < p->getNumChildProcessors(); i++)
+	{
+		auto c = p->getChildProcessor(i);
+
+		if (c == nullptr || dynamic_cast<const ModulatorSynth*>(c) != nullptr)
+			continue;
+
+		f(c);
+		forEachProcessorOfSynth(c, f);
+	}
+}
+
+}
+
+void ModulatorSynth::updateVoiceScratchBuffers(int samplesPerBlock)
+{
+	// The voices are rendered one after another and consume their buffers before the next voice starts
+	const int numConcurrentVoices = useParallelVoiceRendering ? getNumVoices() : 1;
+
+	int numChannelsPerVoice = 0;
+
+	for (int i = 0; i < getNumVoices(); i++)
+		numChannelsPerVoice = jmax<int>(numChannelsPerVoice, static_cast<ModulatorSynthVoice*>(getVoice(i))->getVoiceBuffer().getNumChannels());
+
+	if (numChannelsPerVoice > 0)
+	{
+		voiceScratchBuffer.setSize(numChannelsPerVoice * numConcurrentVoices, samplesPerBlock);
+
+		for (int i = 0; i < getNumVoices(); i++)
+			static_cast<ModulatorSynthVoice*>(getVoice(i))->setVoiceBufferScratch(voiceScratchBuffer, (i % numConcurrentVoices) * numChannelsPerVoice);
+	}
+
+	VoiceScratchHelpers::forEachProcessorOfSynth(this, [numConcurrentVoices](Processor* p)
+	{
+		if (auto chain = dynamic_cast<ModulatorChain*>(p))
+			chain->setNumConcurrentVoices(numConcurrentVoices);
+	});
+}
+
+ModulatorSynth::VoiceBufferMemory ModulatorSynth::getVoiceBufferMemory() const
+{
+	VoiceBufferMemory m;
+
+	m.pooledBytes = sizeof(float) * (size_t)(voiceScratchBuffer.getNumChannels() * voiceScratchBuffer.getNumSamples());
+
+	for (int i = 0; i < getNumVoices(); i++)
+	{
+		const auto& b = static_cast<const ModulatorSynthVoice*>(voices[i])->getVoiceBuffer();
+		m.unpooledBytes += sizeof(float) * (size_t)(b.getNumChannels() * b.getNumSamples());
+	}
+
+	VoiceScratchHelpers::forEachProcessorOfSynth(this, [&m](const Processor* p)
+	{
+		if (auto chain = dynamic_cast<const ModulatorChain*>(p))
+		{
+			m.pooledBytes += chain->getVoiceValueMemory();
+			m.unpooledBytes += chain->getVoiceValueMemoryWithoutPooling();
+		}
+	});
+
+	return m;
+}
 	
 void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 {
@@ -490,10 +631,17 @@ void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 
 	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRenderingGainMod, gainBuffer.getReadPointer(0, startSample), true, numThisTime);
 
+	// A constant block can be applied with a single gain value (or skipped if it's 1.0f)
+	const bool constantGain = gainChain->isTimeVariantBlockConstant();
+	const float constantGainValue = gainBuffer.getSample(0, startSample);
+
 	// Apply all gain modulators to the rendered voices
 	for (int i = 0; i < internalBuffer.getNumChannels(); i++)
 	{
-		FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), gainBuffer.getReadPointer(0, startSample), numThisTime);
+		if (!constantGain)
+			FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), gainBuffer.getReadPointer(0, startSample), numThisTime);
+		else if (constantGainValue != 1.0f)
+			FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), constantGainValue, numThisTime);
 
 		CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRendering, internalBuffer.getReadPointer(i, startSample), i % 2 != 0, numThisTime);
 	}
@@ -693,6 +841,23 @@ bool ModulatorSynth::soundCanBePlayed(ModulatorSynthSound *sound, int midiChanne
 	return sound->appliesToMessage(midiChannel, midiNoteNumber, (int)(velocity * 127));
 };
 
+void ModulatorSynth::collectSoundsToBeStarted(const HiseEvent &m)
+{
+	soundsToBeStarted.clearQuick();
+
+	const int midiChannel = m.getChannel();
+	const int transposedMidiNoteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const float velocity = m.getFloatVelocity();
+
+	for (int i = sounds.size(); --i >= 0;)
+	{
+		ModulatorSynthSound *sound = static_cast<ModulatorSynthSound*>(sounds.getUnchecked(i).get());
+
+		if (soundCanBePlayed(sound, midiChannel, transposedMidiNoteNumber, velocity))
+			soundsToBeStarted.add(sound);
+	}
+}
+
 
 
 	
@@ -738,6 +903,8 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
  			static_cast<ModulatorSynthVoice*>(getVoice(i))->prepareToPlay(newSampleRate, samplesPerBlock);
 		}
 
+		updateVoiceScratchBuffers(samplesPerBlock);
+
 		vuMerger.limitFromBlockSizeToFrameRate(newSampleRate, samplesPerBlock);
 
 		Synthesiser::setCurrentPlaybackSampleRate(newSampleRate);
@@ -845,57 +1012,54 @@ void ModulatorSynth::noteOn(const HiseEvent &m)
 	const int midiChannel = m.getChannel();
 	const int midiNoteNumber = m.getNoteNumber();
 	const int transposedMidiNoteNumber = midiNoteNumber + m.getTransposeAmount();
-	const float velocity = m.getFloatVelocity();
 
-    for (int i = sounds.size(); --i >= 0;)
+	collectSoundsToBeStarted(m);
+
+    for (int i = 0; i < soundsToBeStarted.size(); i++)
     {
-		SynthesiserSound *s = sounds.getUnchecked(i);
-        ModulatorSynthSound *sound = static_cast<ModulatorSynthSound*>(s);
+        ModulatorSynthSound *sound = soundsToBeStarted.getUnchecked(i);
 
-		if (soundCanBePlayed(sound, midiChannel, transposedMidiNoteNumber, velocity))
+        // If hitting a note that's still ringing, stop it first (it could be
+        // still playing because of the sustain or sostenuto pedal).
+        for (int j = voices.size(); --j >= 0;)
         {
-            // If hitting a note that's still ringing, stop it first (it could be
-            // still playing because of the sustain or sostenuto pedal).
-            for (int j = voices.size(); --j >= 0;)
-            {
-                ModulatorSynthVoice* const voice = static_cast<ModulatorSynthVoice*>(voices.getUnchecked (j));
+            ModulatorSynthVoice* const voice = static_cast<ModulatorSynthVoice*>(voices.getUnchecked (j));
 
-				const bool voiceIsActive = voice->isPlayingChannel(midiChannel) && !voice->isBeingKilled();
+			const bool voiceIsActive = voice->isPlayingChannel(midiChannel) && !voice->isBeingKilled();
 
-				// if the voiceLimit is reached, kill the voice!
+			// if the voiceLimit is reached, kill the voice!
 
-				if(voiceIsActive && j >= (internalVoiceLimit - 1)) 
-				{
-					killLastVoice();
-				}
+			if(voiceIsActive && j >= (internalVoiceLimit - 1)) 
+			{
+				killLastVoice();
+			}
 
-                else if (voice->getCurrentlyPlayingNote() == midiNoteNumber // Use the untransposed number for detecting repeated notes
-                     && voice->isPlayingChannel (midiChannel) && !(voice->getCurrentHiseEvent() == m))
-				{
-					handleRetriggeredNote(voice);
-				}
-            }
+            else if (voice->getCurrentlyPlayingNote() == midiNoteNumber // Use the untransposed number for detecting repeated notes
+                 && voice->isPlayingChannel (midiChannel) && !(voice->getCurrentHiseEvent() == m))
+			{
+				handleRetriggeredNote(voice);
+			}
+        }
 
-			ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(findFreeVoice (sound, midiChannel, midiNoteNumber, isNoteStealingEnabled()));
+		ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(findFreeVoice (sound, midiChannel, midiNoteNumber, isNoteStealingEnabled()));
 
-			if( v != nullptr)
-			{
-				const int voiceIndex = v->getVoiceIndex();
+		if( v != nullptr)
+		{
+			const int voiceIndex = v->getVoiceIndex();
 
-				jassert(voiceIndex != -1);
+			jassert(voiceIndex != -1);
 
-				v->setStartUptime(getMainController()->getUptime());
+			v->setStartUptime(getMainController()->getUptime());
 
-				v->setCurrentHiseEvent(m);
+			v->setCurrentHiseEvent(m);
 
-				preStartVoice(voiceIndex, transposedMidiNoteNumber);
+			preStartVoice(voiceIndex, transposedMidiNoteNumber);
 
-				startVoiceWithHiseEvent (v, sound, m);
-			}
+			startVoiceWithHiseEvent (v, sound, m);
+		}
 
-			// Deactivates starting of more than one voice per synth
-			//break;
-        }
+		// Deactivates starting of more than one voice per synth
+		//break;
 	}
 }
 
@@ -1036,6 +1200,9 @@ void ModulatorSynthVoice::resetVoice()
 	killThisVoice = false;
 	killFadeLevel = 1.0f;
 
+	eventVolumeApplied = false;
+	killFadeApplied = false;
+
     gainFader.setValue(1.0);
     gainFader.reset(44100.0, 0.0);
     
@@ -1256,36 +1423,168 @@ void ModulatorSynthVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int
 {
 	if (isActive)
     { 
+		markVoiceBufferAsDirty();
+
 		if(isPitchModulationActive()) calculateVoicePitchValues(startSample, numSamples);
 
 		calculateBlock(startSample, numSamples);
 
-		
-		if (gainFader.isSmoothing())
+		addVoiceBufferToOutput(outputBuffer, startSample, numSamples);
+    }
+}
+
+bool ModulatorSynthVoice::beginParallelRendering(int startSample, int numSamples)
+{
+	if (!isActive)
+		return false;
+
+	markVoiceBufferAsDirty();
+
+	if (isPitchModulationActive()) calculateVoicePitchValues(startSample, numSamples);
+
+	prepareParallelBlock(startSample, numSamples);
+
+	return true;
+}
+
+void ModulatorSynthVoice::endParallelRendering(AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+	// The voice must not be started or killed between beginParallelRendering() and this call
+	if (isActive)
+	{
+		finishParallelBlock(startSample, numSamples);
+
+		addVoiceBufferToOutput(outputBuffer, startSample, numSamples);
+	}
+}
+
+void ModulatorSynthVoice::applyGainStage(const float* gainValues, const float* secondGainValues, float leftGain, float rightGain, int startSample, int numSamples)
+{
+	// The event volume and the kill fade of a child voice are applied by the group voice
+	const bool isInGroup = getOwnerSynth()->isInGroup();
+
+	const bool applyEventVolume = !isInGroup;
+	const bool fadeEventVolume = applyEventVolume && gainFader.isSmoothing();
+
+	if (applyEventVolume && !fadeEventVolume)
+	{
+		jassert(eventGainFactor >= 0.0f && eventGainFactor < 20.0f);
+
+		if (eventGainFactor == 0.0f)
 		{
-			applyEventVolumeFade(startSample, numSamples);
+			killVoice();
 		}
-		else if (eventGainFactor != 1.0f)
+
+		leftGain *= eventGainFactor;
+		rightGain *= eventGainFactor;
+	}
+
+	const bool applyKillFade = killThisVoice && !isInGroup;
+
+	eventVolumeApplied = applyEventVolume;
+	killFadeApplied = applyKillFade;
+
+	const int numChannels = voiceBuffer.getNumChannels();
+
+	gainValues += startSample;
+
+	if (secondGainValues == nullptr && !fadeEventVolume && !applyKillFade && getOwnerSynth()->isGainConstantForVoice(voiceIndex))
+	{
+		// The whole stage is a single gain value per channel
+		for (int c = 0; c < numChannels; c++)
 		{
-			applyEventVolumeFactor(startSample, numSamples);
+			const float channelGain = gainValues[0] * ((c % 2 == 0) ? leftGain : rightGain);
+
+			if (channelGain != 1.0f)
+				FloatVectorOperations::multiply(voiceBuffer.getWritePointer(c, startSample), channelGain, numSamples);
 		}
 
-		if(killThisVoice)
+		return;
+	}
+
+	float* gain = (float*)alloca(sizeof(float)*numSamples);
+
+	if (secondGainValues != nullptr)
+		FloatVectorOperations::multiply(gain, gainValues, secondGainValues + startSample, numSamples);
+	else
+		FloatVectorOperations::copy(gain, gainValues, numSamples);
+
+	if (fadeEventVolume && applyKillFade)
+	{
+		for (int i = 0; i < numSamples; i++)
 		{
-			applyKillFadeout(startSample, numSamples);
+			eventGainFactor = gainFader.getNextValue();
+			killFadeLevel *= killFadeFactor;
+			gain[i] *= eventGainFactor * killFadeLevel;
 		}
+	}
+	else if (fadeEventVolume)
+	{
+		for (int i = 0; i < numSamples; i++)
+		{
+			eventGainFactor = gainFader.getNextValue();
+			gain[i] *= eventGainFactor;
+		}
+	}
+	else if (applyKillFade)
+	{
+		for (int i = 0; i < numSamples; i++)
+		{
+			killFadeLevel *= killFadeFactor;
+			gain[i] *= killFadeLevel;
+		}
+	}
 
-		const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
+	for (int c = 0; c < numChannels; c++)
+	{
+		const float channelGain = (c % 2 == 0) ? leftGain : rightGain;
+		float* d = voiceBuffer.getWritePointer(c, startSample);
 
-		for (int i = 0; i < maxChannelAmount; i++)
+		if (channelGain == 1.0f)
 		{
-			FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
+			FloatVectorOperations::multiply(d, gain, numSamples);
 		}
+		else
+		{
+			for (int i = 0; i < numSamples; i++)
+				d[i] *= gain[i] * channelGain;
+		}
+	}
+}
 
+void ModulatorSynthVoice::addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+	if (eventVolumeApplied)
+	{
+		eventVolumeApplied = false;
+	}
+	else if (gainFader.isSmoothing())
+	{
+		applyEventVolumeFade(startSample, numSamples);
+	}
+	else if (eventGainFactor != 1.0f)
+	{
+		applyEventVolumeFactor(startSample, numSamples);
+	}
 
-		// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
-		checkRelease();
-    }
+	if(killThisVoice)
+	{
+		applyKillFadeout(startSample, numSamples);
+	}
+	else
+	{
+		killFadeApplied = false;
+	}
+
+	const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
+
+	for (int i = 0; i < maxChannelAmount; i++)
+	{
+		FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
+	}
+
+	// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
+	checkRelease();
 }
 
 void ModulatorSynthVoice::setCurrentHiseEvent(const HiseEvent &m)
@@ -258,6 +258,14 @@ public:
 		/** Checks if the message fits the sound, but can be overriden to implement other group start logic. */
 	virtual bool soundCanBePlayed(ModulatorSynthSound *sound, int midiChannel, int midiNoteNumber, float velocity);
 
+	/** Adds all sounds that can be started with the given note on message to soundsToBeStarted.
+	*
+	*	The default implementation checks every sound with soundCanBePlayed(), so the cost depends on the amount of sounds.
+	*	Overwrite this if the synth can narrow down the candidates (the ModulatorSampler uses a prebuilt index for this).
+	*	The sounds will be started in the order in which they are added.
+	*/
+	virtual void collectSoundsToBeStarted(const HiseEvent &m);
+
 	void startVoiceWithHiseEvent(ModulatorSynthVoice* voice, SynthesiserSound *sound, const HiseEvent &e);
 
 	/** Same functionality as Synthesiser::noteOn(), but calls calculateVoiceStartValue() if a new voice is started. */
@@ -365,6 +373,29 @@ public:
 
 	void setKillRetriggeredNote(bool shouldBeKilled) { shouldKillRetriggeredNote = shouldBeKilled; }
 
+	/** Spreads the voice rendering across the threads of the ParallelRenderingPool. 
+	*
+	*	The voices are prepared and summed up on the audio thread in the order of the active voices, so the output is 
+	*	bit-identical to the serial rendering. Only the part of the voices that implement ModulatorSynthVoice::renderParallelBlock()
+	*	will be rendered concurrently. The voice effect chain and the gain stage run in finishParallelBlock() on the audio
+	*	thread, because the voice effects share their state between the voices.
+	*/
+	virtual void setUseParallelVoiceRendering(bool shouldRenderInParallel);
+
+	bool isUsingParallelVoiceRendering() const noexcept { return useParallelVoiceRendering; }
+
+	/** The memory of the voice buffers and the voice values of the modulation chains that belong to this synth. */
+	struct VoiceBufferMemory
+	{
+		size_t pooledBytes = 0;
+
+		/** The memory that would be needed with a separate buffer for every voice. */
+		size_t unpooledBytes = 0;
+	};
+
+	/** Returns the memory of the voice buffers (excluding the child synths). */
+	VoiceBufferMemory getVoiceBufferMemory() const;
+
 	/** specifies the behaviour when a note is started that is already ringing. By default, it is killed, but you can overwrite it to make something else. */
 	virtual void handleRetriggeredNote(ModulatorSynthVoice *voice);
 
@@ -378,12 +409,24 @@ public:
 		return gainData;
 	};
 
+	/** Returns true if the gain values of the last calculateGainValuesForVoice() call were constant for the whole block. */
+	bool isGainConstantForVoice(int voiceIndex) const noexcept { return gainChain->isVoiceBlockConstant(voiceIndex); }
+
 	/** calculates the voice pitch values. You can get the values with getPitchValues for voice. */
 	void calculatePitchValuesForVoice(int voiceIndex, float scriptPitchValue, int startSample, int numSamples)
 	{
         pitchChain->renderVoice(voiceIndex, startSample, numSamples);
 		float *voicePitchValues = pitchChain->getVoiceValues(voiceIndex);
 		const float *timeVariantPitchValues = getConstantPitchValues();
+
+		if (pitchChain->isTimeVariantBlockConstant())
+		{
+			// Combine the time variant value and the script value into a single multiplication
+			const float pitchFactor = timeVariantPitchValues[startSample] * scriptPitchValue;
+			if (pitchFactor != 1.0f) FloatVectorOperations::multiply(voicePitchValues + startSample, pitchFactor, numSamples);
+			return;
+		}
+
 		FloatVectorOperations::multiply(voicePitchValues, timeVariantPitchValues, startSample + numSamples);
 		if (scriptPitchValue != 1.0f) FloatVectorOperations::multiply(voicePitchValues, scriptPitchValue, startSample + numSamples);
 	}
@@ -434,17 +477,30 @@ protected:
 	// Used to display the playing position
 	ModulatorSynthVoice *lastStartedVoice;
 
+	// Will be filled by collectSoundsToBeStarted() for each note on
+	Array<ModulatorSynthSound*> soundsToBeStarted;
+
+	bool useParallelVoiceRendering = false;
+
 	
 
 private:
 
-	
+	void renderVoicesInParallel(int startSample, int numThisTime);
+
+	/** Hands out the voice buffers and the voice value rows of the chains for the voices that can be rendered at the same time. */
+	void updateVoiceScratchBuffers(int samplesPerBlock);
 
 
 	// ===================================================================================================================
 
 	VoiceStack activeVoices;
 
+	Array<ModulatorSynthVoice*> parallelVoices;
+
+	// The memory of the voice buffers (one buffer that is shared by all voices or one buffer per voice if the voices are rendered in parallel)
+	AudioSampleBuffer voiceScratchBuffer;
+
 	Colour iconColour;
 
 	ClockSpeed clockSpeed;
@@ -525,6 +581,31 @@ public:
 
 
 	virtual void calculateBlock(int startSample, int numSamples) = 0;
+
+	/** Prepares the parallel rendering of this voice. This is always called on the audio thread (in the order of the active voices).
+	*
+	*	If the voice supports parallel rendering, calculateBlock() must do the same as calling prepareParallelBlock(), 
+	*	renderParallelBlock() and finishParallelBlock() in this order. Use this method to calculate everything that
+	*	touches the owner synth (modulation chains, shared buffers etc). The default implementation does nothing and 
+	*	renders the entire block in finishParallelBlock().
+	*/
+	virtual void prepareParallelBlock(int /*startSample*/, int /*numSamples*/) {};
+
+	/** Renders the part of the block that only depends on the state of this voice. 
+	*
+	*	This might be called on one of the threads of the ParallelRenderingPool, so you must not access anything that
+	*	is shared between the voices. Use the threadIndex to pick a scratch buffer that isn't used by another thread.
+	*/
+	virtual void renderParallelBlock(int /*startSample*/, int /*numSamples*/, int /*threadIndex*/) {};
+
+	/** Finishes the parallel rendering of this voice. This is always called on the audio thread (in the order of the active voices). */
+	virtual void finishParallelBlock(int startSample, int numSamples) { calculateBlock(startSample, numSamples); };
+
+	/** Calculates the pitch values and calls prepareParallelBlock(). Returns false if the voice is not active. */
+	bool beginParallelRendering(int startSample, int numSamples);
+
+	/** Calls finishParallelBlock() and adds the voice to the output buffer just like renderNextBlock(). */
+	void endParallelRendering(AudioSampleBuffer& outputBuffer, int startSample, int numSamples);
 	
 	void calculateVoicePitchValues(int startSample, int numSamples)
 	{
@@ -609,6 +690,26 @@ public:
 		ProcessorHelpers::increaseBufferIfNeeded(voiceBuffer, samplesPerBlock);
 	}
 
+	const AudioSampleBuffer& getVoiceBuffer() const noexcept { return voiceBuffer; }
+
+	/** Lets the voice buffer use the given channels of the scratch buffer of the owner synth. */
+	void setVoiceBufferScratch(AudioSampleBuffer& scratchBuffer, int firstChannel)
+	{
+		jassert(firstChannel + voiceBuffer.getNumChannels() <= scratchBuffer.getNumChannels());
+
+		voiceBuffer.setDataToReferTo(scratchBuffer.getArrayOfWritePointers() + firstChannel, voiceBuffer.getNumChannels(), scratchBuffer.getNumSamples());
+	}
+
+	/** Call this before the voice is rendered. 
+	*
+	*	The voice buffer might share its memory with other voices, so the cleared flag of the buffer must be reset 
+	*	(otherwise clear() would skip the data that another voice has written since the last call).
+	*/
+	void markVoiceBufferAsDirty() noexcept
+	{
+		voiceBuffer.getArrayOfWritePointers();
+	}
+
 	virtual void setInactive()
 	{
 		// Call this only on non active notes!
@@ -648,41 +749,56 @@ public:
 
 	
 
+	/** Applies the kill fade to the voice buffer. This does nothing if the fade was already applied by applyGainStage() in this block. */
 	void applyKillFadeout(int startSample, int numSamples)
 	{
-		
-
-		while(--numSamples >= 0)
+		if (killFadeApplied)
 		{
-			killFadeLevel *= killFadeFactor;
+			killFadeApplied = false;
+			return;
+		}
 
-			for (int i = 0; i < voiceBuffer.getNumChannels(); i++)
-			{
-				voiceBuffer.getWritePointer(i)[startSample] *= killFadeLevel;
-			}
+		float* ramp = (float*)alloca(sizeof(float)*numSamples);
 
-			//l[startSample] *= killFadeLevel;
-			//r[startSample] *= killFadeLevel;
+		for (int i = 0; i < numSamples; i++)
+		{
+			killFadeLevel *= killFadeFactor;
+			ramp[i] = killFadeLevel;
+		}
 
-			startSample++;
+		for (int i = 0; i < voiceBuffer.getNumChannels(); i++)
+		{
+			FloatVectorOperations::multiply(voiceBuffer.getWritePointer(i, startSample), ramp, numSamples);
 		}
 	}
 
 	void applyEventVolumeFade(int startSample, int numSamples)
 	{
-		while (--numSamples >= 0)
+		float* ramp = (float*)alloca(sizeof(float)*numSamples);
+
+		for (int i = 0; i < numSamples; i++)
 		{
 			eventGainFactor = gainFader.getNextValue();
+			ramp[i] = eventGainFactor;
+		}
 
-			for (int i = 0; i < voiceBuffer.getNumChannels(); i++)
-			{
-				voiceBuffer.getWritePointer(i)[startSample] *= eventGainFactor;
-			}
-
-			startSample++;
+		for (int i = 0; i < voiceBuffer.getNumChannels(); i++)
+		{
+			FloatVectorOperations::multiply(voiceBuffer.getWritePointer(i, startSample), ramp, numSamples);
 		}
 	}
 
+	/** Applies all gain factors of the voice to the voice buffer in a single pass per channel.
+	*
+	*	This multiplies the voice buffer with the gain values (which must be the values returned by getVoiceGainValues()),
+	*	the optional second gain values (eg. crossfade values), the channel gain (even channels use leftGain, odd channels
+	*	rightGain), the event volume and the kill fade. The ramps of the event volume and the kill fade are calculated
+	*	inline, so addVoiceBufferToOutput() and applyKillFadeout() skip them for this block.
+	*
+	*	If the voice is part of a group, the event volume is not applied (the group voice uses its own event volume).
+	*/
+	void applyGainStage(const float* gainValues, const float* secondGainValues, float leftGain, float rightGain, int startSample, int numSamples);
+
 	void applyEventVolumeFactor(int startSample, int numSamples)
 	{
 		jassert(eventGainFactor >= 0.0f && eventGainFactor < 20.0f);
@@ -698,6 +814,9 @@ public:
 		}
 	}
 
+	/** Applies the event volume & kill fade to the voice buffer, adds it to the output and checks the release. */
+	void addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples);
+
 	/** This checks the envelopes of the gain modulation if any envelopes are tailing off. */
 	virtual void checkRelease();
 
@@ -810,6 +929,10 @@ private:
 
 	bool killThisVoice;
 
+	// set by applyGainStage() and cleared when the voice buffer is added to the output
+	bool eventVolumeApplied = false;
+	bool killFadeApplied = false;
+
 	bool isTailing;
 
     
@@ -121,6 +121,8 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 	ModulatorSynth::prepareToPlay(newSampleRate, samplesPerBlock);
 
 	for (int i = 0; i < synths.size(); i++) synths[i]->prepareToPlay(newSampleRate, samplesPerBlock);
+
+	refreshSynthDependencies();
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -139,7 +141,7 @@ void ModulatorSynthChain::numSourceChannelsChanged()
 
 	ModulatorSynth::numSourceChannelsChanged();
 
-	
+	refreshSynthDependencies();
 }
 
 void ModulatorSynthChain::numDestinationChannelsChanged()
@@ -169,14 +171,36 @@ void ModulatorSynthChain::addProcessorsWhenEmpty()
 	
 }
 
+/** Parses the onInit callback of a script on a worker thread. */
+struct ModulatorSynthChain::ScriptParseJob : public ThreadPoolJob
+{
+	ScriptParseJob(JavascriptProcessor* sp_) :
+		ThreadPoolJob("Script Parsing"),
+		sp(sp_)
+	{}
+
+	JobStatus runJob() override
+	{
+		isOrderIndependent = sp->parseOnInitCallback();
+		return jobHasFinished;
+	}
+
+	JavascriptProcessor* sp;
+	bool isOrderIndependent = true;
+};
+
 void ModulatorSynthChain::compileAllScripts()
 {
 	if (getMainController()->isCompilingAllScriptsOnPresetLoad())
 	{
+		const double startTime = Time::getMillisecondCounterHiRes();
+
 		Processor::Iterator<JavascriptProcessor> it(this);
 
 		JavascriptProcessor *sp;
 
+		Array<JavascriptProcessor*> scripts;
+
 		while ((sp = it.getNextProcessor()) != 0)
 		{
 			auto c = sp->getContent();
@@ -185,9 +209,75 @@ void ModulatorSynthChain::compileAllScripts()
 
 			sp->getContent()->resetContentProperties();
 
-			sp->compileScript();
+			scripts.add(sp);
+		}
+
+		bool isOrderIndependent = true;
+
+		Array<JavascriptProcessor::SnippetResult> results;
+
+		// Each call locks the audio thread only while the engine of its script is replaced.
+		// The new engines have no defined callbacks until their onInit callback was executed.
+		for (auto s : scripts)
+			s->prepareCompilation();
+
+		// The parser only touches the engine of its script, so the scripts are parsed
+		// concurrently without holding any lock
+		if (scripts.size() > 1)
+		{
+			if (scriptParsePool == nullptr)
+				scriptParsePool = new ThreadPool(jlimit<int>(1, 8, SystemStats::getNumCpus()));
+
+			OwnedArray<ScriptParseJob> jobs;
+
+			for (auto s : scripts)
+				scriptParsePool->addJob(jobs.add(new ScriptParseJob(s)), false);
+
+			for (auto job : jobs)
+			{
+				scriptParsePool->waitForJobToFinish(job, -1);
+				isOrderIndependent &= job->isOrderIndependent;
+			}
+		}
+		else
+		{
+			for (auto s : scripts)
+				isOrderIndependent &= s->parseOnInitCallback();
+		}
+
+		// A global declaration changes the parsing of all following scripts, so they are parsed in order
+		if (!isOrderIndependent)
+		{
+			for (auto s : scripts)
+				s->discardParsedOnInitCallback();
+		}
+
+		// Only the execution of the onInit callback needs the audio lock, which compilePreparedScript() acquires
+		for (auto s : scripts)
+			results.add(s->compilePreparedScript());
+
+		for (int i = 0; i < scripts.size(); i++)
+		{
+			auto s = scripts[i];
+
+			s->finishCompilation(results.getReference(i));
+
+			if (auto engine = s->getScriptEngine())
+			{
+				debugToConsole(dynamic_cast<Processor*>(s), "Parsed in " + String(engine->getParseMilliseconds(), 1) + "ms, onInit executed in " + 
+								  String(engine->getExecutionMilliseconds(), 1) + "ms");
+			}
+		}
+
+		if (!scripts.isEmpty())
+		{
+			debugToConsole(this, "Compiled " + String(scripts.size()) + " scripts in " + 
+								 String(Time::getMillisecondCounterHiRes() - startTime, 1) + "ms" + 
+								 (isOrderIndependent ? String() : String(" (parsed in order because of global variables)")));
 		}
 	}
+
+	refreshSynthDependencies();
 }
 
 void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffer, const HiseEventBuffer &inputMidiBuffer)
@@ -246,7 +336,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	internalBuffer.setSize(getMatrix().getNumSourceChannels(), numSamples, true, false, true);
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++) if (!synths[i]->isSoftBypassed()) synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+	renderChildSynths(numSamples);
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -311,6 +401,224 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 }
 
 
+void ModulatorSynthChain::renderChildSynths(int numSamples)
+{
+	if (useParallelSynthRendering && 
+		dependencyGraph != nullptr && 
+		dependencyGraph->isValidFor(synths) &&
+		getMainController()->getParallelRenderingPool() != nullptr)
+	{
+		renderChildSynthsInParallel(numSamples);
+		return;
+	}
+
+	for (int i = 0; i < synths.size(); i++) if (!synths[i]->isSoftBypassed()) synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+}
+
+void ModulatorSynthChain::renderChildSynthsInParallel(int numSamples)
+{
+	struct SynthTask : public ParallelRenderingPool::Task
+	{
+		SynthTask(const Array<ModulatorSynth*>& synths_, const OwnedArray<AudioSampleBuffer>& scratchBuffers_, const HiseEventBuffer& events_, int numChannels_, int numSamples_) :
+			synthsToRender(synths_),
+			scratchBuffers(scratchBuffers_),
+			events(events_),
+			numChannels(numChannels_),
+			numSamples(numSamples_)
+		{};
+
+		void runTask(int taskIndex, int /*threadIndex*/) override
+		{
+			AudioSampleBuffer output(scratchBuffers[taskIndex]->getArrayOfWritePointers(), numChannels, numSamples);
+			output.clear();
+
+			synthsToRender.getUnchecked(taskIndex)->renderNextBlockWithModulators(output, events);
+		}
+
+		const Array<ModulatorSynth*>& synthsToRender;
+		const OwnedArray<AudioSampleBuffer>& scratchBuffers;
+		const HiseEventBuffer& events;
+		const int numChannels;
+		const int numSamples;
+	};
+
+	auto graph = dependencyGraph.get();
+	auto pool = getMainController()->getParallelRenderingPool();
+
+	const int numChannels = internalBuffer.getNumChannels();
+
+	const bool scratchBuffersFit = graph->scratchBuffers.size() > 0 &&
+								   graph->scratchBuffers.getFirst()->getNumChannels() >= numChannels &&
+								   graph->scratchBuffers.getFirst()->getNumSamples() >= numSamples;
+
+	for (const auto& stage : graph->stages)
+	{
+		synthsInStage.clearQuick();
+
+		for (int i = stage.start; i < stage.end; i++)
+		{
+			if (!synths[i]->isSoftBypassed())
+				synthsInStage.add(synths[i]);
+		}
+
+		if (!stage.concurrent || !scratchBuffersFit || synthsInStage.size() < 2)
+		{
+			for (auto s : synthsInStage)
+				s->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+
+			continue;
+		}
+
+		SynthTask task(synthsInStage, graph->scratchBuffers, eventBuffer, numChannels, numSamples);
+		pool->run(task, synthsInStage.size());
+
+		// Sum up the scratch buffers in the order of the child synths
+		for (int i = 0; i < synthsInStage.size(); i++)
+		{
+			for (int c = 0; c < numChannels; c++)
+			{
+				FloatVectorOperations::add(internalBuffer.getWritePointer(c, 0), graph->scratchBuffers[i]->getReadPointer(c, 0), numSamples);
+			}
+		}
+	}
+}
+
+void ModulatorSynthChain::setUseParallelSynthRendering(bool shouldRenderInParallel)
+{
+	if (shouldRenderInParallel)
+		getMainController()->getOrCreateParallelRenderingPool();
+
+	useParallelSynthRendering = shouldRenderInParallel;
+
+	refreshSynthDependencies();
+}
+
+void ModulatorSynthChain::refreshSynthDependencies()
+{
+	ScopedPointer<SynthDependencyGraph> newGraph;
+
+	if (useParallelSynthRendering)
+	{
+		newGraph = new SynthDependencyGraph();
+		newGraph->build(synths, getMatrix().getNumSourceChannels(), getBlockSize());
+	}
+
+	ScopedLock sl(getSynthLock());
+
+	synthsInStage.ensureStorageAllocated(synths.size());
+	dependencyGraph.swapWith(newGraph);
+}
+
+ModulatorSynthChain::ScopedDependencyUpdater::ScopedDependencyUpdater(Processor* processorInChain)
+{
+	// No chain renders in parallel if the pool was never created
+	if (processorInChain->getMainController()->getParallelRenderingPool() == nullptr)
+		return;
+
+	Processor* p = processorInChain;
+
+	while ((p = ProcessorHelpers::findParentProcessor(p, true)) != nullptr)
+	{
+		if (auto chain = dynamic_cast<ModulatorSynthChain*>(p))
+		{
+			if (chain->isUsingParallelSynthRendering())
+			{
+				ScopedLock sl(chain->getSynthLock());
+				chain->dependencyGraph = nullptr;
+
+				parentChains.add(chain);
+			}
+		}
+	}
+}
+
+ModulatorSynthChain::ScopedDependencyUpdater::~ScopedDependencyUpdater()
+{
+	for (auto p : parentChains)
+	{
+		if (auto chain = dynamic_cast<ModulatorSynthChain*>(p.get()))
+			chain->refreshSynthDependencies();
+	}
+}
+
+bool ModulatorSynthChain::SynthDependencyGraph::needsExclusiveRendering(ModulatorSynth* s)
+{
+	if (ProcessorHelpers::is<ModulatorSynthChain>(s) ||
+		ProcessorHelpers::is<ModulatorSynthGroup>(s) ||
+		ProcessorHelpers::is<GlobalModulatorContainer>(s))
+	{
+		return true;
+	}
+
+	Processor::Iterator<Processor> iter(s);
+
+	while (auto p = iter.getNextProcessor())
+	{
+		if (ProcessorHelpers::is<JavascriptProcessor>(p) ||
+			ProcessorHelpers::is<GainCollector>(p) ||
+			ProcessorHelpers::is<GainMatcherModulator>(p) ||
+			ProcessorHelpers::is<SlotFX>(p))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ModulatorSynthChain::SynthDependencyGraph::build(const OwnedArray<ModulatorSynth>& synthsToUse, int numChannels, int blockSize)
+{
+	Array<bool> exclusive;
+
+	for (auto s : synthsToUse)
+	{
+		orderedSynths.add(s);
+		exclusive.add(needsExclusiveRendering(s));
+	}
+
+	int maxConcurrentSynths = 0;
+
+	for (int i = 0; i < synthsToUse.size();)
+	{
+		if (exclusive[i])
+		{
+			stages.add({ i, i + 1, false });
+			i++;
+			continue;
+		}
+
+		int end = i + 1;
+
+		while (end < synthsToUse.size() && !exclusive[end])
+			end++;
+
+		stages.add({ i, end, end - i > 1 });
+		maxConcurrentSynths = jmax<int>(maxConcurrentSynths, end - i);
+
+		i = end;
+	}
+
+	if (maxConcurrentSynths > 1)
+	{
+		for (int i = 0; i < maxConcurrentSynths; i++)
+			scratchBuffers.add(new AudioSampleBuffer(numChannels, blockSize));
+	}
+}
+
+bool ModulatorSynthChain::SynthDependencyGraph::isValidFor(const OwnedArray<ModulatorSynth>& synthsToCheck) const
+{
+	if (synthsToCheck.size() != orderedSynths.size())
+		return false;
+
+	for (int i = 0; i < orderedSynths.size(); i++)
+	{
+		if (synthsToCheck.getUnchecked(i) != orderedSynths.getUnchecked(i))
+			return false;
+	}
+
+	return true;
+}
+
 void ModulatorSynthChain::restoreFromValueTree(const ValueTree &v)
 {
 	packageName = v.getProperty("packageName", "");
@@ -534,6 +842,8 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 		synth->synths.insert(index, ms);
 	}
 
+	synth->refreshSynthDependencies();
+
 	sendChangeMessage();
 }
 
@@ -542,7 +852,12 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::remove(Processor *processo
 	{
 		auto& tmp = synth;
 
-		auto f = [tmp, removeSynth](Processor* p) { tmp->synths.removeObject(dynamic_cast<ModulatorSynth*>(p), removeSynth); return true; };
+		auto f = [tmp, removeSynth](Processor* p) 
+		{ 
+			tmp->synths.removeObject(dynamic_cast<ModulatorSynth*>(p), removeSynth); 
+			tmp->refreshSynthDependencies();
+			return true; 
+		};
 
 		synth->getMainController()->getKillStateHandler().killVoicesAndCall(processorToBeRemoved, f, MainController::KillStateHandler::TargetThread::MessageThread);
 		
@@ -570,6 +885,7 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::clear()
 {
 	ScopedLock sl(synth->getMainController()->getLock());
 
+	synth->dependencyGraph = nullptr;
 	synth->synths.clear();
 
 	sendChangeMessage();
@@ -161,6 +161,10 @@ public:
 	*
 	*	If a ScriptProcessor is restored, the script will not be compiled immediately, because it could rely on other Processors that are created afterwards.
 	*	Call this function after every processor is created (normally after the restoreFromValueTree function).
+	*
+	*	The onInit callbacks of all scripts are parsed on a thread pool first, then the scripts are compiled one after
+	*	another in the order of the module tree (so onInit is executed in the same order as before). The parse and
+	*	onInit time of each script is written to the console.
 	*/
 	void compileAllScripts();
 
@@ -175,6 +179,41 @@ public:
 	*/
 	void renderNextBlockWithModulators(AudioSampleBuffer &buffer, const HiseEventBuffer &inputMidiBuffer) override;;
 
+	/** Renders the child synths that don't depend on each other concurrently on the ParallelRenderingPool.
+	*
+	*	Every child synth renders into its own scratch buffer and the buffers are summed up in the order of the child synths,
+	*	so the output is bit-identical to the serial rendering.
+	*/
+	void setUseParallelSynthRendering(bool shouldRenderInParallel);
+
+	bool isUsingParallelSynthRendering() const noexcept { return useParallelSynthRendering; }
+
+	/** Rebuilds the dependency graph of the child synths. 
+	*
+	*	This is called automatically when a child synth is added or removed, when the chain is prepared, after the scripts
+	*	are compiled and when a module is added to or removed from a chain inside a child synth (see ScopedDependencyUpdater).
+	*/
+	void refreshSynthDependencies();
+
+	/** Drops the dependency graphs of all chains above the given processor and rebuilds them when it goes out of scope.
+	*
+	*	Create one of these in the Chain::Handler methods that add or remove a processor, so that a module which changes the
+	*	dependencies (eg. a script processor inside a child synth) is picked up. Until the graph is rebuilt, the chains render
+	*	their child synths serially.
+	*/
+	class ScopedDependencyUpdater
+	{
+	public:
+
+		ScopedDependencyUpdater(Processor* processorInChain);
+
+		~ScopedDependencyUpdater();
+
+	private:
+
+		Array<WeakReference<Processor>> parentChains;
+	};
+
 	int getVoiceAmount() const {return numVoices;};
 
 	int getNumActiveVoices() const override;
@@ -231,13 +270,58 @@ public:
 
 private:
 
+	struct ScriptParseJob;
+
+	/** The order in which the child synths are rendered when the parallel rendering is enabled.
+	*
+	*	Some synths need exclusive access to the chain: scripts can access every other module, global modulator containers
+	*	and gain collectors provide values to other synths and nested containers / groups take the synth lock while rendering.
+	*	These synths depend on every synth before them, and every synth after them depends on them. All other synths are
+	*	independent, so the graph collapses into stages of neighbouring synths that are rendered concurrently.
+	*/
+	struct SynthDependencyGraph
+	{
+		struct Stage
+		{
+			int start;
+			int end;
+			bool concurrent;
+		};
+
+		/** Checks if the synth must be rendered while no other synth of the chain is rendered. */
+		static bool needsExclusiveRendering(ModulatorSynth* s);
+
+		void build(const OwnedArray<ModulatorSynth>& synthsToUse, int numChannels, int blockSize);
+
+		/** Checks if the graph was built for the current list of child synths. */
+		bool isValidFor(const OwnedArray<ModulatorSynth>& synthsToCheck) const;
+
+		Array<ModulatorSynth*> orderedSynths;
+		Array<Stage> stages;
+
+		// One scratch buffer for each synth of the biggest concurrent stage
+		OwnedArray<AudioSampleBuffer> scratchBuffers;
+	};
+
+	void renderChildSynths(int numSamples);
+
+	void renderChildSynthsInParallel(int numSamples);
+
 	HiseEvent::ChannelFilterData activeChannels;
 	ModulatorSynthChainHandler handler;
 	int numVoices;
 	float vuValue;
 	OwnedArray<ModulatorSynth> synths;
+
+	bool useParallelSynthRendering = false;
+	ScopedPointer<SynthDependencyGraph> dependencyGraph;
+	Array<ModulatorSynth*> synthsInStage;
 	ScopedPointer<FactoryType> modulatorSynthFactory;
 	ScopedPointer<FactoryType::Constrainer> constrainer;
+
+	// Created on the first compileAllScripts() call and reused for every preset load
+	ScopedPointer<ThreadPool> scriptParsePool;
+
 	String packageName;
 };
 
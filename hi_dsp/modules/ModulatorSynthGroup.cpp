@@ -240,6 +240,7 @@ void ModulatorSynthGroupVoice::calculateNoFMVoiceInternal(ModulatorSynth * child
 		if (childVoice->isInactive() || childVoice->getOwnerSynth() != childSynth)
 			continue;
 
+		childVoice->markVoiceBufferAsDirty();
 		childVoice->calculateVoicePitchValues(startSample, numSamples);
 
 		float *childPitchValues = childVoice->getVoicePitchValues();
@@ -331,6 +332,7 @@ void ModulatorSynthGroupVoice::calculateFMBlock(ModulatorSynthGroup * group, int
 
 	if (modSynth->isBypassed() || modVoice->isInactive()) return;
 
+	modVoice->markVoiceBufferAsDirty();
 	modVoice->calculateVoicePitchValues(startSample, numSamples);
 
 	const float modGain = modSynth->getGain();
@@ -410,6 +412,7 @@ void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup *
 		if (carrierVoice->isInactive())
 			continue;
 
+		carrierVoice->markVoiceBufferAsDirty();
 		carrierVoice->calculateVoicePitchValues(startSample, numSamples);
 
 		float *carrierPitchValues = carrierVoice->getVoicePitchValues();
@@ -198,6 +198,19 @@ void TimeModulation::applyGainModulation(float *calculatedModulationValues, floa
 {
 	const float a = 1.0f - fixedIntensity;
 
+	if (isConstant(calculatedModulationValues, numValues))
+	{
+		// Skip the vector passes and multiply with a single gain value
+		const float gain = a + fixedIntensity * calculatedModulationValues[0];
+
+		FloatVectorOperations::fill(calculatedModulationValues, gain, numValues);
+
+		if (gain != 1.0f)
+			FloatVectorOperations::multiply(destinationValues, gain, numValues);
+
+		return;
+	}
+
 	FloatVectorOperations::multiply(calculatedModulationValues, fixedIntensity, numValues);
 	FloatVectorOperations::add(calculatedModulationValues, a, numValues);
 	FloatVectorOperations::multiply(destinationValues, calculatedModulationValues, numValues);
@@ -217,6 +230,20 @@ void TimeModulation::applyPitchModulation(float* calculatedModulationValues, flo
 {
 	// input: modValues (0 ... 1), intensity (-1...1)
 
+	if (isConstant(calculatedModulationValues, numValues))
+	{
+		const float value = calculatedModulationValues[0];
+		const float normalisedValue = isBipolar() ? (2.0f * value - 1.0f) * fixedIntensity : value * fixedIntensity;
+		const float pitchFactor = Modulation::PitchConverters::normalisedRangeToPitchFactor(normalisedValue);
+
+		FloatVectorOperations::fill(calculatedModulationValues, pitchFactor, numValues);
+
+		if (pitchFactor != 1.0f)
+			FloatVectorOperations::multiply(destinationValues, pitchFactor, numValues);
+
+		return;
+	}
+
 	if (isBipolar())
 	{
 		FloatVectorOperations::multiply(calculatedModulationValues, 2.0f, numValues);
@@ -314,6 +314,28 @@ public:
 		return lastConstantValue;
 	}
 
+	/** Override this and return false if the modulator can't be calculated with a reduced sample rate.
+	*
+	*	A ModulatorChain with a control rate prepares its modulators with the downsampled rate and renders them with
+	*	less samples. This doesn't work for modulators that read values at the audio rate positions (eg. global modulators)
+	*	or expose the samplerate to a script.
+	*/
+	virtual bool canBeCalculatedAtControlRate() const { return true; }
+
+	/** Returns true if all values are the same. This exits at the first different value, so it's cheap for varying data. */
+	static bool isConstant(const float* data, int numValues) noexcept
+	{
+		const float firstValue = data[0];
+
+		for (int i = 1; i < numValues; i++)
+		{
+			if (data[i] != firstValue)
+				return false;
+		}
+
+		return true;
+	}
+
 protected:
 
 	TimeModulation(Modulation::Mode m):
@@ -140,15 +140,25 @@ unlockCounter(0)
 
 		if (audioResourceFile.existsAsFile())
 		{
-			FileInputStream fis(audioResourceFile);
-
 			LOG_START("Load impulses");
 
-			ValueTree impulseDataFile = ValueTree::readFromStream(fis);
+			// The impulses are decoded when they are used for the first time
+			ScopedPointer<EmbeddedResourceFile> resources = new EmbeddedResourceFile(audioResourceFile);
 
-			if (impulseDataFile.isValid())
+			if (resources->isValid())
 			{
-				getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(impulseDataFile);
+				getSampleManager().getAudioSampleBufferPool()->setResourceFile(resources.release());
+			}
+			else
+			{
+				FileInputStream fis(audioResourceFile);
+
+				ValueTree impulseDataFile = ValueTree::readFromStream(fis);
+
+				if (impulseDataFile.isValid())
+				{
+					getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(impulseDataFile);
+				}
 			}
 		}
 	}
@@ -242,6 +252,15 @@ void FrontendProcessor::loadImages(ValueTree *imageData)
 
 		if (imageResources.existsAsFile())
 		{
+			// The images are decoded when they are used for the first time
+			ScopedPointer<EmbeddedResourceFile> resources = new EmbeddedResourceFile(imageResources);
+
+			if (resources->isValid())
+			{
+				getSampleManager().getImagePool()->setResourceFile(resources.release());
+				return;
+			}
+
 			FileInputStream fis(imageResources);
 
 			auto t = ValueTree::readFromStream(fis);
@@ -31,6 +31,7 @@
 #include "hi_lac.h"
 
 #include "hlac/BitCompressors.cpp"
+#include "hlac/BitUnpackers.cpp"
 #include "hlac/CompressionHelpers.cpp"
 #include "hlac/SampleBuffer.cpp"
 #include "hlac/HlacEncoder.cpp"
@@ -83,6 +83,15 @@ If enabled, then the decoding time is measured and printed to the console
 #define HLAC_MEASURE_DECODING_PERFORMANCE 0
 #endif
 
+//=============================================================================
+/** Config: HLAC_USE_SIMD_UNPACKING
+
+If enabled, then the decompressors use SSE4.1 / AVX2 / NEON code (picked at runtime) to unpack the bit-reduced values.
+*/
+#ifndef HLAC_USE_SIMD_UNPACKING
+#define HLAC_USE_SIMD_UNPACKING 1
+#endif
+
 //=============================================================================
 /** Config: HLAC_DEBUG_LOG
 
@@ -69,21 +69,6 @@ uint16 compressInt16(int16 input, int bitDepth)
 	return (uint16)((int)input + a);
 }
 
-#if USE_SSE
-void compressInt16Block(int16* input, int16* output, int bitDepth, int numToCompress)
-{
-	auto inputIpp = reinterpret_cast<Ipp16u*>(input);
-	auto outputIpp = reinterpret_cast<Ipp16u*>(output);
-
-	const uint16 signMask = 0b1000000000000000;
-
-	ippsAbs_16s(input, output, numToCompress);
-	ippsAndC_16u_I(signMask, inputIpp, numToCompress);
-	ippsRShiftC_16s_I(16 - bitDepth, input, numToCompress);
-	ippsOr_16u_I(inputIpp, outputIpp, numToCompress);
-}
-#endif
-
 constexpr uint16 getBitMask(int bitDepth) { return (1 << (bitDepth - 1)) - 1; }
 
 int16 decompressUInt16(uint16 input, int bitDepth)
@@ -92,25 +77,6 @@ int16 decompressUInt16(uint16 input, int bitDepth)
 	return (int16)input - sub;
 }
 
-#if USE_SSE
-void decompressInt16Block(int16* input, int16* output, uint8 bitDepth, int numToCompress)
-{
-	auto ippInput = reinterpret_cast<Ipp16u*>(input);
-	auto ippOutput = reinterpret_cast<Ipp16u*>(output);
-
-	const uint16 signMask = 0b0000000000000010;
-	const uint16 valueMask = 0b0000011111111111;
-	const uint8 shiftAmount = bitDepth - 2;
-
-	ippsAndC_16u(ippInput, valueMask, ippOutput, numToCompress);
-	ippsRShiftC_16u_I(shiftAmount, ippInput, numToCompress);
-	ippsAndC_16u_I(signMask, ippInput, numToCompress);
-	ippsMulC_16s_I(-1, input, numToCompress);
-	ippsAddC_16s_I(1, input, numToCompress);
-	ippsMul_16s_I(input, output, numToCompress);
-}
-#endif
-
 void packArrayOfInt16(int16* d, int numValues, uint8 bitDepth)
 {
 	for (int i = 0; i < numValues; i++)
@@ -143,6 +109,16 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 
 }
 
+/** Decodes the first part of the data with the SIMD unpackers and moves the pointers to the values that are left for the scalar code. */
+void unpackWithSimdAndAdvance(uint8 bitDepth, int16*& destination, const uint8*& data, int& numValues)
+{
+	const int numUnpacked = BitCompressors::unpackWithSimd(bitDepth, destination, data, numValues);
+
+	destination += numUnpacked;
+	data += numUnpacked * bitDepth / 8;
+	numValues -= numUnpacked;
+}
+
 
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
@@ -219,6 +195,8 @@ bool BitCompressors::OneBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::OneBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSimdAndAdvance(1, destination, data, numValuesToDecompress);
+
 	const uint8 masks[8] = { 0b00000001, 0b00000010, 0b00000100, 0b00001000,
 		0b00010000, 0b00100000, 0b01000000, 0b10000000 };
 
@@ -314,6 +292,8 @@ bool BitCompressors::TwoBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSimdAndAdvance(2, destination, data, numValuesToDecompress);
+
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
@@ -427,7 +407,7 @@ bool BitCompressors::FourBit::compress(uint8* destination, const int16* data, in
 
 bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-	
+	unpackWithSimdAndAdvance(4, destination, data, numValuesToDecompress);
 
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
 	const uint8 valueMasks[2] = { 0b00000111, 0b01110000 };
@@ -539,6 +519,8 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSimdAndAdvance(6, destination, data, numValuesToDecompress);
+
 #if HLAC_NO_SSE
 	while (numValuesToDecompress >= 8)
 	{
@@ -704,6 +686,8 @@ bool BitCompressors::EightBit::compress(uint8* destination, const int16* data, i
 
 bool BitCompressors::EightBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSimdAndAdvance(8, destination, data, numValuesToDecompress);
+
     while (--numValuesToDecompress >= 0)
 	{
 		const int8 value = *reinterpret_cast<const int8*>(data++);
@@ -791,6 +775,8 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSimdAndAdvance(10, destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -849,41 +835,7 @@ bool BitCompressors::TwelveBit::compress(uint8* destination, const int16* data,
 
 bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-#if USE_SSE
-
-	const int numInBlockProcessing = numValuesToDecompress - (numValuesToDecompress % 4);
-
-	int16* alignedDestination = (int16*)ippAlignPtr(destination, 32);
-	jassert(alignedDestination == destination);
-	uint16* dst = scratchBuffer;
-
-
-	while (numValuesToDecompress >= 4)
-	{
-		const uint16* dataBlock = reinterpret_cast<const uint16*>(data);
-
-		dst[0] = (dataBlock[0] & 0b1111111111110000) >> 4;
-		dst[1] = (dataBlock[0] & 0b0000000000001111) << 8;
-		dst[1] |= (dataBlock[1] & 0b1111111100000000) >> 8;
-		dst[2] = (dataBlock[1] & 0b0000000011111111) << 4;
-		dst[2] |= (dataBlock[2] & 0b1111000000000000) >> 12;
-		dst[3] = (dataBlock[2] & 0b0000111111111111);
-
-		//dst[0] = decompressUInt16(dst[0], 12);
-		//dst[1] = decompressUInt16(dst[1], 12);
-		//dst[2] = decompressUInt16(dst[2], 12);
-		//dst[3] = decompressUInt16(dst[3], 12);
-
-		numValuesToDecompress -= 4;
-		dst += 4;
-		data += 6;
-
-	}
-
-	decompressInt16Block((int16*)scratchBuffer, destination, 12, numInBlockProcessing);
-	destination += numInBlockProcessing;
-
-#else
+	unpackWithSimdAndAdvance(12, destination, data, numValuesToDecompress);
 
 	int16* dst = destination;
 
@@ -913,10 +865,6 @@ bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data
 
 	memcpy(destination, data, sizeof(int16) * numValuesToDecompress);
 
-#endif
-
-	
-
 	return true;
 }
 
@@ -1003,6 +951,8 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSimdAndAdvance(14, destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
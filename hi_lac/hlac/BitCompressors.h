@@ -36,13 +36,6 @@ namespace hlac { using namespace juce;
 
 #define LOG_RATIO(x) 
 
-#define USE_SSE 0
-
-
-#if USE_SSE
-#include <ipp.h>
-#endif
-
 struct BitCompressors
 {
 	struct Base
@@ -101,6 +94,38 @@ struct BitCompressors
 
 	static uint8 getMinBitDepthForData(const int16* data, int numValues, int8 expectedBitDepth = -1);
 
+	/** The instruction set that is used by the decompressors. */
+	enum class SimdMode
+	{
+		Scalar = 0,
+		SSE41,
+		AVX2,
+		NEON,
+		numSimdModes
+	};
+
+	/** Returns the instruction set that is used for decompression. 
+	*
+	*	By default this is the fastest one that is supported by the CPU.
+	*/
+	static SimdMode getSimdMode();
+
+	/** Forces the decompressors to use the given instruction set. Returns false if the CPU doesn't support it. */
+	static bool setSimdMode(SimdMode newMode);
+
+	static bool isSimdModeAvailable(SimdMode modeToCheck);
+
+	static String getSimdModeName(SimdMode m);
+
+	/** Decodes as many values as possible with the current instruction set and returns the number of decoded values.
+	*
+	*	The remaining values (and the values after the last full block) must be decoded by the scalar code.
+	*/
+	static int unpackWithSimd(uint8 bitDepth, int16* destination, const uint8* data, int numValues);
+
+	/** Converts the int16 values (plus the optional second source) to float with the current instruction set and returns the number of converted values. */
+	static int convertToFloatWithSimd(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale);
+
 
 	struct ZeroBit : public Base
 	{
@@ -161,30 +186,10 @@ struct BitCompressors
 
 	struct TwelveBit : public Base
 	{
-#if USE_SSE
-		TwelveBit()
-		{
-			scratchBuffer = ippsMalloc_16u(16383);
-			scratchBuffer2 = ippsMalloc_16u(16383);
-		}
-
-		~TwelveBit()
-		{
-			ippsFree(scratchBuffer);
-			ippsFree(scratchBuffer2);
-		}
-#endif
-
 		int getAllowedBitRange() const override;
 		bool compress(uint8* destination, const int16* data, int numValues) override;
 		bool decompress(int16* destination, const uint8* data, int numValuesToDecompress) override;
 		int getByteAmount(int numValuesToCompress) override;
-
-#if USE_SSE
-		Ipp16u* scratchBuffer;
-		Ipp16u* scratchBuffer2;
-#endif
-
 	};
 
 	struct FourteenBit : public Base
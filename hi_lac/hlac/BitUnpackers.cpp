@@ -0,0 +1,678 @@
+/*  HISE Lossless Audio Codec
+*	�2017 Christoph Hart
+*
+*	Redistribution and use in source and binary forms, with or without modification,
+*	are permitted provided that the following conditions are met:
+*
+*	1. Redistributions of source code must retain the above copyright notice,
+*	   this list of conditions and the following disclaimer.
+*
+*	2. Redistributions in binary form must reproduce the above copyright notice,
+*	   this list of conditions and the following disclaimer in the documentation
+*	   and/or other materials provided with the distribution.
+*
+*	3. All advertising materials mentioning features or use of this software must
+*	   display the following acknowledgement:
+*	   This product includes software developed by Hart Instruments
+*
+*	4. Neither the name of the copyright holder nor the names of its contributors may be used
+*	   to endorse or promote products derived from this software without specific prior written permission.
+*
+*	THIS SOFTWARE IS PROVIDED BY CHRISTOPH HART "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+*	BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*	DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+*	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+*	GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+*	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+*	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+*/
+
+#if HLAC_USE_SIMD_UNPACKING && JUCE_INTEL && !JUCE_IOS
+#define HLAC_SIMD_X86 1
+#else
+#define HLAC_SIMD_X86 0
+#endif
+
+#if HLAC_USE_SIMD_UNPACKING && JUCE_ARM && (defined(__aarch64__) || defined(_M_ARM64))
+#define HLAC_SIMD_NEON 1
+#else
+#define HLAC_SIMD_NEON 0
+#endif
+
+#if HLAC_SIMD_X86
+#include <immintrin.h>
+
+#if JUCE_MSVC
+#define HLAC_TARGET_SSE41
+#define HLAC_TARGET_AVX2
+#else
+#define HLAC_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define HLAC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#endif
+
+#if HLAC_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace hlac { using namespace juce; 
+
+/** The 6, 10, 12 and 14 bit compressors write the values as a MSB-first bit stream of 16 bit words.
+
+	Every value is gathered into a 32 bit lane that contains the word with its first bit in the upper half
+	and the following word in the lower half. Shifting the lane to the left by the bit offset and then to
+	the right by (32 - bitDepth) yields the packed value. 8 values are decoded in two registers of 4 lanes.
+*/
+struct OffsetBinaryLayout
+{
+	OffsetBinaryLayout(int bitDepth_):
+		bitDepth(bitDepth_)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			const int bitOffset = i * bitDepth;
+			const int wordIndex = bitOffset / 16;
+			const int lane = i % 4;
+			const int half = i / 4;
+
+			shuffle[half][lane * 4 + 0] = (uint8)(2 * wordIndex + 2);
+			shuffle[half][lane * 4 + 1] = (uint8)(2 * wordIndex + 3);
+			shuffle[half][lane * 4 + 2] = (uint8)(2 * wordIndex);
+			shuffle[half][lane * 4 + 3] = (uint8)(2 * wordIndex + 1);
+
+			shifts[half][lane] = bitOffset % 16;
+			multipliers[half][lane] = 1 << (bitOffset % 16);
+		}
+	}
+
+	/** Returns the number of 8 value groups that can be decoded with a 16 byte load without reading past the packed data. */
+	int getNumSafeGroups(int numValues) const
+	{
+		const int numGroups = numValues / 8;
+		const int numGroupsPerLoad = (16 + bitDepth - 1) / bitDepth;
+
+		return jmax<int>(0, numGroups - numGroupsPerLoad + 1);
+	}
+
+	const int bitDepth;
+
+	uint8 shuffle[2][16];
+	int32 shifts[2][4];
+	int32 multipliers[2][4];
+};
+
+static const OffsetBinaryLayout sixBitLayout(6);
+static const OffsetBinaryLayout tenBitLayout(10);
+static const OffsetBinaryLayout twelveBitLayout(12);
+static const OffsetBinaryLayout fourteenBitLayout(14);
+
+static const OffsetBinaryLayout* getOffsetBinaryLayout(uint8 bitDepth)
+{
+	switch (bitDepth)
+	{
+	case 6:	 return &sixBitLayout;
+	case 10: return &tenBitLayout;
+	case 12: return &twelveBitLayout;
+	case 14: return &fourteenBitLayout;
+	default: return nullptr;
+	}
+}
+
+#if HLAC_SIMD_X86
+
+struct SSE41Unpackers
+{
+	template <int BitDepth> HLAC_TARGET_SSE41 static int offsetBinary(int16* destination, const uint8* data, int numValues)
+	{
+		const auto layout = getOffsetBinaryLayout(BitDepth);
+		const int numGroups = layout->getNumSafeGroups(numValues);
+
+		const __m128i shuffleLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->shuffle[0]));
+		const __m128i shuffleHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->shuffle[1]));
+		const __m128i multipliersLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->multipliers[0]));
+		const __m128i multipliersHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->multipliers[1]));
+		const __m128i offset = _mm_set1_epi16((1 << (BitDepth - 1)) - 1);
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+			__m128i lo = _mm_shuffle_epi8(packed, shuffleLo);
+			__m128i hi = _mm_shuffle_epi8(packed, shuffleHi);
+
+			lo = _mm_srli_epi32(_mm_mullo_epi32(lo, multipliersLo), 32 - BitDepth);
+			hi = _mm_srli_epi32(_mm_mullo_epi32(hi, multipliersHi), 32 - BitDepth);
+
+			const __m128i values = _mm_sub_epi16(_mm_packus_epi32(lo, hi), offset);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), values);
+
+			destination += 8;
+			data += BitDepth;
+		}
+
+		return numGroups * 8;
+	}
+
+	HLAC_TARGET_SSE41 static int oneBit(int16* destination, const uint8* data, int numValues)
+	{
+		const __m128i bitMasks = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+		const __m128i one = _mm_set1_epi16(1);
+
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const __m128i bits = _mm_and_si128(_mm_set1_epi16((int16)data[i]), bitMasks);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_min_epu16(bits, one));
+
+			destination += 8;
+		}
+
+		return numGroups * 8;
+	}
+
+	/** Decodes sign / magnitude values by moving the sign bit of each value to the MSB of its 16 bit lane. */
+	HLAC_TARGET_SSE41 static __m128i signMagnitude(__m128i bytes, __m128i multipliers, int numValueBits)
+	{
+		const __m128i t = _mm_mullo_epi16(bytes, multipliers);
+		const __m128i sign = _mm_srai_epi16(t, 15);
+		const __m128i value = _mm_srl_epi16(_mm_slli_epi16(t, 1), _mm_cvtsi32_si128(16 - numValueBits));
+
+		return _mm_sub_epi16(_mm_xor_si128(value, sign), sign);
+	}
+
+	HLAC_TARGET_SSE41 static int twoBit(int16* destination, const uint8* data, int numValues)
+	{
+		const __m128i spread = _mm_setr_epi8(0, -1, 0, -1, 0, -1, 0, -1, 1, -1, 1, -1, 1, -1, 1, -1);
+		const __m128i multipliers = _mm_setr_epi16(1 << 14, 1 << 12, 1 << 10, 1 << 8, 1 << 14, 1 << 12, 1 << 10, 1 << 8);
+
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			uint16 twoBytes;
+			memcpy(&twoBytes, data, sizeof(uint16));
+
+			const __m128i bytes = _mm_shuffle_epi8(_mm_cvtsi32_si128(twoBytes), spread);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), signMagnitude(bytes, multipliers, 1));
+
+			destination += 8;
+			data += 2;
+		}
+
+		return numGroups * 8;
+	}
+
+	HLAC_TARGET_SSE41 static int fourBit(int16* destination, const uint8* data, int numValues)
+	{
+		const __m128i spread = _mm_setr_epi8(0, -1, 0, -1, 1, -1, 1, -1, 2, -1, 2, -1, 3, -1, 3, -1);
+		const __m128i multipliers = _mm_setr_epi16(1 << 12, 1 << 8, 1 << 12, 1 << 8, 1 << 12, 1 << 8, 1 << 12, 1 << 8);
+
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			int32 fourBytes;
+			memcpy(&fourBytes, data, sizeof(int32));
+
+			const __m128i bytes = _mm_shuffle_epi8(_mm_cvtsi32_si128(fourBytes), spread);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), signMagnitude(bytes, multipliers, 3));
+
+			destination += 8;
+			data += 4;
+		}
+
+		return numGroups * 8;
+	}
+
+	HLAC_TARGET_SSE41 static int eightBit(int16* destination, const uint8* data, int numValues)
+	{
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_cvtepi8_epi16(bytes));
+
+			destination += 8;
+			data += 8;
+		}
+
+		return numGroups * 8;
+	}
+
+	template <bool AddSecondSource> HLAC_TARGET_SSE41 static int int16ToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale)
+	{
+		const __m128 s = _mm_set1_ps(scale);
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+
+			if (AddSecondSource)
+			{
+				values = _mm_add_epi16(values, _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceToAdd)));
+				sourceToAdd += 8;
+			}
+
+			const __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(values)), s);
+			const __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(values, 8))), s);
+
+			_mm_storeu_ps(destination, lo);
+			_mm_storeu_ps(destination + 4, hi);
+
+			source += 8;
+			destination += 8;
+		}
+
+		return numGroups * 8;
+	}
+
+	static int unpack(uint8 bitDepth, int16* destination, const uint8* data, int numValues)
+	{
+		switch (bitDepth)
+		{
+		case 1:	 return oneBit(destination, data, numValues);
+		case 2:	 return twoBit(destination, data, numValues);
+		case 4:	 return fourBit(destination, data, numValues);
+		case 6:	 return offsetBinary<6>(destination, data, numValues);
+		case 8:	 return eightBit(destination, data, numValues);
+		case 10: return offsetBinary<10>(destination, data, numValues);
+		case 12: return offsetBinary<12>(destination, data, numValues);
+		case 14: return offsetBinary<14>(destination, data, numValues);
+		default: return 0;
+		}
+	}
+
+	static int convertToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale)
+	{
+		if (sourceToAdd != nullptr)
+			return int16ToFloat<true>(source, sourceToAdd, destination, numValues, scale);
+		else
+			return int16ToFloat<false>(source, nullptr, destination, numValues, scale);
+	}
+};
+
+struct AVX2Unpackers
+{
+	/** Decodes two groups of 8 values per iteration (one group per 128 bit lane) and leaves the rest to the SSE4.1 code. */
+	template <int BitDepth> HLAC_TARGET_AVX2 static int offsetBinary(int16* destination, const uint8* data, int numValues)
+	{
+		const auto layout = getOffsetBinaryLayout(BitDepth);
+		const int numGroups = layout->getNumSafeGroups(numValues);
+
+		const __m256i shuffleLo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->shuffle[0])));
+		const __m256i shuffleHi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->shuffle[1])));
+		const __m256i shiftsLo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->shifts[0])));
+		const __m256i shiftsHi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(layout->shifts[1])));
+		const __m256i offset = _mm256_set1_epi16((1 << (BitDepth - 1)) - 1);
+
+		int groupIndex = 0;
+
+		for (; groupIndex + 1 < numGroups; groupIndex += 2)
+		{
+			const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + BitDepth));
+			const __m256i packed = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+
+			__m256i lo = _mm256_shuffle_epi8(packed, shuffleLo);
+			__m256i hi = _mm256_shuffle_epi8(packed, shuffleHi);
+
+			lo = _mm256_srli_epi32(_mm256_sllv_epi32(lo, shiftsLo), 32 - BitDepth);
+			hi = _mm256_srli_epi32(_mm256_sllv_epi32(hi, shiftsHi), 32 - BitDepth);
+
+			// packus works per 128 bit lane, so each lane ends up with the 8 values of its group
+			const __m256i values = _mm256_sub_epi16(_mm256_packus_epi32(lo, hi), offset);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), values);
+
+			destination += 16;
+			data += 2 * BitDepth;
+		}
+
+		const int numDone = groupIndex * 8;
+
+		return numDone + SSE41Unpackers::offsetBinary<BitDepth>(destination, data, numValues - numDone);
+	}
+
+	HLAC_TARGET_AVX2 static int eightBit(int16* destination, const uint8* data, int numValues)
+	{
+		const int numGroups = numValues / 16;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), _mm256_cvtepi8_epi16(bytes));
+
+			destination += 16;
+			data += 16;
+		}
+
+		const int numDone = numGroups * 16;
+
+		return numDone + SSE41Unpackers::eightBit(destination, data, numValues - numDone);
+	}
+
+	template <bool AddSecondSource> HLAC_TARGET_AVX2 static int int16ToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale)
+	{
+		const __m256 s = _mm256_set1_ps(scale);
+		const int numGroups = numValues / 16;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+
+			if (AddSecondSource)
+			{
+				values = _mm256_add_epi16(values, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sourceToAdd)));
+				sourceToAdd += 16;
+			}
+
+			const __m256 lo = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(values))), s);
+			const __m256 hi = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(values, 1))), s);
+
+			_mm256_storeu_ps(destination, lo);
+			_mm256_storeu_ps(destination + 8, hi);
+
+			source += 16;
+			destination += 16;
+		}
+
+		const int numDone = numGroups * 16;
+
+		return numDone + SSE41Unpackers::int16ToFloat<AddSecondSource>(source, sourceToAdd, destination, numValues - numDone, scale);
+	}
+
+	static int unpack(uint8 bitDepth, int16* destination, const uint8* data, int numValues)
+	{
+		switch (bitDepth)
+		{
+		case 6:	 return offsetBinary<6>(destination, data, numValues);
+		case 8:	 return eightBit(destination, data, numValues);
+		case 10: return offsetBinary<10>(destination, data, numValues);
+		case 12: return offsetBinary<12>(destination, data, numValues);
+		case 14: return offsetBinary<14>(destination, data, numValues);
+		default: return SSE41Unpackers::unpack(bitDepth, destination, data, numValues);
+		}
+	}
+
+	static int convertToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale)
+	{
+		if (sourceToAdd != nullptr)
+			return int16ToFloat<true>(source, sourceToAdd, destination, numValues, scale);
+		else
+			return int16ToFloat<false>(source, nullptr, destination, numValues, scale);
+	}
+};
+
+#endif
+
+#if HLAC_SIMD_NEON
+
+struct NEONUnpackers
+{
+	template <int BitDepth> static int offsetBinary(int16* destination, const uint8* data, int numValues)
+	{
+		const auto layout = getOffsetBinaryLayout(BitDepth);
+		const int numGroups = layout->getNumSafeGroups(numValues);
+
+		const uint8x16_t shuffleLo = vld1q_u8(layout->shuffle[0]);
+		const uint8x16_t shuffleHi = vld1q_u8(layout->shuffle[1]);
+		const int32x4_t shiftsLo = vld1q_s32(layout->shifts[0]);
+		const int32x4_t shiftsHi = vld1q_s32(layout->shifts[1]);
+		const int16x8_t offset = vdupq_n_s16((1 << (BitDepth - 1)) - 1);
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const uint8x16_t packed = vld1q_u8(data);
+
+			uint32x4_t lo = vreinterpretq_u32_u8(vqtbl1q_u8(packed, shuffleLo));
+			uint32x4_t hi = vreinterpretq_u32_u8(vqtbl1q_u8(packed, shuffleHi));
+
+			lo = vshrq_n_u32(vshlq_u32(lo, shiftsLo), 32 - BitDepth);
+			hi = vshrq_n_u32(vshlq_u32(hi, shiftsHi), 32 - BitDepth);
+
+			const int16x8_t values = vreinterpretq_s16_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+
+			vst1q_s16(destination, vsubq_s16(values, offset));
+
+			destination += 8;
+			data += BitDepth;
+		}
+
+		return numGroups * 8;
+	}
+
+	static int oneBit(int16* destination, const uint8* data, int numValues)
+	{
+		static const int16 shifts[8] = { 0, -1, -2, -3, -4, -5, -6, -7 };
+
+		const int16x8_t rightShifts = vld1q_s16(shifts);
+		const uint16x8_t one = vdupq_n_u16(1);
+
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const uint16x8_t bits = vandq_u16(vshlq_u16(vdupq_n_u16(data[i]), rightShifts), one);
+			vst1q_s16(destination, vreinterpretq_s16_u16(bits));
+
+			destination += 8;
+		}
+
+		return numGroups * 8;
+	}
+
+	/** Moves the sign bit of each value to the MSB of its lane, then restores the sign of the magnitude. */
+	template <int NumValueBits> static int16x8_t signMagnitude(uint16x8_t bytes, int16x8_t leftShifts)
+	{
+		const int16x8_t t = vreinterpretq_s16_u16(vshlq_u16(bytes, leftShifts));
+		const int16x8_t sign = vshrq_n_s16(t, 15);
+		const int16x8_t value = vreinterpretq_s16_u16(vshrq_n_u16(vshlq_n_u16(vreinterpretq_u16_s16(t), 1), 16 - NumValueBits));
+
+		return vsubq_s16(veorq_s16(value, sign), sign);
+	}
+
+	static int twoBit(int16* destination, const uint8* data, int numValues)
+	{
+		static const int16 shifts[8] = { 14, 12, 10, 8, 14, 12, 10, 8 };
+		const int16x8_t leftShifts = vld1q_s16(shifts);
+
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const uint16x4_t first = vdup_n_u16(data[0]);
+			const uint16x4_t second = vdup_n_u16(data[1]);
+
+			vst1q_s16(destination, signMagnitude<1>(vcombine_u16(first, second), leftShifts));
+
+			destination += 8;
+			data += 2;
+		}
+
+		return numGroups * 8;
+	}
+
+	static int fourBit(int16* destination, const uint8* data, int numValues)
+	{
+		static const int16 shifts[8] = { 12, 8, 12, 8, 12, 8, 12, 8 };
+		const int16x8_t leftShifts = vld1q_s16(shifts);
+
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			const uint16 bytes[8] = { data[0], data[0], data[1], data[1], data[2], data[2], data[3], data[3] };
+
+			vst1q_s16(destination, signMagnitude<3>(vld1q_u16(bytes), leftShifts));
+
+			destination += 8;
+			data += 4;
+		}
+
+		return numGroups * 8;
+	}
+
+	static int eightBit(int16* destination, const uint8* data, int numValues)
+	{
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			vst1q_s16(destination, vmovl_s8(vld1_s8(reinterpret_cast<const int8*>(data))));
+
+			destination += 8;
+			data += 8;
+		}
+
+		return numGroups * 8;
+	}
+
+	static int unpack(uint8 bitDepth, int16* destination, const uint8* data, int numValues)
+	{
+		switch (bitDepth)
+		{
+		case 1:	 return oneBit(destination, data, numValues);
+		case 2:	 return twoBit(destination, data, numValues);
+		case 4:	 return fourBit(destination, data, numValues);
+		case 6:	 return offsetBinary<6>(destination, data, numValues);
+		case 8:	 return eightBit(destination, data, numValues);
+		case 10: return offsetBinary<10>(destination, data, numValues);
+		case 12: return offsetBinary<12>(destination, data, numValues);
+		case 14: return offsetBinary<14>(destination, data, numValues);
+		default: return 0;
+		}
+	}
+
+	static int convertToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale)
+	{
+		const int numGroups = numValues / 8;
+
+		for (int i = 0; i < numGroups; i++)
+		{
+			int16x8_t values = vld1q_s16(source);
+
+			if (sourceToAdd != nullptr)
+			{
+				values = vaddq_s16(values, vld1q_s16(sourceToAdd));
+				sourceToAdd += 8;
+			}
+
+			vst1q_f32(destination, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(values))), scale));
+			vst1q_f32(destination + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(values))), scale));
+
+			source += 8;
+			destination += 8;
+		}
+
+		return numGroups * 8;
+	}
+};
+
+#endif
+
+static BitCompressors::SimdMode getBestAvailableSimdMode()
+{
+	if (BitCompressors::isSimdModeAvailable(BitCompressors::SimdMode::AVX2))
+		return BitCompressors::SimdMode::AVX2;
+
+	if (BitCompressors::isSimdModeAvailable(BitCompressors::SimdMode::SSE41))
+		return BitCompressors::SimdMode::SSE41;
+
+	if (BitCompressors::isSimdModeAvailable(BitCompressors::SimdMode::NEON))
+		return BitCompressors::SimdMode::NEON;
+
+	return BitCompressors::SimdMode::Scalar;
+}
+
+static std::atomic<int> currentSimdMode(-1);
+
+BitCompressors::SimdMode BitCompressors::getSimdMode()
+{
+	int mode = currentSimdMode.load();
+
+	if (mode < 0)
+	{
+		mode = (int)getBestAvailableSimdMode();
+		currentSimdMode.store(mode);
+	}
+
+	return (SimdMode)mode;
+}
+
+bool BitCompressors::setSimdMode(SimdMode newMode)
+{
+	if (!isSimdModeAvailable(newMode))
+		return false;
+
+	currentSimdMode.store((int)newMode);
+	return true;
+}
+
+bool BitCompressors::isSimdModeAvailable(SimdMode modeToCheck)
+{
+	switch (modeToCheck)
+	{
+	case SimdMode::Scalar:	return true;
+#if HLAC_SIMD_X86
+	case SimdMode::SSE41:	return SystemStats::hasSSE41();
+	case SimdMode::AVX2:	return SystemStats::hasSSE41() && SystemStats::hasAVX2();
+#endif
+#if HLAC_SIMD_NEON
+	case SimdMode::NEON:	return true;
+#endif
+	default:				return false;
+	}
+}
+
+String BitCompressors::getSimdModeName(SimdMode m)
+{
+	switch (m)
+	{
+	case SimdMode::Scalar:	return "Scalar";
+	case SimdMode::SSE41:	return "SSE4.1";
+	case SimdMode::AVX2:	return "AVX2";
+	case SimdMode::NEON:	return "NEON";
+	default:				return {};
+	}
+}
+
+int BitCompressors::unpackWithSimd(uint8 bitDepth, int16* destination, const uint8* data, int numValues)
+{
+	switch (getSimdMode())
+	{
+#if HLAC_SIMD_X86
+	case SimdMode::SSE41:	return SSE41Unpackers::unpack(bitDepth, destination, data, numValues);
+	case SimdMode::AVX2:	return AVX2Unpackers::unpack(bitDepth, destination, data, numValues);
+#endif
+#if HLAC_SIMD_NEON
+	case SimdMode::NEON:	return NEONUnpackers::unpack(bitDepth, destination, data, numValues);
+#endif
+	default:				ignoreUnused(bitDepth, destination, data, numValues);
+							return 0;
+	}
+}
+
+int BitCompressors::convertToFloatWithSimd(const int16* source, const int16* sourceToAdd, float* destination, int numValues, float scale)
+{
+	switch (getSimdMode())
+	{
+#if HLAC_SIMD_X86
+	case SimdMode::SSE41:	return SSE41Unpackers::convertToFloat(source, sourceToAdd, destination, numValues, scale);
+	case SimdMode::AVX2:	return AVX2Unpackers::convertToFloat(source, sourceToAdd, destination, numValues, scale);
+#endif
+#if HLAC_SIMD_NEON
+	case SimdMode::NEON:	return NEONUnpackers::convertToFloat(source, sourceToAdd, destination, numValues, scale);
+#endif
+	default:				ignoreUnused(source, sourceToAdd, destination);
+							ignoreUnused(numValues, scale);
+							return 0;
+	}
+}
+
+} // namespace hlac
@@ -490,45 +490,25 @@ void CompressionHelpers::dump(const AudioSampleBuffer& b)
 
 void CompressionHelpers::fastInt16ToFloat(const void* source, float* dest, int numSamples)
 {
-#if HLAC_NO_SSE
-
-	AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
+	fastInt16ToFloat(static_cast<const int16*>(source), nullptr, dest, numSamples);
+}
 
-#else
+void CompressionHelpers::fastInt16ToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numSamples)
+{
+	const float scale = 1.0f / (float)0x7fff;
 
-	uint64 alignOffsetFloat = reinterpret_cast<uint64>(dest) % 16;
-	uint64 alignOffsetInt = reinterpret_cast<uint64>(source) % 16;
+	const int numDone = BitCompressors::convertToFloatWithSimd(source, sourceToAdd, destination, numSamples, scale);
 
-	if (alignOffsetFloat == 0 && alignOffsetInt == 0)
+	if (sourceToAdd != nullptr)
 	{
-		const int16* intData = static_cast<const int16*> (source);
-		const float scale = 1.0f / 0x7fff;
-
-		__m128 s = _mm_set1_ps(scale);
-
-		const int numSingle = (numSamples % 4);
-		const int numSSE = numSamples - numSingle;
-
-		for (int i = 0; i < numSSE; i += 4)
-		{
-			__m128i a = _mm_loadl_epi64((__m128i*)(intData + i));
-			a = _mm_cvtepi16_epi32(a);
-			__m128 a_f = _mm_cvtepi32_ps(a);
-			a_f = _mm_mul_ps(a_f, s);
-			_mm_store_ps(dest + i, a_f);
-		}
-
-		for (int i = 0; i < numSingle; i++)
-		{
-			dest[i + numSSE] = scale * intData[i + numSSE];
-		}
+		for (int i = numDone; i < numSamples; i++)
+			destination[i] = scale * (float)(int16)(source[i] + sourceToAdd[i]);
 	}
 	else
 	{
-		AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
+		for (int i = numDone; i < numSamples; i++)
+			destination[i] = scale * (float)source[i];
 	}
-
-#endif
 }
 
 uint8 CompressionHelpers::checkBuffersEqual(AudioSampleBuffer& workBuffer, AudioSampleBuffer& referenceBuffer)
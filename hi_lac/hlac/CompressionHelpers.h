@@ -195,6 +195,13 @@ struct CompressionHelpers
 
 	static void fastInt16ToFloat(const void* source, float* destination, int numSamples);
 
+	/** Converts the int16 values to float. 
+	*
+	*	If sourceToAdd is not nullptr, its values are added to the source values in the same pass (with the same 
+	*	int16 wrap around as IntVectorOperations::add()).
+	*/
+	static void fastInt16ToFloat(const int16* source, const int16* sourceToAdd, float* destination, int numSamples);
+
 	struct Diff
 	{
 		static int getNumFullValues(int bufferSize);
@@ -59,6 +59,8 @@ bool HiseLosslessAudioFormatReader::readSamples(int** destSamples, int numDestCh
 
 		const int bytesPerFrame = sizeof(int16) * numChannels;
 
+		ScopedLock sl(internalReader.decoderLock);
+
 		input->setPosition(1 + startSampleInFile * bytesPerFrame);
 
 		while (numSamples > 0)
@@ -188,6 +190,8 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 
 	bool isStereo = destSamples[1] != nullptr;
 
+	ScopedLock sl(decoderLock);
+
 	if (startSampleInFile != decoder.getCurrentReadPosition())
 	{
 		auto byteOffset = header.getOffsetForReadPosition(startSampleInFile, useHeaderOffsetWhenSeeking);
@@ -265,6 +269,8 @@ bool HlacReaderCommon::fixedBufferRead(HiseSampleBuffer& buffer, int numDestChan
 {
 	bool isStereo = numDestChannels == 2;
 
+	ScopedLock sl(decoderLock);
+
 	if (startSampleInFile != decoder.getCurrentReadPosition())
 	{
 		auto byteOffset = header.getOffsetForReadPosition(startSampleInFile, useHeaderOffsetWhenSeeking);
@@ -306,6 +312,8 @@ bool HiseLosslessAudioFormatReader::copyFromMonolith(HiseSampleBuffer& destinati
 
 	const int bytesPerFrame = sizeof(int16) * numChannelsToCopy;
 
+	ScopedLock sl(internalReader.decoderLock);
+
 	input->setPosition(1 + offsetInFile * bytesPerFrame);
 
 	while (numSamples > 0)
@@ -411,6 +419,8 @@ bool HlacMemoryMappedAudioFormatReader::mapSectionOfFile(Range<int64> samplesToM
 
 		auto fileRange = Range<int64>(start, end);
 
+		ScopedLock sl(internalReader.decoderLock);
+
 		map = new MemoryMappedFile(getFile(), fileRange, MemoryMappedFile::readOnly, false);
 
 		if (map != nullptr && !map->getRange().isEmpty())
@@ -124,6 +124,10 @@ private:
 
 	bool useHeaderOffsetWhenSeeking = true;
 
+	/** The reader of a monolith channel is shared by all sounds (and instances) that use this channel,
+	*	so every access to the stream position and the decoder state must be locked. */
+	CriticalSection decoderLock;
+
 };
 
 class HiseLosslessAudioFormatReader : public AudioFormatReader
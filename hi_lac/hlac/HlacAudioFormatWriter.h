@@ -58,6 +58,13 @@ public:
 
 	double getCompressionRatioForLastFile() { return encoder.getCompressionRatio(); }
 
+	/** Compresses the blocks of each write call in parallel on the given pool (see HlacEncoder::setThreadPool()).
+	*
+	*	Each write call should contain a multiple of COMPRESSION_BLOCK_SIZE samples (except for the last one) to
+	*	make use of the pool. The pool must not be deleted before this writer.
+	*/
+	void setThreadPool(ThreadPool* pool) { encoder.setThreadPool(pool); }
+
 	/** You can use a temporary file instead of the memory buffer if you encode large files. */
 	void setTemporaryBufferType(bool shouldUseTemporaryFile);
 
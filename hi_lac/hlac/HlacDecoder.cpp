@@ -246,9 +246,17 @@ void HlacDecoder::decodeCycle(const CycleHeader& header, bool /*decodeStereo*/,
 		{
 			compressor->decompress(workBuffer.getWritePointer(), (const uint8*)readBuffer.getData(), numSamples);
 
-			CompressionHelpers::IntVectorOperations::add(workBuffer.getWritePointer(), currentCycle.getReadPointer(), numSamples);
-			
-			writeToFloatArray(true, true, destination, channelIndex, numSamples);
+			if (destination.isFloatingPoint())
+			{
+				// The template is added during the float conversion
+				writeToFloatArray(true, true, destination, channelIndex, numSamples, true);
+			}
+			else
+			{
+				CompressionHelpers::IntVectorOperations::add(workBuffer.getWritePointer(), currentCycle.getReadPointer(), numSamples);
+
+				writeToFloatArray(true, true, destination, channelIndex, numSamples);
+			}
 		}
 		else
 		{
@@ -260,9 +268,27 @@ void HlacDecoder::decodeCycle(const CycleHeader& header, bool /*decodeStereo*/,
 }
 
 
-void HlacDecoder::writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSampleBuffer& destination, int channelIndex, int numSamples)
+void HlacDecoder::copyToDestination(HiseSampleBuffer& destination, int channelIndex, int bufferOffset, const int16* src, const int16* srcToAdd, int numSamples)
+{
+	if (destination.isFloatingPoint())
+	{
+		auto dst = static_cast<float*>(destination.getWritePointer(channelIndex, bufferOffset));
+		CompressionHelpers::fastInt16ToFloat(src, srcToAdd, dst, numSamples);
+	}
+	else
+	{
+		// The int16 path adds the template before writing
+		jassert(srcToAdd == nullptr);
+
+		auto dst = static_cast<int16*>(destination.getWritePointer(channelIndex, bufferOffset));
+		memcpy(dst, src, sizeof(int16) * numSamples);
+	}
+}
+
+void HlacDecoder::writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSampleBuffer& destination, int channelIndex, int numSamples, bool addCurrentCycle)
 {
 	auto src = useTempBuffer ? workBuffer.getReadPointer() : currentCycle.getReadPointer();
+	auto srcToAdd = addCurrentCycle ? currentCycle.getReadPointer() : nullptr;
 
 	int& skipToUse = channelIndex == 0 ? leftNumToSkip : rightNumToSkip;
 
@@ -276,16 +302,7 @@ void HlacDecoder::writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSam
 		{
 			if (shouldCopy)
 			{
-				if (destination.isFloatingPoint())
-				{
-					auto dst = static_cast<float*>(destination.getWritePointer(channelIndex, bufferOffset));
-					CompressionHelpers::fastInt16ToFloat(src, dst, numThisTime);
-				}
-				else
-				{
-					auto dst = static_cast<int16*>(destination.getWritePointer(channelIndex, bufferOffset));
-					memcpy(dst, src, sizeof(int16) * numThisTime);
-				}
+				copyToDestination(destination, channelIndex, bufferOffset, src, srcToAdd, numThisTime);
 			}
 				
 			else
@@ -318,16 +335,7 @@ void HlacDecoder::writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSam
 
 			if (shouldCopy)
 			{
-				if (destination.isFloatingPoint())
-				{
-					auto dst = static_cast<float*>(destination.getWritePointer(channelIndex, bufferOffset));
-					CompressionHelpers::fastInt16ToFloat(src + skipToUse, dst, numThisTime);
-				}
-				else
-				{
-					auto dst = static_cast<int16*>(destination.getWritePointer(channelIndex, bufferOffset));
-					memcpy(dst, src + skipToUse, sizeof(int16) * numThisTime);
-				}
+				copyToDestination(destination, channelIndex, bufferOffset, src + skipToUse, srcToAdd != nullptr ? srcToAdd + skipToUse : nullptr, numThisTime);
 			}
 				
 			else
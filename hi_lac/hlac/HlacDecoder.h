@@ -94,7 +94,9 @@ private:
 		numWriteModes
 	};
 
-	void writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSampleBuffer& destination, int channelIndex, int numSamples);
+	void writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSampleBuffer& destination, int channelIndex, int numSamples, bool addCurrentCycle=false);
+
+	void copyToDestination(HiseSampleBuffer& destination, int channelIndex, int bufferOffset, const int16* src, const int16* srcToAdd, int numSamples);
 
 	CycleHeader readCycleHeader(InputStream& input);
 
@@ -55,6 +55,19 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	blockOffset = 0;
 	int32 numSamplesRemaining = source.getNumSamples();
 
+	if (threadPool != nullptr)
+	{
+		const int numFullBlocks = numSamplesRemaining / COMPRESSION_BLOCK_SIZE;
+
+		if (numFullBlocks * source.getNumChannels() > 1)
+		{
+			compressBlocksInParallel(source, numFullBlocks, output, blockOffsetData);
+
+			blockOffset = numFullBlocks * COMPRESSION_BLOCK_SIZE;
+			numSamplesRemaining -= blockOffset;
+		}
+	}
+
 	while (numSamplesRemaining >= COMPRESSION_BLOCK_SIZE)
 	{
 		blockOffsetData[blockIndex] = numBytesWritten;
@@ -145,25 +158,119 @@ bool HlacEncoder::encodeBlock(AudioSampleBuffer& block, OutputStream& output)
 }
 
 bool HlacEncoder::encodeBlock(CompressionHelpers::AudioBufferInt16& block16, OutputStream& output)
+{
+	auto blockData = createBlockData(block16);
+
+	writeChecksumBytesForBlock(output);
+
+	numBytesWritten += (uint32)blockData.getSize();
+	return output.write(blockData.getData(), blockData.getSize());
+}
+
+MemoryBlock HlacEncoder::createBlockData(CompressionHelpers::AudioBufferInt16& block16)
 {
 	auto compressedBlock = createCompressedBlock(block16);
 
-	auto thisBlockSize = compressedBlock.getSize();
+	if (compressedBlock.getSize() > 2 * COMPRESSION_BLOCK_SIZE)
+	{
+		MemoryOutputStream uncompressed;
 
-	writeChecksumBytesForBlock(output);
+		writeCycleHeader(true, 16, COMPRESSION_BLOCK_SIZE, uncompressed);
+		uncompressed.write(block16.getReadPointer(), sizeof(int16) * COMPRESSION_BLOCK_SIZE);
+		uncompressed.flush();
+
+		return uncompressed.getMemoryBlock();
+	}
 
-	if (thisBlockSize > 2 * COMPRESSION_BLOCK_SIZE)
+	return compressedBlock;
+}
+
+/** Compresses a range of blocks with its own encoder. The blocks are indexed interleaved (block * numChannels + channel). */
+struct HlacEncoder::BlockEncodingJob : public ThreadPoolJob
+{
+	BlockEncodingJob(CompressorOptions options, const AudioSampleBuffer& source_, Array<MemoryBlock>& blockData_, int startIndex_, int endIndex_) :
+		ThreadPoolJob("HLAC block encoding"),
+		source(source_),
+		blockData(blockData_),
+		startIndex(startIndex_),
+		endIndex(endIndex_)
 	{
-		writeCycleHeader(true, 16, COMPRESSION_BLOCK_SIZE, output);
+		encoder.setOptions(options);
+	}
+
+	JobStatus runJob() override
+	{
+		const int numChannels = source.getNumChannels();
+
+		CompressionHelpers::AudioBufferInt16 block16(COMPRESSION_BLOCK_SIZE);
+
+		for (int i = startIndex; i < endIndex; i++)
+		{
+			const int channelIndex = i % numChannels;
+			const int offset = (i / numChannels) * COMPRESSION_BLOCK_SIZE;
 
-		numBytesWritten += sizeof(int16)*COMPRESSION_BLOCK_SIZE + 3;
+			AudioDataConverters::convertFloatToInt16LE(source.getReadPointer(channelIndex, offset), block16.getWritePointer(), COMPRESSION_BLOCK_SIZE);
 
-		return output.write(block16.getReadPointer(), sizeof(int16) * COMPRESSION_BLOCK_SIZE);
+			blockData.getReference(i) = encoder.createBlockData(block16);
+		}
+
+		return jobHasFinished;
 	}
-	else
+
+	HlacEncoder encoder;
+
+	const AudioSampleBuffer& source;
+	Array<MemoryBlock>& blockData;
+
+	const int startIndex;
+	const int endIndex;
+};
+
+void HlacEncoder::compressBlocksInParallel(AudioSampleBuffer& source, int numFullBlocks, OutputStream& output, uint32* blockOffsetData)
+{
+	jassert(threadPool != nullptr);
+
+	const int numChannels = source.getNumChannels();
+	const int numItems = numFullBlocks * numChannels;
+	const int numJobs = jmin<int>(numItems, threadPool->getNumThreads());
+
+	Array<MemoryBlock> blockData;
+	blockData.insertMultiple(0, MemoryBlock(), numItems);
+
+	OwnedArray<BlockEncodingJob> jobs;
+
+	for (int i = 0; i < numJobs; i++)
 	{
-		numBytesWritten += (uint32)compressedBlock.getSize();
-		return output.write(compressedBlock.getData(), compressedBlock.getSize());
+		const int startIndex = (numItems * i) / numJobs;
+		const int endIndex = (numItems * (i + 1)) / numJobs;
+
+		threadPool->addJob(jobs.add(new BlockEncodingJob(options, source, blockData, startIndex, endIndex)), false);
+	}
+
+	for (auto job : jobs)
+	{
+		threadPool->waitForJobToFinish(job, -1);
+
+		numBytesUncompressed += job->encoder.numBytesUncompressed;
+		numTemplates += job->encoder.numTemplates;
+		numDeltas += job->encoder.numDeltas;
+	}
+
+	// Write the blocks in their original order so that the data matches the serial encoding
+	for (int i = 0; i < numItems; i++)
+	{
+		if (i % numChannels == 0)
+		{
+			blockOffsetData[blockIndex] = numBytesWritten;
+			++blockIndex;
+		}
+
+		const auto& b = blockData.getReference(i);
+
+		writeChecksumBytesForBlock(output);
+
+		numBytesWritten += (uint32)b.getSize();
+		output.write(b.getData(), b.getSize());
 	}
 }
 
@@ -423,7 +530,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForFull > 0)
 	{
 		MemoryBlock mbFull;
-		mbFull.setSize(numBytesForFull);
+		mbFull.setSize(numBytesForFull, true);
 		compressorFull->compress((uint8*)mbFull.getData(), packedBuffer.getReadPointer(), numFullValues);
 
 		if (!output.write(mbFull.getData(), numBytesForFull))
@@ -435,7 +542,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForError > 0)
 	{
 		MemoryBlock mbError;
-		mbError.setSize(numBytesForError);
+		mbError.setSize(numBytesForError, true);
 		compressorError->compress((uint8*)mbError.getData(), packedErrorBuffer.getReadPointer(), numErrorValues);
 
 		
@@ -159,8 +159,23 @@ public:
 
 	uint32 getNumBlocksWritten() const { return blockIndex; }
 
+	/** Sets a thread pool that is used to compress the full blocks of a buffer in parallel.
+	*
+	*	The blocks are independent from each other, so they are compressed on the pool and then written
+	*	in their original order which produces the same data as the serial encoding. Pass nullptr to
+	*	encode on the calling thread (the default).
+	*/
+	void setThreadPool(ThreadPool* newPool) { threadPool = newPool; }
+
 private:
 
+	struct BlockEncodingJob;
+
+	void compressBlocksInParallel(AudioSampleBuffer& source, int numFullBlocks, OutputStream& output, uint32* blockOffsetData);
+
+	/** Returns the data of a block that is written after the checksum. */
+	MemoryBlock createBlockData(CompressionHelpers::AudioBufferInt16& block16);
+
 	bool encodeBlock(AudioSampleBuffer& block, OutputStream& output);
 
 	bool encodeBlock(CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
@@ -222,6 +237,8 @@ private:
 	uint64 readIndex = 0;
 
 	double decompressionSpeed = 0.0;
+
+	ThreadPool* threadPool = nullptr;
 };
 
 } // namespace hlac
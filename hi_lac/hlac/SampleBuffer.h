@@ -66,7 +66,7 @@ public:
 	}
 
 	HiseSampleBuffer(HiseSampleBuffer&& otherBuffer) :
-		floatBuffer(otherBuffer.floatBuffer),
+		floatBuffer(std::move(otherBuffer.floatBuffer)),
 		isFloat(otherBuffer.isFloat),
 		leftIntBuffer(std::move(otherBuffer.leftIntBuffer)),
 		rightIntBuffer(std::move(otherBuffer.rightIntBuffer)),
@@ -90,7 +90,7 @@ public:
 		isFloat = other.isFloat;
 		leftIntBuffer = std::move(other.leftIntBuffer);
 		rightIntBuffer = std::move(other.rightIntBuffer);
-		floatBuffer = other.floatBuffer;
+		floatBuffer = std::move(other.floatBuffer);
 		numChannels = other.numChannels;
 		size = other.size;
 
@@ -56,8 +56,7 @@ loadAfterProcessFlag(false),
 isCurrentlyProcessing(false),
 loadingThread(*this),
 #if USE_FFT_CONVOLVER
-convolverL(new MultithreadedConvolver()),
-convolverR(new MultithreadedConvolver())
+convolver(new PartitionedConvolver())
 #else
 wdlPimpl(new WdlPimpl())
 #endif
@@ -79,18 +78,15 @@ wdlPimpl(new WdlPimpl())
 	smoothedGainerDry.setParameter((int)ScriptingDsp::SmoothedGainer::Parameters::Gain, 0.0f);
 
 #if USE_FFT_CONVOLVER
-	convolverL->reset();
-	convolverR->reset();
-	convolverL->setUseBackgroundThread(false);
-	convolverR->setUseBackgroundThread(false);
+	convolver->reset();
+	convolver->setUseBackgroundThread(false);
 #endif
 }
 
 ConvolutionEffect::~ConvolutionEffect()
 {
 #if USE_FFT_CONVOLVER
-	convolverL = nullptr;
-	convolverR = nullptr;
+	convolver = nullptr;
 #else
 	wdlPimpl = nullptr;
 #endif
@@ -113,7 +109,7 @@ float ConvolutionEffect::getAttribute(int parameterIndex) const
 	case ImpulseLength:	return 1.0f;
 	case ProcessInput:	return processFlag ? 1.0f : 0.0f;
 #if USE_FFT_CONVOLVER
-	case UseBackgroundThread:	return convolverL->isUsingBackgroundThread() ? 1.0f : 0.0f;
+	case UseBackgroundThread:	return convolver->isUsingBackgroundThread() ? 1.0f : 0.0f;
 #endif
 	case Predelay:		return predelayMs;
 	case HiCut:			return (float)cutoffFrequency;
@@ -140,8 +136,7 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 		break;
 	case ProcessInput:	enableProcessing(newValue >= 0.5f); break;
 #if USE_FFT_CONVOLVER
-	case UseBackgroundThread:	convolverL->setUseBackgroundThread(newValue > 0.5f);
-								convolverR->setUseBackgroundThread(newValue > 0.5f);
+	case UseBackgroundThread:	convolver->setUseBackgroundThread(newValue > 0.5f);
 								break;
 #endif
 	case Predelay:		predelayMs = newValue;
@@ -299,11 +294,10 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		//memset(convolutedL, 0, sizeof(float)*numSamples);
 		//memset(convolutedR, 0, sizeof(float)*numSamples);
 
-		if (convolverL != nullptr)
-			convolverL->process(l, convolutedL, numSamples);
+		const float* inputs[2] = { l, r };
+		float* outputs[2] = { convolutedL, convolutedR };
 
-		if(convolverR != nullptr)
-			convolverR->process(r, convolutedR, numSamples);
+		convolver->process(inputs, outputs, numSamples);
 		
 		smoothedGainerDry.processBlock(channels, 2, numSamples);
 
@@ -348,8 +342,7 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 				{
 #if USE_FFT_CONVOLVER
 
-					convolverL->cleanPipeline();
-					convolverR->cleanPipeline();
+					convolver->cleanPipeline();
 
 					
 
@@ -448,9 +441,6 @@ void ConvolutionEffect::calcPredelay()
 
 void ConvolutionEffect::applyExponentialFadeout(AudioSampleBuffer& buffer, int numSamples, float targetValue)
 {
-	float* l = buffer.getWritePointer(0);
-	float* r = buffer.getWritePointer(1);
-
 	const float base = targetValue;
 	const float invBase = 1.0f - targetValue;
 	const float factor = -1.0f * (float)numSamples / 4.0f;
@@ -459,8 +449,8 @@ void ConvolutionEffect::applyExponentialFadeout(AudioSampleBuffer& buffer, int n
 	{
 		const float multiplier = base + invBase * expf((float)i / factor);
 
-		*l++ *= multiplier;
-		*r++ *= multiplier;
+		for (int c = 0; c < buffer.getNumChannels(); c++)
+			buffer.getWritePointer(c)[i] *= multiplier;
 	}
 }
 
@@ -472,11 +462,11 @@ void ConvolutionEffect::applyHighFrequencyDamping(AudioSampleBuffer& buffer, int
 
 	SimpleOnePole lp1;
 	lp1.setSampleRate(sampleRate);
-	lp1.setNumChannels(2);
+	lp1.setNumChannels(buffer.getNumChannels());
 
 	SimpleOnePole lp2;
 	lp2.setSampleRate(sampleRate);
-	lp2.setNumChannels(2);
+	lp2.setNumChannels(buffer.getNumChannels());
 
 	for (int i = 0; i < numSamples; i += 64)
 	{
@@ -588,8 +578,7 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 	{
 		ScopedLock sl(parent.getImpulseLock());
 
-		parent.convolverL->reset();
-		parent.convolverR->reset();
+		parent.convolver->reset();
 		shouldReload = false;
 		return;
 	}
@@ -598,10 +587,13 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 
 	auto pBuffer = *parent.getSampleBuffer();
 
-	AudioSampleBuffer copyBuffer(2, parent.getSampleBuffer()->getNumSamples());
+	// Mono impulses are only calculated once, four channel impulses are used as true stereo
+	const int numIrChannels = pBuffer.getNumChannels() >= 4 ? 4 : jmin<int>(2, pBuffer.getNumChannels());
+
+	AudioSampleBuffer copyBuffer(numIrChannels, parent.getSampleBuffer()->getNumSamples());
 
-	copyBuffer.copyFrom(0, 0, pBuffer.getReadPointer(0), pBuffer.getNumSamples(), 1.0f);
-	copyBuffer.copyFrom(1, 0, pBuffer.getReadPointer(pBuffer.getNumChannels() >= 2 ? 1 : 0), pBuffer.getNumSamples(), 1.0f);
+	for (int i = 0; i < numIrChannels; i++)
+		copyBuffer.copyFrom(i, 0, pBuffer.getReadPointer(i), pBuffer.getNumSamples(), 1.0f);
 
 	if (shouldRestart)
 	{
@@ -617,14 +609,11 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 	if (irLength > 44100 * 20)
 		jassertfalse;
 
-	auto l = copyBuffer.getReadPointer(0, offset);
-	auto r = copyBuffer.getReadPointer(1, offset);
-
 	auto resampleRatio = parent.getResampleFactor();
 
 	int resampledLength = roundDoubleToInt((double)irLength * resampleRatio);
 
-	AudioSampleBuffer scratchBuffer(2, resampledLength);
+	AudioSampleBuffer scratchBuffer(numIrChannels, resampledLength);
 
 	if (shouldRestart)
 	{
@@ -633,17 +622,19 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 	}
 		
 
-	if (resampleRatio != 1.0)
-	{
-		LagrangeInterpolator resampler;
-		resampler.process(1.0 / resampleRatio, l, scratchBuffer.getWritePointer(0), resampledLength);
-		resampler.reset();
-		resampler.process(1.0 / resampleRatio, r, scratchBuffer.getWritePointer(1), resampledLength);
-	}
-	else
+	for (int i = 0; i < numIrChannels; i++)
 	{
-		FloatVectorOperations::copy(scratchBuffer.getWritePointer(0), l, irLength);
-		FloatVectorOperations::copy(scratchBuffer.getWritePointer(1), r, irLength);
+		auto source = copyBuffer.getReadPointer(i, offset);
+
+		if (resampleRatio != 1.0)
+		{
+			LagrangeInterpolator resampler;
+			resampler.process(1.0 / resampleRatio, source, scratchBuffer.getWritePointer(i), resampledLength);
+		}
+		else
+		{
+			FloatVectorOperations::copy(scratchBuffer.getWritePointer(i), source, irLength);
+		}
 	}
 
 	if (shouldRestart)
@@ -671,20 +662,9 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 	}
 
 
-	const auto headSize = nextPowerOfTwo(parent.getBlockSize());
-	const auto fullTailLength = nextPowerOfTwo(resampledLength - headSize);
-
 	ScopedLock sl(parent.getImpulseLock());
 
-	parent.convolverL->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(0), resampledLength);
-
-	if (shouldRestart)
-	{
-		shouldReload = true;
-		return;
-	}
-
-	parent.convolverR->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(1), resampledLength);
+	parent.convolver->init(parent.getBlockSize(), parent.getSampleRate(), scratchBuffer.getArrayOfReadPointers(), numIrChannels, resampledLength);
 
 	if (shouldRestart)
 	{
@@ -103,122 +103,12 @@ private:
 	
 };
 
-class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver
-{
-	class BackgroundThread : public Thread
-	{
-	public:
-
-		BackgroundThread(MultithreadedConvolver& parent_) :
-			Thread("Convolution Background Thread"),
-			parent(parent_)
-		{
-			
-		}
-
-		void run() override
-		{
-			while (!threadShouldExit())
-			{
-
-				if (active)
-				{
-					ScopedValueSetter<bool> svs(currentlyRendering, true);
-					parent.doBackgroundProcessing();
-					active = false;
-
-					if (threadShouldExit())
-						return;
-				}
-
-				wait(500);
-			}
-		};
-
-		void setSomethingTodo(bool shouldBeActive)
-		{
-			active = shouldBeActive;
-		}
-
-		bool isBusy() const { return currentlyRendering; }
-
-		bool currentlyRendering = false;
-		bool active = false;
-
-		MultithreadedConvolver& parent;
-	};
-
-
-public:
-
-	MultithreadedConvolver() :
-		TwoStageFFTConvolver(),
-		backgroundThread(*this)
-	{};
-
-	virtual ~MultithreadedConvolver()
-	{
-		backgroundThread.stopThread(1000);
-	};
-
-	void startBackgroundProcessing() override
-	{
-		if (useBackgroundThread)
-		{
-			backgroundThread.setSomethingTodo(true);
-			backgroundThread.notify();
-		}
-		else
-		{
-			doBackgroundProcessing();
-		}
-	}
-
-	void waitForBackgroundProcessing() override
-	{
-		if (useBackgroundThread)
-		{
-			while (backgroundThread.isBusy())
-				jassertfalse;
-		}
-	}
-
-	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread)
-	{
-		if (useBackgroundThread != shouldBeUsingBackgroundThread)
-		{
-			useBackgroundThread = shouldBeUsingBackgroundThread;
-		
-			if (useBackgroundThread)
-				backgroundThread.startThread(9);
-			else
-			{
-				if(backgroundThread.isThreadRunning())
-					backgroundThread.stopThread(1000);
-			}
-				
-		}
-	}
-
-	bool isUsingBackgroundThread() const
-	{
-		return useBackgroundThread;
-	}
-
-private:
-
-	BackgroundThread backgroundThread;
-
-	bool useBackgroundThread = true;
-};
-
-
 /** @brief A convolution reverb using zero-latency convolution
 *	@ingroup effectTypes
 *
-*	This is a wrapper for the convolution engine found in WDL (the sole MIT licenced convolution engine available)
-*	It is not designed to replace real convolution reverbs (as the CPU usage for impulses > 0.6 seconds is unreasonable),
-*	but your early reflection impulses or other filter impulses will be thankful for this effect.
+*	It uses the PartitionedConvolver, which renders the tail of long impulse responses on a thread pool that is shared
+*	between all convolution effects. Stereo impulse responses are processed in parallel, four channel impulse 
+*	responses as true stereo (L->L, L->R, R->L, R->R).
 */
 class ConvolutionEffect: public MasterEffectProcessor,
 						 public AudioSampleProcessor
@@ -275,8 +165,7 @@ class ConvolutionEffect: public MasterEffectProcessor,
 
 			ScopedLock sl(parent.getImpulseLock());
 
-			parent.convolverL->reset();
-			parent.convolverR->reset();
+			parent.convolver->reset();
 
 			stopTimer();
 		}
@@ -391,8 +280,7 @@ private:
 
 #if USE_FFT_CONVOLVER
 
-	ScopedPointer<MultithreadedConvolver> convolverL;
-	ScopedPointer<MultithreadedConvolver> convolverR;
+	ScopedPointer<PartitionedConvolver> convolver;
 
 #else
 
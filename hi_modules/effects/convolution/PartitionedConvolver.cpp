@@ -0,0 +1,572 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace PartitionedConvolutionHelpers
+{
+
+/** Multiplies two packed real spectra and adds the result to the accumulator. */
+static void multiplyAdd(float* accumulator, const float* a, const float* b, int fftSize)
+{
+	// DC and nyquist are real
+	accumulator[0] += a[0] * b[0];
+	accumulator[1] += a[1] * b[1];
+
+	int i = 2;
+
+#if JUCE_USE_SSE_INTRINSICS
+
+	const __m128 sign = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+
+	for (; i + 4 <= fftSize; i += 4)
+	{
+		const __m128 av = _mm_loadu_ps(a + i);
+		const __m128 bv = _mm_loadu_ps(b + i);
+
+		const __m128 bRe = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 bIm = _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(3, 3, 1, 1));
+		const __m128 aSwapped = _mm_shuffle_ps(av, av, _MM_SHUFFLE(2, 3, 0, 1));
+
+		const __m128 product = _mm_add_ps(_mm_mul_ps(av, bRe), _mm_mul_ps(_mm_mul_ps(aSwapped, bIm), sign));
+
+		_mm_storeu_ps(accumulator + i, _mm_add_ps(_mm_loadu_ps(accumulator + i), product));
+	}
+
+#endif
+
+	for (; i < fftSize; i += 2)
+	{
+		accumulator[i] += a[i] * b[i] - a[i + 1] * b[i + 1];
+		accumulator[i + 1] += a[i] * b[i + 1] + a[i + 1] * b[i];
+	}
+}
+
+}
+
+/** A uniformly partitioned zero latency convolution (overlap-add with a frequency domain delay line). 
+*
+*	The input spectra are calculated once per input and the spectra of every path are summed up before the 
+*	inverse FFT, so the amount of FFTs doesn't depend on the number of paths.
+*/
+class PartitionedConvolver::Stage
+{
+public:
+
+	struct Path
+	{
+		int input;
+		int output;
+		int irChannel;
+	};
+
+	Stage(int partitionSize_, int irOffset, int irLength, const float** ir, int numIrChannels_, const Array<Path>& paths_, int numInputs_, int numOutputs_) :
+		fft(HiseFFT::DataType::RealFloat),
+		paths(paths_),
+		partitionSize(partitionSize_),
+		fftSize(2 * partitionSize_),
+		numPartitions(jmax<int>(1, (irLength + partitionSize_ - 1) / partitionSize_)),
+		numIrChannels(numIrChannels_),
+		numInputs(numInputs_),
+		numOutputs(numOutputs_)
+	{
+		irSpectra.calloc(numIrChannels * numPartitions * fftSize);
+		inputSpectra.calloc(numInputs * numPartitions * fftSize);
+		inputSegments.calloc(numInputs * fftSize);
+		premultiplied.calloc(numOutputs * fftSize);
+		convolved.calloc(numOutputs * fftSize);
+		overlap.calloc(numOutputs * partitionSize);
+
+		// The inverse FFT is unscaled, so the impulse response is scaled instead
+		const float scaleFactor = 1.0f / (float)fftSize;
+
+		HeapBlock<float> segment(fftSize);
+
+		for (int c = 0; c < numIrChannels; c++)
+		{
+			for (int p = 0; p < numPartitions; p++)
+			{
+				const int numToCopy = jlimit<int>(0, partitionSize, irLength - p * partitionSize);
+
+				FloatVectorOperations::clear(segment, fftSize);
+				FloatVectorOperations::copyWithMultiply(segment, ir[c] + irOffset + p * partitionSize, scaleFactor, numToCopy);
+
+				fft.realFFT(segment, getIrSpectrum(c, p), fftSize);
+			}
+		}
+	}
+
+	int getPartitionSize() const noexcept { return partitionSize; }
+
+	void clear()
+	{
+		FloatVectorOperations::clear(inputSpectra, numInputs * numPartitions * fftSize);
+		FloatVectorOperations::clear(inputSegments, numInputs * fftSize);
+		FloatVectorOperations::clear(premultiplied, numOutputs * fftSize);
+		FloatVectorOperations::clear(overlap, numOutputs * partitionSize);
+
+		currentPartition = 0;
+		inputFill = 0;
+	}
+
+	/** Adds the convolution of the inputs to the outputs. */
+	void process(const float** inputs, float** outputs, int numSamples)
+	{
+		using namespace PartitionedConvolutionHelpers;
+
+		int offset = 0;
+
+		while (offset < numSamples)
+		{
+			const int numThisTime = jmin<int>(numSamples - offset, partitionSize - inputFill);
+
+			for (int i = 0; i < numInputs; i++)
+			{
+				float* segment = inputSegments + i * fftSize;
+				FloatVectorOperations::copy(segment + inputFill, inputs[i] + offset, numThisTime);
+				fft.realFFT(segment, getInputSpectrum(i, 0), fftSize);
+			}
+
+			// The older partitions don't change until the segment is full
+			if (inputFill == 0)
+			{
+				FloatVectorOperations::clear(premultiplied, numOutputs * fftSize);
+
+				for (const auto& path : paths)
+				{
+					float* acc = premultiplied + path.output * fftSize;
+
+					for (int p = 1; p < numPartitions; p++)
+						multiplyAdd(acc, getInputSpectrum(path.input, p), getIrSpectrum(path.irChannel, p), fftSize);
+				}
+			}
+
+			FloatVectorOperations::copy(convolved, premultiplied, numOutputs * fftSize);
+
+			for (const auto& path : paths)
+				multiplyAdd(convolved + path.output * fftSize, getInputSpectrum(path.input, 0), getIrSpectrum(path.irChannel, 0), fftSize);
+
+			for (int o = 0; o < numOutputs; o++)
+			{
+				float* result = convolved + o * fftSize;
+
+				fft.realFFTInverseInplace(result, fftSize);
+
+				FloatVectorOperations::add(outputs[o] + offset, result + inputFill, numThisTime);
+				FloatVectorOperations::add(outputs[o] + offset, overlap + o * partitionSize + inputFill, numThisTime);
+			}
+
+			inputFill += numThisTime;
+
+			if (inputFill == partitionSize)
+			{
+				for (int o = 0; o < numOutputs; o++)
+					FloatVectorOperations::copy(overlap + o * partitionSize, convolved + o * fftSize + partitionSize, partitionSize);
+
+				for (int i = 0; i < numInputs; i++)
+					FloatVectorOperations::clear(inputSegments + i * fftSize, partitionSize);
+
+				currentPartition = (currentPartition + 1) % numPartitions;
+				inputFill = 0;
+			}
+
+			offset += numThisTime;
+		}
+	}
+
+private:
+
+	float* getIrSpectrum(int irChannel, int partitionIndex) const noexcept
+	{
+		return irSpectra + (irChannel * numPartitions + partitionIndex) * fftSize;
+	}
+
+	/** Returns the spectrum of the input segment that was delayed by the given amount of partitions. */
+	float* getInputSpectrum(int inputIndex, int delayInPartitions) const noexcept
+	{
+		const int index = (currentPartition - delayInPartitions + numPartitions) % numPartitions;
+		return inputSpectra + (inputIndex * numPartitions + index) * fftSize;
+	}
+
+	HiseFFT fft;
+
+	const Array<Path> paths;
+
+	const int partitionSize;
+	const int fftSize;
+	const int numPartitions;
+	const int numIrChannels;
+	const int numInputs;
+	const int numOutputs;
+
+	int currentPartition = 0;
+	int inputFill = 0;
+
+	HeapBlock<float> irSpectra;
+	HeapBlock<float> inputSpectra;
+	HeapBlock<float> inputSegments;
+	HeapBlock<float> premultiplied;
+	HeapBlock<float> convolved;
+	HeapBlock<float> overlap;
+
+	JUCE_DECLARE_NON_COPYABLE(Stage)
+};
+
+/** A stage that collects a full partition on the audio thread and renders it as job of the thread pool. 
+*
+*	The result of a partition is played back one partition after it was rendered, which is why a tail stage must start 
+*	at twice its partition size.
+*
+*	The audio thread never waits for the job: if the last partition isn't rendered when the next one is full, the 
+*	previous result is played back again and the new partition is skipped. The next job renders a silent partition
+*	for every skipped one before its own input, so the delay line of the stage stays aligned with the input.
+*/
+class PartitionedConvolver::TailStage : public SampleThreadPool::Job
+{
+public:
+
+	TailStage(Stage* stage_, int numInputs, int numOutputs, double sampleRate) :
+		Job("Convolution Tail"),
+		stage(stage_),
+		partitionSize(stage_->getPartitionSize()),
+		inputBuffer(numInputs, partitionSize),
+		jobInput(numInputs, partitionSize),
+		silentInput(numInputs, partitionSize),
+		durationTicks(Time::secondsToHighResolutionTicks((double)partitionSize / sampleRate))
+	{
+		for (auto& b : outputBuffers)
+			b.setSize(numOutputs, partitionSize);
+
+		// Creates the shared pointer of the weak reference now so that the audio thread doesn't allocate
+		WeakReference<Job> createdReference(this);
+
+		clear();
+	}
+
+	JobStatus runJob() override
+	{
+		auto& target = outputBuffers[1 - currentOutput];
+
+		if (clearStageInJob)
+			stage->clear();
+
+		// The results of the skipped partitions were replaced by the previous result
+		for (int i = 0; i < numSkippedForJob; i++)
+		{
+			target.clear();
+			stage->process(silentInput.getArrayOfReadPointers(), target.getArrayOfWritePointers(), partitionSize);
+		}
+
+		target.clear();
+		stage->process(jobInput.getArrayOfReadPointers(), target.getArrayOfWritePointers(), partitionSize);
+
+		return jobHasFinished;
+	}
+
+	int getPartitionSize() const noexcept { return partitionSize; }
+
+	int getNumSamplesUntilFull() const noexcept { return partitionSize - inputFill; }
+
+	/** Adds the current output to the outputs and collects the input. Returns true if the partition is full. */
+	bool process(const float** inputs, float** outputs, int offset, int numSamples)
+	{
+		jassert(inputFill + numSamples <= partitionSize);
+
+		const auto& output = outputBuffers[currentOutput];
+
+		for (int o = 0; o < output.getNumChannels(); o++)
+			FloatVectorOperations::add(outputs[o] + offset, output.getReadPointer(o, inputFill), numSamples);
+
+		for (int i = 0; i < inputBuffer.getNumChannels(); i++)
+			FloatVectorOperations::copy(inputBuffer.getWritePointer(i, inputFill), inputs[i] + offset, numSamples);
+
+		inputFill += numSamples;
+
+		return inputFill == partitionSize;
+	}
+
+	/** Swaps the output buffers and renders the collected partition. 
+	*
+	*	Returns false if the last partition wasn't finished in time. In this case the previous result is played back
+	*	again and the collected partition is skipped.
+	*/
+	bool startRendering(SampleThreadPool* poolToUse)
+	{
+		inputFill = 0;
+
+		if (isQueued())
+		{
+			numSkippedPartitions = jmin<int>(numSkippedPartitions + 1, MaxSkippedPartitions);
+			return false;
+		}
+
+		// Discards the result of the job that was running when the pipeline was cleaned
+		if (clearPending)
+			outputBuffers[1 - currentOutput].clear();
+
+		currentOutput = 1 - currentOutput;
+
+		numSkippedForJob = numSkippedPartitions;
+		numSkippedPartitions = 0;
+		clearStageInJob = clearPending;
+		clearPending = false;
+
+		for (int i = 0; i < jobInput.getNumChannels(); i++)
+			FloatVectorOperations::copy(jobInput.getWritePointer(i), inputBuffer.getReadPointer(i), partitionSize);
+
+		if (poolToUse != nullptr)
+		{
+			setDeadline(Time::getHighResolutionTicks() + durationTicks);
+			poolToUse->addJob(this, false);
+		}
+		else
+		{
+			runJob();
+		}
+
+		return true;
+	}
+
+	void waitForJob()
+	{
+		while (isQueued())
+			Thread::sleep(1);
+	}
+
+	void clear()
+	{
+		waitForJob();
+
+		stage->clear();
+
+		inputBuffer.clear();
+		jobInput.clear();
+		silentInput.clear();
+
+		for (auto& b : outputBuffers)
+			b.clear();
+
+		currentOutput = 0;
+		inputFill = 0;
+		numSkippedPartitions = 0;
+		numSkippedForJob = 0;
+		clearPending = false;
+		clearStageInJob = false;
+	}
+
+	/** Clears the pipeline without waiting for a running job. 
+	*
+	*	If a job is running, the history of the stage is cleared by the next job and the result of the running job 
+	*	is discarded.
+	*/
+	void clearWithoutWaiting()
+	{
+		if (!isQueued())
+		{
+			clear();
+			return;
+		}
+
+		inputBuffer.clear();
+		outputBuffers[currentOutput].clear();
+
+		inputFill = 0;
+		numSkippedPartitions = 0;
+		clearPending = true;
+	}
+
+private:
+
+	/** The job renders at most this many silent partitions, so that a late job doesn't get even later. */
+	static constexpr int MaxSkippedPartitions = 2;
+
+	ScopedPointer<Stage> stage;
+
+	const int partitionSize;
+
+	AudioSampleBuffer inputBuffer;
+	AudioSampleBuffer jobInput;
+	AudioSampleBuffer silentInput;
+
+	/** The buffer that is played back and the buffer that the job renders into. */
+	AudioSampleBuffer outputBuffers[2];
+	int currentOutput = 0;
+
+	int inputFill = 0;
+
+	int numSkippedPartitions = 0;
+	int numSkippedForJob = 0;
+
+	bool clearPending = false;
+	bool clearStageInJob = false;
+
+	const int64 durationTicks;
+
+	JUCE_DECLARE_NON_COPYABLE(TailStage)
+};
+
+ConvolutionThreadPool::ConvolutionThreadPool() :
+	SampleThreadPool(jlimit<int>(1, 4, SystemStats::getNumCpus() / 2), "Convolution Thread", "Convolution Worker Thread")
+{
+}
+
+PartitionedConvolver::PartitionedConvolver()
+{
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+	waitForTailJobs();
+}
+
+void PartitionedConvolver::init(int blockSize, double sampleRate, const float** impulseResponse, int numIrChannels, int irLength, int numInputsToUse)
+{
+	reset();
+
+	if (irLength <= 0 || numIrChannels <= 0 || sampleRate <= 0.0)
+		return;
+
+	// Only mono, stereo and true stereo impulse responses are supported
+	jassert(numIrChannels == 1 || numIrChannels == 2 || numIrChannels == 4);
+
+	numInputs = jlimit<int>(1, 2, numInputsToUse);
+
+	Array<Stage::Path> paths;
+
+	if (numIrChannels >= 4)
+	{
+		numIrChannels = 4;
+		numOutputs = 2;
+
+		// A mono input uses the L->L and L->R impulse responses
+		for (int i = 0; i < numInputs; i++)
+			for (int o = 0; o < numOutputs; o++)
+				paths.add({ i, o, i * 2 + o });
+	}
+	else if (numIrChannels >= 2)
+	{
+		numIrChannels = 2;
+		numOutputs = 2;
+
+		for (int o = 0; o < numOutputs; o++)
+			paths.add({ jmin<int>(o, numInputs - 1), o, o });
+	}
+	else
+	{
+		numOutputs = numInputs;
+
+		for (int i = 0; i < numInputs; i++)
+			paths.add({ i, i, 0 });
+	}
+
+	const int headSize = jlimit<int>(MinPartitionSize, MaxPartitionSize, nextPowerOfTwo(blockSize));
+
+	int tailSize = jmin<int>(headSize * 4, MaxPartitionSize);
+	int offset = jmin<int>(irLength, tailSize * 2);
+
+	head = new Stage(headSize, 0, offset, impulseResponse, numIrChannels, paths, numInputs, numOutputs);
+
+	while (offset < irLength)
+	{
+		const int nextTailSize = jmin<int>(tailSize * 4, MaxPartitionSize);
+		const bool isLastStage = tailSize == MaxPartitionSize || nextTailSize * 2 >= irLength;
+		const int length = isLastStage ? irLength - offset : nextTailSize * 2 - offset;
+
+		auto stage = new Stage(tailSize, offset, length, impulseResponse, numIrChannels, paths, numInputs, numOutputs);
+		tails.add(new TailStage(stage, numInputs, numOutputs, sampleRate));
+
+		offset += length;
+		tailSize = nextTailSize;
+	}
+}
+
+void PartitionedConvolver::process(const float** inputs, float** outputs, int numSamples)
+{
+	for (int o = 0; o < numOutputs; o++)
+		FloatVectorOperations::clear(outputs[o], numSamples);
+
+	if (head == nullptr)
+		return;
+
+	head->process(inputs, outputs, numSamples);
+
+	if (tails.isEmpty())
+		return;
+
+	SampleThreadPool* poolToUse = useBackgroundThread ? &pool.get() : nullptr;
+
+	int offset = 0;
+
+	while (offset < numSamples)
+	{
+		// The partition sizes are multiples of the first one, so no other stage gets full within this chunk
+		const int numThisTime = jmin<int>(numSamples - offset, tails.getFirst()->getNumSamplesUntilFull());
+
+		for (auto t : tails)
+		{
+			if (t->process(inputs, outputs, offset, numThisTime) && !t->startRendering(poolToUse))
+				++numMissedDeadlines;
+		}
+
+		offset += numThisTime;
+	}
+}
+
+void PartitionedConvolver::reset()
+{
+	waitForTailJobs();
+
+	tails.clear();
+	head = nullptr;
+}
+
+void PartitionedConvolver::cleanPipeline()
+{
+	if (head != nullptr)
+		head->clear();
+
+	for (auto t : tails)
+		t->clearWithoutWaiting();
+}
+
+void PartitionedConvolver::setUseBackgroundThread(bool shouldBeUsingBackgroundThread)
+{
+	useBackgroundThread = shouldBeUsingBackgroundThread;
+}
+
+void PartitionedConvolver::waitForTailJobs()
+{
+	for (auto t : tails)
+		t->waitForJob();
+}
+
+} // namespace hise
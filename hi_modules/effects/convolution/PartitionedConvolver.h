@@ -0,0 +1,134 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PARTITIONEDCONVOLVER_H_INCLUDED
+#define PARTITIONEDCONVOLVER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** The thread pool that renders the tail partitions of all PartitionedConvolver instances.
+*
+*	It is shared between all convolution effects of the process, so it doesn't matter how many convolution reverbs
+*	are used in a patch: the amount of background threads stays the same. The jobs are executed in the order of
+*	their deadline (the time when the audio thread needs the result).
+*/
+class ConvolutionThreadPool : public SampleThreadPool
+{
+public:
+
+	ConvolutionThreadPool();
+};
+
+/** A zero latency convolution engine with non-uniform partitions.
+*
+*	The impulse response is split into a head and multiple tail stages. The head uses the block size as partition
+*	size and is calculated on the audio thread. Every tail stage uses a partition size that is four times bigger than
+*	the previous one (up to MaxPartitionSize) and starts at twice its partition size, so its result is needed one
+*	partition later than its input is available. This time is used to render the tail stages on the shared
+*	ConvolutionThreadPool (or directly in the audio callback if the background thread is disabled).
+*
+*	The spectrum of every impulse response channel is calculated only once and the input spectra are shared between
+*	the outputs, so a true stereo impulse response only needs two forward and two inverse FFTs per partition.
+*
+*	The routing depends on the number of impulse response channels:
+*
+*	- 1 channel: every input is convolved with the same impulse response
+*	- 2 channels: the inputs are convolved with the respective channel (a mono input is sent to both outputs)
+*	- 4 channels: true stereo (L->L, L->R, R->L, R->R)
+*/
+class PartitionedConvolver
+{
+public:
+
+	enum
+	{
+		MinPartitionSize = 64,
+		MaxPartitionSize = 16384
+	};
+
+	PartitionedConvolver();
+	~PartitionedConvolver();
+
+	/** Calculates the partitions for the given impulse response. 
+	*
+	*	This allocates, so call it on a background thread (and make sure that process() isn't called at the same time).
+	*/
+	void init(int blockSize, double sampleRate, const float** impulseResponse, int numIrChannels, int irLength, int numInputs=2);
+
+	/** Convolves the input and writes the result into the output channels. 
+	*
+	*	The outputs are overwritten and must not point to the inputs. 
+	*/
+	void process(const float** inputs, float** outputs, int numSamples);
+
+	/** Removes the impulse response. */
+	void reset();
+
+	/** Clears the rendering history but keeps the impulse response. */
+	void cleanPipeline();
+
+	/** If enabled, the tail stages are rendered on the shared convolution thread pool. */
+	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread);
+
+	bool isUsingBackgroundThread() const noexcept { return useBackgroundThread; }
+
+	/** Returns the number of output channels for the current impulse response. */
+	int getNumOutputs() const noexcept { return numOutputs; }
+
+	/** Returns the number of tail stages that were not finished when the audio thread needed their result. */
+	int getNumMissedDeadlines() const noexcept { return numMissedDeadlines; }
+
+private:
+
+	class Stage;
+	class TailStage;
+
+	void waitForTailJobs();
+
+	ScopedPointer<Stage> head;
+	OwnedArray<TailStage> tails;
+
+	SharedResourcePointer<ConvolutionThreadPool> pool;
+
+	bool useBackgroundThread = false;
+
+	int numInputs = 2;
+	int numOutputs = 2;
+
+	int numMissedDeadlines = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartitionedConvolver)
+};
+
+} // namespace hise
+
+#endif  // PARTITIONEDCONVOLVER_H_INCLUDED
@@ -30,7 +30,7 @@
 
 
 
-#if USE_IPP || USE_VDSP_FFT
+#if !WDL_FFT_USE_DJBFFT
 
 void WDL_fft(WDL_FFT_COMPLEX *buf, int len, int isInverse, HiseFFTType &fftData, bool unpack)
 {
@@ -389,7 +389,7 @@ static WDL_FFT_COMPLEX d32768[4095];
   b1 = t4; \
   }
 
-#if USE_IPP || USE_VDSP_FFT
+#if !WDL_FFT_USE_DJBFFT
 #else
 static void c2(WDL_FFT_COMPLEX *a)
 {
@@ -651,7 +651,7 @@ static void cpassbig(WDL_FFT_COMPLEX *a,const WDL_FFT_COMPLEX *w,unsigned int n)
   } while (k -= 2);
 }
 
-#if USE_IPP || USE_VDSP_FFT
+#if !WDL_FFT_USE_DJBFFT
 #else
 
 static void c1024(WDL_FFT_COMPLEX *a)
@@ -1040,7 +1040,7 @@ static void upassbig(WDL_FFT_COMPLEX *a,const WDL_FFT_COMPLEX *w,unsigned int n)
   } while (k -= 2);
 }
 
-#if USE_IPP || USE_VDSP_FFT
+#if !WDL_FFT_USE_DJBFFT
 
 #else
 
@@ -1133,7 +1133,7 @@ static unsigned int fftfreq_c(unsigned int i,unsigned int n)
 
 static int _idxperm[2<<FFT_MAXBITLEN];
 
-#if USE_IPP || USE_VDSP_FFT
+#if !WDL_FFT_USE_DJBFFT
 #else
 static void idx_perm_calc(int offs, int n)
 {
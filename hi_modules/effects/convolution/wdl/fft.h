@@ -32,10 +32,13 @@
 
 #if HISE_IOS || (JUCE_MAC && USE_VDSP_FFT)
 #define HiseFFTType hise::VDspFFT
-#elif USE_IPP
-#define HiseFFTType hise::IppFFT
 #else
-class HiseFFTType {};
+#define HiseFFTType hise::HiseFFT
+#endif
+
+/** Set this to 1 to use the original DJB FFT routines instead of HiseFFTType. */
+#ifndef WDL_FFT_USE_DJBFFT
+#define WDL_FFT_USE_DJBFFT 0
 #endif
 
 
@@ -257,21 +257,15 @@ class FFTDisplay : public AudioAnalyserComponent
 public:
 
 	FFTDisplay(Processor* p) :
-#if USE_IPP
         AudioAnalyserComponent(p),
-		fftObject(IppFFT::DataType::RealFloat)
-#else
-       AudioAnalyserComponent(p)
-#endif
+		fftObject(HiseFFT::DataType::RealFloat)
 	{};
 
 	void paint(Graphics& g) override;
 
 private:
 
-#if USE_IPP
-	IppFFT fftObject;
-#endif
+	HiseFFT fftObject;
 
 	Path lPath;
 	Path rPath;
@@ -214,6 +214,9 @@ public:
 
 	void calculateBlock(int startSample, int numSamples) override;
 
+	/** The values are copied from the global container at audio rate. */
+	bool canBeCalculatedAtControlRate() const override { return false; }
+
 	void invertBuffer(int startSample, int numSamples);
 
 	/** sets the new target value if the controller number matches. */
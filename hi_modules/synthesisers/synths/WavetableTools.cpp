@@ -187,12 +187,11 @@ struct ResynthesisHelpers
 	{
 		
 
-#if USE_IPP
 		if (pitch != 0.0)
 		{
 			int size = buffer.getNumSamples();
 
-			IppFFT fft(IppFFT::DataType::RealFloat, 16);
+			HiseFFT fft(HiseFFT::DataType::RealFloat, 16);
 
 			float* dl = (float*)alloca(sizeof(float)*size);
 			float* dr = (float*)alloca(sizeof(float)*size);
@@ -289,9 +288,6 @@ struct ResynthesisHelpers
 		{
 			return false;
 		}
-#else
-		return false;
-#endif
 	}
 
 	static int getWavetableLength(int noteNumber, double sampleRate)
@@ -84,6 +84,10 @@ SET_DOCUMENTATION(ModulatorSampler)
 
     ADD_PARAMETER_DOC(UseStaticMatrix,
         "If this is true, then the routing matrix will not be resized when you load a sample map with another mic position amount.");
+
+	ADD_PARAMETER_DOC_WITH_NAME(InterpolationMode, "Interpolation",
+		"The interpolation algorithm that is used for pitching the samples: `0` = Linear, `1` = Hermite (4-point), `2` = Sinc (8-point). "\
+		"The higher modes reduce the aliasing and the high frequency loss at the cost of more CPU usage.");
     
 	ADD_CHAIN_DOC(SampleStartModulation, "Sample Start", 
 		"Allows modification of the sample start if the sound allows this. The modulation range is depending on the *SampleStartMod* value of each sample.");
@@ -117,7 +121,9 @@ numChannels(1),
 deactivateUIUpdate(false),
 samplePreloadPending(false),
 temporaryVoiceBuffer(true, 2, 0),
-samplePropertyUpdater(this)
+samplePropertyUpdater(this),
+mappingVersion(0),
+soundIndexUpdater(this)
 {
 #if USE_BACKEND
 	sampleEditHandler = new SampleEditHandler(this);
@@ -141,6 +147,7 @@ samplePropertyUpdater(this)
 	parameterNames.add("Purged");
 	parameterNames.add("Reversed");
     parameterNames.add("UseStaticMatrix");
+	parameterNames.add("InterpolationMode");
 
 	editorStateIdentifiers.add("SampleStartChainShown");
 	editorStateIdentifiers.add("SettingsShown");
@@ -336,6 +343,7 @@ void ModulatorSampler::restoreFromValueTree(const ValueTree &v)
 
 	loadAttribute(SamplerRepeatMode, "SamplerRepeatMode");
 	loadAttribute(Purged, "Purged");
+	loadAttribute(InterpolationMode, "InterpolationMode");
 
 	killAllVoicesAndCall([v](Processor* p) { static_cast<ModulatorSampler*>(p)->loadSampleMapSync(v.getChildWithName("samplemap")); return true; });
 
@@ -366,6 +374,7 @@ ValueTree ModulatorSampler::exportAsValueTree() const
 	saveAttribute(Reversed, "Reversed");
 	v.setProperty("NumChannels", numChannels, nullptr);
     saveAttribute(UseStaticMatrix, "UseStaticMatrix");
+	saveAttribute(InterpolationMode, "InterpolationMode");
 
 	ValueTree channels("channels");
 
@@ -407,6 +416,7 @@ float ModulatorSampler::getAttribute(int parameterIndex) const
 	case Purged:			return purged ? 1.0f : 0.0f;
 	case Reversed:			return reversed ? 1.0f : 0.0f;
     case UseStaticMatrix:   return useStaticMatrix ? 1.0f : 0.0f;
+	case InterpolationMode:	return (float)(int)interpolationMode;
 	default:				jassertfalse; return -1.0f;
 	}
 }
@@ -437,6 +447,7 @@ void ModulatorSampler::setInternalAttribute(int parameterIndex, float newValue)
 	case CrossfadeGroups:	crossfadeGroups = newValue > 0.5f; refreshCrossfadeTables(); break;
 	case Purged:			purgeAllSamples(newValue > 0.5f); break;
 	case UseStaticMatrix:   setUseStaticMatrix(newValue > 0.5f); break;
+	case InterpolationMode: interpolationMode = (StreamingResampler::InterpolationMode)jlimit<int>(0, (int)StreamingResampler::InterpolationMode::numInterpolationModes - 1, (int)newValue); break;
 	default:				jassertfalse; break;
 	}
 }
@@ -485,11 +496,56 @@ void ModulatorSampler::prepareToPlay(double newSampleRate, int samplesPerBlock)
 
 		StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, samplesPerBlock);
 
+		if (isUsingParallelVoiceRendering())
+			refreshParallelTemporaryVoiceBuffers();
+
 		sampleStartChain->prepareToPlay(newSampleRate, samplesPerBlock);
 		crossFadeChain->prepareToPlay(newSampleRate, samplesPerBlock);
 	}
 }
 
+hlac::HiseSampleBuffer* ModulatorSampler::getTemporaryVoiceBuffer(int threadIndex)
+{
+	if (threadIndex == 0)
+		return &temporaryVoiceBuffer;
+
+	jassert(isPositiveAndBelow(threadIndex - 1, parallelTemporaryVoiceBuffers.size()));
+
+	return parallelTemporaryVoiceBuffers[threadIndex - 1];
+}
+
+void ModulatorSampler::setUseParallelVoiceRendering(bool shouldRenderInParallel)
+{
+	if (shouldRenderInParallel)
+	{
+		// Make sure the pool exists, so that we know how many buffers we need
+		getMainController()->getOrCreateParallelRenderingPool();
+
+		refreshParallelTemporaryVoiceBuffers();
+	}
+
+	ModulatorSynth::setUseParallelVoiceRendering(shouldRenderInParallel);
+}
+
+void ModulatorSampler::refreshParallelTemporaryVoiceBuffers()
+{
+	auto pool = getMainController()->getParallelRenderingPool();
+
+	if (pool == nullptr)
+		return;
+
+	OwnedArray<hlac::HiseSampleBuffer> newBuffers;
+
+	for (int i = 1; i < pool->getNumThreads(); i++)
+	{
+		auto b = newBuffers.add(new hlac::HiseSampleBuffer(temporaryVoiceBuffer.isFloatingPoint(), 2, 0));
+		StreamingSamplerVoice::initTemporaryVoiceBuffer(b, getBlockSize());
+	}
+
+	ScopedLock sl(getMainController()->getLock());
+	parallelTemporaryVoiceBuffers.swapWith(newBuffers);
+}
+
 ProcessorEditorBody* ModulatorSampler::createEditor(ProcessorEditor *parentEditor)
 {
 #if USE_BACKEND
@@ -569,6 +625,8 @@ void ModulatorSampler::deleteSound(ModulatorSamplerSound *s)
         static_cast<ModulatorSamplerSound*>(sounds[i].get())->setNewIndex(i);
     }
     
+	soundMappingChanged();
+
 	sendChangeMessage();
 }
 
@@ -590,6 +648,8 @@ void ModulatorSampler::deleteAllSounds()
 		getMainController()->getSampleManager().getModulatorSamplerSoundPool()->clearUnreferencedMonoliths();
 	}
 	
+	soundMappingChanged();
+
 	refreshMemoryUsage();
 	sendChangeMessage();
 }
@@ -617,15 +677,13 @@ void ModulatorSampler::refreshPreloadSizes()
 
 double ModulatorSampler::getDiskUsage()
 {
-    double diskUsage = 0.0;
-    
-	for (int i = 0; i < getNumVoices(); i++)
-	{
-		if (auto v = getVoice(i))
-		{
-			diskUsage += static_cast<ModulatorSamplerVoice*>(v)->getDiskUsage();
-		}
-	}
+	auto pool = getMainController()->getSampleManager().getGlobalSampleThreadPool();
+
+	double diskUsage = 0.0;
+
+	// The busiest streaming worker limits the amount of voices that can be streamed
+	for (int i = 0; i < pool->getNumWorkers(); i++)
+		diskUsage = jmax(diskUsage, pool->getWorkerStatistics(i).usage);
 
 	return diskUsage * 100.0;
 }
@@ -644,6 +702,9 @@ void ModulatorSampler::refreshMemoryUsage()
 
 		StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, getBlockSize());
 
+		if (isUsingParallelVoiceRendering())
+			refreshParallelTemporaryVoiceBuffers();
+
 		for (auto i = 0; i < getNumVoices(); i++)
 		{
 			static_cast<ModulatorSamplerVoice*>(getVoice(i))->setStreamingBufferDataType(temporaryBufferShouldBeFloatingPoint);
@@ -813,6 +874,84 @@ void ModulatorSampler::SamplePropertyUpdater::addNewPropertyChange(ModulatorSamp
 	}
 }
 
+void ModulatorSampler::SoundIndexUpdater::timerCallback()
+{
+	stopTimer();
+	triggerAsyncUpdate();
+}
+
+void ModulatorSampler::SoundIndexUpdater::handleAsyncUpdate()
+{
+	// Don't block the message thread while a sample map is loaded
+	if (sampler->sampleMapLoadingPending)
+	{
+		startTimer(100);
+		return;
+	}
+
+	sampler->refreshSoundIndex();
+}
+
+void ModulatorSampler::SoundIndex::build(const ReferenceCountedArray<SynthesiserSound>& soundsToIndex)
+{
+	for (auto& c : cells)
+		c.clearQuick();
+
+	for (int i = soundsToIndex.size(); --i >= 0;)
+	{
+		auto sound = static_cast<ModulatorSamplerSound*>(soundsToIndex.getUnchecked(i).get());
+
+		const Range<int> fullRange(0, 128);
+		const auto noteRange = sound->getNoteRange().getIntersectionWith(fullRange);
+		const auto velocityRange = sound->getVelocityRange().getIntersectionWith(fullRange);
+
+		if (noteRange.isEmpty() || velocityRange.isEmpty())
+			continue;
+
+		const Entry e = { sound->getRRGroup(), i };
+
+		const int firstBucket = velocityRange.getStart() / VelocityBucketSize;
+		const int lastBucket = (velocityRange.getEnd() - 1) / VelocityBucketSize;
+
+		for (int n = noteRange.getStart(); n < noteRange.getEnd(); n++)
+		{
+			for (int b = firstBucket; b <= lastBucket; b++)
+				cells[n * NumVelocityBuckets + b].add(e);
+		}
+	}
+
+	for (auto& c : cells)
+	{
+		// keeps the descending sound order within each group
+		std::stable_sort(c.begin(), c.end());
+		c.minimiseStorageOverheads();
+	}
+}
+
+void ModulatorSampler::soundMappingChanged()
+{
+	++mappingVersion;
+	soundIndexUpdater.triggerAsyncUpdate();
+}
+
+void ModulatorSampler::refreshSoundIndex()
+{
+	ScopedPointer<SoundIndex> newIndex = new SoundIndex();
+
+	{
+		ScopedLock sl(getMainController()->getSampleManager().getSamplerSoundLock());
+
+		// Read the version before building the index, so that every change during the build invalidates it
+		newIndex->version = mappingVersion.load();
+		newIndex->build(sounds);
+	}
+
+	{
+		ScopedLock sl(getSynthLock());
+		soundIndex.swapWith(newIndex);
+	}
+}
+
 void ModulatorSampler::AsyncPurger::timerCallback()
 {
 	triggerAsyncUpdate();
@@ -899,6 +1038,9 @@ ModulatorSamplerSound* ModulatorSampler::addSamplerSound(const ValueTree &descri
 		newSound->setUndoManager(getMainController()->getControlUndoManager());
 		newSound->addChangeListener(sampleMap);
 		newSound->setMaxRRGroupIndex(rrGroupAmount);
+		newSound->setOwnerSampler(this);
+
+		soundMappingChanged();
 
 		sendChangeMessage();
 
@@ -919,18 +1061,27 @@ void ModulatorSampler::addSamplerSounds(OwnedArray<ModulatorSamplerSound>& monol
 
 	const int numNewSounds = monolithicSounds.size();
 
-	for (int i = 0; i < numNewSounds; i++)
 	{
-		ModulatorSamplerSound* newSound = monolithicSounds.removeAndReturn(0);
+		ScopedLock sl(getMainController()->getSampleManager().getSamplerSoundLock());
 
-		sounds.add(newSound);
+		for (int i = 0; i < numNewSounds; i++)
+		{
+			ModulatorSamplerSound* newSound = monolithicSounds.removeAndReturn(0);
 
-		newSound->setPurged(purged);
-		newSound->setMaxRRGroupIndex(rrGroupAmount);
-		newSound->setUndoManager(getMainController()->getControlUndoManager());
-		newSound->addChangeListener(sampleMap);
+			sounds.add(newSound);
+
+			newSound->setPurged(purged);
+			newSound->setMaxRRGroupIndex(rrGroupAmount);
+			newSound->setUndoManager(getMainController()->getControlUndoManager());
+			newSound->addChangeListener(sampleMap);
+			newSound->setOwnerSampler(this);
+		}
 	}
 
+	// The voices are killed at this point, so we can build the index right away
+	soundMappingChanged();
+	refreshSoundIndex();
+
 	sendChangeMessage();
 }
 
@@ -1006,6 +1157,52 @@ bool ModulatorSampler::soundCanBePlayed(ModulatorSynthSound *sound, int midiChan
 	return true;
 }
 
+void ModulatorSampler::collectSoundsToBeStarted(const HiseEvent &m)
+{
+	auto localIndex = soundIndex.get();
+
+	if (localIndex == nullptr || localIndex->version != mappingVersion.load())
+	{
+		ModulatorSynth::collectSoundsToBeStarted(m);
+		return;
+	}
+
+	soundsToBeStarted.clearQuick();
+
+	const int midiChannel = m.getChannel();
+	const int transposedMidiNoteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const float velocity = m.getFloatVelocity();
+
+	if (!isPositiveAndBelow(transposedMidiNoteNumber, (int)SoundIndex::NumNotes))
+		return;
+
+	const auto& entries = localIndex->getEntries(transposedMidiNoteNumber, jlimit<int>(0, 127, (int)(velocity * 127)));
+
+	auto start = entries.begin();
+	auto end = entries.end();
+
+	if (!crossfadeGroups)
+	{
+		const SoundIndex::Entry groupToFind = { currentRRGroupIndex, 0 };
+		auto groupRange = std::equal_range(start, end, groupToFind);
+
+		start = groupRange.first;
+		end = groupRange.second;
+	}
+
+	for (auto e = start; e != end; ++e)
+	{
+		if (!isPositiveAndBelow(e->soundIndex, sounds.size()))
+			continue;
+
+		auto sound = static_cast<ModulatorSynthSound*>(sounds.getUnchecked(e->soundIndex).get());
+
+		// The index only contains the mapping, so this still needs to be checked (purged samples, exact velocity, etc.)
+		if (soundCanBePlayed(sound, midiChannel, transposedMidiNoteNumber, velocity))
+			soundsToBeStarted.add(sound);
+	}
+}
+
 void ModulatorSampler::handleRetriggeredNote(ModulatorSynthVoice *voice)
 {
 	switch (repeatMode)
@@ -1301,10 +1498,10 @@ bool ModulatorSampler::preloadAllSamples()
 
 	ModulatorSampler::SoundIterator sIter(this);
 
-	const int numToLoad = jmax<int>(1, sounds.size() * getNumMicPositions());
-	int currentIndex = 0;
+	Array<SoundIterator::SharedPointer> soundsToReverse;
+	Array<StreamingSamplerSound*> soundsToPreload;
 
-	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
+	soundsToPreload.ensureStorageAllocated(sounds.size() * getNumMicPositions());
 
 	while (auto sound = sIter.getNextSound())
 	{
@@ -1312,12 +1509,7 @@ bool ModulatorSampler::preloadAllSamples()
 
 		if (getNumMicPositions() == 1)
 		{
-			auto s = sound->getReferenceToSound();
-
-			progress = (double)currentIndex++ / (double)numToLoad;
-
-			if (!preloadSample(s, preloadSizeToUse))
-				return false;
+			soundsToPreload.add(sound->getReferenceToSound());
 		}
 		else
 		{
@@ -1327,24 +1519,31 @@ bool ModulatorSampler::preloadAllSamples()
 
 				auto s = sound->getReferenceToSound(j);
 
-				progress = (double)currentIndex++ / (double)numToLoad;
-
 				if (s != nullptr)
 				{
 					if (isEnabled)
-					{
-						if (!preloadSample(s, preloadSizeToUse))
-							return false;
-					}
+						soundsToPreload.add(s);
 					else
 						s->setPurged(true);
 				}
 			}
 		}
 
-		sound->setReversed(isReversed);
+		soundsToReverse.add(sound);
 	}
 
+	MainController::SampleManager::PreloadThreadData data;
+
+	data.thread = Thread::getCurrentThread();
+	data.progress = &getMainController()->getSampleManager().getPreloadProgress();
+	data.totalSamplesToLoad = jmax<int>(1, soundsToPreload.size());
+
+	if (!preloadSamplesInParallel(soundsToPreload, preloadSizeToUse, data))
+		return false;
+
+	for (auto sound : soundsToReverse)
+		sound->setReversed(isReversed);
+
 	refreshMemoryUsage();
 	setShouldUpdateUI(true);
 	setHasPendingSampleLoad(false);
@@ -1370,16 +1569,180 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 	{
 		String x;
 		x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
-		getMainController()->getDebugLogger().logMessage(x);
+		
+		reportPreloadError(x);
+
+		return false;
+	}
+}
+
+void ModulatorSampler::reportPreloadError(const String& errorMessage)
+{
+	getMainController()->getDebugLogger().logMessage(errorMessage);
 
 #if USE_FRONTEND
-		getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+	getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, errorMessage);
 #else
-		debugError(this, x);
+	debugError(this, errorMessage);
 #endif
+}
 
-		return false;
+/** Preloads a list of sounds on a worker thread. It stops at the first error or if another batch has failed. */
+struct ModulatorSampler::PreloadBatchJob : public ThreadPoolJob
+{
+	PreloadBatchJob(int preloadSize_, Atomic<int>& numLoaded_, Atomic<int>& abortFlag_) :
+		ThreadPoolJob("Sample Preloading"),
+		preloadSize(preloadSize_),
+		numLoaded(numLoaded_),
+		abortFlag(abortFlag_)
+	{}
+
+	JobStatus runJob() override
+	{
+		for (auto s : sounds)
+		{
+			if (shouldExit() || abortFlag.get() != 0)
+				break;
+
+			try
+			{
+				s->setPreloadSize(s->hasActiveState() ? preloadSize : 0, true);
+				s->closeFileHandle();
+			}
+			catch (StreamingSamplerSound::LoadingError l)
+			{
+				errorMessage << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
+				abortFlag.set(1);
+				break;
+			}
+
+			++numLoaded;
+		}
+
+		return jobHasFinished;
 	}
+
+	/** Sorts the sounds by their channel file and their position in the monolith. */
+	struct MonolithOffsetSorter
+	{
+		static int compareElements(StreamingSamplerSound* first, StreamingSamplerSound* second)
+		{
+			const int c1 = first->getMonolithChannelIndex();
+			const int c2 = second->getMonolithChannelIndex();
+
+			if (c1 != c2)
+				return c1 < c2 ? -1 : 1;
+
+			const int64 o1 = first->getMonolithOffset();
+			const int64 o2 = second->getMonolithOffset();
+
+			if (o1 != o2)
+				return o1 < o2 ? -1 : 1;
+
+			return 0;
+		}
+	};
+
+	Array<StreamingSamplerSound*> sounds;
+	String errorMessage;
+
+	const int preloadSize;
+	Atomic<int>& numLoaded;
+	Atomic<int>& abortFlag;
+};
+
+bool ModulatorSampler::preloadSamplesInParallel(Array<StreamingSamplerSound*>& soundsToPreload, const int preloadSizeToUse, MainController::SampleManager::PreloadThreadData& data)
+{
+	auto& sampleManager = getMainController()->getSampleManager();
+	auto pool = sampleManager.getPreloadWorkerPool();
+
+	// Concurrent reads would only add seek time on a HDD
+	const bool useSingleBatch = sampleManager.isUsingHddMode();
+	const int numFileBatches = useSingleBatch ? 1 : pool->getNumThreads();
+
+	Atomic<int> numLoaded;
+	Atomic<int> abortFlag;
+
+	OwnedArray<PreloadBatchJob> jobs;
+	Array<PreloadBatchJob*> monolithJobs;
+	Array<StreamingSamplerSound*> fileSounds;
+
+	for (auto s : soundsToPreload)
+	{
+		jassert(s != nullptr);
+
+		const int channelIndex = s->isMonolithic() ? s->getMonolithChannelIndex() : -1;
+
+		if (channelIndex < 0 || useSingleBatch)
+		{
+			fileSounds.add(s);
+			continue;
+		}
+
+		// All sounds of a channel file share the same reader, so they must be loaded in the same batch
+		while (monolithJobs.size() <= channelIndex)
+			monolithJobs.add(nullptr);
+
+		if (monolithJobs[channelIndex] == nullptr)
+			monolithJobs.set(channelIndex, jobs.add(new PreloadBatchJob(preloadSizeToUse, numLoaded, abortFlag)));
+
+		monolithJobs[channelIndex]->sounds.add(s);
+	}
+
+	if (!fileSounds.isEmpty())
+	{
+		const int numBatches = jmin<int>(numFileBatches, fileSounds.size());
+
+		for (int i = 0; i < numBatches; i++)
+		{
+			auto job = jobs.add(new PreloadBatchJob(preloadSizeToUse, numLoaded, abortFlag));
+
+			const int start = (fileSounds.size() * i) / numBatches;
+			const int end = (fileSounds.size() * (i + 1)) / numBatches;
+
+			job->sounds.addArray(fileSounds, start, end - start);
+		}
+	}
+
+	PreloadBatchJob::MonolithOffsetSorter sorter;
+
+	for (auto job : jobs)
+	{
+		job->sounds.sort(sorter, true);
+		pool->addJob(job, false);
+	}
+
+	auto updateProgress = [&data, &numLoaded]()
+	{
+		data.samplesLoaded = numLoaded.get();
+
+		if (data.progress != nullptr)
+			*data.progress = (double)data.samplesLoaded / (double)jmax<int>(1, data.totalSamplesToLoad);
+	};
+
+	for (auto job : jobs)
+	{
+		while (!pool->waitForJobToFinish(job, 50))
+		{
+			updateProgress();
+
+			if (data.thread != nullptr && data.thread->threadShouldExit())
+				abortFlag.set(1);
+		}
+	}
+
+	updateProgress();
+
+	for (auto job : jobs)
+	{
+		if (job->errorMessage.isNotEmpty())
+		{
+			reportPreloadError(job->errorMessage);
+			return false;
+		}
+	}
+
+	return abortFlag.get() == 0;
 }
 
 } // namespace hise
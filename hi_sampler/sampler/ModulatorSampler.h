@@ -151,6 +151,7 @@ public:
 		Purged, 
 		Reversed,
         UseStaticMatrix,
+		InterpolationMode,
 		numModulatorSamplerParameters
 	};
 
@@ -232,7 +233,7 @@ public:
 	*	This is the actual loading process, so it is put into a seperate thread with a progress window. */
 	void refreshPreloadSizes();
 
-	/** Returns the time spent reading samples from disk. */
+	/** Returns the usage of the busiest streaming worker in percent (see SampleThreadPool::getWorkerStatistics()). */
 	double getDiskUsage();
 
 	/** Scans all sounds and voices and adds their memory usage. */
@@ -306,6 +307,18 @@ public:
 	void preVoiceRendering(int startSample, int numThisTime) override;
 	void soundsChanged() {};
 	bool soundCanBePlayed(ModulatorSynthSound *sound, int midiChannel, int midiNoteNumber, float velocity) override;;
+
+	/** Uses the sound index to find the sounds for the note on message (or checks every sound if the index is outdated). */
+	void collectSoundsToBeStarted(const HiseEvent &m) override;
+
+	/** Call this whenever a sound was added / removed or its key range, velocity range or RR group was changed.
+	*
+	*	The sampler will check every sound on note on until the index is rebuilt on the message thread.
+	*/
+	void soundMappingChanged();
+
+	/** Rebuilds the index that is used to find the sounds for a note on message. */
+	void refreshSoundIndex();
 	void handleRetriggeredNote(ModulatorSynthVoice *voice) override;
 
 	/** Overwrites the base class method and ignores the note off event if Parameters::OneShot is enabled. */
@@ -328,11 +341,22 @@ public:
 	void loadSampleMapFromIdAsync(const String& sampleMapId);
 	void loadSampleMapFromId(const String& sampleMapId);
 
-	/** This function will be called on a background thread and preloads all samples. */
+	/** This function will be called on a background thread and preloads all samples. 
+	*
+	*	The samples are preloaded in batches on the preload worker pool of the SampleManager (see preloadSamplesInParallel()).
+	*/
 	bool preloadAllSamples();
 
 	bool preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse);
 
+	/** Preloads the given sounds on the preload worker pool and waits until they are loaded.
+	*
+	*	Monolithic sounds share one reader per channel file, so they are preloaded in one batch per channel sorted 
+	*	by their monolith offset (which results in sequential reads). All other sounds are split into batches for 
+	*	every worker thread. It updates the progress of the PreloadThreadData and aborts if its thread should exit.
+	*/
+	bool preloadSamplesInParallel(Array<StreamingSamplerSound*>& soundsToPreload, const int preloadSizeToUse, MainController::SampleManager::PreloadThreadData& data);
+
 	void saveSampleMap() const;
 
 	void saveSampleMapAs();
@@ -538,6 +562,12 @@ public:
 
 	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer() { return &temporaryVoiceBuffer; }
 
+	/** Returns the temporary voice buffer for the given thread of the parallel rendering pool (0 is the audio thread). */
+	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer(int threadIndex);
+
+	/** Allocates a temporary voice buffer for each thread of the pool, so that the voices can be streamed concurrently. */
+	void setUseParallelVoiceRendering(bool shouldRenderInParallel) override;
+
 	bool checkAndLogIsSoftBypassed(DebugLogger::Location location) const;
 
 	void setHasPendingSampleLoad(bool hasSamplesPending)
@@ -560,8 +590,15 @@ public:
     
     bool isUsingStaticMatrix() const noexcept { return useStaticMatrix; };
 
+	/** Returns the interpolation algorithm that the voices use for resampling. */
+	StreamingResampler::InterpolationMode getInterpolationMode() const noexcept { return interpolationMode; }
+
 private:
 
+	struct PreloadBatchJob;
+
+	void reportPreloadError(const String& errorMessage);
+
 	bool isOnSampleLoadingThread() const
 	{
 		return getMainController()->getKillStateHandler().getCurrentThread() == MainController::KillStateHandler::SampleLoadingThread;
@@ -635,6 +672,62 @@ private:
 	};
 
 	SamplePropertyUpdater samplePropertyUpdater;
+
+	/** A lookup table for all sounds that are mapped to a key and velocity area.
+	*
+	*	The velocity range is split into 8 buckets and every cell contains the sound indexes sorted by their RR group
+	*	(and in descending order within one group, which is the order that the ModulatorSynth uses to start the voices).
+	*/
+	struct SoundIndex
+	{
+		enum
+		{
+			NumNotes = 128,
+			NumVelocityBuckets = 8,
+			VelocityBucketSize = 128 / NumVelocityBuckets
+		};
+
+		struct Entry
+		{
+			bool operator<(const Entry& other) const noexcept { return rrGroup < other.rrGroup; }
+
+			int rrGroup;
+			int soundIndex;
+		};
+
+		void build(const ReferenceCountedArray<SynthesiserSound>& soundsToIndex);
+
+		const Array<Entry>& getEntries(int noteNumber, int velocity) const noexcept
+		{
+			return cells[noteNumber * NumVelocityBuckets + velocity / VelocityBucketSize];
+		}
+
+		int version = -1;
+
+		Array<Entry> cells[NumNotes * NumVelocityBuckets];
+	};
+
+	struct SoundIndexUpdater : public AsyncUpdater,
+							   public Timer
+	{
+	public:
+
+		SoundIndexUpdater(ModulatorSampler *sampler_) :
+			sampler(sampler_)
+		{};
+
+		void timerCallback() override;
+
+		void handleAsyncUpdate() override;
+
+	private:
+
+		ModulatorSampler *sampler;
+	};
+
+	ScopedPointer<SoundIndex> soundIndex;
+	std::atomic<int> mappingVersion;
+	SoundIndexUpdater soundIndexUpdater;
     
 
     /** Sets the streaming buffer and preload buffer sizes. */
@@ -676,6 +769,8 @@ private:
 
 	bool useStaticMatrix = false;
 
+	StreamingResampler::InterpolationMode interpolationMode = StreamingResampler::InterpolationMode::Linear;
+
 	int64 memoryUsage;
 
 	OwnedArray<SampleLookupTable> crossfadeTables;
@@ -684,6 +779,11 @@ private:
 
 	hlac::HiseSampleBuffer temporaryVoiceBuffer;
 
+	void refreshParallelTemporaryVoiceBuffers();
+
+	// The temporary voice buffers for the worker threads of the parallel rendering pool
+	OwnedArray<hlac::HiseSampleBuffer> parallelTemporaryVoiceBuffers;
+
 	float groupGainValues[8];
 
 	ChannelData channelData[NUM_MIC_POSITIONS];
@@ -867,19 +867,77 @@ void MonolithExporter::exportCurrentSampleMap(bool overwriteExistingData, bool e
 
 	if (exportSamples)
 	{
-		for (int i = 0; i < numChannels; i++)
+		if (threadShouldExit())
 		{
-			if (threadShouldExit())
-			{
-				error = "Export aborted by user";
-				return;
-			}
-
-			writeFiles(i, overwriteExistingData);
+			error = "Export aborted by user";
+			return;
 		}
+
+		writeChannelFilesInParallel(overwriteExistingData);
 	}
 }
 
+struct MonolithExporter::ChannelExportJob : public ThreadPoolJob
+{
+	ChannelExportJob(MonolithExporter& parent_, int channelIndex_, bool overwriteExistingData_) :
+		ThreadPoolJob("Monolith channel export"),
+		parent(parent_),
+		channelIndex(channelIndex_),
+		overwriteExistingData(overwriteExistingData_)
+	{}
+
+	JobStatus runJob() override
+	{
+		parent.writeFiles(channelIndex, overwriteExistingData);
+		return jobHasFinished;
+	}
+
+	MonolithExporter& parent;
+	const int channelIndex;
+	const bool overwriteExistingData;
+};
+
+void MonolithExporter::writeChannelFilesInParallel(bool overwriteExistingData)
+{
+	const int numThreads = jmax<int>(1, SystemStats::getNumCpus());
+
+	compressionPreset = getComboBoxComponent("compressionOptions")->getSelectedItemIndex();
+	numSamplesWritten.set(0);
+
+	// The channel jobs are waiting for the block encoding jobs, so they can't share a pool
+	encodingPool = new ThreadPool(numThreads);
+	ThreadPool channelPool(jmin<int>(numChannels, numThreads));
+
+	OwnedArray<ChannelExportJob> jobs;
+
+	for (int i = 0; i < numChannels; i++)
+		channelPool.addJob(jobs.add(new ChannelExportJob(*this, i, overwriteExistingData)), false);
+
+	const double numSamplesTotal = (double)jmax<int>(1, numSamples * numChannels);
+
+	while (channelPool.getNumJobs() > 0)
+	{
+		setProgress((double)numSamplesWritten.get() / numSamplesTotal);
+		Thread::sleep(100);
+	}
+
+	for (auto job : jobs)
+		channelPool.waitForJobToFinish(job, -1);
+
+	encodingPool = nullptr;
+
+	if (threadShouldExit())
+		setExportError("Export aborted by user");
+}
+
+void MonolithExporter::setExportError(const String& newError)
+{
+	ScopedLock sl(errorLock);
+
+	if (error.isEmpty())
+		error = newError;
+}
+
 void MonolithExporter::writeSampleMapFile(bool /*overwriteExistingFile*/)
 {
 	ScopedPointer<XmlElement> xml = v.createXml();
@@ -920,6 +978,55 @@ void MonolithExporter::checkSanity()
 	}
 }
 
+/** Does the same as AudioFormatWriter::writeFromAudioReader(), but uses chunks that are a multiple of the HLAC block size
+*	so that the blocks of each chunk can be encoded in parallel. The chunk borders fall on block borders, so the encoded
+*	data is the same as with the default chunk size.
+*/
+static bool writeFromReaderInBlockChunks(AudioFormatWriter& writer, AudioFormatReader& reader)
+{
+	jassert(writer.isFloatingPoint());
+
+	const int bufferSize = COMPRESSION_BLOCK_SIZE * 32;
+
+	AudioSampleBuffer tempBuffer((int)writer.getNumChannels(), bufferSize);
+
+	int* buffers[128] = { 0 };
+
+	for (int i = tempBuffer.getNumChannels(); --i >= 0;)
+		buffers[i] = reinterpret_cast<int*>(tempBuffer.getWritePointer(i, 0));
+
+	int64 numSamplesToRead = reader.lengthInSamples;
+	int64 startSample = 0;
+
+	while (numSamplesToRead > 0)
+	{
+		const int numToDo = (int)jmin<int64>(numSamplesToRead, (int64)bufferSize);
+
+		if (!reader.read(buffers, (int)writer.getNumChannels(), startSample, numToDo, false))
+			return false;
+
+		if (!reader.usesFloatingPointData)
+		{
+			int** bufferChan = buffers;
+
+			while (*bufferChan != nullptr)
+			{
+				void* const b = *bufferChan++;
+
+				FloatVectorOperations::convertFixedToFloat((float*)b, (int*)b, 1.0f / 0x7fffffff, numToDo);
+			}
+		}
+
+		if (!writer.write(const_cast<const int**>(buffers), numToDo))
+			return false;
+
+		numSamplesToRead -= numToDo;
+		startSample += numToDo;
+	}
+
+	return true;
+}
+
 void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 {
 	AudioFormatManager afm;
@@ -929,13 +1036,14 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 	Array<File>* channelList = filesToWrite[channelIndex];
 
 	bool isMono = false;
+	double channelSampleRate = 0.0;
 
 	if (channelList->size() > 0)
 	{
 		ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(channelList->getUnchecked(0));
 
 		isMono = reader->numChannels == 1;
-		sampleRate = reader->sampleRate;
+		channelSampleRate = reader->sampleRate;
 	}
 
 	String channelFileName = sampleMap->getId().toString().replace("/", "_") + ".ch" + String(channelIndex + 1);
@@ -952,29 +1060,38 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		FileOutputStream* hlacOutput = new FileOutputStream(outputFile);
 
-		int cIndex = getComboBoxComponent("compressionOptions")->getSelectedItemIndex();
-
-		hlac::HlacEncoder::CompressorOptions options = hlac::HlacEncoder::CompressorOptions::getPreset((hlac::HlacEncoder::CompressorOptions::Presets)cIndex);
+		hlac::HlacEncoder::CompressorOptions options = hlac::HlacEncoder::CompressorOptions::getPreset((hlac::HlacEncoder::CompressorOptions::Presets)compressionPreset);
 
 		StringPairArray empty;
 
-		ScopedPointer<AudioFormatWriter> writer = hlac.createWriterFor(hlacOutput, sampleRate, isMono ? 1 : 2, 16, empty, 5);
+		ScopedPointer<AudioFormatWriter> writer = hlac.createWriterFor(hlacOutput, channelSampleRate, isMono ? 1 : 2, 16, empty, 5);
+
+		auto hlacWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get());
 
-		dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get())->setOptions(options);
+		hlacWriter->setOptions(options);
+		hlacWriter->setThreadPool(encodingPool);
 
 		for (int i = 0; i < channelList->size(); i++)
 		{
-			setProgress((double)i / (double)numSamples);
+			if (threadShouldExit())
+			{
+				writer->flush();
+				writer = nullptr;
+
+				return;
+			}
 
 			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(channelList->getUnchecked(i));
 
 			if (reader != nullptr)
 			{
-				writer->writeFromAudioReader(*reader, 0, -1);
+				writeFromReaderInBlockChunks(*writer, *reader);
+
+				++numSamplesWritten;
 			}
 			else
 			{
-				error = "Could not read the source file " + channelList->getUnchecked(i).getFullPathName();
+				setExportError("Could not read the source file " + channelList->getUnchecked(i).getFullPathName());
 				writer->flush();
 				writer = nullptr;
 
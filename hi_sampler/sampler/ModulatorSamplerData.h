@@ -338,11 +338,23 @@ private:
 	void checkSanity();
 
 
+	struct ChannelExportJob;
+
 	/** Writes the files and updates the samplemap with the information. */
 	void writeFiles(int channelIndex, bool overwriteExistingData);
 
+	/** Writes all channel files concurrently and updates the progress until they are finished. */
+	void writeChannelFilesInParallel(bool overwriteExistingData);
+
+	void setExportError(const String& newError);
+
 	void updateSampleMap();
 
+	ScopedPointer<ThreadPool> encodingPool;
+	CriticalSection errorLock;
+	Atomic<int> numSamplesWritten;
+	int compressionPreset = 0;
+
 	int64 largestSample;
 
 	ScopedPointer<FilenameComponent> fc;
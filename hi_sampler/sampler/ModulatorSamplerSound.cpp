@@ -419,6 +419,17 @@ void ModulatorSamplerSound::setMaxRRGroupIndex(int newGroupLimit)
 	// rrGroup = jmin(rrGroup, newGroupLimit);
 }
 
+void ModulatorSamplerSound::setOwnerSampler(ModulatorSampler* s)
+{
+	ownerSampler = s;
+}
+
+void ModulatorSamplerSound::mappingChanged()
+{
+	if (auto sampler = static_cast<ModulatorSampler*>(ownerSampler.get()))
+		sampler->soundMappingChanged();
+}
+
 void ModulatorSamplerSound::setMappingData(MappingData newData)
 {
 	rootNote = newData.rootNote;
@@ -428,6 +439,8 @@ void ModulatorSamplerSound::setMappingData(MappingData newData)
 	midiNotes.setRange(newData.loKey, newData.hiKey - newData.loKey + 1, true);
 	rrGroup = newData.rrGroup;
 
+	mappingChanged();
+
 	setProperty(SampleStart, newData.sampleStart, dontSendNotification);
 	setProperty(SampleEnd, newData.sampleEnd, dontSendNotification);
 	setProperty(SampleStartMod, newData.sampleStartMod, dontSendNotification);
@@ -660,6 +673,8 @@ void ModulatorSamplerSound::setPropertyInternal(Property p, int newValue)
 	default:			jassertfalse; break;
 	}
 
+	if (p >= KeyHigh && p <= RRGroup)
+		mappingChanged();
 }
 
 void ModulatorSamplerSound::setPreloadPropertyInternal(Property p, int newValue)
@@ -727,6 +742,14 @@ asyncCleaner(*this)
 	
 }
 
+ModulatorSamplerSoundPool::~ModulatorSamplerSoundPool()
+{
+#if HISE_SHARE_SAMPLE_DATA
+	for (auto info : loadedMonoliths)
+		sharedSampleData->releaseMonolithInfo(info);
+#endif
+}
+
 void ModulatorSamplerSoundPool::setDebugProcessor(Processor *p)
 {
 	debugProcessor = p;
@@ -752,29 +775,45 @@ bool ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, c
 
 	clearUnreferencedMonoliths();
 	
-	loadedMonoliths.add(new MonolithInfoToUse(monolithicFiles));
+	ReferenceCountedObjectPtr<MonolithInfoToUse> hmaf;
 
-	MonolithInfoToUse* hmaf = loadedMonoliths.getLast();
+#if HISE_SHARE_SAMPLE_DATA
+	const int64 monolithKey = SharedSampleDataStore::createMonolithKey(monolithicFiles, sampleMap);
 
-	try
-	{
-		hmaf->fillMetadataInfo(sampleMap);
-	}
-	catch (StreamingSamplerSound::LoadingError l)
+	// Another instance might have already mapped these files
+	hmaf = sharedSampleData->acquireMonolithInfo(monolithKey);
+#endif
+
+	if (hmaf == nullptr)
 	{
-		String x;
-		x << "Error at loading sample " << l.fileName << ": " << l.errorDescription;
-		mc->getDebugLogger().logMessage(x);
+		hmaf = new MonolithInfoToUse(monolithicFiles);
+
+		try
+		{
+			hmaf->fillMetadataInfo(sampleMap);
+		}
+		catch (StreamingSamplerSound::LoadingError l)
+		{
+			String x;
+			x << "Error at loading sample " << l.fileName << ": " << l.errorDescription;
+			mc->getDebugLogger().logMessage(x);
 
 #if USE_FRONTEND
-		mc->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+			mc->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
 #else
-		debugError(mc->getMainSynthChain(), x);
+			debugError(mc->getMainSynthChain(), x);
 #endif
 
-		return false;
+			return false;
+		}
+
+#if HISE_SHARE_SAMPLE_DATA
+		hmaf = sharedSampleData->addMonolithInfo(monolithKey, hmaf);
+#endif
 	}
 
+	loadedMonoliths.add(hmaf);
+
 	for (int i = 0; i < sampleMap.getNumChildren(); i++)
 	{
 		ValueTree sample = sampleMap.getChild(i);
@@ -783,7 +822,7 @@ bool ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, c
 		{
 			String fileName = sample.getProperty("FileName").toString().fromFirstOccurrenceOf("{PROJECT_FOLDER}", false, false);
 			StreamingSamplerSound* sound = new StreamingSamplerSound(hmaf, 0, i);
-			pool.add(sound);
+			addToPool(sound);
 			sounds.add(new ModulatorSamplerSound(mc, sound, i));
 		}
 		else
@@ -793,7 +832,7 @@ bool ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, c
 			for (int j = 0; j < sample.getNumChildren(); j++)
 			{
 				StreamingSamplerSound* sound = new StreamingSamplerSound(hmaf, j, i);
-				pool.add(sound);
+				addToPool(sound);
 				multiMicArray.add(sound);
 			}
 
@@ -826,9 +865,31 @@ void ModulatorSamplerSoundPool::clearUnreferencedSamplesInternal()
 	}
 
 	pool.swapWith(currentList);
+	rebuildPoolIndex();
+
+#if HISE_SHARE_SAMPLE_DATA
+	sharedSampleData->clearUnusedData();
+#endif
+
 	if (updatePool) sendChangeMessage();
 }
 
+void ModulatorSamplerSoundPool::rebuildPoolIndex()
+{
+	poolIndex.clear();
+
+	for (int i = 0; i < pool.size(); i++)
+	{
+		if (auto s = pool[i].get())
+		{
+			const int64 hash = s->getHashCode();
+
+			if (!poolIndex.contains(hash))
+				poolIndex.set(hash, i);
+		}
+	}
+}
+
 
 
 int ModulatorSamplerSoundPool::getNumSoundsInPool() const noexcept
@@ -997,6 +1058,7 @@ public:
 			PresetHandler::showMessageWindow("Error", errorMessage, PresetHandler::IconType::Error);
 		}
 
+		pool->rebuildPoolIndex();
 		pool->setUpdatePool(true);
 		pool->sendChangeMessage();
 	}
@@ -1146,9 +1208,9 @@ void ModulatorSamplerSoundPool::decreaseNumOpenFileHandles()
 	if(updatePool) sendChangeMessage();
 }
 
-bool ModulatorSamplerSoundPool::isFileBeingUsed(int poolIndex)
+bool ModulatorSamplerSoundPool::isFileBeingUsed(int indexInPool)
 {
-	if (auto s = pool[poolIndex])
+	if (auto s = pool[indexInPool])
 	{
 		return s->isOpened();
 	}
@@ -1160,22 +1222,43 @@ int ModulatorSamplerSoundPool::getSoundIndexFromPool(int64 hashCode, int64 other
 {
 	if (!searchPool) return -1;
 
-	for (int i = 0; i < pool.size(); i++)
-	{
-		StreamingSamplerSound::Ptr s = pool[i].get();
-		
-		if (s == nullptr)
-			return -1;
+	const int index = getPoolIndexForHash(hashCode);
+
+	if (index != -1 || otherPossibleHashCode == -1)
+		return index;
+
+	return getPoolIndexForHash(otherPossibleHashCode);
+}
+
+int ModulatorSamplerSoundPool::getPoolIndexForHash(int64 hashCode)
+{
+	if (!poolIndex.contains(hashCode))
+		return -1;
 
-		if (s->getHashCode() == hashCode) return i;
+	const int index = poolIndex[hashCode];
 
-		if (otherPossibleHashCode != -1 && s->getHashCode() == otherPossibleHashCode)
-			return i;
+	if (auto s = pool[index].get())
+	{
+		if (s->getHashCode() == hashCode)
+			return index;
 	}
 
+	// The sound was deleted or its file reference has changed
+	poolIndex.remove(hashCode);
 	return -1;
 }
 
+void ModulatorSamplerSoundPool::addToPool(StreamingSamplerSound* s)
+{
+	const int64 hash = s->getHashCode();
+
+	// Keep the first sound with this hash (like the linear search did), unless it was deleted
+	if (getPoolIndexForHash(hash) == -1)
+		poolIndex.set(hash, pool.size());
+
+	pool.add(s);
+}
+
 ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithSingleMic(const ValueTree &soundDescription, int index, bool forceReuse /*= false*/)
 {
 	String fileNameWildcard = soundDescription.getProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName));
@@ -1226,7 +1309,7 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithSingleMic(const V
         
 		StreamingSamplerSound::Ptr s = new StreamingSamplerSound(fileName, this);
 
-		pool.add(s.get());
+		addToPool(s.get());
 
 		if(updatePool) sendChangeMessage();
 
@@ -1279,7 +1362,7 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 					StreamingSamplerSound::Ptr s = new StreamingSamplerSound(fileName, this);
 
 					multiMicArray.add(s);
-					pool.add(s.get());
+					addToPool(s.get());
 					continue;
 				}
             }
@@ -1288,7 +1371,7 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 				StreamingSamplerSound::Ptr s = new StreamingSamplerSound(fileName, this);
 
 				multiMicArray.add(s);
-				pool.add(s.get());
+				addToPool(s.get());
 			}
 		}
 	}
@@ -1307,8 +1390,21 @@ void ModulatorSamplerSoundPool::clearUnreferencedMonoliths()
 {
 	for (int i = 0; i < loadedMonoliths.size(); i++)
 	{
-		if (loadedMonoliths[i]->getReferenceCount() == 2)
+		auto info = loadedMonoliths.getObjectPointerUnchecked(i);
+
+#if HISE_SHARE_SAMPLE_DATA
+		// The store and the registered pools (including this one) keep a reference to a shared info
+		const int numUnusedReferences = jmax(1, sharedSampleData->getNumPoolReferences(info));
+#else
+		const int numUnusedReferences = 1;
+#endif
+
+		if (info->getReferenceCount() == numUnusedReferences)
 		{
+#if HISE_SHARE_SAMPLE_DATA
+			sharedSampleData->releaseMonolithInfo(info);
+#endif
+
 			loadedMonoliths.remove(i--);
 		}
 	}
@@ -280,7 +280,7 @@ public:
 	// ====================================================================================================================
 
 	void setMaxRRGroupIndex(int newGroupLimit);
-	void setRRGroup(int newGroupIndex) noexcept{ rrGroup = jmin(newGroupIndex, maxRRGroup); };
+	void setRRGroup(int newGroupIndex) noexcept{ rrGroup = jmin(newGroupIndex, maxRRGroup); mappingChanged(); };
 	int getRRGroup() const;
 
 	// ====================================================================================================================
@@ -290,6 +290,9 @@ public:
 	bool appliesToChannel(int /*midiChannel*/) override { return true; };
 	bool appliesToRRGroup(int group) const noexcept{ return rrGroup == group; };
 
+	/** Sets the sampler that will be notified when the key / velocity range or the RR group changes. */
+	void setOwnerSampler(ModulatorSampler* s);
+
 	// ====================================================================================================================
 
 	StreamingSamplerSound::Ptr getReferenceToSound() const { return firstSound.get(); };
@@ -406,6 +409,11 @@ private:
 	// ================================================================================================================
 
 	friend class MultimicMergeDialogWindow;
+
+	/** Tells the sampler that its note on index is outdated. */
+	void mappingChanged();
+
+	WeakReference<Processor> ownerSampler;
 	
 	const CriticalSection& getLock() const { return firstSound.get()->getSampleLock(); };
 	
@@ -469,7 +477,7 @@ public:
 	// ================================================================================================================
 
 	ModulatorSamplerSoundPool(MainController *mc);
-	~ModulatorSamplerSoundPool() {}
+	~ModulatorSamplerSoundPool();
 
 	// ================================================================================================================
 
@@ -529,7 +537,7 @@ public:
 
 	void decreaseNumOpenFileHandles() override;
 
-	bool isFileBeingUsed(int poolIndex);
+	bool isFileBeingUsed(int indexInPool);
 
 	bool &getPreloadLockFlag()
 	{
@@ -546,6 +554,9 @@ public:
 
 	void clearUnreferencedSamples();
 
+	/** Recreates the hash index of the pool. Call this if the file reference of a sound in the pool was changed. */
+	void rebuildPoolIndex();
+
 private:
 
 	void clearUnreferencedSamplesInternal();
@@ -584,8 +595,18 @@ private:
 
 	ReferenceCountedArray<MonolithInfoToUse> loadedMonoliths;
 
+#if HISE_SHARE_SAMPLE_DATA
+	SharedResourcePointer<SharedSampleDataStore> sharedSampleData;
+#endif
+
 	int getSoundIndexFromPool(int64 hashCode, int64 otherPossibleHashCode);
 
+	/** Returns the pool index of the sound with the given hash code or -1 if it's not in the pool (or was deleted). */
+	int getPoolIndexForHash(int64 hashCode);
+
+	/** Adds the sound to the pool and the hash index. */
+	void addToPool(StreamingSamplerSound* s);
+
 	ModulatorSamplerSound *addSoundWithSingleMic(const ValueTree &soundDescription, int index, bool forceReuse = false);
 	ModulatorSamplerSound *addSoundWithMultiMic(const ValueTree &soundDescription, int index, bool forceReuse = false);
 	
@@ -598,6 +619,9 @@ private:
 
 	WeakStreamingSamplerSoundArray pool;
 
+	/** Maps the hash code of the sounds (the file path or the monolith sample name) to their index in the pool. */
+	HashMap<int64, int> poolIndex;
+
 	bool isCurrentlyLoading;
 	bool forcePoolSearch;
     bool updatePool;
@@ -75,6 +75,7 @@ void ModulatorSamplerVoice::startNote(int midiNoteNumber,
 
 	wrappedVoice.setPitchFactor(midiNoteNumber, samePitch ? midiNoteNumber : currentlyPlayingSamplerSound->getRootNote(), sound, getOwnerSynth()->getMainController()->getGlobalPitchFactor());
 	wrappedVoice.setSampleStartModValue(sampleStartModulationDelta);
+	wrappedVoice.setInterpolationMode(static_cast<ModulatorSampler*>(getOwnerSynth())->getInterpolationMode());
 	wrappedVoice.startNote(midiNoteNumber, velocity, sound, -1);
 
 	voiceUptime = wrappedVoice.voiceUptime;
@@ -95,35 +96,49 @@ void ModulatorSamplerVoice::stopNote(float velocity, bool allowTailoff)
 }
 
 void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
+{
+	ADD_GLITCH_DETECTOR(getOwnerSynth(), DebugLogger::Location::SampleRendering);
+
+	prepareParallelBlock(startSample, numSamples);
+	renderParallelBlock(startSample, numSamples, 0);
+	finishParallelBlock(startSample, numSamples);
+}
+
+void ModulatorSamplerVoice::prepareParallelBlock(int startSample, int numSamples)
 {
     const StreamingSamplerSound *sound = wrappedVoice.getLoadedSound();
     jassert(sound != nullptr);
  
 	CHECK_AND_LOG_ASSERTION(getOwnerSynth(), DebugLogger::Location::SampleRendering, sound != nullptr, 1);
-
-	ADD_GLITCH_DETECTOR(getOwnerSynth(), DebugLogger::Location::SampleRendering);
  
 	ignoreUnused(sound);
 
-	const int startIndex = startSample;
-	const int samplesInBlock = numSamples;
-
 	float *voicePitchValues = isPitchModulationActive() ? getVoicePitchValues() : nullptr;
 	const double propertyPitch = currentlyPlayingSamplerSound->getPropertyPitch();
 	
 	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta * propertyPitch, startSample, numSamples);
 	
-	const float *modValues = getVoiceGainValues(startSample, numSamples);
+	voiceGainValues = getVoiceGainValues(startSample, numSamples);
 
 	wrappedVoice.setPitchCounterForThisBlock(pitchCounter);
 	wrappedVoice.setPitchValues(voicePitchValues);
 	wrappedVoice.setDynamicPitchFactor(propertyPitch);
 
 	voiceBuffer.clear();
+}
 
-	
-
+void ModulatorSamplerVoice::renderParallelBlock(int startSample, int numSamples, int threadIndex)
+{
+	wrappedVoice.setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer(threadIndex));
 	wrappedVoice.renderNextBlock(voiceBuffer, startSample, numSamples);
+}
+
+void ModulatorSamplerVoice::finishParallelBlock(int startSample, int numSamples)
+{
+	const int startIndex = startSample;
+	const int samplesInBlock = numSamples;
+
+	const float *modValues = voiceGainValues;
 
 	CHECK_AND_LOG_BUFFER_DATA(getOwnerSynth(), DebugLogger::Location::SampleRendering, voiceBuffer.getReadPointer(0, startSample), true, samplesInBlock);
 	CHECK_AND_LOG_BUFFER_DATA(getOwnerSynth(), DebugLogger::Location::SampleRendering, voiceBuffer.getReadPointer(1, startSample), false, samplesInBlock);
@@ -137,9 +152,6 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesInBlock);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesInBlock);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesInBlock);
-
 	const float propertyGain = currentlyPlayingSamplerSound->getPropertyVolume();
 	const float normalizationGain = currentlyPlayingSamplerSound->getNormalizedPeak();
 	const float lGain = currentlyPlayingSamplerSound->getBalance(false);
@@ -147,21 +159,14 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 	const float totalL = propertyGain * normalizationGain * lGain * velocityXFadeValue;
 	const float totalR = propertyGain * normalizationGain * rGain * velocityXFadeValue;
 
-	if (totalL != 1.0f) FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), totalL, samplesInBlock);
-	if (totalR != 1.0f) FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), totalR, samplesInBlock);
+	const float *crossFadeValues = sampler->isUsingCrossfadeGroups() ? getCrossfadeModulationValues(startSample, numSamples) : nullptr;
 
-	if (sampler->isUsingCrossfadeGroups())
-	{
-		const float *crossFadeValues = getCrossfadeModulationValues(startSample, numSamples);
-
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), crossFadeValues + startIndex, samplesInBlock);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), crossFadeValues + startIndex, samplesInBlock);
-	}
+	applyGainStage(modValues, crossFadeValues, totalL, totalR, startIndex, samplesInBlock);
 
 #if USE_BACKEND
 	if (sampler->isLastStartedVoice(this))
 	{
-		handlePlaybackPosition(sound);
+		handlePlaybackPosition(wrappedVoice.getLoadedSound());
 	}
 #endif
 }
@@ -335,6 +340,7 @@ void MultiMicModulatorSamplerVoice::startNote(int midiNoteNumber, float velocity
 
 		voiceToUse->setPitchFactor(midiNoteNumber, rootNote, sound, globalPitchFactor);
 		voiceToUse->setSampleStartModValue(sampleStartModulationDelta);
+		voiceToUse->setInterpolationMode(sampler->getInterpolationMode());
 		voiceToUse->startNote(midiNoteNumber, velocity, sound, -1);
 
 		voiceUptime = wrappedVoices[i]->voiceUptime;
@@ -347,26 +353,42 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 {
 	ADD_GLITCH_DETECTOR(getOwnerSynth(), DebugLogger::Location::MultiMicSampleRendering);
 
-	const int startIndex = startSample;
-	const int samplesInBlock = numSamples;
+	prepareParallelBlock(startSample, numSamples);
+	renderParallelBlock(startSample, numSamples, 0);
+	finishParallelBlock(startSample, numSamples);
+}
 
+void MultiMicModulatorSamplerVoice::prepareParallelBlock(int startSample, int numSamples)
+{
 	float *voicePitchValues = isPitchModulationActive() ? getVoicePitchValues() : nullptr;
 	const double propertyPitch = (float)currentlyPlayingSamplerSound->getPropertyPitch();
 	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta * propertyPitch, startSample, numSamples);
 
-	const float *modValues = getVoiceGainValues(startSample, numSamples);
+	voiceGainValues = getVoiceGainValues(startSample, numSamples);
 
 	voiceBuffer.clear();
 
 	for (int i = 0; i < wrappedVoices.size(); i++)
 	{
-		const StreamingSamplerSound *sound = wrappedVoices[i]->getLoadedSound();
-
-		if (sound == nullptr) continue;
+		if (wrappedVoices[i]->getLoadedSound() == nullptr) continue;
 
 		wrappedVoices[i]->setPitchValues(voicePitchValues);
 		wrappedVoices[i]->setPitchCounterForThisBlock(pitchCounter);
 		wrappedVoices[i]->uptimeDelta = uptimeDelta * propertyPitch;
+	}
+
+	micPositionStopped = false;
+}
+
+void MultiMicModulatorSamplerVoice::renderParallelBlock(int startSample, int numSamples, int threadIndex)
+{
+	auto tempVoiceBuffer = sampler->getTemporaryVoiceBuffer(threadIndex);
+
+	for (int i = 0; i < wrappedVoices.size(); i++)
+	{
+		const StreamingSamplerSound *sound = wrappedVoices[i]->getLoadedSound();
+
+		if (sound == nullptr) continue;
 
 		float *leftChannel = voiceBuffer.getWritePointer(2*i);
 		float *rightChannel = voiceBuffer.getWritePointer(2*i + 1);
@@ -374,15 +396,31 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 
 		AudioSampleBuffer channelBuffer(channels, 2, voiceBuffer.getNumSamples());
 
+		wrappedVoices[i]->setTemporaryVoiceBuffer(tempVoiceBuffer);
 		wrappedVoices[i]->renderNextBlock(channelBuffer, startSample, numSamples);
 
 		voiceUptime = wrappedVoices[i]->voiceUptime;
 
+		// The voice will be reset in finishParallelBlock(), which stops the remaining mic positions too.
 		if (!wrappedVoices[i]->isActive)
 		{
-			resetVoice();
+			micPositionStopped = true;
+			break;
 		}
 	}
+}
+
+void MultiMicModulatorSamplerVoice::finishParallelBlock(int startSample, int numSamples)
+{
+	const int startIndex = startSample;
+	const int samplesInBlock = numSamples;
+
+	const float *modValues = voiceGainValues;
+
+	if (micPositionStopped)
+	{
+		resetVoice();
+	}
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesInBlock);
 	
@@ -395,32 +433,10 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 	const float lSum = propertyGain * normalizationGain * lGain * velocityXFadeValue;
 	const float rSum = propertyGain * normalizationGain * rGain * velocityXFadeValue;
 
-	
-
-	for (int i = 0; i < wrappedVoices.size(); i++)
-	{
-		if (wrappedVoices[i]->getLoadedSound() == nullptr) continue;
-
-		// Apply Modulation
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), modValues + startIndex, samplesInBlock);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), modValues + startIndex, samplesInBlock);
+	const float *crossFadeValues = sampler->isUsingCrossfadeGroups() ? getCrossfadeModulationValues(startSample, numSamples) : nullptr;
 
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), lSum, samplesInBlock);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), rSum, samplesInBlock);
-	}
-
-	if (sampler->isUsingCrossfadeGroups())
-	{
-		const float *crossFadeValues = getCrossfadeModulationValues(startSample, numSamples);
-
-		for (int i = 0; i < wrappedVoices.size(); i++)
-		{
-			if (wrappedVoices[i]->getLoadedSound() == nullptr) continue;
-
-			FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2 * i, startIndex), crossFadeValues + startIndex, samplesInBlock);
-			FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2 * i + 1, startIndex), crossFadeValues + startIndex, samplesInBlock);
-		}
-	}
+	// The channels of the unloaded mic positions are silent, so they can be processed too
+	applyGainStage(modValues, crossFadeValues, lSum, rSum, startIndex, samplesInBlock);
 
 	if (sampler->isLastStartedVoice(this))
 	{
@@ -61,6 +61,12 @@ public:
 	void calculateBlock(int startSample, int numSamples) override;
 	void resetVoice() override;
 
+	// ================================================================================================================
+
+	void prepareParallelBlock(int startSample, int numSamples) override;
+	void renderParallelBlock(int startSample, int numSamples, int threadIndex) override;
+	void finishParallelBlock(int startSample, int numSamples) override;
+
 	void handlePlaybackPosition(const StreamingSamplerSound * sound);
 
 	static double limitPitchDataToMaxSamplerPitch(float * pitchData, double uptimeDelta, int startSample, int numSamples);
@@ -99,6 +105,10 @@ protected:
 	float velocityXFadeValue;
 	float sampleStartModValue;
 
+	// The gain modulation values calculated in prepareParallelBlock(). This points into the voice row of the gain chain,
+	// which is not overwritten by other voices because the chain has one row per voice when the voices render in parallel.
+	const float* voiceGainValues = nullptr;
+
 	// ================================================================================================================
 
 private:
@@ -132,6 +142,10 @@ public:
 	void calculateBlock(int startSample, int numSamples) override;
 	void prepareToPlay(double sampleRate, int samplesPerBlock);
 
+	void prepareParallelBlock(int startSample, int numSamples) override;
+	void renderParallelBlock(int startSample, int numSamples, int threadIndex) override;
+	void finishParallelBlock(int startSample, int numSamples) override;
+
 	// ================================================================================================================
 
 	void setLoaderBufferSize(int newBufferSize) override;
@@ -148,6 +162,9 @@ private:
 
 	OwnedArray<StreamingSamplerVoice> wrappedVoices;
 
+	// Set by renderParallelBlock() if one of the mic positions ran out of samples
+	bool micPositionStopped = false;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultiMicModulatorSamplerVoice)
 };
 
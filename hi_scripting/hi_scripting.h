@@ -90,6 +90,7 @@ END_JUCE_MODULE_DECLARATION
 #include "scripting/engine/HiseJavascriptEngine.h"
 
 #include "scripting/api/XmlApi.h"
+#include "scripting/api/ScriptDrawActions.h"
 #include "scripting/api/ScriptingApiObjects.h"
 #include "scripting/api/ScriptingApi.h"
 #include "scripting/api/ScriptingApiContent.h"
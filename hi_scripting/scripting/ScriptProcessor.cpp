@@ -549,10 +549,8 @@ void JavascriptProcessor::clearExternalWindows()
 	}
 }
 
-JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
+void JavascriptProcessor::storeContentBeforeCompilation()
 {
-	
-
 	ProcessorWithScriptingContent* thisAsScriptBaseProcessor = dynamic_cast<ProcessorWithScriptingContent*>(this);
 
 	ScriptingApi::Content* content = thisAsScriptBaseProcessor->getScriptingContent();
@@ -562,23 +560,95 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 	if (saveThisContent) 
 		thisAsScriptBaseProcessor->restoredContentValues = content->exportAsValueTree();
 
+	mainController->getScriptComponentEditBroadcaster()->clearSelection(sendNotification);
+}
+
+void JavascriptProcessor::resetEngineForCompilation()
+{
+	scriptEngine->clearDebugInformation();
+
+	dynamic_cast<ProcessorWithScriptingContent*>(this)->getScriptingContent()->beginInitialization();
+
+	setupApi();
+}
+
+void JavascriptProcessor::prepareCompilation()
+{
+	jassert(compilationState == CompilationState::Idle);
+
+	storeContentBeforeCompilation();
+
 	auto thisAsProcessor = dynamic_cast<Processor*>(this);
 
-	thisAsProcessor->getMainController()->getScriptComponentEditBroadcaster()->clearSelection(sendNotification);
+	ScopedLock callbackLock(thisAsProcessor->isOnAir() ? mainController->getLock() : thisAsProcessor->getDummyLockWhenNotOnAir());
+	ScopedWriteLock sl(mainController->getCompileLock());
+
+	resetEngineForCompilation();
+
+	compilationState = CompilationState::EnginePrepared;
+
+	preparedOnInitCode = String();
+
+#if ENABLE_SCRIPTING_BREAKPOINTS
+	// The breakpoints are passed to the parser for each callback in compileInternal()
+	if (!breakpoints.isEmpty())
+		return;
+#endif
+
+	const static Identifier onInit("onInit");
+
+	// The parsed code must be the first one that is executed in compileInternal()
+	auto onInitSnippet = getNumSnippets() > 0 ? getSnippet(0) : nullptr;
+
+	if (onInitSnippet != nullptr && onInitSnippet->getCallbackName() == onInit)
+	{
+		onInitSnippet->checkIfScriptActive();
+
+		if (!onInitSnippet->isSnippetEmpty())
+			preparedOnInitCode = onInitSnippet->getSnippetAsFunction();
+	}
+}
+
+bool JavascriptProcessor::parseOnInitCallback()
+{
+	jassert(compilationState == CompilationState::EnginePrepared);
+
+	if (preparedOnInitCode.isEmpty())
+		return true;
+
+	return scriptEngine->preparse(preparedOnInitCode, true);
+}
+
+void JavascriptProcessor::discardParsedOnInitCallback()
+{
+	preparedOnInitCode = String();
+
+	if (compilationState == CompilationState::EnginePrepared)
+		compilationState = CompilationState::ContentStored;
+}
+
+JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
+{
+	ProcessorWithScriptingContent* thisAsScriptBaseProcessor = dynamic_cast<ProcessorWithScriptingContent*>(this);
+
+	if (compilationState == CompilationState::Idle)
+		storeContentBeforeCompilation();
+
+	auto thisAsProcessor = dynamic_cast<Processor*>(this);
 
     ScopedLock callbackLock(thisAsProcessor->isOnAir() ? mainController->getLock() : thisAsProcessor->getDummyLockWhenNotOnAir());
 
     
 	ScopedWriteLock sl(mainController->getCompileLock());
     
+	// The engine might have been created by prepareCompilation() (with the onInit callback already parsed)
+	if (compilationState != CompilationState::EnginePrepared)
+		resetEngineForCompilation();
 
-	scriptEngine->clearDebugInformation();
-
-	content->beginInitialization();
-
-	setupApi();
+	compilationState = CompilationState::Idle;
+	preparedOnInitCode = String();
 
-	content = thisAsScriptBaseProcessor->getScriptingContent();
+	ScriptingApi::Content* content = thisAsScriptBaseProcessor->getScriptingContent();
 
 	
     scriptEngine->setIsInitialising(true);
@@ -693,6 +763,20 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileScript()
 		result = compileInternal();
 	}
 
+	finishCompilation(result);
+
+	return result;
+}
+
+JavascriptProcessor::SnippetResult JavascriptProcessor::compilePreparedScript()
+{
+	jassert(compilationState != CompilationState::Idle);
+
+	return compileInternal();
+}
+
+void JavascriptProcessor::finishCompilation(const SnippetResult& result)
+{
 	if (lastCompileWasOK)
 	{
 		String x;
@@ -722,8 +806,6 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileScript()
 	}
 
 	mainController->sendScriptCompileMessage(this);
-
-	return result;
 }
 
 
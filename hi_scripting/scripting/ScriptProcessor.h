@@ -384,6 +384,35 @@ public:
 
 	SnippetResult compileScript();
 
+	/** Creates the engine for the next compileScript() call, so that the onInit callback can be parsed in advance.
+	*
+	*	This is used by ModulatorSynthChain::compileAllScripts() to parse the scripts on multiple threads. Call this
+	*	on the thread that will compile the script, then parseOnInitCallback() (on any thread) and then 
+	*	compilePreparedScript() and finishCompilation().
+	*
+	*	The prepared engine must not be used by the audio thread, so hold the lock of the MainController (if the 
+	*	processor is on air) and the compile lock until compilePreparedScript() has returned.
+	*/
+	void prepareCompilation();
+
+	/** Parses the onInit callback into the prepared engine. 
+	*
+	*	Returns false if the script declares global variables and must be parsed in order with the other scripts.
+	*/
+	bool parseOnInitCallback();
+
+	/** Throws away the parsed onInit callback, so that compilePreparedScript() creates a new engine and parses it again. */
+	void discardParsedOnInitCallback();
+
+	/** Compiles the script that was prepared with prepareCompilation() on the calling thread. 
+	*
+	*	This does not send the compile message, call finishCompilation() with the result after releasing the locks.
+	*/
+	SnippetResult compilePreparedScript();
+
+	/** Updates the watched files and sends the compile message after the script was compiled. */
+	void finishCompilation(const SnippetResult& result);
+
 	void setupApi();
 
 	virtual void registerApiClasses() = 0;
@@ -569,6 +598,20 @@ protected:
 
 private:
 
+	enum class CompilationState
+	{
+		Idle,
+		ContentStored,
+		EnginePrepared
+	};
+
+	void storeContentBeforeCompilation();
+	void resetEngineForCompilation();
+
+	CompilationState compilationState = CompilationState::Idle;
+
+	String preparedOnInitCode;
+
 	struct Helpers
 	{
 		static String resolveIncludeStatements(String& x, Array<File>& includedFiles, const JavascriptProcessor* p);
@@ -289,6 +289,9 @@ public:
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;;
 
+	/** The script callback expects the buffer at the sample rate of the voice. */
+	bool canBeCalculatedAtControlRate() const override { return false; }
+
 	Processor *getChildProcessor(int /*processorIndex*/) override final { return nullptr; };
 	const Processor *getChildProcessor(int /*processorIndex*/) const override final { return nullptr; };
 	int getNumChildProcessors() const override final { return 0; };
@@ -383,6 +386,9 @@ public:
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;;
 
+	/** The script callback expects the buffer at the sample rate of the voice. */
+	bool canBeCalculatedAtControlRate() const override { return false; }
+
 	void startVoice(int voiceIndex) override;
 	void stopVoice(int voiceIndex) override;
 	void reset(int voiceIndex) override;
@@ -0,0 +1,410 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace DrawActionHelpers
+{
+using Command = DrawActionList::Command;
+
+static void setArea(Command& c, Rectangle<float> area)
+{
+	c.values[0] = area.getX();
+	c.values[1] = area.getY();
+	c.values[2] = area.getWidth();
+	c.values[3] = area.getHeight();
+}
+
+static Rectangle<float> getArea(const Command& c)
+{
+	return { c.values[0], c.values[1], c.values[2], c.values[3] };
+}
+
+/** The image areas are stored as float values (which are exact for every sensible image size). */
+static Rectangle<int> getIntArea(const Command& c, int offset)
+{
+	return { (int)c.values[offset], (int)c.values[offset + 1], (int)c.values[offset + 2], (int)c.values[offset + 3] };
+}
+
+/** Antialiased edges can touch one more pixel outside the area. */
+static Rectangle<float> withEdges(Rectangle<float> r, float lineThickness = 0.0f)
+{
+	return r.expanded(lineThickness * 0.5f + 1.0f);
+}
+
+} // namespace DrawActionHelpers
+
+DrawActionList::Command& DrawActionList::addCommand(CommandType type)
+{
+	Command c;
+
+	c.type = type;
+	c.colour = 0;
+	c.intValue = 0;
+	c.resources[0] = -1;
+	c.resources[1] = -1;
+	FloatVectorOperations::clear(c.values, 8);
+
+	commands.add(c);
+
+	return commands.getReference(commands.size() - 1);
+}
+
+void DrawActionList::fillAll(Colour c) { addCommand(CommandType::FillAll).colour = c.getARGB(); }
+void DrawActionList::setColour(Colour c) { addCommand(CommandType::SetColour).colour = c.getARGB(); }
+
+void DrawActionList::setGradientFill(const ColourGradient& gradient)
+{
+	addCommand(CommandType::SetGradientFill).resources[0] = gradients.size();
+	gradients.add(gradient);
+}
+
+void DrawActionList::setOpacity(float alpha) { addCommand(CommandType::SetOpacity).values[0] = alpha; }
+void DrawActionList::fillRect(Rectangle<float> area) { DrawActionHelpers::setArea(addCommand(CommandType::FillRect), area); }
+
+void DrawActionList::drawRect(Rectangle<float> area, float borderSize)
+{
+	auto& c = addCommand(CommandType::DrawRect);
+	DrawActionHelpers::setArea(c, area);
+	c.values[4] = borderSize;
+}
+
+void DrawActionList::fillRoundedRectangle(Rectangle<float> area, float cornerSize)
+{
+	auto& c = addCommand(CommandType::FillRoundedRectangle);
+	DrawActionHelpers::setArea(c, area);
+	c.values[4] = cornerSize;
+}
+
+void DrawActionList::drawRoundedRectangle(Rectangle<float> area, float cornerSize, float borderSize)
+{
+	auto& c = addCommand(CommandType::DrawRoundedRectangle);
+	DrawActionHelpers::setArea(c, area);
+	c.values[4] = cornerSize;
+	c.values[5] = borderSize;
+}
+
+void DrawActionList::drawHorizontalLine(int y, float x1, float x2)
+{
+	auto& c = addCommand(CommandType::DrawHorizontalLine);
+	c.intValue = y;
+	c.values[0] = x1;
+	c.values[1] = x2;
+}
+
+void DrawActionList::drawLine(float x1, float y1, float x2, float y2, float lineThickness)
+{
+	auto& c = addCommand(CommandType::DrawLine);
+	c.values[0] = x1;
+	c.values[1] = y1;
+	c.values[2] = x2;
+	c.values[3] = y2;
+	c.values[4] = lineThickness;
+}
+
+void DrawActionList::drawText(const String& text, Rectangle<float> area, const Font& font, Justification justification)
+{
+	auto& c = addCommand(CommandType::DrawText);
+	DrawActionHelpers::setArea(c, area);
+	c.intValue = justification.getFlags();
+	c.resources[0] = texts.size();
+	c.resources[1] = fonts.size();
+
+	texts.add(text);
+	fonts.add(font);
+}
+
+void DrawActionList::drawEllipse(Rectangle<float> area, float lineThickness)
+{
+	auto& c = addCommand(CommandType::DrawEllipse);
+	DrawActionHelpers::setArea(c, area);
+	c.values[4] = lineThickness;
+}
+
+void DrawActionList::fillEllipse(Rectangle<float> area) { DrawActionHelpers::setArea(addCommand(CommandType::FillEllipse), area); }
+
+void DrawActionList::drawImage(const Image& image, Rectangle<int> targetArea, Rectangle<int> sourceArea)
+{
+	auto& c = addCommand(CommandType::DrawImage);
+	DrawActionHelpers::setArea(c, targetArea.toFloat());
+	c.values[4] = (float)sourceArea.getX();
+	c.values[5] = (float)sourceArea.getY();
+	c.values[6] = (float)sourceArea.getWidth();
+	c.values[7] = (float)sourceArea.getHeight();
+	c.resources[0] = images.size();
+
+	images.add(image);
+}
+
+void DrawActionList::drawDropShadow(Rectangle<int> area, Colour colour, int radius)
+{
+	auto& c = addCommand(CommandType::DrawDropShadow);
+	DrawActionHelpers::setArea(c, area.toFloat());
+	c.colour = colour.getARGB();
+	c.intValue = radius;
+}
+
+void DrawActionList::fillPath(const Path& p)
+{
+	addCommand(CommandType::FillPath).resources[0] = paths.size();
+	paths.add(p);
+}
+
+void DrawActionList::strokePath(const Path& p, float thickness)
+{
+	auto& c = addCommand(CommandType::StrokePath);
+	c.resources[0] = paths.size();
+	c.values[0] = thickness;
+
+	paths.add(p);
+}
+
+void DrawActionList::addTransform(const AffineTransform& t)
+{
+	auto& c = addCommand(CommandType::AddTransform);
+	c.values[0] = t.mat00;
+	c.values[1] = t.mat01;
+	c.values[2] = t.mat02;
+	c.values[3] = t.mat10;
+	c.values[4] = t.mat11;
+	c.values[5] = t.mat12;
+}
+
+void DrawActionList::addDropShadowFromAlpha(Colour colour, int radius, float scaleFactor)
+{
+	auto& c = addCommand(CommandType::DropShadowFromAlpha);
+	c.colour = colour.getARGB();
+	c.intValue = radius;
+	c.values[0] = scaleFactor;
+}
+
+void DrawActionList::clear()
+{
+	// Keeps the allocated storage for the next recording
+	commands.clearQuick();
+	texts.clearQuick();
+	fonts.clearQuick();
+	images.clearQuick();
+	paths.clearQuick();
+	gradients.clearQuick();
+}
+
+void DrawActionList::swapWith(DrawActionList& other)
+{
+	commands.swapWith(other.commands);
+	texts.swapWith(other.texts);
+	fonts.swapWith(other.fonts);
+	images.swapWith(other.images);
+	paths.swapWith(other.paths);
+	gradients.swapWith(other.gradients);
+}
+
+void DrawActionList::perform(Graphics& g, Image& canvas) const
+{
+	for (const auto& c : commands)
+		perform(c, g, canvas);
+}
+
+void DrawActionList::perform(const Command& c, Graphics& g, Image& canvas) const
+{
+	const auto area = DrawActionHelpers::getArea(c);
+	const float* v = c.values;
+
+	switch (c.type)
+	{
+	case CommandType::FillAll:				g.fillAll(Colour(c.colour)); break;
+	case CommandType::SetColour:			g.setColour(Colour(c.colour)); break;
+	case CommandType::SetGradientFill:		g.setGradientFill(gradients.getReference(c.resources[0])); break;
+	case CommandType::SetOpacity:			g.setOpacity(v[0]); break;
+	case CommandType::FillRect:				g.fillRect(area); break;
+	case CommandType::DrawRect:				g.drawRect(area, v[4]); break;
+	case CommandType::FillRoundedRectangle:	g.fillRoundedRectangle(area, v[4]); break;
+	case CommandType::DrawRoundedRectangle:	g.drawRoundedRectangle(area, v[4], v[5]); break;
+	case CommandType::DrawHorizontalLine:	g.drawHorizontalLine(c.intValue, v[0], v[1]); break;
+	case CommandType::DrawLine:				g.drawLine(v[0], v[1], v[2], v[3], v[4]); break;
+	case CommandType::DrawText:
+		g.setFont(fonts.getReference(c.resources[1]));
+		g.drawText(texts.getReference(c.resources[0]), area, Justification(c.intValue));
+		break;
+	case CommandType::DrawEllipse:			g.drawEllipse(area, v[4]); break;
+	case CommandType::FillEllipse:			g.fillEllipse(area); break;
+	case CommandType::DrawImage:
+	{
+		const auto targetArea = DrawActionHelpers::getIntArea(c, 0);
+		const auto sourceArea = DrawActionHelpers::getIntArea(c, 4);
+
+		g.drawImage(images.getReference(c.resources[0]), targetArea.getX(), targetArea.getY(), targetArea.getWidth(), targetArea.getHeight(),
+					sourceArea.getX(), sourceArea.getY(), sourceArea.getWidth(), sourceArea.getHeight());
+		break;
+	}
+	case CommandType::DrawDropShadow:
+	{
+		DropShadow shadow;
+
+		shadow.colour = Colour(c.colour);
+		shadow.radius = c.intValue;
+
+		shadow.drawForRectangle(g, DrawActionHelpers::getIntArea(c, 0));
+		break;
+	}
+	case CommandType::FillPath:				g.fillPath(paths.getReference(c.resources[0])); break;
+	case CommandType::StrokePath:			g.strokePath(paths.getReference(c.resources[0]), PathStrokeType(v[0])); break;
+	case CommandType::AddTransform:			g.addTransform(AffineTransform(v[0], v[1], v[2], v[3], v[4], v[5])); break;
+	case CommandType::DropShadowFromAlpha:
+	{
+		DropShadow shadow;
+
+		shadow.colour = Colour(c.colour);
+		shadow.radius = c.intValue;
+
+		Graphics g2(canvas);
+
+#if JUCE_MAC || HISE_IOS
+		// don't ask why...
+		g2.addTransform(AffineTransform::scale(1.0f / v[0]));
+#endif
+
+		shadow.drawForImage(g2, canvas);
+		break;
+	}
+	case CommandType::numCommandTypes:		jassertfalse; break;
+	}
+}
+
+bool DrawActionList::isEqual(const Command& c, const DrawActionList& otherList, const Command& other) const
+{
+	if (c.type != other.type || c.colour != other.colour || c.intValue != other.intValue)
+		return false;
+
+	for (int i = 0; i < 8; i++)
+	{
+		if (c.values[i] != other.values[i])
+			return false;
+	}
+
+	switch (c.type)
+	{
+	case CommandType::SetGradientFill:
+		return gradients.getReference(c.resources[0]) == otherList.gradients.getReference(other.resources[0]);
+	case CommandType::DrawText:
+		return fonts.getReference(c.resources[1]) == otherList.fonts.getReference(other.resources[1]) &&
+			   texts.getReference(c.resources[0]) == otherList.texts.getReference(other.resources[0]);
+	case CommandType::DrawImage:
+		return images.getReference(c.resources[0]) == otherList.images.getReference(other.resources[0]);
+	case CommandType::FillPath:
+	case CommandType::StrokePath:
+		return paths.getReference(c.resources[0]) == otherList.paths.getReference(other.resources[0]);
+	default:
+		return true;
+	}
+}
+
+Rectangle<float> DrawActionList::getBounds(const Command& c) const
+{
+	const auto area = DrawActionHelpers::getArea(c);
+	const float* v = c.values;
+
+	switch (c.type)
+	{
+	case CommandType::FillRect:
+	case CommandType::DrawRect:
+	case CommandType::FillRoundedRectangle:
+	case CommandType::FillEllipse:
+	case CommandType::DrawImage:			return DrawActionHelpers::withEdges(area);
+	case CommandType::DrawRoundedRectangle:	return DrawActionHelpers::withEdges(area, v[5]);
+	case CommandType::DrawEllipse:			return DrawActionHelpers::withEdges(area, v[4]);
+	case CommandType::DrawHorizontalLine:	return DrawActionHelpers::withEdges({ jmin(v[0], v[1]), (float)c.intValue, std::abs(v[1] - v[0]), 1.0f });
+	case CommandType::DrawLine:				return DrawActionHelpers::withEdges(Rectangle<float>(Point<float>(v[0], v[1]), Point<float>(v[2], v[3])), v[4]);
+	case CommandType::DrawDropShadow:		return DrawActionHelpers::withEdges(area.expanded((float)c.intValue));
+	case CommandType::FillPath:				return DrawActionHelpers::withEdges(paths.getReference(c.resources[0]).getBounds());
+	case CommandType::DrawText:
+	{
+		// The glyphs are not clipped vertically, so a font that is larger than the area can exceed it
+		return DrawActionHelpers::withEdges(area.expanded(0.0f, fonts.getReference(c.resources[1]).getHeight()));
+	}
+	case CommandType::StrokePath:
+	{
+		// The mitered joints can exceed the line thickness, so this creates the actual stroke
+		Path stroke;
+		PathStrokeType(v[0]).createStrokedPath(stroke, paths.getReference(c.resources[0]));
+		return DrawActionHelpers::withEdges(stroke.getBounds());
+	}
+	default:
+		return {};
+	}
+}
+
+Rectangle<int> DrawActionList::getChangedArea(const DrawActionList& previous, const AffineTransform& canvasTransform, Rectangle<int> fullArea) const
+{
+	if (commands.size() != previous.commands.size())
+		return fullArea;
+
+	AffineTransform t(canvasTransform);
+	Rectangle<float> changedArea;
+	bool somethingChanged = false;
+	bool needsCanvas = false;
+
+	for (int i = 0; i < commands.size(); i++)
+	{
+		const auto& c = commands.getReference(i);
+		const auto& p = previous.commands.getReference(i);
+
+		// The shadow depends on the existing content of the canvas
+		needsCanvas |= c.type == CommandType::DropShadowFromAlpha;
+
+		if (!isEqual(c, previous, p))
+		{
+			auto newBounds = getBounds(c);
+			auto oldBounds = previous.getBounds(p);
+
+			// A state change or an unknown area
+			if (newBounds.isEmpty() || oldBounds.isEmpty())
+				return fullArea;
+
+			changedArea = changedArea.getUnion(newBounds.transformedBy(t)).getUnion(oldBounds.transformedBy(t));
+			somethingChanged = true;
+		}
+
+		if (c.type == CommandType::AddTransform)
+			t = AffineTransform(c.values[0], c.values[1], c.values[2], c.values[3], c.values[4], c.values[5]).followedBy(t);
+	}
+
+	if (!somethingChanged)
+		return {};
+
+	if (needsCanvas)
+		return fullArea;
+
+	return changedArea.getSmallestIntegerContainer().getIntersection(fullArea);
+}
+
+} // namespace hise
@@ -0,0 +1,162 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef SCRIPTDRAWACTIONS_H_INCLUDED
+#define SCRIPTDRAWACTIONS_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A list of recorded drawing commands.
+*
+*	The Graphics object of a ScriptPanel paint routine records its calls into this list instead of
+*	drawing into the canvas directly. Building the list doesn't need a Graphics context, so the
+*	recording can happen on any thread and the list can be kept until the next paint call.
+*
+*	The commands are stored as flat records in a single array. Parameters that aren't plain values
+*	(texts, fonts, images, paths and gradients) are kept in separate arrays and referenced by index.
+*	Clearing the list keeps the allocated storage, so recording the next paint call doesn't allocate
+*	the records again.
+*
+*	When the panel is repainted, the new list is compared against the last one and only the area
+*	that is touched by the changed commands is rasterized again. If nothing changed, the rasterization
+*	is skipped completely.
+*/
+class DrawActionList
+{
+public:
+
+	enum class CommandType : uint8
+	{
+		FillAll = 0,
+		SetColour,
+		SetGradientFill,
+		SetOpacity,
+		FillRect,
+		DrawRect,
+		FillRoundedRectangle,
+		DrawRoundedRectangle,
+		DrawHorizontalLine,
+		DrawLine,
+		DrawText,
+		DrawEllipse,
+		FillEllipse,
+		DrawImage,
+		DrawDropShadow,
+		FillPath,
+		StrokePath,
+		AddTransform,
+		DropShadowFromAlpha,
+		numCommandTypes
+	};
+
+	/** A single recorded drawing command. */
+	struct Command
+	{
+		CommandType type;
+		uint32 colour;
+		int intValue;			// the justification flags or the shadow radius
+		int resources[2];		// the indexes of the text, font, image, path or gradient
+		float values[8];		// the area and the other float parameters
+	};
+
+	DrawActionList() {};
+
+	// ================================================================================================================
+
+	void fillAll(Colour c);
+	void setColour(Colour c);
+	void setGradientFill(const ColourGradient& gradient);
+	void setOpacity(float alpha);
+	void fillRect(Rectangle<float> area);
+	void drawRect(Rectangle<float> area, float borderSize);
+	void fillRoundedRectangle(Rectangle<float> area, float cornerSize);
+	void drawRoundedRectangle(Rectangle<float> area, float cornerSize, float borderSize);
+	void drawHorizontalLine(int y, float x1, float x2);
+	void drawLine(float x1, float y1, float x2, float y2, float lineThickness);
+	void drawText(const String& text, Rectangle<float> area, const Font& font, Justification justification);
+	void drawEllipse(Rectangle<float> area, float lineThickness);
+	void fillEllipse(Rectangle<float> area);
+	void drawImage(const Image& image, Rectangle<int> targetArea, Rectangle<int> sourceArea);
+	void drawDropShadow(Rectangle<int> area, Colour c, int radius);
+	void fillPath(const Path& p);
+	void strokePath(const Path& p, float thickness);
+	void addTransform(const AffineTransform& t);
+	void addDropShadowFromAlpha(Colour c, int radius, float scaleFactor);
+
+	// ================================================================================================================
+
+	/** Draws all commands in the recorded order. */
+	void perform(Graphics& g, Image& canvas) const;
+
+	/** Compares this list with the previous one and returns the area of the canvas that needs to be rasterized again.
+	*
+	*	The bounds of the changed commands (both old and new) are transformed with the canvas transform. It returns
+	*	an empty rectangle if both lists draw exactly the same and fullArea if the changes can't be limited to a region.
+	*/
+	Rectangle<int> getChangedArea(const DrawActionList& previous, const AffineTransform& canvasTransform, Rectangle<int> fullArea) const;
+
+	void clear();
+
+	void swapWith(DrawActionList& other);
+
+	int getNumActions() const { return commands.size(); }
+
+private:
+
+	Command& addCommand(CommandType type);
+
+	void perform(const Command& c, Graphics& g, Image& canvas) const;
+
+	/** Returns true if the other command has the same type and parameters. */
+	bool isEqual(const Command& c, const DrawActionList& otherList, const Command& other) const;
+
+	/** Returns the (unscaled) area that this command draws to.
+	*
+	*	Commands that change the Graphics state or draw an unknown area return an empty rectangle,
+	*	so a change will cause a repaint of the whole canvas.
+	*/
+	Rectangle<float> getBounds(const Command& c) const;
+
+	Array<Command> commands;
+
+	Array<String> texts;
+	Array<Font> fonts;
+	Array<Image> images;
+	Array<Path> paths;
+	Array<ColourGradient> gradients;
+
+	JUCE_DECLARE_NON_COPYABLE(DrawActionList);
+};
+
+} // namespace hise
+
+#endif  // SCRIPTDRAWACTIONS_H_INCLUDED
@@ -959,6 +959,7 @@ struct ScriptingApi::Engine::Wrapper
 	API_METHOD_WRAPPER_1(Engine, isControllerUsedByAutomation);
 	API_METHOD_WRAPPER_0(Engine, getSettingsWindowObject);
 	API_METHOD_WRAPPER_1(Engine, getMasterPeakLevel);
+	API_VOID_METHOD_WRAPPER_1(Engine, setUseParallelSynthRendering);
 	API_VOID_METHOD_WRAPPER_1(Engine, loadFont);
 	API_VOID_METHOD_WRAPPER_2(Engine, loadFontAs);
 	API_VOID_METHOD_WRAPPER_0(Engine, undo);
@@ -1008,6 +1009,7 @@ ApiClass(0)
 	ADD_API_METHOD_2(getRegexMatches);
 	ADD_API_METHOD_2(doubleToString);
 	ADD_API_METHOD_1(getMasterPeakLevel);
+	ADD_API_METHOD_1(setUseParallelSynthRendering);
 	ADD_API_METHOD_0(getOS);
 	ADD_API_METHOD_0(getDeviceType);
 	ADD_API_METHOD_0(getDeviceResolution);
@@ -1191,6 +1193,11 @@ double ScriptingApi::Engine::getMasterPeakLevel(int channel)
 		return getScriptProcessor()->getMainController_()->getMainSynthChain()->getDisplayValues().outR;
 }
 
+void ScriptingApi::Engine::setUseParallelSynthRendering(bool shouldRenderInParallel)
+{
+	getScriptProcessor()->getMainController_()->getMainSynthChain()->setUseParallelSynthRendering(shouldRenderInParallel);
+}
+
 var ScriptingApi::Engine::getSettingsWindowObject()
 {
 	reportScriptError("Deprecated");
@@ -1493,6 +1500,7 @@ struct ScriptingApi::Sampler::Wrapper
     API_VOID_METHOD_WRAPPER_2(Sampler, setAttribute);
     API_METHOD_WRAPPER_1(Sampler, getAttribute);
 	API_VOID_METHOD_WRAPPER_1(Sampler, setUseStaticMatrix);
+	API_VOID_METHOD_WRAPPER_1(Sampler, setUseParallelVoiceRendering);
 };
 
 
@@ -1521,6 +1529,7 @@ sampler(sampler_)
     ADD_API_METHOD_1(getAttribute);
     ADD_API_METHOD_2(setAttribute);
 	ADD_API_METHOD_1(setUseStaticMatrix);
+	ADD_API_METHOD_1(setUseParallelVoiceRendering);
 
 	for (int i = 1; i < ModulatorSamplerSound::numProperties; i++)
 	{
@@ -1942,6 +1951,19 @@ void ScriptingApi::Sampler::setUseStaticMatrix(bool shouldUseStaticMatrix)
 	s->setUseStaticMatrix(shouldUseStaticMatrix);
 }
 
+void ScriptingApi::Sampler::setUseParallelVoiceRendering(bool shouldRenderInParallel)
+{
+	ModulatorSampler *s = static_cast<ModulatorSampler*>(sampler.get());
+
+	if (s == nullptr)
+	{
+		reportScriptError("setUseParallelVoiceRendering() only works with Samplers.");
+		RETURN_VOID_IF_NO_THROW()
+	}
+
+	s->setUseParallelVoiceRendering(shouldRenderInParallel);
+}
+
 // ====================================================================================================== Synth functions
 
 
@@ -316,6 +316,9 @@ public:
 		/** Returns the current peak volume (0...1) for the given channel. */
 		double getMasterPeakLevel(int channel);
 
+		/** Enables rendering of independent sound generators of the main container on the parallel rendering pool. */
+		void setUseParallelSynthRendering(bool shouldRenderInParallel);
+
 		/** Returns a object that contains the properties for the settings dialog. */
 		var getSettingsWindowObject();
 
@@ -447,6 +450,9 @@ public:
 		/** Disables dynamic resizing when a sample map is loaded. */
 		void setUseStaticMatrix(bool shouldUseStaticMatrix);
 
+		/** Renders the voices of this sampler on multiple threads (the output stays identical to the serial rendering). */
+		void setUseParallelVoiceRendering(bool shouldRenderInParallel);
+
 		// ============================================================================================================
 
 		struct Wrapper;
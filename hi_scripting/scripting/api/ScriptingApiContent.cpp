@@ -2659,29 +2659,29 @@ void ScriptingApi::Content::ScriptPanel::internalRepaint(bool forceRepaint/*=fal
 		if ((!forceRepaint && !isShowing()) || canvasWidth <= 0 || canvasHeight <= 0)
 		{
 			paintCanvas = Image();
+			lastDrawActions.clear();
 
 			return;
 		}
 
+		const Rectangle<int> fullArea(0, 0, canvasWidth, canvasHeight);
+		const auto canvasTransform = AffineTransform::scale((float)getScaleFactorForCanvas());
+
+		bool canvasChanged = false;
+
 		if (paintCanvas.getWidth() != canvasWidth ||
 			paintCanvas.getHeight() != canvasHeight)
 		{
 			paintCanvas = Image(Image::PixelFormat::ARGB, canvasWidth, canvasHeight, !getScriptObjectProperty(Properties::opaque));
+			canvasChanged = true;
 		}
-		else if (!getScriptObjectProperty(Properties::opaque))
-		{
-			paintCanvas.clear(Rectangle<int>(0, 0, canvasWidth, canvasHeight));
-		}
-
-		Graphics g(paintCanvas);
-
-		g.addTransform(AffineTransform::scale((float)getScaleFactorForCanvas()));
 
 		var thisObject(this);
 		var arguments = var(graphics);
 		var::NativeFunctionArgs args(thisObject, &arguments, 1);
 
-		graphics->setGraphics(&g, &paintCanvas);
+		drawActions.clear();
+		graphics->setDrawActionList(&drawActions);
 
 		Result r = Result::ok();
 
@@ -2697,7 +2697,28 @@ void ScriptingApi::Content::ScriptPanel::internalRepaint(bool forceRepaint/*=fal
 			debugError(dynamic_cast<Processor*>(getScriptProcessor()), r.getErrorMessage());
 		}
 
-		graphics->setGraphics(nullptr, nullptr);
+		graphics->setDrawActionList(nullptr);
+
+		// Only rasterize the area that is affected by the changed actions
+		const auto dirtyArea = canvasChanged ? fullArea : drawActions.getChangedArea(lastDrawActions, canvasTransform, fullArea);
+
+		lastDrawActions.swapWith(drawActions);
+		drawActions.clear();
+
+		if (dirtyArea.isEmpty())
+			return;
+
+		if (!getScriptObjectProperty(Properties::opaque))
+			paintCanvas.clear(dirtyArea);
+
+		{
+			Graphics g(paintCanvas);
+
+			g.reduceClipRegion(dirtyArea);
+			g.addTransform(canvasTransform);
+
+			lastDrawActions.perform(g, paintCanvas);
+		}
 
 		sendChangeMessage();
 
@@ -2931,6 +2952,9 @@ void ScriptingApi::Content::ScriptPanel::setImage(String imageName, int xOffset,
 	paintRoutine = var();
 	usesClippedFixedImage = true;
 
+	// The canvas will not contain the recorded actions anymore
+	lastDrawActions.clear();
+
 	Image toUse = getLoadedImage(imageName);
 
 	auto b = getBoundsForImage();
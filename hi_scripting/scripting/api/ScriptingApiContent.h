@@ -1414,6 +1414,9 @@ public:
 
 		Image paintCanvas;
 
+		DrawActionList drawActions;
+		DrawActionList lastDrawActions;
+
 		enum class NamedImageEntries
 		{
 			Image=0,
@@ -2025,8 +2025,7 @@ rectangleResult(Result::ok())
 ScriptingObjects::GraphicsObject::~GraphicsObject()
 {
 	parent = nullptr;
-	imageToDraw = nullptr;
-	g = nullptr;
+	drawActions = nullptr;
 }
 
 void ScriptingObjects::GraphicsObject::fillAll(var colour)
@@ -2034,7 +2033,7 @@ void ScriptingObjects::GraphicsObject::fillAll(var colour)
 	initGraphics();
 	Colour c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
 
-	g->fillAll(c);
+	drawActions->fillAll(c);
 
 	
 }
@@ -2043,7 +2042,7 @@ void ScriptingObjects::GraphicsObject::fillRect(var area)
 {
 	initGraphics();
 
-	g->fillRect(getRectangleFromVar(area));
+	drawActions->fillRect(getRectangleFromVar(area));
 }
 
 void ScriptingObjects::GraphicsObject::drawRect(var area, float borderSize)
@@ -2052,7 +2051,7 @@ void ScriptingObjects::GraphicsObject::drawRect(var area, float borderSize)
 
 	auto bs = (float)borderSize;
 
-	g->drawRect(getRectangleFromVar(area), SANITIZED(bs));
+	drawActions->drawRect(getRectangleFromVar(area), SANITIZED(bs));
 }
 
 void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, float cornerSize)
@@ -2061,7 +2060,7 @@ void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, float corn
 
     auto cs = (float)cornerSize;
     
-	g->fillRoundedRectangle(getRectangleFromVar(area), SANITIZED(cs));
+	drawActions->fillRoundedRectangle(getRectangleFromVar(area), SANITIZED(cs));
 }
 
 void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, float cornerSize, float borderSize)
@@ -2071,7 +2070,7 @@ void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, float corn
     auto cs = (float)cornerSize;
     auto bs = (float)borderSize;
     
-    g->drawRoundedRectangle(getRectangleFromVar(area), SANITIZED(cs), SANITIZED(bs));
+    drawActions->drawRoundedRectangle(getRectangleFromVar(area), SANITIZED(cs), SANITIZED(bs));
 }
 
 void ScriptingObjects::GraphicsObject::drawHorizontalLine(int y, float x1, float x2)
@@ -2080,7 +2079,7 @@ void ScriptingObjects::GraphicsObject::drawHorizontalLine(int y, float x1, float
 
     
     
-	g->drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2));
+	drawActions->drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2));
 }
 
 void ScriptingObjects::GraphicsObject::setOpacity(float alphaValue)
@@ -2089,21 +2088,22 @@ void ScriptingObjects::GraphicsObject::setOpacity(float alphaValue)
 
 	
 
-	g->setOpacity(alphaValue);
+	drawActions->setOpacity(alphaValue);
 }
 
 void ScriptingObjects::GraphicsObject::drawLine(float x1, float x2, float y1, float y2, float lineThickness)
 {
 	initGraphics();
 
-	g->drawLine(SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness));
+	drawActions->drawLine(SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness));
 }
 
 void ScriptingObjects::GraphicsObject::setColour(var colour)
 {
-	
+	initGraphics();
+
 	currentColour = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	g->setColour(currentColour);
+	drawActions->setColour(currentColour);
 
 	useGradient = false;
 }
@@ -2113,8 +2113,6 @@ void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
 	MainController *mc = getScriptProcessor()->getMainController_();
 
 	currentFont = mc->getFontFromString(fontName, SANITIZED(fontSize));
-
-	g->setFont(currentFont);
 }
 
 void ScriptingObjects::GraphicsObject::drawText(String text, var area)
@@ -2125,9 +2123,7 @@ void ScriptingObjects::GraphicsObject::drawText(String text, var area)
 
 	currentFont.setHeightWithoutChangingWidth(r.getHeight());
 
-	g->setFont(currentFont);
-
-	g->drawText(text, r, Justification::centred);
+	drawActions->drawText(text, r, currentFont, Justification::centred);
 }
 
 void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, String alignment)
@@ -2143,14 +2139,13 @@ void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, St
 	if (re.failed())
 		reportScriptError(re.getErrorMessage());
 
-
-	g->setFont(currentFont);
-
-	g->drawText(text, r, just);
+	drawActions->drawText(text, r, currentFont, just);
 }
 
 void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 {
+	initGraphics();
+
 	if (gradientData.isArray())
 	{
 		Array<var>* data = gradientData.getArray();
@@ -2165,7 +2160,7 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 
 			useGradient = true;
 
-			g->setGradientFill(currentGradient);
+			drawActions->setGradientFill(currentGradient);
 		}
 		else
 		{
@@ -2184,14 +2179,14 @@ void ScriptingObjects::GraphicsObject::drawEllipse(var area, float lineThickness
 {
 	initGraphics();
 
-	g->drawEllipse(getRectangleFromVar(area), lineThickness);
+	drawActions->drawEllipse(getRectangleFromVar(area), lineThickness);
 }
 
 void ScriptingObjects::GraphicsObject::fillEllipse(var area)
 {
 	initGraphics();
 
-	g->fillEllipse(getRectangleFromVar(area));
+	drawActions->fillEllipse(getRectangleFromVar(area));
 }
 
 void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int /*xOffset*/, int yOffset)
@@ -2210,7 +2205,10 @@ void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int
         {
             const double scaleFactor = (double)img.getWidth() / (double)r.getWidth();
             
-            g->drawImage(img, (int)r.getX(), (int)r.getY(), (int)r.getWidth(), (int)r.getHeight(), 0, yOffset, (int)img.getWidth(), (int)((double)r.getHeight() * scaleFactor));
+            Rectangle<int> targetArea((int)r.getX(), (int)r.getY(), (int)r.getWidth(), (int)r.getHeight());
+            Rectangle<int> sourceArea(0, yOffset, (int)img.getWidth(), (int)((double)r.getHeight() * scaleFactor));
+
+            drawActions->drawImage(img, targetArea, sourceArea);
         }        
 	}
 	else
@@ -2223,14 +2221,10 @@ void ScriptingObjects::GraphicsObject::drawDropShadow(var area, var colour, int
 {
 	initGraphics();
 
-	DropShadow shadow;
-
-	shadow.colour = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	shadow.radius = radius;
-
+	auto c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
 	auto r = getIntRectangleFromVar(area);
 
-	shadow.drawForRectangle(*g, r);
+	drawActions->drawDropShadow(r, c, radius);
 }
 
 void ScriptingObjects::GraphicsObject::drawTriangle(var area, float angle, float lineThickness)
@@ -2246,8 +2240,7 @@ void ScriptingObjects::GraphicsObject::drawTriangle(var area, float angle, float
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 	
-	PathStrokeType pst(lineThickness);
-	g->strokePath(p, pst);
+	drawActions->strokePath(p, lineThickness);
 }
 
 void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
@@ -2263,32 +2256,24 @@ void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-	g->fillPath(p);
+	drawActions->fillPath(p);
 }
 
 void ScriptingObjects::GraphicsObject::addDropShadowFromAlpha(var colour, int radius)
 {
 	initGraphics();
 
-	DropShadow shadow;
+	auto c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
 
-	shadow.colour = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	shadow.radius = radius;
+	const double scaleFactor = dynamic_cast<ScriptingApi::Content::ScriptPanel*>(parent)->parent->usesDoubleResolution() ? 2.0 : 1.0;
 
-    Graphics g2(*imageToDraw);
-    
-#if JUCE_MAC || HISE_IOS
-    const double scaleFactor = dynamic_cast<ScriptingApi::Content::ScriptPanel*>(parent)->parent->usesDoubleResolution() ? 2.0 : 1.0;
-    
-    // don't ask why...
-    g2.addTransform(AffineTransform::scale((float)(1.0 / scaleFactor)));
-#endif
-    
-	shadow.drawForImage(g2, *imageToDraw);
+	drawActions->addDropShadowFromAlpha(c, radius, (float)scaleFactor);
 }
 
 void ScriptingObjects::GraphicsObject::fillPath(var path, var area)
 {
+	initGraphics();
+
 	if (PathObject* pathObject = dynamic_cast<PathObject*>(path.getObject()))
 	{
 		Path p = pathObject->getPath();
@@ -2299,12 +2284,14 @@ void ScriptingObjects::GraphicsObject::fillPath(var path, var area)
 			p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 		}
 
-		g->fillPath(p);
+		drawActions->fillPath(p);
 	}
 }
 
 void ScriptingObjects::GraphicsObject::drawPath(var path, var area, var thickness)
 {
+	initGraphics();
+
 	if (PathObject* pathObject = dynamic_cast<PathObject*>(path.getObject()))
 	{
 		Path p = pathObject->getPath();
@@ -2317,7 +2304,7 @@ void ScriptingObjects::GraphicsObject::drawPath(var path, var area, var thicknes
 
         auto t = (float)thickness;
         
-		g->strokePath(p, PathStrokeType(SANITIZED(t)));
+		drawActions->strokePath(p, SANITIZED(t));
 	}
 }
 
@@ -2331,7 +2318,7 @@ void ScriptingObjects::GraphicsObject::rotate(var angleInRadian, var center)
     
 	auto a = AffineTransform::rotation(SANITIZED(air), c.getX(), c.getY());
 
-	g->addTransform(a);
+	drawActions->addTransform(a);
 }
 
 Point<float> ScriptingObjects::GraphicsObject::getPointFromVar(const var& data)
@@ -2363,7 +2350,7 @@ Rectangle<int> ScriptingObjects::GraphicsObject::getIntRectangleFromVar(const va
 
 void ScriptingObjects::GraphicsObject::initGraphics()
 {
-	if (g == nullptr) reportScriptError("Graphics not initialised");
+	if (drawActions == nullptr) reportScriptError("Graphics not initialised");
 
 }
 
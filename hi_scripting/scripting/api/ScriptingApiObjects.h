@@ -1084,11 +1084,10 @@ public:
 
 		struct Wrapper;
 
-		
-		void setGraphics(Graphics *g_, Image* image_)
+		/** Sets the list that records the calls of the paint routine (or nullptr after the paint routine). */
+		void setDrawActionList(DrawActionList* newList)
 		{
-			g = g_;
-			imageToDraw = image_;
+			drawActions = newList;
 		}
 
 	private:
@@ -1101,9 +1100,7 @@ public:
 
 		Result rectangleResult;
 
-		Image *imageToDraw = nullptr;
-
-		Graphics *g = nullptr;
+		DrawActionList* drawActions = nullptr;
 
 		Colour currentColour;
 		Font currentFont;
@@ -252,7 +252,7 @@ void CPP_PREFIX complexFFT(void* FFTState, float* in, float* out, int fftSize)
 
 	kiss_fft((kiss_fft_cfg)FFTState, (kiss_fft_cpx*)in, (kiss_fft_cpx*)out);
 #else
-	static_cast<IppFFT*>(FFTState)->complexFFT(in, out, fftSize);
+	static_cast<HiseFFT*>(FFTState)->complexFFT(in, out, fftSize);
 #endif
 }
 
@@ -265,7 +265,7 @@ void CPP_PREFIX complexFFTInverse(void* FFTState, float* in, float* out, int fft
 	
 	kiss_fft((kiss_fft_cfg)FFTState, (kiss_fft_cpx*)in, (kiss_fft_cpx*)out);
 #else
-	static_cast<IppFFT*>(FFTState)->complexFFTInverse(in, out, fftSize);
+	static_cast<HiseFFT*>(FFTState)->complexFFTInverse(in, out, fftSize);
 #endif
 }
 
@@ -278,7 +278,7 @@ void CPP_PREFIX complexFFTInplace(void* FFTState, float* data, int fftSize)
 	memcpy(data, out, s);
 	free((void*)out);
 #else
-	static_cast<IppFFT*>(FFTState)->complexFFTInplace(data, fftSize);
+	static_cast<HiseFFT*>(FFTState)->complexFFTInplace(data, fftSize);
 #endif
 }
 
@@ -296,7 +296,7 @@ void CPP_PREFIX complexFFTInverseInplace(void* FFTState, float* data, int fftSiz
 
 	free((void*)out);
 #else
-	static_cast<IppFFT*>(FFTState)->complexFFTInverseInplace(data, fftSize);
+	static_cast<HiseFFT*>(FFTState)->complexFFTInverseInplace(data, fftSize);
 #endif
 }
 
@@ -309,7 +309,12 @@ void CPP_PREFIX realFFT(void* FFTState, float* in, float* out, int fftSize)
 
 	kiss_fftr((kiss_fftr_cfg)FFTState, in, (kiss_fft_cpx*)out);
 #else
-	static_cast<IppFFT*>(FFTState)->realFFT(in, out, fftSize);
+	static_cast<HiseFFT*>(FFTState)->realFFT(in, out, fftSize);
+
+	// Unpack the Nyquist bin to the kiss_fftr layout (N/2+1 complex bins)
+	out[fftSize] = out[1];
+	out[fftSize + 1] = 0.0f;
+	out[1] = 0.0f;
 #endif
 }
 
@@ -321,7 +326,17 @@ void CPP_PREFIX realFFTInverse(void* FFTState, float* in, float* out, int fftSiz
 
 	kiss_fftri((kiss_fftr_cfg)FFTState, (const kiss_fft_cpx*)in, (float*)out);
 #else
-	static_cast<IppFFT*>(FFTState)->realFFTInverse(in, out, fftSize);
+	size_t s = sizeof(float) * (size_t)fftSize;
+
+	float* packed = (float*)malloc(s);
+
+	// Pack the kiss_fftr layout into the layout of HiseFFT (the Nyquist bin is stored in the imaginary part of the DC bin)
+	memcpy(packed, in, s);
+	packed[1] = in[fftSize];
+
+	static_cast<HiseFFT*>(FFTState)->realFFTInverse(packed, out, fftSize);
+
+	free((void*)packed);
 #endif
 }
 
@@ -500,6 +515,8 @@ void CPP_PREFIX zeroPadVector(float* dst, const float* src, int size, int paddin
 
 void* CPP_PREFIX createFFTState(int size, bool isReal, bool isInverse)
 {
+	// Without IPP, the library keeps using kiss_fft so that the real FFT returns 
+	// the kiss_fftr layout (N/2+1 complex bins) that existing scripts expect.
 #if USE_C_IMPLEMENTATION || !USE_IPP
 	if (isReal)
 	{
@@ -514,7 +531,7 @@ void* CPP_PREFIX createFFTState(int size, bool isReal, bool isInverse)
 	ignoreUnused(isInverse);
 
 	const int N = (int)log2((double)size);
-	return new IppFFT(isReal ? IppFFT::DataType::RealFloat : IppFFT::DataType::ComplexFloat, isReal ? N+2 : N+1);
+	return new HiseFFT(isReal ? HiseFFT::DataType::RealFloat : HiseFFT::DataType::ComplexFloat, isReal ? N+2 : N+1);
 
 #endif
 }
@@ -529,9 +546,9 @@ void CPP_PREFIX destroyFFTState(void* state)
 	}
 #else
 
-	if (IppFFT* ippState = reinterpret_cast<IppFFT*>(state))
+	if (HiseFFT* fftState = reinterpret_cast<HiseFFT*>(state))
 	{
-		delete ippState;
+		delete fftState;
 		state = nullptr;
 	}
 	
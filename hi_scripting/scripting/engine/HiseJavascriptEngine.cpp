@@ -646,6 +646,21 @@ Result HiseJavascriptEngine::execute(const String& javascriptCode, bool allowCon
 	return Result::ok();
 }
 
+bool HiseJavascriptEngine::preparse(const String& javascriptCode, bool allowConstDeclarations/*=true*/)
+{
+	return root->preparse(javascriptCode, allowConstDeclarations);
+}
+
+double HiseJavascriptEngine::getParseMilliseconds() const
+{
+	return root->parseMilliseconds;
+}
+
+double HiseJavascriptEngine::getExecutionMilliseconds() const
+{
+	return root->executionMilliseconds;
+}
+
 var HiseJavascriptEngine::evaluate(const String& code, Result* result)
 {
 	static const Identifier ext("eval");
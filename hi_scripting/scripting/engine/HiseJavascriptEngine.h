@@ -38,6 +38,45 @@ namespace hise { using namespace juce;
 class JavascriptProcessor;
 class DialogWindowWithBackgroundThread;
 
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+
+/** Counts the heap allocations of the current thread while a ScopedCounter is alive.
+*
+*	The global operator new is replaced when this is enabled, so it's only meant as a debugging tool to
+*	check that the realtime callbacks (eg. onNoteOn) can be executed without touching the heap. 
+*
+*	Only the calls to operator new are counted. Memory that is allocated with malloc / realloc (eg. the HeapBlock
+*	of a growing Array or a var array) is not included, so a count of zero doesn't prove that a callback is 
+*	allocation free.
+*
+*	There is no per-callback arena: the allocations that are reported here must be removed from the script 
+*	(or the engine), they are not redirected to a preallocated buffer.
+*/
+struct ScriptAllocationCounter
+{
+	/** Counts the allocations of this thread and writes the result into the given integer when it goes out of scope.
+	*
+	*	Counters can be nested: the allocations of the inner counter are added to the outer counter, so a callback
+	*	that is executed from within another callback doesn't reset the count of the outer one.
+	*/
+	struct ScopedCounter
+	{
+		ScopedCounter(int& numAllocationsToWrite) noexcept;
+		~ScopedCounter();
+
+	private:
+
+		int& target;
+		int numAllocations = 0;
+		int* previousCounter;
+	};
+
+	/** Called by the replaced operator new. */
+	static void countAllocation() noexcept;
+};
+
+#endif
+
 /** The HISE Javascript Engine.
  *
  *	This class is a modified version of the original Javascript engine found in JUCE.
@@ -111,6 +150,23 @@ public:
 	*/
 	Result execute(const String& javascriptCode, bool allowConstDeclarations=true);
 
+	/** Parses a block of javascript code without running it.
+	*
+	*	The next call to execute() with the same code will use the parsed statements (or report the parse error). 
+	*	This only touches the data of this engine, so the code of different engines can be parsed on different threads
+	*	at the same time (but not while they execute code).
+	*
+	*	Returns false if the code declares a global variable. The lookup of global variables depends on the order in which
+	*	the scripts are compiled, so you have to create a new engine and let execute() parse the code in this case.
+	*/
+	bool preparse(const String& javascriptCode, bool allowConstDeclarations=true);
+
+	/** Returns the time in milliseconds that was spent parsing the code of this engine (including preparse()). */
+	double getParseMilliseconds() const;
+
+	/** Returns the time in milliseconds that was spent running the code passed to execute() (mostly the onInit callback). */
+	double getExecutionMilliseconds() const;
+
 	/** Attempts to parse and run a javascript expression, and returns the result.
 	If there's a syntax error, or the expression can't be evaluated, the return value
 	will be var::undefined(). The errorMessage parameter gives you a way to find out
@@ -334,6 +390,7 @@ public:
 						public CyclicReferenceCheckBase
 	{
 		RootObject();
+		~RootObject();
 
 		Time timeout;
 
@@ -474,7 +531,7 @@ public:
 
 		struct VarStatement;			struct LiteralValue; 		struct UnqualifiedName;
 		struct ArraySubscript;			struct Assignment;
-		struct SelfAssignment;			struct PostAssignment;
+		struct SelfAssignment;			struct PostAssignment;		struct PropertyCache;
 
 		// Function / Objects
 
@@ -489,7 +546,7 @@ public:
 		struct GlobalVarStatement;		struct GlobalReference;		struct LocalVarStatement;
 		struct LocalReference;			struct LockStatement;	    struct CallbackParameterReference;
 		struct CallbackLocalStatement;  struct CallbackLocalReference;  struct ExternalCFunction;
-		struct NativeJIT;				struct IsDefinedTest;
+		struct NativeJIT;				struct IsDefinedTest;			struct CallbackProgram;
 
 		// Parser classes
 
@@ -563,9 +620,20 @@ public:
 			String getDebugValue() const override 
 			{
 				const double percentage = lastExecutionTime / bufferTime * 100.0;
+
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+				// Only operator new is counted, malloc / realloc are not included
+				return String(percentage, 2) + "% (" + String(lastNumAllocations) + " operator new calls)";
+#else
 				return String(percentage, 2) + "%";
+#endif
 			}
 
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+			/** Returns the number of operator new calls that happened during the last execution (malloc / realloc are not counted). */
+			int getNumAllocationsOfLastExecution() const noexcept { return lastNumAllocations; }
+#endif
+
 			var createDynamicObjectForBreakpoint()
 			{
 				DynamicObject::Ptr object = new DynamicObject();
@@ -613,7 +681,11 @@ public:
 
 		private:
 
+			/** Executes the compiled program of the callback or the statement tree if it couldn't be compiled. */
+			var performStatements(const Scope& s);
+
 			ScopedPointer<BlockStatement> statements;
+			ScopedPointer<CallbackProgram> program;
 			double lastExecutionTime;
 			const Identifier callbackName;
 			int numArgs;
@@ -621,6 +693,11 @@ public:
 			const double bufferTime;
 
 			bool isCallbackDefined = false;
+
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+			int lastNumAllocations = 0;
+			bool allocationWarningSent = false;
+#endif
 		};
 
 		struct JavascriptNamespace: public ReferenceCountedObject,
@@ -802,11 +879,31 @@ public:
 			shouldUseCycleCheck = true;
 		}
 
+		/** Parses the code so that the next execute() call with the same code can skip the parsing. */
+		bool preparse(const String& code, bool allowConstDeclarations);
+
 		HiseSpecialData hiseSpecialData;
 
+		/** The time spent in parsing and running the code passed to execute(). */
+		double parseMilliseconds = 0.0;
+		double executionMilliseconds = 0.0;
+
+		/** This is set while preparse() is running so that the parser can stop at global declarations. */
+		bool preparsing = false;
+
+		/** Writes a parser message to the console (or stores it while preparse() is running). */
+		void logParserMessage(const String& message);
+
+		struct PreparsedCode;
+
 		private:
 
-		Array<CallStackEntry> callStack;
+		BlockStatement* parseStatements(const String& code, bool allowConstDeclarations);
+
+		ScopedPointer<PreparsedCode> preparsedCode;
+
+		/** The minimum size keeps the storage around when the callback entries are removed again. */
+		Array<CallStackEntry, DummyCriticalSection, 32> callStack;
 
 		bool enableCallstack = false;
 
@@ -65,6 +65,11 @@ hiseSpecialData(this)
 	setMethod("typeof", typeof_internal);
 }
 
+HiseJavascriptEngine::RootObject::~RootObject()
+{
+	preparsedCode = nullptr;
+}
+
 
 #if JUCE_MSVC
 #pragma warning (push)
@@ -196,7 +201,17 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (ConstScriptingObject* c = dynamic_cast<ConstScriptingObject*>(thisObject.getObject()))
 			{
-				c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
+				// Objects of the same class share their function table, so the lookup is only needed if the class changes
+				const std::type_info* objectType = &typeid(*c);
+
+				if (objectType != lastObjectType)
+				{
+					lastObjectType = nullptr;
+					c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
+
+					if (functionIndex != -1)
+						lastObjectType = objectType;
+				}
 
 				CHECK_CONDITION_WITH_LOCATION(functionIndex != -1, "function not found");
 				CHECK_CONDITION_WITH_LOCATION(numArgs == arguments.size(), "argument amount mismatch: " + String(arguments.size()) + ", Expected: " + String(numArgs));
@@ -211,7 +226,8 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (DynamicObject* dynObj = thisObject.getDynamicObject())
 			{
-				var property = dynObj->getProperty(dot->child);
+				const var* propertyPointer = dot->cache.getPropertyPointer(dynObj, dot->child);
+				var property = propertyPointer != nullptr ? *propertyPointer : var();
 
 				if (auto obj = dynamic_cast<InlineFunction::Object*>(property.getObject()))
 				{
@@ -756,6 +772,14 @@ void HiseJavascriptEngine::RootObject::Callback::setStatements(BlockStatement *s
 {
 	statements = s;
 	isCallbackDefined = s->statements.size() != 0;
+
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+	allocationWarningSent = false;
+#endif
+
+#if ENABLE_SCRIPTING_BYTECODE
+	program = CallbackProgram::create(*this, statements);
+#endif
 }
 
 
@@ -765,24 +789,59 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 
 	var returnValue = var::undefined();
 
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+	{
+		ScriptAllocationCounter::ScopedCounter sc(lastNumAllocations);
+#endif
+
 #if USE_BACKEND
 	const double pre = Time::getMillisecondCounterHiRes();
 
 
 	root->addToCallStack(callbackName, nullptr);
 
-
-
-	statements->perform(s, &returnValue);
+	returnValue = performStatements(s);
 
 	root->removeFromCallStack(callbackName);
 
 	const double post = Time::getMillisecondCounterHiRes();
 	lastExecutionTime = post - pre;
 #else
-	statements->perform(s, &returnValue);
+	returnValue = performStatements(s);
+#endif
+
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+	}
+
+	if (lastNumAllocations > 0 && !allocationWarningSent)
+	{
+		allocationWarningSent = true;
+
+		auto p = dynamic_cast<Processor*>(root->hiseSpecialData.processor);
+
+		if (p != nullptr)
+			debugError(p, callbackName.toString() + " called operator new " + String(lastNumAllocations) + " times");
+	}
+#endif
+
+	return returnValue;
+}
+
+var HiseJavascriptEngine::RootObject::Callback::performStatements(const Scope& s)
+{
+#if ENABLE_SCRIPTING_BYTECODE
+	if (program != nullptr && program->canExecute())
+	{
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+		return program->executeAndVerify(s, statements);
+#else
+		return program->execute(s);
+#endif
+	}
 #endif
 
+	var returnValue = var::undefined();
+	statements->perform(s, &returnValue);
 	return returnValue;
 }
 
@@ -806,5 +865,62 @@ void ScriptingObject::reportScriptError(const String &errorMessage) const
 #endif
 }
 
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+
+static thread_local int* currentAllocationCounter = nullptr;
+
+ScriptAllocationCounter::ScopedCounter::ScopedCounter(int& numAllocationsToWrite) noexcept:
+	target(numAllocationsToWrite),
+	previousCounter(currentAllocationCounter)
+{
+	currentAllocationCounter = &numAllocations;
+}
+
+ScriptAllocationCounter::ScopedCounter::~ScopedCounter()
+{
+	currentAllocationCounter = previousCounter;
+
+	if (previousCounter != nullptr)
+		*previousCounter += numAllocations;
+
+	target = numAllocations;
+}
+
+void ScriptAllocationCounter::countAllocation() noexcept
+{
+	if (currentAllocationCounter != nullptr)
+		++(*currentAllocationCounter);
+}
+
+#endif
+
 } // namespace hise
 
+#if ENABLE_SCRIPTING_ALLOCATION_COUNTER
+
+void* operator new(std::size_t size)
+{
+	hise::ScriptAllocationCounter::countAllocation();
+
+	if (void* p = std::malloc(size != 0 ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	hise::ScriptAllocationCounter::countAllocation();
+	return std::malloc(size != 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size)                               { return operator new(size); }
+void* operator new[](std::size_t size, const std::nothrow_t& nt) noexcept { return operator new(size, nt); }
+
+void operator delete(void* p) noexcept                          { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept   { std::free(p); }
+void operator delete[](void* p) noexcept                        { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#endif
+
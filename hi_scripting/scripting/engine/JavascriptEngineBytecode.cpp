@@ -0,0 +1,1116 @@
+namespace hise { using namespace juce;
+
+/** A callback body compiled into a linear list of register instructions.
+
+	The compiler walks the statement tree once after the callback was parsed and resolves every operand:
+
+	- temporary values are stored in a register file that is owned by the program.
+	- callback parameters, callback locals and `reg` variables are addressed by a pointer to their storage.
+	- literals and API constants are stored in a constant pool.
+	- `const var` slots are read from their namespace by index.
+
+	Arithmetic and comparisons on numbers are computed inline without creating any nodes. Everything else
+	uses the code of the tree interpreter, so statements and expressions without an instruction (eg. inline
+	function calls or for...in loops) are simply executed by calling their perform() / getResult() method.
+
+	If ENABLE_SCRIPTING_BYTECODE_VERIFICATION is set, the program checks its results against the tree interpreter.
+*/
+struct HiseJavascriptEngine::RootObject::CallbackProgram
+{
+	enum class OperandType : uint8
+	{
+		Temp = 0,
+		Pointer,
+		Constant,
+		ConstObject,
+		numOperandTypes
+	};
+
+	struct Operand
+	{
+		Operand() noexcept {}
+		Operand(OperandType t, int i) noexcept : type(t), index((uint16)i) {}
+
+		bool isSlot() const noexcept { return type == OperandType::Temp || type == OperandType::Pointer; }
+
+		OperandType type = OperandType::Constant;
+		uint16 index = 0;
+	};
+
+	enum class OpCode : uint8
+	{
+		Move = 0,				// dst = a
+		ToBool,					// dst = (bool)a
+		Add,					// dst = a + b (also the ops below until BinaryOp)
+		Subtract,
+		Multiply,
+		Equals,
+		NotEquals,
+		LessThan,
+		LessThanOrEqual,
+		GreaterThan,
+		GreaterThanOrEqual,
+		BinaryOp,				// dst = node->getWithValues(a, b)
+		Jump,					// goto target
+		JumpIfFalse,			// if(!a) goto target
+		JumpIfTrue,				// if(a) goto target
+		CallApi,				// dst = node->apiClass->callFunction(a ... a + numArgs)
+		Evaluate,				// dst = node->getResult()
+		AssignTo,				// node->assign(a)
+		Perform,				// node->perform(), break -> target, continue -> target2
+		CheckTimeout,
+		Return,					// return a
+		Exit,
+		numOpCodes
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		Operand dst, a, b;
+		uint16 numArgs;
+		int target, target2;
+		const Statement* node;
+	};
+
+	struct ConstSlot
+	{
+		JavascriptNamespace* ns;
+		int index;
+	};
+
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+
+	/** The instructions of a statement that only reads and writes variables. It is executed without jumping 
+		out of the range, so it can be checked against the tree interpreter when the program reaches the end. 
+	*/
+	struct VerifiedRange
+	{
+		int start;
+		int end;
+		const Statement* node;
+	};
+
+#endif
+
+	CallbackProgram(Callback& c) :
+		callbackName(c.getName()),
+		locals(c.localProperties),
+		numLocals(c.localProperties.size())
+	{}
+
+	/** Compiles the body of the callback. Returns nullptr if the callback must be executed by the tree interpreter. */
+	static CallbackProgram* create(Callback& c, const BlockStatement* body)
+	{
+		if (body == nullptr || body->statements.size() == 0)
+			return nullptr;
+
+		ScopedPointer<CallbackProgram> p = new CallbackProgram(c);
+
+		Compiler compiler(*p, c);
+
+		if (!compiler.compileBody(body))
+			return nullptr;
+
+		return p.release();
+	}
+
+	/** The program can't be executed recursively and must be thrown away if the callback got new local variables. */
+	bool canExecute() const noexcept
+	{
+		return !isExecuting && locals.size() == numLocals;
+	}
+
+	var execute(const Scope& s)
+	{
+		ScopedValueSetter<bool> svs(isExecuting, true);
+		ScopedRegisterCleaner src(*this);
+
+		var returnValue = var::undefined();
+
+		const Instruction* code = instructions.getRawDataPointer();
+		int pc = 0;
+
+		for (;;)
+		{
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+			if (verifyRanges)
+				checkVerifiedRanges(s, pc);
+#endif
+
+			const Instruction& i = code[pc++];
+
+			switch (i.op)
+			{
+			case OpCode::Move:		getSlot(i.dst) = read(i.a); break;
+			case OpCode::ToBool:	getSlot(i.dst) = static_cast<bool>(read(i.a)); break;
+			case OpCode::Add:
+			case OpCode::Subtract:
+			case OpCode::Multiply:
+			case OpCode::Equals:
+			case OpCode::NotEquals:
+			case OpCode::LessThan:
+			case OpCode::LessThanOrEqual:
+			case OpCode::GreaterThan:
+			case OpCode::GreaterThanOrEqual:
+			{
+				const var& a = read(i.a);
+				const var& b = read(i.b);
+
+				if (isNumber(a) && isNumber(b))
+				{
+					var result = getWithNumbers(i.op, a, b);
+
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+					verifyValue(s, i, result, getBinaryOperator(i)->getWithValues(a, b));
+#endif
+
+					getSlot(i.dst) = result;
+				}
+				else
+					getSlot(i.dst) = getBinaryOperator(i)->getWithValues(a, b);
+
+				break;
+			}
+			case OpCode::BinaryOp:		getSlot(i.dst) = getBinaryOperator(i)->getWithValues(read(i.a), read(i.b)); break;
+			case OpCode::Jump:			pc = i.target; break;
+			case OpCode::JumpIfFalse:	if (!static_cast<bool>(read(i.a))) pc = i.target; break;
+			case OpCode::JumpIfTrue:	if (static_cast<bool>(read(i.a))) pc = i.target; break;
+			case OpCode::CallApi:		getSlot(i.dst) = callApi(i); break;
+			case OpCode::Evaluate:		getSlot(i.dst) = static_cast<const Expression*>(i.node)->getResult(s); break;
+			case OpCode::AssignTo:		static_cast<const Expression*>(i.node)->assign(s, read(i.a)); break;
+			case OpCode::Perform:
+			{
+				const Statement::ResultCode r = i.node->perform(s, &returnValue);
+
+				if (r == Statement::ok)
+					break;
+
+				const int nextInstruction = r == Statement::breakWasHit ? i.target :
+											r == Statement::continueWasHit ? i.target2 : -1;
+
+				// A return statement, or a break / continue outside of a compiled loop ends the callback
+				if (nextInstruction == -1)
+					return returnValue;
+
+				pc = nextInstruction;
+				break;
+			}
+			case OpCode::CheckTimeout:	s.checkTimeOut(i.node->location); break;
+			case OpCode::Return:		returnValue = read(i.a); return returnValue;
+			case OpCode::Exit:			return returnValue;
+			case OpCode::numOpCodes:
+			default:					jassertfalse; return returnValue;
+			}
+		}
+	}
+
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+
+	/** Executes the program and compares the result with the tree interpreter.
+
+		Every statement that only reads and writes variables (see VerifiedRange) is checked when the program
+		has executed its instructions: the variables are reset to their values before the statement, the
+		statement is executed by the tree interpreter and all variables are compared with the program state.
+		Statements with other side effects (API calls or tree nodes) are executed once, their inline arithmetic
+		is checked against the operator nodes.
+
+		Programs that only change callback locals and `reg` variables are executed twice: the values that the
+		program wrote are restored and the callback is executed again by the tree interpreter, so that the
+		return value and every written variable can be compared.
+	*/
+	var executeAndVerify(const Scope& s, const BlockStatement* body)
+	{
+		ScopedValueSetter<bool> svs(verifyRanges, true);
+		activeRange = -1;
+
+		if (!isPure || hasObjectOperands())
+			return execute(s);
+
+		Array<var> initialValues;
+
+		for (auto index : writtenPointers)
+			initialValues.add(*pointers[index]);
+
+		var programResult = execute(s);
+
+		Array<var> programValues;
+
+		for (int i = 0; i < writtenPointers.size(); i++)
+		{
+			programValues.add(*pointers[writtenPointers[i]]);
+			*pointers[writtenPointers[i]] = initialValues[i];
+		}
+
+		var treeResult = var::undefined();
+		body->perform(s, &treeResult);
+
+		if (!treeResult.equalsWithSameType(programResult))
+			reportMismatch(s, "return value: " + treeResult.toString() + " vs. " + programResult.toString());
+
+		for (int i = 0; i < writtenPointers.size(); i++)
+		{
+			const var& treeValue = *pointers[writtenPointers[i]];
+
+			if (!treeValue.equalsWithSameType(programValues[i]))
+				reportMismatch(s, "variable value: " + treeValue.toString() + " vs. " + programValues[i].toString());
+		}
+
+		return treeResult;
+	}
+
+	/** Operators can change objects in place (eg. buffer += 1), so a program that reads an object can't be executed twice. */
+	bool hasObjectOperands() const
+	{
+		auto isObject = [](const var& v) { return v.isObject() || v.isArray(); };
+
+		for (auto ptr : pointers)
+			if (isObject(*ptr))
+				return true;
+
+		for (const auto& c : constants)
+			if (isObject(c))
+				return true;
+
+		for (const auto& c : constSlots)
+			if (isObject(c.ns->constObjects.getValueAt(c.index)))
+				return true;
+
+		return false;
+	}
+
+	/** Starts or finishes the verification of a statement at the given instruction. */
+	void checkVerifiedRanges(const Scope& s, int pc)
+	{
+		if (activeRange != -1 && verifiedRanges.getReference(activeRange).end == pc)
+			finishVerifiedRange(s);
+
+		if (activeRange == -1 && rangeStarts[pc] != -1 && !readsObjects(verifiedRanges.getReference(rangeStarts[pc])))
+		{
+			activeRange = rangeStarts[pc];
+
+			rangeSnapshot.clearQuick();
+
+			for (auto ptr : pointers)
+				rangeSnapshot.add(*ptr);
+		}
+	}
+
+	/** Executes the statement of the active range with the tree interpreter and compares all variables. */
+	void finishVerifiedRange(const Scope& s)
+	{
+		const VerifiedRange& r = verifiedRanges.getReference(activeRange);
+		activeRange = -1;
+
+		Array<var> programValues;
+
+		for (int i = 0; i < pointers.size(); i++)
+		{
+			programValues.add(*pointers[i]);
+			*pointers[i] = rangeSnapshot[i];
+		}
+
+		var unused;
+		r.node->perform(s, &unused);
+
+		for (int i = 0; i < pointers.size(); i++)
+		{
+			const var& treeValue = *pointers[i];
+
+			if (!treeValue.equalsWithSameType(programValues[i]))
+			{
+				int col, line;
+				r.node->location.fillColumnAndLines(col, line);
+
+				reportMismatch(s, "Line " + String(line) + ", variable value: " + treeValue.toString() + " vs. " + programValues[i].toString());
+			}
+
+			// Continue with the program state
+			*pointers[i] = programValues[i];
+		}
+	}
+
+	/** Operators can change objects in place, so a statement that reads an object can't be executed twice. */
+	bool readsObjects(const VerifiedRange& r) const
+	{
+		auto isObject = [this](const Operand& o) 
+		{ 
+			if (o.type == OperandType::Temp)
+				return false;
+
+			const var& v = read(o);
+			return v.isObject() || v.isArray(); 
+		};
+
+		for (int i = r.start; i < r.end; i++)
+		{
+			const Instruction& instruction = instructions.getReference(i);
+
+			if (isObject(instruction.dst) || isObject(instruction.a) || isObject(instruction.b))
+				return true;
+		}
+
+		return false;
+	}
+
+	void verifyValue(const Scope& s, const Instruction& i, const var& programValue, const var& treeValue) const
+	{
+		if (!treeValue.equalsWithSameType(programValue))
+		{
+			int col, line;
+			i.node->location.fillColumnAndLines(col, line);
+
+			reportMismatch(s, "Line " + String(line) + ": " + treeValue.toString() + " vs. " + programValue.toString());
+		}
+	}
+
+	void reportMismatch(const Scope& s, const String& message) const
+	{
+		auto p = dynamic_cast<Processor*>(s.root->hiseSpecialData.processor);
+
+		if (p != nullptr)
+			debugError(p, "Bytecode mismatch in " + callbackName.toString() + "(): " + message);
+
+		DBG("Bytecode mismatch in " + callbackName.toString() + "(): " + message);
+		jassertfalse;
+	}
+
+#endif
+
+private:
+
+	struct ScopedRegisterCleaner
+	{
+		ScopedRegisterCleaner(CallbackProgram& p_) noexcept : p(p_) {}
+
+		/** Releases the temporary values so that objects are not kept alive until the next callback. */
+		~ScopedRegisterCleaner()
+		{
+			for (int i = 0; i < p.numRegisters; i++)
+				p.registers[i] = var();
+		}
+
+		CallbackProgram& p;
+	};
+
+	static bool isNumber(const var& v) noexcept
+	{
+		return v.isInt() || v.isInt64() || v.isDouble();
+	}
+
+	/** Mirrors BinaryOperator::getWithValues() for two numbers. */
+	static var getWithNumbers(OpCode op, const var& a, const var& b) noexcept
+	{
+		if (a.isDouble() || b.isDouble())
+		{
+			const double x = a;
+			const double y = b;
+
+			switch (op)
+			{
+			case OpCode::Add:					return x + y;
+			case OpCode::Subtract:				return x - y;
+			case OpCode::Multiply:				return x * y;
+			case OpCode::Equals:				return x == y;
+			case OpCode::NotEquals:				return x != y;
+			case OpCode::LessThan:				return x < y;
+			case OpCode::LessThanOrEqual:		return x <= y;
+			case OpCode::GreaterThan:			return x > y;
+			case OpCode::GreaterThanOrEqual:	return x >= y;
+			default:							jassertfalse; return var();
+			}
+		}
+
+		const int64 x = a;
+		const int64 y = b;
+
+		switch (op)
+		{
+		case OpCode::Add:					return x + y;
+		case OpCode::Subtract:				return x - y;
+		case OpCode::Multiply:				return x * y;
+		case OpCode::Equals:				return x == y;
+		case OpCode::NotEquals:				return x != y;
+		case OpCode::LessThan:				return x < y;
+		case OpCode::LessThanOrEqual:		return x <= y;
+		case OpCode::GreaterThan:			return x > y;
+		case OpCode::GreaterThanOrEqual:	return x >= y;
+		default:							jassertfalse; return var();
+		}
+	}
+
+	static const BinaryOperator* getBinaryOperator(const Instruction& i) noexcept
+	{
+		return static_cast<const BinaryOperator*>(i.node);
+	}
+
+	const var& read(const Operand& o) const noexcept
+	{
+		switch (o.type)
+		{
+		case OperandType::Temp:			return registers[o.index];
+		case OperandType::Pointer:		return *pointers[o.index];
+		case OperandType::Constant:		return constants.getReference(o.index);
+		case OperandType::ConstObject:
+		{
+			const ConstSlot& c = constSlots.getReference(o.index);
+			return c.ns->constObjects.getValueAt(c.index);
+		}
+		case OperandType::numOperandTypes:
+		default:						jassertfalse; return constants.getReference(0);
+		}
+	}
+
+	var& getSlot(const Operand& o) noexcept
+	{
+		jassert(o.isSlot());
+		return o.type == OperandType::Temp ? registers[o.index] : *pointers[o.index];
+	}
+
+	var callApi(const Instruction& i) const
+	{
+		const ApiCall* call = static_cast<const ApiCall*>(i.node);
+		var* args = registers + i.a.index;
+
+		for (int n = 0; n < i.numArgs; n++)
+			HiseJavascriptEngine::checkValidParameter(n, args[n], call->location);
+
+		if (call->apiClass == nullptr)
+			call->location.throwError("API class does not exist");
+
+		try
+		{
+			return call->apiClass->callFunction(call->functionIndex, args, i.numArgs);
+		}
+		catch (String& error)
+		{
+			throw Error::fromLocation(call->location, error);
+		}
+	}
+
+	// ============================================================================================================
+
+	struct Compiler
+	{
+		Compiler(CallbackProgram& p_, Callback& c_) : p(p_), callback(c_) {}
+
+		bool compileBody(const BlockStatement* body)
+		{
+			compileBlock(body);
+			emit(OpCode::Exit);
+
+			// A single perform instruction would only add overhead to the tree interpreter
+			if (p.instructions.size() == 2 && p.instructions.getFirst().op == OpCode::Perform)
+				return false;
+
+			if (failed)
+				return false;
+
+			p.constants.add(var()); // makes sure that the default operand can always be read
+			p.registerStorage.insertMultiple(0, var(), jmax(1, maxNumTemps));
+			p.registers = p.registerStorage.getRawDataPointer();
+			p.numRegisters = maxNumTemps;
+
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+			p.rangeStarts.insertMultiple(0, -1, p.instructions.size());
+
+			for (int i = 0; i < p.verifiedRanges.size(); i++)
+				p.rangeStarts.set(p.verifiedRanges[i].start, i);
+#endif
+
+			return true;
+		}
+
+		void compileBlock(const BlockStatement* b)
+		{
+			if (b->lockStatements.size() != 0)
+			{
+				emitPerform(b);
+				return;
+			}
+
+			for (auto st : b->statements)
+			{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+				if (st->breakpointReference.index != -1)
+				{
+					failed = true;
+					return;
+				}
+#endif
+
+				compileStatement(st);
+			}
+		}
+
+		void compileStatement(const Statement* st)
+		{
+			const int tempMark = numTemps;
+
+			if (isEmptyStatement(st))
+			{
+			}
+			else if (auto b = dynamic_cast<const BlockStatement*>(st))
+				compileBlock(b);
+			else if (auto is = dynamic_cast<const IfStatement*>(st))
+				compileIf(is);
+			else if (auto l = dynamic_cast<const LoopStatement*>(st))
+			{
+				if (l->isIterator)
+					emitPerform(l);
+				else
+					compileLoop(l);
+			}
+			else if (auto r = dynamic_cast<const ReturnStatement*>(st))
+				emit(OpCode::Return, {}, compileExpression(r->returnValue));
+			else if (dynamic_cast<const BreakStatement*>(st) != nullptr)
+				emitLoopJump(true);
+			else if (dynamic_cast<const ContinueStatement*>(st) != nullptr)
+				emitLoopJump(false);
+			else if (auto cl = dynamic_cast<const CallbackLocalStatement*>(st))
+			{
+				Operand local;
+				const int start = getPosition();
+
+				if (getLocalOperand(cl->parentCallback, cl->index, local))
+				{
+					compileInto(cl->initialiser, local);
+					addVerifiedRange(start, st);
+				}
+				else
+					emitPerform(st);
+			}
+			else if (auto e = dynamic_cast<const Expression*>(st))
+			{
+				const int start = getPosition();
+				compileExpression(e);
+				addVerifiedRange(start, st);
+			}
+			else
+				emitPerform(st);
+
+			numTemps = tempMark;
+		}
+
+		/** Adds the instructions of the statement as range that can be verified if they only read and write variables. */
+		void addVerifiedRange(int start, const Statement* st)
+		{
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+			const int end = getPosition();
+
+			if (end == start)
+				return;
+
+			for (int i = start; i < end; i++)
+			{
+				const Instruction& instruction = p.instructions.getReference(i);
+
+				switch (instruction.op)
+				{
+				case OpCode::Move:
+				case OpCode::ToBool:
+				case OpCode::Add:
+				case OpCode::Subtract:
+				case OpCode::Multiply:
+				case OpCode::Equals:
+				case OpCode::NotEquals:
+				case OpCode::LessThan:
+				case OpCode::LessThanOrEqual:
+				case OpCode::GreaterThan:
+				case OpCode::GreaterThanOrEqual:
+				case OpCode::BinaryOp:
+					break;
+				case OpCode::Jump:
+				case OpCode::JumpIfFalse:
+				case OpCode::JumpIfTrue:
+					// The range must be executed from the start to the end
+					if (instruction.target < start || instruction.target > end)
+						return;
+					break;
+				default:
+					return;
+				}
+			}
+
+			p.verifiedRanges.add({ start, end, st });
+#else
+			ignoreUnused(start, st);
+#endif
+		}
+
+		void compileIf(const IfStatement* is)
+		{
+			const int jumpToFalse = emit(OpCode::JumpIfFalse, {}, compileExpression(is->condition));
+
+			compileStatement(is->trueBranch);
+
+			if (isEmptyStatement(is->falseBranch))
+			{
+				setJumpTarget(jumpToFalse);
+			}
+			else
+			{
+				const int jumpToEnd = emit(OpCode::Jump);
+				setJumpTarget(jumpToFalse);
+				compileStatement(is->falseBranch);
+				setJumpTarget(jumpToEnd);
+			}
+		}
+
+		/** Mirrors the control flow of LoopStatement::perform(). */
+		void compileLoop(const LoopStatement* l)
+		{
+			if (l->initialiser != nullptr)
+				compileStatement(l->initialiser);
+
+			loops.add(LoopTargets());
+
+			const int start = getPosition();
+			int exitJump = -1;
+
+			if (!l->isDoLoop)
+				exitJump = emit(OpCode::JumpIfFalse, {}, compileExpression(l->condition));
+
+			emit(OpCode::CheckTimeout, {}, {}, {}, l);
+			compileStatement(l->body);
+
+			int continueTarget;
+
+			if (l->isDoLoop)
+			{
+				compileIterator(l);
+				emit(OpCode::JumpIfTrue, {}, compileExpression(l->condition), {}, nullptr, start);
+				const int jumpToEnd = emit(OpCode::Jump);
+
+				// A continue in a do loop skips the condition check
+				continueTarget = getPosition();
+				compileIterator(l);
+				emit(OpCode::Jump, {}, {}, {}, nullptr, start);
+
+				setJumpTarget(jumpToEnd);
+			}
+			else
+			{
+				continueTarget = getPosition();
+				compileIterator(l);
+				emit(OpCode::Jump, {}, {}, {}, nullptr, start);
+				setJumpTarget(exitJump);
+			}
+
+			const int breakTarget = getPosition();
+			const LoopTargets targets = loops.removeAndReturn(loops.size() - 1);
+
+			for (auto j : targets.breakJumps)
+				p.instructions.getReference(j).target = breakTarget;
+
+			for (auto j : targets.continueJumps)
+				p.instructions.getReference(j).target = continueTarget;
+
+			for (auto j : targets.performs)
+			{
+				p.instructions.getReference(j).target = breakTarget;
+				p.instructions.getReference(j).target2 = continueTarget;
+			}
+		}
+
+		void compileIterator(const LoopStatement* l)
+		{
+			if (l->iterator != nullptr)
+				compileStatement(l->iterator);
+		}
+
+		// ========================================================================================================
+
+		/** Returns the operand that holds the value of the expression after its instructions were executed. */
+		Operand compileExpression(const Expression* e)
+		{
+			Operand result;
+
+			if (getLeafOperand(e, result))
+				return result;
+
+			if (isMultiStepExpression(e))
+				return compileMultiStepExpression(e);
+
+			result = allocateTemps(1);
+			compileSingleStepExpression(e, result);
+			return result;
+		}
+
+		/** Writes the value of the expression into the given slot. */
+		void compileInto(const Expression* e, Operand dst)
+		{
+			Operand source;
+
+			if (getLeafOperand(e, source))
+				emit(OpCode::Move, dst, source);
+			else if (isMultiStepExpression(e))
+				emit(OpCode::Move, dst, compileMultiStepExpression(e));
+			else
+				compileSingleStepExpression(e, dst);
+		}
+
+		/** These expressions write their target only after all operands have been evaluated. */
+		void compileSingleStepExpression(const Expression* e, Operand dst)
+		{
+			if (auto bo = dynamic_cast<const BinaryOperator*>(e))
+			{
+				Operand a = compileExpression(bo->lhs);
+
+				// The left operand must keep its value if the right operand changes it (eg. x + x++)
+				if (!isLeaf(bo->rhs) && (a.type == OperandType::Pointer || a.type == OperandType::ConstObject))
+				{
+					const Operand copy = allocateTemps(1);
+					emit(OpCode::Move, copy, a);
+					a = copy;
+				}
+
+				const Operand b = compileExpression(bo->rhs);
+
+				emit(getOpCode(bo->operation), dst, a, b, bo);
+			}
+			else if (auto call = dynamic_cast<const ApiCall*>(e))
+			{
+				const int numArgs = call->expectedNumArguments;
+				const Operand args = allocateTemps(numArgs);
+
+				for (int i = 0; i < numArgs; i++)
+					compileInto(call->argumentList[i], Operand(OperandType::Temp, args.index + i));
+
+				const int index = emit(OpCode::CallApi, dst, args, {}, call);
+				p.instructions.getReference(index).numArgs = (uint16)numArgs;
+				p.isPure = false;
+			}
+			else
+			{
+				emit(OpCode::Evaluate, dst, {}, {}, e);
+				p.isPure = false;
+			}
+		}
+
+		Operand compileMultiStepExpression(const Expression* e)
+		{
+			if (auto a = dynamic_cast<const Assignment*>(e))
+				return compileAssignment(a->target, a->newValue);
+
+			if (auto pa = dynamic_cast<const PostAssignment*>(e))
+			{
+				const Operand oldValue = allocateTemps(1);
+				Operand target;
+
+				if (getAssignableOperand(pa->target, target))
+				{
+					emit(OpCode::Move, oldValue, target);
+					compileInto(pa->newValue, target);
+				}
+				else
+				{
+					emit(OpCode::Evaluate, oldValue, {}, {}, pa->target);
+					emit(OpCode::AssignTo, {}, compileExpression(pa->newValue), {}, pa->target);
+					p.isPure = false;
+				}
+
+				return oldValue;
+			}
+
+			if (auto sa = dynamic_cast<const SelfAssignment*>(e))
+				return compileAssignment(sa->target, sa->newValue);
+
+			const Operand result = allocateTemps(1);
+
+			if (auto c = dynamic_cast<const ConditionalOp*>(e))
+			{
+				const int jumpToFalse = emit(OpCode::JumpIfFalse, {}, compileExpression(c->condition));
+				compileInto(c->trueBranch, result);
+				const int jumpToEnd = emit(OpCode::Jump);
+				setJumpTarget(jumpToFalse);
+				compileInto(c->falseBranch, result);
+				setJumpTarget(jumpToEnd);
+			}
+			else if (auto lo = dynamic_cast<const BinaryOperatorBase*>(e))
+			{
+				const bool isAnd = dynamic_cast<const LogicalAndOp*>(e) != nullptr;
+				jassert(isAnd || dynamic_cast<const LogicalOrOp*>(e) != nullptr);
+
+				emit(OpCode::ToBool, result, compileExpression(lo->lhs));
+				const int shortCircuit = emit(isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue, {}, result);
+				emit(OpCode::ToBool, result, compileExpression(lo->rhs));
+				setJumpTarget(shortCircuit);
+			}
+			else
+				jassertfalse;
+
+			return result;
+		}
+
+		Operand compileAssignment(const Expression* target, const Expression* newValue)
+		{
+			Operand slot;
+
+			if (getAssignableOperand(target, slot))
+			{
+				compileInto(newValue, slot);
+				return slot;
+			}
+
+			const Operand value = compileExpression(newValue);
+			emit(OpCode::AssignTo, {}, value, {}, target);
+			p.isPure = false;
+			return value;
+		}
+
+		// ========================================================================================================
+
+		static bool isEmptyStatement(const Statement* st)
+		{
+			return st == nullptr || typeid(*st) == typeid(Statement);
+		}
+
+		static bool isMultiStepExpression(const Expression* e)
+		{
+			return dynamic_cast<const Assignment*>(e) != nullptr ||
+				   dynamic_cast<const SelfAssignment*>(e) != nullptr ||
+				   dynamic_cast<const ConditionalOp*>(e) != nullptr ||
+				   dynamic_cast<const LogicalAndOp*>(e) != nullptr ||
+				   dynamic_cast<const LogicalOrOp*>(e) != nullptr;
+		}
+
+		bool isLeaf(const Expression* e)
+		{
+			Operand unused;
+			return getLeafOperand(e, unused, false);
+		}
+
+		/** Resolves the expressions that can be read without executing any code. */
+		bool getLeafOperand(const Expression* e, Operand& result, bool addToProgram=true)
+		{
+			if (typeid(*e) == typeid(Expression))
+				return getConstantOperand(var::undefined(), result, addToProgram);
+
+			if (auto l = dynamic_cast<const LiteralValue*>(e))
+				return getConstantOperand(l->value, result, addToProgram);
+
+			if (auto ac = dynamic_cast<const ApiConstant*>(e))
+				return getConstantOperand(ac->value, result, addToProgram);
+
+			if (auto cr = dynamic_cast<const ConstReference*>(e))
+			{
+				if (addToProgram)
+				{
+					result = Operand(OperandType::ConstObject, p.constSlots.size());
+					p.constSlots.add({ cr->ns, cr->index });
+				}
+
+				return checkNumOperands(p.constSlots.size());
+			}
+
+			return getAssignableOperand(e, result, addToProgram) || getParameterOperand(e, result, addToProgram);
+		}
+
+		bool getConstantOperand(const var& value, Operand& result, bool addToProgram)
+		{
+			if (addToProgram)
+			{
+				result = Operand(OperandType::Constant, p.constants.size());
+				p.constants.add(value);
+			}
+
+			return checkNumOperands(p.constants.size());
+		}
+
+		bool getParameterOperand(const Expression* e, Operand& result, bool addToProgram)
+		{
+			if (auto cp = dynamic_cast<const CallbackParameterReference*>(e))
+				return getPointerOperand(cp->data, result, addToProgram);
+
+			return false;
+		}
+
+		/** Resolves `reg` variables and callback locals, which can be written directly. */
+		bool getAssignableOperand(const Expression* e, Operand& result, bool addToProgram=true)
+		{
+			if (auto rn = dynamic_cast<const RegisterName*>(e))
+				return getPointerOperand(rn->data, result, addToProgram);
+
+			if (auto cl = dynamic_cast<const CallbackLocalReference*>(e))
+				return getLocalOperand(cl->parentCallback, cl->index, result, addToProgram);
+
+			return false;
+		}
+
+		bool getLocalOperand(const Callback* parent, int index, Operand& result, bool addToProgram=true)
+		{
+			if (parent != &callback)
+				return false;
+
+			// The storage of the locals won't move because the callback can't add new locals after it was parsed.
+			return getPointerOperand(callback.localProperties.getVarPointerAt(index), result, addToProgram);
+		}
+
+		bool getPointerOperand(var* data, Operand& result, bool addToProgram)
+		{
+			if (data == nullptr)
+				return false;
+
+			if (addToProgram)
+			{
+				int index = p.pointers.indexOf(data);
+
+				if (index == -1)
+				{
+					index = p.pointers.size();
+					p.pointers.add(data);
+				}
+
+				result = Operand(OperandType::Pointer, index);
+			}
+
+			return checkNumOperands(p.pointers.size());
+		}
+
+		bool checkNumOperands(int numOperands)
+		{
+			if (numOperands > (int)std::numeric_limits<uint16>::max())
+				failed = true;
+
+			return true;
+		}
+
+		static OpCode getOpCode(TokenType operation)
+		{
+			if (operation == TokenTypes::plus)					return OpCode::Add;
+			if (operation == TokenTypes::minus)					return OpCode::Subtract;
+			if (operation == TokenTypes::times)					return OpCode::Multiply;
+			if (operation == TokenTypes::equals)				return OpCode::Equals;
+			if (operation == TokenTypes::notEquals)				return OpCode::NotEquals;
+			if (operation == TokenTypes::lessThan)				return OpCode::LessThan;
+			if (operation == TokenTypes::lessThanOrEqual)		return OpCode::LessThanOrEqual;
+			if (operation == TokenTypes::greaterThan)			return OpCode::GreaterThan;
+			if (operation == TokenTypes::greaterThanOrEqual)	return OpCode::GreaterThanOrEqual;
+
+			return OpCode::BinaryOp;
+		}
+
+		// ========================================================================================================
+
+		Operand allocateTemps(int numToAllocate)
+		{
+			const Operand first(OperandType::Temp, numTemps);
+
+			numTemps += numToAllocate;
+			maxNumTemps = jmax(maxNumTemps, numTemps);
+
+			checkNumOperands(numTemps);
+
+			return first;
+		}
+
+		int emit(OpCode op, Operand dst = {}, Operand a = {}, Operand b = {}, const Statement* node = nullptr, int target = -1)
+		{
+			if (dst.type == OperandType::Pointer && !p.writtenPointers.contains(dst.index))
+				p.writtenPointers.add(dst.index);
+
+			Instruction i;
+
+			i.op = op;
+			i.dst = dst;
+			i.a = a;
+			i.b = b;
+			i.numArgs = 0;
+			i.target = target;
+			i.target2 = -1;
+			i.node = node;
+
+			p.instructions.add(i);
+
+			return p.instructions.size() - 1;
+		}
+
+		void emitPerform(const Statement* st)
+		{
+			const int index = emit(OpCode::Perform, {}, {}, {}, st);
+			p.isPure = false;
+
+			if (!loops.isEmpty())
+				loops.getReference(loops.size() - 1).performs.add(index);
+		}
+
+		void emitLoopJump(bool isBreak)
+		{
+			// The tree interpreter stops executing the callback if a break / continue statement is not inside a loop
+			if (loops.isEmpty())
+			{
+				emit(OpCode::Exit);
+				return;
+			}
+
+			const int index = emit(OpCode::Jump);
+			auto& targets = loops.getReference(loops.size() - 1);
+
+			(isBreak ? targets.breakJumps : targets.continueJumps).add(index);
+		}
+
+		int getPosition() const { return p.instructions.size(); }
+
+		void setJumpTarget(int instructionIndex)
+		{
+			p.instructions.getReference(instructionIndex).target = getPosition();
+		}
+
+		struct LoopTargets
+		{
+			Array<int> breakJumps;
+			Array<int> continueJumps;
+			Array<int> performs;
+		};
+
+		CallbackProgram& p;
+		Callback& callback;
+
+		Array<LoopTargets> loops;
+
+		int numTemps = 0;
+		int maxNumTemps = 0;
+
+		bool failed = false;
+	};
+
+	// ============================================================================================================
+
+	const Identifier callbackName;
+
+	Array<Instruction> instructions;
+
+	Array<var> registerStorage;
+	var* registers = nullptr;
+	int numRegisters = 0;
+
+	Array<var*> pointers;
+	Array<var> constants;
+	Array<ConstSlot> constSlots;
+
+	Array<int> writtenPointers;
+
+#if ENABLE_SCRIPTING_BYTECODE_VERIFICATION
+
+	Array<VerifiedRange> verifiedRanges;
+
+	// The index of the range that starts at each instruction or -1
+	Array<int> rangeStarts;
+
+	Array<var> rangeSnapshot;
+	int activeRange = -1;
+	bool verifyRanges = false;
+
+#endif
+
+	const NamedValueSet& locals;
+	const int numLocals;
+
+	bool isPure = true;
+	bool isExecuting = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CallbackProgram)
+};
+
+} // namespace hise
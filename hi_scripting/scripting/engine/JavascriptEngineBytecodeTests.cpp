@@ -0,0 +1,123 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+/** Executes a corpus of callback bodies with the callback program and with the tree interpreter and compares the variables. */
+class CallbackProgramTest : public UnitTest
+{
+public:
+
+	CallbackProgramTest() :
+		UnitTest("Testing callback programs")
+	{};
+
+	void runTest() override
+	{
+		beginTest("Arithmetic");
+
+		expectSameResult("a = 1 + 2 * 3; b = a - 4; c = b * 2.5; d = 7 / 2;");
+		expectSameResult("a = 5; b = 2.0; c = a + b; d = a * b - c;");
+		expectSameResult("a = 17 % 5; b = 3 & 5; c = 3 | 5; d = 1 << 4;");
+		expectSameResult("a = -3; b = a + 0.5; c = b * b; d = c / 0.25;");
+
+		beginTest("Comparisons and logic");
+
+		expectSameResult("a = 3 < 4; b = 3 >= 4; c = 2 == 2.0; d = 2 != 3;");
+		expectSameResult("a = 3; b = a > 2 && a < 5; c = a == 1 || a == 3; d = !b;");
+		expectSameResult("a = 4; b = a > 2 ? 10 : 20; c = a > 8 ? 1.5 : 2; d = b + c;");
+
+		beginTest("Assignments");
+
+		expectSameResult("a = 1; a += 4; b = 2; b *= a; c = 10; c -= b; d = 9; d /= 3;");
+		expectSameResult("a = 0; a++; a++; b = a; b--; c = 2; c++; d = c;");
+
+		beginTest("Branches");
+
+		expectSameResult("a = 5; if(a > 3) b = 1; else b = 2; if(a == 5) { c = 3; d = 4; }");
+		expectSameResult("a = 2; if(a > 3) { b = 1; } else if(a > 1) { b = 2; } else { b = 3; } c = b * 2; d = 0;");
+
+		beginTest("Loops");
+
+		expectSameResult("a = 0; b = 0; for(i = 0; i < 10; i++) { a += i; b = a * 2; } c = a; d = b;");
+		expectSameResult("a = 0; b = 1; while(a < 20) { a += 3; b *= 2; } c = a; d = b;");
+		expectSameResult("a = 0; b = 0; do { a++; b += 0.5; } while(a < 7); c = a; d = b;");
+		expectSameResult("a = 0; b = 0; for(i = 0; i < 20; i++) { if(i == 3) continue; if(i > 10) break; a += i; } c = i; d = b;");
+
+		beginTest("Strings");
+
+		expectSameResult("a = \"x\"; b = a + 1; c = b + 2.5; d = c + a;");
+		expectSameResult("a = 3; b = \"value: \" + a; c = b == \"value: 3\"; d = \"\";");
+	}
+
+private:
+
+	/** Executes the body as callback and as top level statements and checks that both leave the same values. */
+	void expectSameResult(const String& body)
+	{
+		const String declarations = "reg a = 0; reg b = 0; reg c = 0; reg d = 0; reg i = 0;";
+
+		ScopedPointer<HiseJavascriptEngine> programEngine = new HiseJavascriptEngine(nullptr);
+		ScopedPointer<HiseJavascriptEngine> treeEngine = new HiseJavascriptEngine(nullptr);
+
+		programEngine->registerCallbackName("onTest", 0, 1.0);
+
+		Result r = programEngine->execute(declarations + "function onTest() { " + body + " }");
+		expect(r.wasOk(), r.getErrorMessage());
+
+		programEngine->executeCallback(0, &r);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		r = treeEngine->execute(declarations + body);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		const String values = "[a, b, c, d, i]";
+
+		var programValues = programEngine->evaluate(values);
+		var treeValues = treeEngine->evaluate(values);
+
+		expect(programValues.isArray() && treeValues.isArray(), "Can't evaluate the variables");
+
+		if (!programValues.isArray() || !treeValues.isArray())
+			return;
+
+		for (int i = 0; i < treeValues.size(); i++)
+		{
+			expect(programValues[i].equalsWithSameType(treeValues[i]), body + ": " + 
+				   programValues[i].toString() + " vs. " + treeValues[i].toString());
+		}
+	}
+};
+
+static CallbackProgramTest callbackProgramTest;
+
+} // namespace hise
@@ -503,18 +503,26 @@ struct HiseJavascriptEngine::RootObject::GlobalReference : public Expression
 
 	var getResult(const Scope& s) const override
 	{
-		return s.root->hiseSpecialData.globals->getProperty(id);
+		if (const var* v = cache.getPropertyPointer(s.root->hiseSpecialData.globals, id))
+			return *v;
+
+		return var();
 	}
 
 	void assign(const Scope& s, const var& newValue) const override
 	{
-		s.root->hiseSpecialData.globals->setProperty(id, newValue);
+		if (var* v = cache.getPropertyPointer(s.root->hiseSpecialData.globals, id))
+			*v = newValue;
+		else
+			s.root->hiseSpecialData.globals->setProperty(id, newValue);
 	}
 
 	DynamicObject::Ptr globals;
 	const Identifier id;
 
 	int index;
+
+	PropertyCache cache;
 };
 
 
@@ -525,13 +533,16 @@ struct HiseJavascriptEngine::RootObject::LocalVarStatement : public Statement
 
 	ResultCode perform(const Scope& s, var*) const override
 	{
-		parentFunction->localProperties.set(name, initialiser->getResult(s));
+		*parentFunction->localProperties.getVarPointerAt(index) = initialiser->getResult(s);
 		return ok;
 	}
 
 	mutable InlineFunction::Object* parentFunction;
 	Identifier name;
 	ExpPtr initialiser;
+
+	/** The index in the local properties. Locals are never removed, so the parser can resolve it. */
+	int index = -1;
 };
 
 
@@ -542,12 +553,12 @@ struct HiseJavascriptEngine::RootObject::LocalReference : public Expression
 
 	var getResult(const Scope& /*s*/) const override
 	{
-		return parentFunction->localProperties[id];
+		return parentFunction->localProperties.getValueAt(index);
 	}
 
 	void assign(const Scope& /*s*/, const var& newValue) const override
 	{
-		parentFunction->localProperties.set(id, newValue);
+		*parentFunction->localProperties.getVarPointerAt(index) = newValue;
 	}
 
 	InlineFunction::Object* parentFunction;
@@ -576,35 +587,40 @@ struct HiseJavascriptEngine::RootObject::CallbackLocalStatement : public Stateme
 
 	ResultCode perform(const Scope& s, var*) const override
 	{
-		parentCallback->localProperties.set(name, initialiser->getResult(s));
+		*parentCallback->localProperties.getVarPointerAt(index) = initialiser->getResult(s);
 		return ok;
 	}
 
 	mutable Callback* parentCallback;
 	Identifier name;
 	ExpPtr initialiser;
+
+	/** The index in the local properties of the callback (resolved by the parser). */
+	int index = -1;
 };
 
 struct HiseJavascriptEngine::RootObject::CallbackLocalReference : public Expression
 {
-	CallbackLocalReference(const CodeLocation& l, Callback* parent_, const Identifier& name_) noexcept : 
+	CallbackLocalReference(const CodeLocation& l, Callback* parent_, const Identifier& name_, int index_) noexcept : 
 	Expression(l), 
 	parentCallback(parent_),
-	name(name_)
+	name(name_),
+	index(index_)
 	{}
 
 	var getResult(const Scope& /*s*/) const override
 	{
-		return parentCallback->localProperties[name];
+		return parentCallback->localProperties.getValueAt(index);
 	}
 
 	void assign(const Scope& /*s*/, const var& newValue) const
 	{ 
-		parentCallback->localProperties.set(name, newValue);
+		*parentCallback->localProperties.getVarPointerAt(index) = newValue;
 	}
 
 	Callback* parentCallback;
 	Identifier name;
+	const int index;
 
 	CallbackLocalStatement* target;
 };
@@ -7,16 +7,50 @@ struct HiseJavascriptEngine::RootObject::LiteralValue : public Expression
 	var value;
 };
 
+/** A per-site cache for the property lookup of a DynamicObject.
+
+	It remembers the index of the last found property and checks that the name at this index still matches
+	before it searches the property list. Objects at the same site usually share their layout (eg. the root
+	scope or the scope of a function call), so the lookup doesn't have to compare all names.
+*/
+struct HiseJavascriptEngine::RootObject::PropertyCache
+{
+	var* getPropertyPointer(DynamicObject* o, const Identifier& id) const noexcept
+	{
+		NamedValueSet& properties = o->getProperties();
+		const int index = cachedIndex;
+
+		if (isPositiveAndBelow(index, properties.size()) && properties.getName(index) == id)
+			return properties.getVarPointerAt(index);
+
+		const int newIndex = properties.indexOf(id);
+
+		if (newIndex == -1)
+			return nullptr;
+
+		cachedIndex = newIndex;
+		return properties.getVarPointerAt(newIndex);
+	}
+
+	mutable int cachedIndex = -1;
+};
+
 struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 {
 	UnqualifiedName(const CodeLocation& l, const Identifier& n, bool isFunction) noexcept : Expression(l), name(n), allowUnqualifiedDefinition(isFunction) {}
 
-	var getResult(const Scope& s) const override  { return s.findSymbolInParentScopes(name); }
+	var getResult(const Scope& s) const override
+	{
+		if (const var* v = cache.getPropertyPointer(s.scope, name))
+			return *v;
+
+		return s.parent != nullptr ? s.parent->findSymbolInParentScopes(name) : var::undefined();
+	}
 
 	void assign(const Scope& s, const var& newValue) const override
 	{
 		const Scope* currentScope = &s;
-		var* v = getPropertyPointer(currentScope->scope, name);
+		var* v = cache.getPropertyPointer(currentScope->scope, name);
 
 		while (v == nullptr && currentScope->parent != nullptr)
 		{
@@ -48,6 +82,8 @@ struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 
 	JavascriptNamespace* ns = nullptr;
 	Identifier name;
+
+	PropertyCache cache;
 };
 
 
@@ -95,13 +131,20 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 		else if (const Array<var>* array = result.getArray())
 			return (*array)[static_cast<int> (index->getResult(s))];
 
-        else if (const DynamicObject* obj = result.getDynamicObject())
+        else if (DynamicObject* obj = result.getDynamicObject())
         {
-            const String name = index->getResult(s).toString();
+            if (literalId.isValid())
+            {
+                const var* v = cache.getPropertyPointer(obj, literalId);
+                return v != nullptr ? *v : var();
+            }
+
+            const String key = index->getResult(s).toString();
             
-            if(name.isNotEmpty())
+            if(key.isNotEmpty())
             {
-                return obj->getProperty(Identifier(name));
+                const var* v = getPropertyPointerForKey(obj, key);
+                return v != nullptr ? *v : var();
             }
             
             
@@ -142,9 +185,24 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 		}
         else if (DynamicObject* obj = result.getDynamicObject())
         {
-            const String name = index->getResult(s).toString();
-                     
-            return obj->setProperty(Identifier(name), newValue);
+            if (literalId.isValid())
+            {
+                if (var* v = cache.getPropertyPointer(obj, literalId))
+                    *v = newValue;
+                else
+                    obj->setProperty(literalId, newValue);
+
+                return;
+            }
+
+            const String key = index->getResult(s).toString();
+
+            if (var* v = getPropertyPointerForKey(obj, key))
+                *v = newValue;
+            else
+                obj->setProperty(Identifier(key), newValue);
+
+            return;
         }
 
 
@@ -152,11 +210,33 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 		Expression::assign(s, newValue);
 	}
 
+	/** Searches the properties for a key that is not a string literal.
+
+		This compares the names with the key string, so that a dynamic key isn't added to the string pool
+		unless it creates a new property. String literals are converted by the parser and use the cache.
+	*/
+	static var* getPropertyPointerForKey(DynamicObject* obj, const String& key)
+	{
+		NamedValueSet& properties = obj->getProperties();
+
+		for (int i = 0; i < properties.size(); i++)
+		{
+			if (properties.getName(i) == StringRef(key))
+				return properties.getVarPointerAt(i);
+		}
+
+		return nullptr;
+	}
+
 	void cacheIndex(AssignableObject *instance, const Scope &s) const;
 
 	ExpPtr object, index;
 
 	mutable int cachedIndex = -1;
+
+	Identifier literalId;
+
+	PropertyCache cache;
 };
 
 
@@ -179,7 +259,7 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 		}
 
 		if (DynamicObject* o = p.getDynamicObject())
-			if (const var* v = getPropertyPointer(o, child))
+			if (const var* v = cache.getPropertyPointer(o, child))
 				return *v;
 
 		if (ConstScriptingObject* o = dynamic_cast<ConstScriptingObject*>(p.getObject()))
@@ -197,13 +277,20 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 	void assign(const Scope& s, const var& newValue) const override
 	{
 		if (DynamicObject* o = parent->getResult(s).getDynamicObject())
-			o->setProperty(child, newValue);
+		{
+			if (var* v = cache.getPropertyPointer(o, child))
+				*v = newValue;
+			else
+				o->setProperty(child, newValue);
+		}
 		else
 			Expression::assign(s, newValue);
 	}
 
 	ExpPtr parent;
 	Identifier child;
+
+	PropertyCache cache;
 };
 
 
@@ -271,6 +358,7 @@ struct HiseJavascriptEngine::RootObject::FunctionCall : public Expression
 	mutable ConstScriptingObject* constObject = nullptr;
 	mutable int numArgs = -1;
 	mutable int functionIndex = -1;
+	mutable const std::type_info* lastObjectType = nullptr;
 };
 
 struct HiseJavascriptEngine::RootObject::NewOperator : public FunctionCall
@@ -355,7 +443,7 @@ struct HiseJavascriptEngine::RootObject::FunctionObject : public DynamicObject,
 
 	var invoke(const Scope& s, const var::NativeFunctionArgs& args) const
 	{
-		DynamicObject::Ptr functionRoot(new DynamicObject());
+		DynamicObject::Ptr functionRoot(getScopeForInvocation());
 
 		static const Identifier thisIdent("this");
 		functionRoot->setProperty(thisIdent, args.thisObject);
@@ -370,11 +458,54 @@ struct HiseJavascriptEngine::RootObject::FunctionObject : public DynamicObject,
 #if ENABLE_SCRIPTING_SAFE_CHECKS
 		if(enableCycleCheck)
 			lastScopeForCycleCheck = var(functionRoot);
+		else
 #endif
+			recycleScope(functionRoot, thisIdent);
 
 		return result;
 	}
 
+	/** Returns the scope of the last call if it could be recycled or allocates a new one. */
+	DynamicObject::Ptr getScopeForInvocation() const
+	{
+		DynamicObject::Ptr scope;
+
+		{
+			GenericScopedTryLock<SpinLock> sl(scopeLock);
+
+			if (sl.isLocked())
+			{
+				scope = recycledScope;
+				recycledScope = nullptr;
+			}
+		}
+
+		if (scope == nullptr)
+			scope = new DynamicObject();
+
+		return scope;
+	}
+
+	/** Keeps the scope for the next call if nothing holds a reference to it and it only contains the parameters.
+	*
+	*	The values are cleared, but the property names stay so that the next call doesn't need to allocate.
+	*/
+	void recycleScope(DynamicObject::Ptr& scope, const Identifier& thisIdent) const
+	{
+		if (scope->getReferenceCount() != 1 || scope->getProperties().size() != parameters.size() + 1)
+			return;
+
+		scope->setProperty(thisIdent, var());
+
+		for (int i = 0; i < parameters.size(); ++i)
+			scope->setProperty(parameters.getReference(i), var());
+
+		GenericScopedTryLock<SpinLock> sl(scopeLock);
+
+		if (sl.isLocked())
+			recycledScope = scope;
+	}
+
 	var invokeWithoutAllocation(const Scope &s, const var::NativeFunctionArgs &args, DynamicObject *scope) const
 	{
 		var result;
@@ -433,6 +564,9 @@ struct HiseJavascriptEngine::RootObject::FunctionObject : public DynamicObject,
 	mutable var lastScopeForCycleCheck;
 
 	DynamicObject::Ptr unneededScope;
+
+	mutable DynamicObject::Ptr recycledScope;
+	mutable SpinLock scopeLock;
 };
 
 
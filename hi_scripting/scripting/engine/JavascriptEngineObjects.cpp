@@ -89,14 +89,7 @@ struct HiseJavascriptEngine::RootObject::ArrayClass : public DynamicObject
 	{
 		if (Array<var>* array = a.thisObject.getArray())
 		{
-			Array<var> reversedArray;
-
-			for (int i = array->size()-1; i >= 0; --i)
-			{
-				reversedArray.add(array->getUnchecked(i));
-			}
-
-			array->swapWith(reversedArray);
+			std::reverse(array->begin(), array->end());
 		}
 
 		return var();
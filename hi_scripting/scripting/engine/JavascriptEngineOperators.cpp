@@ -24,6 +24,12 @@ struct HiseJavascriptEngine::RootObject::BinaryOperator : public BinaryOperatorB
 	{
 		var a(lhs->getResult(s)), b(rhs->getResult(s));
 
+		return getWithValues(a, b);
+	}
+
+	/** Applies the operator to already evaluated operands. This is also used by the callback bytecode. */
+	var getWithValues(const var& a, const var& b) const
+	{
 		if (isNumericOrUndefined(a) && isNumericOrUndefined(b))
 			return (a.isDouble() || b.isDouble()) ? getWithDoubles(a, b) : getWithInts(a, b);
 
@@ -234,6 +234,37 @@ private:
 	}
 };
 
+//==============================================================================
+/** The result of RootObject::preparse() that will be picked up by the next execute() call. */
+struct HiseJavascriptEngine::RootObject::PreparsedCode
+{
+	/** Thrown by the parser when it finds a global declaration during preparse(). */
+	struct OrderDependentStatement {};
+
+	PreparsedCode(const String& code_, bool allowConstDeclarations_) :
+		code(code_),
+		allowConstDeclarations(allowConstDeclarations_)
+	{}
+
+	bool matches(const String& otherCode, bool otherAllowConstDeclarations) const
+	{
+		return allowConstDeclarations == otherAllowConstDeclarations && code == otherCode;
+	}
+
+	const String code;
+	const bool allowConstDeclarations;
+
+	ScopedPointer<BlockStatement> statements;
+
+	/** The parse error will be rethrown by execute() so that it's reported like before. */
+	std::exception_ptr error;
+
+	bool isOrderDependent = false;
+
+	/** The console messages of the parser, posted by execute() on the thread that compiles the script. */
+	StringArray consoleMessages;
+};
+
 //==============================================================================
 struct HiseJavascriptEngine::RootObject::ExpressionTreeBuilder : private TokenIterator
 {
@@ -644,7 +675,7 @@ private:
 		{
 			if (hiseSpecialData->includedFiles[i]->f == f)
 			{
-				debugToConsole(dynamic_cast<Processor*>(hiseSpecialData->processor), "File " + shortFileName + " was included multiple times");
+				hiseSpecialData->root->logParserMessage("File " + shortFileName + " was included multiple times");
 				return String();
 			}
 				
@@ -910,6 +941,10 @@ private:
 
 	Statement* parseGlobalAssignment()
 	{
+		// The global object is shared between all scripts, so it must not be changed on a worker thread
+		if (hiseSpecialData->root->preparsing)
+			throw PreparsedCode::OrderDependentStatement();
+
 		ScopedPointer<GlobalVarStatement> s(new GlobalVarStatement(location));
 		s->name = parseIdentifier();
 		
@@ -942,6 +977,7 @@ private:
 			hiseSpecialData->checkIfExistsInOtherStorage(HiseSpecialData::VariableStorageType::LocalScope, s->name, location);
 
 			ifo->localProperties.set(s->name, var::undefined());
+			s->index = ifo->localProperties.indexOf(s->name);
 
 			s->initialiser = matchIf(TokenTypes::assign) ? parseExpression() : new Expression(location);
 
@@ -966,6 +1002,7 @@ private:
 			hiseSpecialData->checkIfExistsInOtherStorage(HiseSpecialData::VariableStorageType::LocalScope, s->name, location);
 
 			callback->localProperties.set(s->name, var());
+			s->index = callback->localProperties.indexOf(s->name);
 
 			s->initialiser = matchIf(TokenTypes::assign) ? parseExpression() : new Expression(location);
 
@@ -1729,6 +1766,14 @@ private:
 			ScopedPointer<ArraySubscript> s(new ArraySubscript(location));
 			s->object = input;
 			s->index = parseExpression();
+
+			// Resolve the identifier of constant string keys here so that obj["key"] doesn't touch the string pool
+			if (auto literal = dynamic_cast<LiteralValue*>(s->index.get()))
+			{
+				if (literal->value.isString() && literal->value.toString().isNotEmpty())
+					s->literalId = Identifier(literal->value.toString());
+			}
+
 			match(TokenTypes::closeBracket);
 			return parseSuffixes(s.release());
 		}
@@ -1778,7 +1823,9 @@ private:
 				if (localParameterIndex >= 0)
 				{
 					parseIdentifier();
-					return parseSuffixes(new LocalReference(location, ob, id));
+					ScopedPointer<LocalReference> r = new LocalReference(location, ob, id);
+					r->index = localParameterIndex;
+					return parseSuffixes(r.release());
 				}
 			}
 
@@ -1856,13 +1903,13 @@ private:
 								return parseSuffixes(new CallbackParameterReference(location, callbackParameter));
 							}
 
-							var* localParameter = c->localProperties.getVarPointer(id);
+							const int localIndex = c->localProperties.indexOf(id);
 
-							if (localParameter != nullptr)
+							if (localIndex != -1)
 							{
 								auto name = parseIdentifier();
 
-								return parseSuffixes(new CallbackLocalReference(location, c, name));
+								return parseSuffixes(new CallbackLocalReference(location, c, name, localIndex));
 							}
 						}
 						else
@@ -2356,7 +2403,7 @@ var HiseJavascriptEngine::RootObject::evaluate(const String& code)
 	return ExpPtr(tb.parseExpression())->getResult(Scope(nullptr, this, this));
 }
 
-void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowConstDeclarations)
+HiseJavascriptEngine::RootObject::BlockStatement* HiseJavascriptEngine::RootObject::parseStatements(const String& code, bool allowConstDeclarations)
 {
 	ExpressionTreeBuilder tb(code, String());
 
@@ -2366,12 +2413,81 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 
 	tb.setupApiData(hiseSpecialData, allowConstDeclarations ? code : String());
 
-	auto sl = ScopedPointer<BlockStatement>(tb.parseStatementList());
+	return tb.parseStatementList();
+}
+
+bool HiseJavascriptEngine::RootObject::preparse(const String& code, bool allowConstDeclarations)
+{
+	preparsedCode = new PreparsedCode(code, allowConstDeclarations);
+
+	const double startTime = Time::getMillisecondCounterHiRes();
+
+	preparsing = true;
+
+	try
+	{
+		preparsedCode->statements = parseStatements(code, allowConstDeclarations);
+	}
+	catch (PreparsedCode::OrderDependentStatement&)
+	{
+		preparsedCode->isOrderDependent = true;
+	}
+	catch (...)
+	{
+		preparsedCode->error = std::current_exception();
+	}
+
+	preparsing = false;
+
+	parseMilliseconds += Time::getMillisecondCounterHiRes() - startTime;
+
+	return !preparsedCode->isOrderDependent;
+}
+
+void HiseJavascriptEngine::RootObject::logParserMessage(const String& message)
+{
+	// preparse() might run on a worker thread, so the message is stored until execute() is called
+	if (preparsing && preparsedCode != nullptr)
+		preparsedCode->consoleMessages.add(message);
+	else
+		debugToConsole(dynamic_cast<Processor*>(hiseSpecialData.processor), message);
+}
+
+void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowConstDeclarations)
+{
+	ScopedPointer<PreparsedCode> pc(preparsedCode.release());
+	ScopedPointer<BlockStatement> sl;
+
+	// The aborted parsing has already changed this engine, so it must be recreated before it can execute the code
+	jassert(pc == nullptr || !pc->isOrderDependent);
+
+	if (pc != nullptr && !pc->isOrderDependent && pc->matches(code, allowConstDeclarations))
+	{
+		for (const auto& m : pc->consoleMessages)
+			logParserMessage(m);
+
+		if (pc->error != nullptr)
+			std::rethrow_exception(pc->error);
+
+		sl = pc->statements.release();
+	}
+	else
+	{
+		const double startTime = Time::getMillisecondCounterHiRes();
+
+		sl = parseStatements(code, allowConstDeclarations);
+
+		parseMilliseconds += Time::getMillisecondCounterHiRes() - startTime;
+	}
 	
 	if(shouldUseCycleCheck)
 		prepareCycleReferenceCheck();
 
+	const double startTime = Time::getMillisecondCounterHiRes();
+
 	sl->perform(Scope(nullptr, this, this), nullptr);
+
+	executionMilliseconds += Time::getMillisecondCounterHiRes() - startTime;
 }
 
 HiseJavascriptEngine::RootObject::FunctionObject::FunctionObject(const FunctionObject& other) : DynamicObject(), functionCode(other.functionCode)
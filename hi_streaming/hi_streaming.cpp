@@ -4,11 +4,12 @@
 
 #include "hi_streaming/SampleThreadPool.cpp"
 #include "hi_streaming/MonolithAudioFormat.cpp"
+#include "hi_streaming/SharedSampleData.cpp"
 #include "hi_streaming/StreamingSampler.cpp"
+#include "hi_streaming/StreamingResampler.cpp"
 #include "hi_streaming/StreamingSamplerSound.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
 
-
-
-
-
+#if HI_RUN_UNIT_TESTS
+#include "hi_streaming/StreamingResamplerTests.cpp"
+#endif
@@ -79,13 +79,34 @@ Set this to true if you add this module to your existing C++ project and don't e
 #endif
 
 
+//=============================================================================
+/** Config: NUM_SAMPLE_STREAMING_THREADS
+
+The number of background threads that are used for the disk streaming (including the sample loading thread).
+*/
+#ifndef NUM_SAMPLE_STREAMING_THREADS
+#define NUM_SAMPLE_STREAMING_THREADS 2
+#endif
+
+//=============================================================================
+/** Config: HISE_SHARE_SAMPLE_DATA
+
+If enabled, the preload buffers and the memory mapped monolith files are shared between all plugin instances of the process.
+*/
+#ifndef HISE_SHARE_SAMPLE_DATA
+#define HISE_SHARE_SAMPLE_DATA 0
+#endif
+
+
 #include "hi_streaming/lockfree_fifo/readerwriterqueue.h"
 
 
 
 #include "hi_streaming/SampleThreadPool.h"
 #include "hi_streaming/MonolithAudioFormat.h"
+#include "hi_streaming/SharedSampleData.h"
 #include "hi_streaming/StreamingSampler.h"
+#include "hi_streaming/StreamingResampler.h"
 #include "hi_streaming/StreamingSamplerSound.h"
 #include "hi_streaming/StreamingSamplerVoice.h"
 
@@ -139,6 +139,8 @@ public:
         
         const int bytesPerFrame = sizeof(int16) * numChannels;
         
+        ScopedLock sl(readLock);
+        
         input->setPosition (1 + startSampleInFile * bytesPerFrame);
         
         while (numSamples > 0)
@@ -181,6 +183,11 @@ public:
             ReadHelper<AudioData::Float32, AudioData::Int16, AudioData::LittleEndian>::read(destSamples, startOffsetInDestBuffer, numDestChannels, sourceData, 2, numSamples);
         }
     }
+
+private:
+    
+    /** The reader is shared by all sounds that use this channel. */
+    CriticalSection readLock;
 };
 
 class HiseMonolithAudioFormat: public AudioFormat,
@@ -317,6 +324,11 @@ public:
     {
         return multiChannelSampleInformation[0][sampleIndex].sampleRate;
     }
+
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
     
 	struct SampleInfo
 	{
@@ -407,6 +419,11 @@ public:
 		return multiChannelSampleInformation[0][sampleIndex].sampleRate;
 	}
 
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
+
 	AudioFormatReader* createMonolithicReader(int sampleIndex, int channelIndex)
 	{
 		const int sizeOfFirstChannelList = (int)multiChannelSampleInformation[0].size();
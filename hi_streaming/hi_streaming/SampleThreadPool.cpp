@@ -33,136 +33,435 @@
 namespace hise { using namespace juce;
 
 
-struct SampleThreadPool::Pimpl
+class SampleThreadPool::Worker : public Thread
 {
-	Pimpl() :
-		jobQueue(2048),
-		currentlyExecutedJob(nullptr),
-		diskUsage(0.0),
-		counter(0)
+public:
+
+	Worker(SampleThreadPool* parent_, int index_, const String& name) :
+		Thread(name + " " + String(index_)),
+		parent(parent_),
+		index(index_)
 	{};
 
-	~Pimpl()
+	void run() override;
+
+private:
+
+	SampleThreadPool* parent;
+	const int index;
+};
+
+/** A bounded lock free queue with multiple producers and a single consumer.
+*
+*	Jobs are added from the audio thread (or the voice rendering workers), the preload thread and the message thread,
+*	so the producers claim their slot with a compare and swap on the write position. Every slot has a sequence number
+*	that tells the consumer whether the producer has finished writing the element (this is Dmitry Vyukov's bounded queue).
+*/
+class MultiProducerJobQueue
+{
+public:
+
+	MultiProducerJobQueue(int capacity) :
+		cells((size_t)nextPowerOfTwo(capacity)),
+		mask(cells.size() - 1),
+		writePosition(0),
+		readPosition(0)
 	{
-		if (Job* currentJob = currentlyExecutedJob.load())
+		for (size_t i = 0; i < cells.size(); i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/** Adds the element. Returns false if the queue is full. This can be called from any thread. */
+	bool tryEnqueue(const WeakReference<SampleThreadPool::Job>& element) noexcept
+	{
+		size_t pos = writePosition.load(std::memory_order_relaxed);
+
+		for (;;)
 		{
-			currentJob->signalJobShouldExit();
+			auto& c = cells[pos & mask];
+			const size_t sequence = c.sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+			if (diff == 0)
+			{
+				if (writePosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					c.element = element;
+					c.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = writePosition.load(std::memory_order_relaxed);
 		}
 	}
 
-	Atomic<int> counter;
+	/** Removes the oldest element. Must only be called by one thread at a time. */
+	bool tryDequeue(WeakReference<SampleThreadPool::Job>& element) noexcept
+	{
+		const size_t pos = readPosition.load(std::memory_order_relaxed);
+		auto& c = cells[pos & mask];
 
-	std::atomic<double> diskUsage;
+		if (c.sequence.load(std::memory_order_acquire) != pos + 1)
+			return false;
 
-	int64 startTime, endTime;
+		element = c.element;
+		c.element = nullptr;
 
-	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
+		readPosition.store(pos + 1, std::memory_order_relaxed);
+		c.sequence.store(pos + mask + 1, std::memory_order_release);
 
-	std::atomic<Job*> currentlyExecutedJob;
+		return true;
+	}
 
-	static const String errorMessage;
-};
+private:
 
-SampleThreadPool::SampleThreadPool() :
-	Thread("Sample Loading Thread"),
-	pimpl(new Pimpl())
-{
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		WeakReference<SampleThreadPool::Job> element;
+	};
 
-	startThread(9);
-}
+	std::vector<Cell> cells;
 
-SampleThreadPool::~SampleThreadPool()
-{
-	pimpl = nullptr;
+	const size_t mask;
 
-	stopThread(300);
-}
+	std::atomic<size_t> writePosition;
+	std::atomic<size_t> readPosition;
 
-double SampleThreadPool::getDiskUsage() const noexcept
-{
-	return pimpl->diskUsage.load();
-}
+	JUCE_DECLARE_NON_COPYABLE(MultiProducerJobQueue)
+};
 
-void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
+struct SampleThreadPool::Pimpl
 {
-	++pimpl->counter;
+	struct WorkerState
+	{
+		WorkerState() :
+			currentlyExecutedJob(nullptr),
+			idle(false),
+			usage(0.0),
+			totalJobTime(0.0),
+			numJobs(0),
+			numMissedDeadlines(0),
+			endTime(0)
+		{};
+
+		Thread* thread = nullptr;
+
+		std::atomic<Job*> currentlyExecutedJob;
+		std::atomic<bool> idle;
+
+		std::atomic<double> usage;
+		std::atomic<double> totalJobTime;
+		std::atomic<int> numJobs;
+		std::atomic<int> numMissedDeadlines;
+
+		int64 endTime;
+	};
+
+	Pimpl(int numWorkers) :
+		jobQueue(2048),
+		counter(0),
+		jobGeneration(0),
+		numStreamedBytes(0)
+	{
+		jassert(numWorkers > 0);
 
-	ignoreUnused(unused);
+		for (int i = 0; i < numWorkers; i++)
+			workerStates.add(new WorkerState());
 
-#if ENABLE_CONSOLE_OUTPUT
-	if (jobToAdd->isQueued())
+		pendingJobs.ensureStorageAllocated(2048);
+	};
+
+	~Pimpl()
 	{
-		Logger::writeToLog(pimpl->errorMessage);
-		Logger::writeToLog(String(pimpl->counter.get()));
+		signalAllJobsShouldExit();
 	}
-#endif
-
 
-	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
+	void signalAllJobsShouldExit()
+	{
+		for (auto w : workerStates)
+		{
+			if (Job* currentJob = w->currentlyExecutedJob.load())
+				currentJob->signalJobShouldExit();
+		}
+	}
 
+	/** Moves all jobs from the (lock free) job queue into the pending list. Must be called with the pendingLock held. */
+	void drainJobQueue()
+	{
+		WeakReference<Job> next;
 
-	notify();
-}
+		while (jobQueue.tryDequeue(next))
+		{
+			if (next.get() != nullptr && !pendingJobs.contains(next))
+				pendingJobs.add(next);
+		}
+	}
 
-void SampleThreadPool::run()
-{
-	while (!threadShouldExit())
+	/** Removes the pending job with the earliest deadline that can be executed by the given worker. */
+	Job* getNextJob(bool isLoadingThread)
 	{
-		if (WeakReference<Job>* next = pimpl->jobQueue.peek())
+		ScopedLock sl(pendingLock);
+
+		drainJobQueue();
+
+		int bestIndex = -1;
+		int64 bestDeadline = 0;
+
+		for (int i = 0; i < pendingJobs.size(); i++)
 		{
-			Job* j = next->get();
+			Job* j = pendingJobs.getReference(i).get();
 
-#if ENABLE_CPU_MEASUREMENT
+			if (j == nullptr)
+			{
+				pendingJobs.remove(i--);
+				--counter;
+				continue;
+			}
 
-			const int64 lastEndTime = pimpl->endTime;
-			pimpl->startTime = Time::getHighResolutionTicks();
-#endif
+			if (j->running.load() || (j->needsLoadingThread && !isLoadingThread))
+				continue;
+
+			const int64 thisDeadline = j->getDeadline();
 
-			if (j != nullptr)
+			if (bestIndex == -1 || thisDeadline < bestDeadline)
 			{
-				pimpl->currentlyExecutedJob.store(j);
+				bestIndex = i;
+				bestDeadline = thisDeadline;
+			}
+		}
+
+		if (bestIndex == -1)
+			return nullptr;
 
-				j->currentThread.store(this);
+		Job* j = pendingJobs.getReference(bestIndex).get();
+		pendingJobs.remove(bestIndex);
+
+		// Set this while the lock is held so that no other worker can pick it up
+		j->running.store(true);
+
+		return j;
+	}
+
+	void rescheduleJob(Job* j)
+	{
+		ScopedLock sl(pendingLock);
+		pendingJobs.add(j);
+	}
+
+	void runWorkerLoop(Thread* t, int workerIndex)
+	{
+		auto w = workerStates[workerIndex];
+		jassert(w->thread == t);
+
+		const bool isLoadingThread = workerIndex == 0;
+
+		while (!t->threadShouldExit())
+		{
+			const int lastGeneration = jobGeneration.load();
+
+			if (Job* j = getNextJob(isLoadingThread))
+			{
+				w->idle.store(false);
+
+				const int64 startTime = Time::getHighResolutionTicks();
+
+				if (j->getDeadline() != 0 && startTime > j->getDeadline())
+					++w->numMissedDeadlines;
+
+				w->currentlyExecutedJob.store(j);
+				j->currentThread.store(t);
 
-				j->running.store(true);
-				
 				Job::JobStatus status = j->runJob();
 
 				j->running.store(false);
 
 				if (status == Job::jobHasFinished)
 				{
-					pimpl->jobQueue.pop();
 					j->queued.store(false);
-					--pimpl->counter;
+					--counter;
+				}
+				else
+				{
+					rescheduleJob(j);
 				}
 
-				pimpl->currentlyExecutedJob.store(nullptr);
-			}
+				w->currentlyExecutedJob.store(nullptr);
 
+				const int64 endTime = Time::getHighResolutionTicks();
 
-#if ENABLE_CPU_MEASUREMENT
-			pimpl->endTime = Time::getHighResolutionTicks();
+				++w->numJobs;
 
-			const int64 idleTime = pimpl->startTime - lastEndTime;
-			const int64 busyTime = pimpl->endTime - pimpl->startTime;
+#if ENABLE_CPU_MEASUREMENT
+				const int64 idleTime = w->endTime != 0 ? startTime - w->endTime : 0;
+				const int64 busyTime = endTime - startTime;
 
-			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
+				w->usage.store((double)busyTime / (double)jmax<int64>(1, idleTime + busyTime));
+				w->totalJobTime.store(w->totalJobTime.load() + Time::highResolutionTicksToSeconds(busyTime) * 1000.0);
 #endif
-		}
 
-#if 0 // Set this to true to enable defective threading (for debugging purposes)
-		wait(500);
-#else
-		else
-		{
-			wait(500);
+				w->endTime = endTime;
+			}
+			else
+			{
+				w->idle.store(true);
+
+				// Check again in case a job was added before the idle flag was set
+				if (lastGeneration == jobGeneration.load())
+					t->wait(500);
+
+				w->idle.store(false);
+			}
 		}
+	}
+
+	Atomic<int> counter;
+
+	std::atomic<int> jobGeneration;
+
+	std::atomic<int64> numStreamedBytes;
+
+	MultiProducerJobQueue jobQueue;
+
+	CriticalSection pendingLock;
+
+	Array<WeakReference<Job>> pendingJobs;
+
+	OwnedArray<WorkerState> workerStates;
+
+	OwnedArray<Worker> workers;
+
+	static const String errorMessage;
+};
+
+void SampleThreadPool::Worker::run()
+{
+	parent->pimpl->runWorkerLoop(this, index);
+}
+
+SampleThreadPool::SampleThreadPool(int numWorkersToUse, const String& threadName, const String& workerName) :
+	Thread(threadName),
+	pimpl(new Pimpl(jmax<int>(1, numWorkersToUse)))
+{
+	pimpl->workerStates[0]->thread = this;
+
+	for (int i = 1; i < pimpl->workerStates.size(); i++)
+		pimpl->workerStates[i]->thread = pimpl->workers.add(new Worker(this, i, workerName));
+
+	startThread(9);
+
+	for (auto w : pimpl->workers)
+		w->startThread(9);
+}
+
+SampleThreadPool::~SampleThreadPool()
+{
+	pimpl->signalAllJobsShouldExit();
+
+	for (auto w : pimpl->workers)
+		w->signalThreadShouldExit();
+
+	signalThreadShouldExit();
+	notifyWorkers();
+
+	for (auto w : pimpl->workers)
+		w->stopThread(300);
+
+	stopThread(300);
+
+	pimpl = nullptr;
+}
+
+int SampleThreadPool::getNumWorkers() const noexcept
+{
+	return pimpl->workerStates.size();
+}
+
+SampleThreadPool::WorkerStatistics SampleThreadPool::getWorkerStatistics(int workerIndex) const noexcept
+{
+	WorkerStatistics stats;
+
+	if (auto w = pimpl->workerStates[workerIndex])
+	{
+		stats.usage = w->usage.load();
+		stats.numJobs = w->numJobs.load();
+		stats.numMissedDeadlines = w->numMissedDeadlines.load();
+		stats.averageJobDuration = stats.numJobs > 0 ? w->totalJobTime.load() / (double)stats.numJobs : 0.0;
+	}
+
+	return stats;
+}
+
+int SampleThreadPool::getNumPendingJobs() const noexcept
+{
+	return pimpl->counter.get();
+}
+
+void SampleThreadPool::addStreamedBytes(int64 numBytes) noexcept
+{
+	pimpl->numStreamedBytes.fetch_add(numBytes);
+}
+
+int64 SampleThreadPool::getNumStreamedBytes() const noexcept
+{
+	return pimpl->numStreamedBytes.load();
+}
+
+void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
+{
+	ignoreUnused(unused);
+
+	bool wasQueued = false;
+
+	// The queued job will read the most recent state when it runs, so it doesn't need to be added again
+	if (!jobToAdd->queued.compare_exchange_strong(wasQueued, true))
+	{
+#if ENABLE_CONSOLE_OUTPUT
+		Logger::writeToLog(pimpl->errorMessage);
+		Logger::writeToLog(String(pimpl->counter.get()));
 #endif
+		return;
+	}
 
+	++pimpl->counter;
 
+	if (!pimpl->jobQueue.tryEnqueue(jobToAdd))
+	{
+		// The queue is full, so add it directly (this only happens if the workers can't keep up at all)
+		ScopedLock sl(pimpl->pendingLock);
+		pimpl->pendingJobs.add(jobToAdd);
 	}
+
+	++pimpl->jobGeneration;
+
+	if (jobToAdd->needsLoadingThread)
+		notify();
+	else
+		notifyWorkers();
+}
+
+void SampleThreadPool::notifyWorkers()
+{
+	// Wake up the first idle worker. If none is idle, the busy ones will pick up the job when they are done.
+	for (auto w : pimpl->workerStates)
+	{
+		if (w->idle.load() && w->thread != nullptr)
+		{
+			w->thread->notify();
+			return;
+		}
+	}
+
+	// The job might need the loading thread, so make sure that it's not sleeping.
+	notify();
+}
+
+void SampleThreadPool::run()
+{
+	pimpl->runWorkerLoop(this, 0);
 }
 
 const String SampleThreadPool::Pimpl::errorMessage("HDD overflow");
@@ -35,11 +35,24 @@
 
 namespace hise { using namespace juce;
 
+/** A pool of background threads that perform the disk streaming of the sampler voices.
+*
+*	The pool always contains the "Sample Loading Thread" (this object) which will also execute all jobs that need
+*	to be run on the sample loading thread (eg. the internal preloading). Additional worker threads can be
+*	used to spread the streaming jobs across multiple cores (which makes sense if you're using a fast SSD).
+*
+*	Every job has a deadline (in high resolution ticks) and the workers will always pick the pending job
+*	with the earliest deadline, so voices that are about to run out of samples will be served first.
+*/
 class SampleThreadPool : public Thread
 {
 public:
 
-	SampleThreadPool();
+	/** Creates a thread pool with the given amount of workers (including the sample loading thread). 
+	*
+	*	The names are used for the sample loading thread and the additional workers (which get their index appended).
+	*/
+	SampleThreadPool(int numWorkersToUse=NUM_SAMPLE_STREAMING_THREADS, const String& threadName="Sample Loading Thread", const String& workerName="Sample Streaming Thread");
 
 	~SampleThreadPool();
 	
@@ -52,7 +65,9 @@ public:
 			name(name_),
 			queued(false),
 			running(false),
-			shouldStop(false)
+			shouldStop(false),
+			deadline(0),
+			needsLoadingThread(false)
 		{};
         
         virtual ~Job() { masterReference.clear(); }
@@ -73,10 +88,22 @@ public:
 
 		bool isQueued() const noexcept{ return queued.load(); };
 
+		/** Sets the time (in high resolution ticks) when this job must be finished.
+		*
+		*	Jobs with an earlier deadline will be executed first. A deadline of zero (the default)
+		*	means as soon as possible.
+		*/
+		void setDeadline(int64 deadlineInTicks) noexcept { deadline.store(deadlineInTicks); }
+
+		int64 getDeadline() const noexcept { return deadline.load(); }
+
 	protected:
 
 		Thread* getCurrentThread() { return currentThread.load(); }
 
+		/** Call this in the constructor of your subclass if the job must be executed by the sample loading thread. */
+		void setNeedsSampleLoadingThread(bool shouldRunOnLoadingThread) { needsLoadingThread = shouldRunOnLoadingThread; }
+
 	private:
 
 		friend class SampleThreadPool;
@@ -92,19 +119,64 @@ public:
 
 		std::atomic<Thread*> currentThread;
 
+		std::atomic<int64> deadline;
+
+		bool needsLoadingThread;
+
 		const String name;
 	};
 
-	double getDiskUsage() const noexcept;
+	/** The statistics of a single worker thread. */
+	struct WorkerStatistics
+	{
+		/** The ratio of busy time to the total time (0.0 ... 1.0). */
+		double usage = 0.0;
+
+		/** The average duration of a job in milliseconds. */
+		double averageJobDuration = 0.0;
+
+		/** The amount of jobs this worker has processed. */
+		int numJobs = 0;
 
+		/** The amount of jobs that were started after their deadline. */
+		int numMissedDeadlines = 0;
+	};
+
+	/** Returns the number of worker threads (including the sample loading thread). */
+	int getNumWorkers() const noexcept;
+
+	/** Returns the statistics for the worker with the given index (0 is the sample loading thread). */
+	WorkerStatistics getWorkerStatistics(int workerIndex) const noexcept;
+
+	/** Returns the amount of jobs that are queued or running. */
+	int getNumPendingJobs() const noexcept;
+
+	/** Adds the size of the data that a job has read from disk. */
+	void addStreamedBytes(int64 numBytes) noexcept;
+
+	/** Returns the total amount of bytes that were streamed since the pool was created. */
+	int64 getNumStreamedBytes() const noexcept;
+
+	/** Adds a job to the queue and wakes up a worker. 
+	*
+	*	This can be called from any thread and doesn't lock unless the queue is full. If the job is already queued, 
+	*	it will not be added again.
+	*/
 	void addJob(Job* jobToAdd, bool unused);
 
+	/** Wakes up an idle worker. */
+	void notifyWorkers();
+
 	void run() override;
 
 	struct Pimpl;
 
 	ScopedPointer<Pimpl> pimpl;
 
+private:
+
+	class Worker;
+
 };
 
 typedef SampleThreadPool::Job SampleThreadPoolJob;
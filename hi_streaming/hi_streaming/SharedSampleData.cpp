@@ -0,0 +1,169 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+SharedSampleDataStore::PreloadBuffer::Ptr SharedSampleDataStore::getPreloadBuffer(int64 key) const
+{
+	ScopedLock sl(lock);
+
+	return preloadBuffers.contains(key) ? preloadBuffers[key] : nullptr;
+}
+
+SharedSampleDataStore::PreloadBuffer::Ptr SharedSampleDataStore::addPreloadBuffer(int64 key, hlac::HiseSampleBuffer&& buffer)
+{
+	ScopedLock sl(lock);
+
+	if (preloadBuffers.contains(key))
+		return preloadBuffers[key];
+
+	PreloadBuffer::Ptr newBuffer = new PreloadBuffer(std::move(buffer));
+	preloadBuffers.set(key, newBuffer);
+
+	return newBuffer;
+}
+
+SharedSampleDataStore::MonolithPtr SharedSampleDataStore::acquireMonolithInfo(int64 key)
+{
+	ScopedLock sl(lock);
+
+	if (!monoliths.contains(key))
+		return nullptr;
+
+	auto& entry = monoliths.getReference(key);
+	entry.numPools++;
+
+	return entry.info;
+}
+
+SharedSampleDataStore::MonolithPtr SharedSampleDataStore::addMonolithInfo(int64 key, MonolithInfoToUse* info)
+{
+	ScopedLock sl(lock);
+
+	auto& entry = monoliths.getReference(key);
+
+	if (entry.info == nullptr)
+		entry.info = info;
+
+	entry.numPools++;
+
+	return entry.info;
+}
+
+void SharedSampleDataStore::releaseMonolithInfo(const MonolithInfoToUse* info)
+{
+	ScopedLock sl(lock);
+
+	for (HashMap<int64, MonolithEntry>::Iterator i(monoliths); i.next();)
+	{
+		if (i.getValue().info.get() == info)
+		{
+			auto& entry = monoliths.getReference(i.getKey());
+
+			jassert(entry.numPools > 0);
+			entry.numPools = jmax(0, entry.numPools - 1);
+			return;
+		}
+	}
+}
+
+int SharedSampleDataStore::getNumPoolReferences(const MonolithInfoToUse* info) const
+{
+	ScopedLock sl(lock);
+
+	for (HashMap<int64, MonolithEntry>::Iterator i(monoliths); i.next();)
+	{
+		// The store keeps one reference and every registered pool another one
+		if (i.getValue().info.get() == info)
+			return 1 + i.getValue().numPools;
+	}
+
+	return 0;
+}
+
+void SharedSampleDataStore::clearUnusedData()
+{
+	ScopedLock sl(lock);
+
+	Array<int64> unusedKeys;
+
+	// The store holds one reference and the pointer returned by getValue() another one
+	for (HashMap<int64, PreloadBuffer::Ptr>::Iterator i(preloadBuffers); i.next();)
+	{
+		if (i.getValue()->getReferenceCount() <= 2)
+			unusedKeys.add(i.getKey());
+	}
+
+	for (auto key : unusedKeys)
+		preloadBuffers.remove(key);
+
+	unusedKeys.clearQuick();
+
+	for (HashMap<int64, MonolithEntry>::Iterator i(monoliths); i.next();)
+	{
+		if (i.getValue().numPools == 0 && i.getValue().info->getReferenceCount() <= 2)
+			unusedKeys.add(i.getKey());
+	}
+
+	for (auto key : unusedKeys)
+		monoliths.remove(key);
+}
+
+int SharedSampleDataStore::getNumPreloadBuffers() const
+{
+	ScopedLock sl(lock);
+
+	return preloadBuffers.size();
+}
+
+int64 SharedSampleDataStore::createMonolithKey(const Array<File>& monolithicFiles, const ValueTree& sampleMap)
+{
+	String key;
+
+	for (const auto& f : monolithicFiles)
+		key << getFileIdentifier(f) << ";";
+
+	key << sampleMap.getProperty("ID").toString() << ";" << sampleMap.getNumChildren();
+
+	return key.hashCode64();
+}
+
+String SharedSampleDataStore::getFileIdentifier(const File& f)
+{
+	String id;
+
+	id << f.getFullPathName() << ":" << f.getSize() << ":" << f.getLastModificationTime().toMilliseconds();
+
+	return id;
+}
+
+} // namespace hise
@@ -0,0 +1,136 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef SHAREDSAMPLEDATA_H_INCLUDED
+#define SHAREDSAMPLEDATA_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A process wide store for the read only sample data that can be shared between plugin instances.
+*
+*	Every plugin instance has its own sample pool, so if the same library is loaded in multiple instances, the
+*	preload buffers and the memory mapped monolith files would be loaded multiple times. If HISE_SHARE_SAMPLE_DATA
+*	is enabled, the sounds and the pools look up their data in this store (which is shared using a 
+*	SharedResourcePointer) and only read it from disk if no other instance has loaded it yet.
+*
+*	The data is identified by a key that is created from the source file (path, size and modification date) and the 
+*	settings that define the content of the buffer. The voice state stays in every instance.
+*
+*	The entries are reference counted. Unused entries are kept until clearUnusedData() is called, so that 
+*	reloading the same preset doesn't read the data again.
+*/
+class SharedSampleDataStore
+{
+public:
+
+	/** A preload buffer that is used by all sounds with the same key. It must not be changed after it was added. */
+	struct PreloadBuffer : public ReferenceCountedObject
+	{
+		typedef ReferenceCountedObjectPtr<PreloadBuffer> Ptr;
+
+		PreloadBuffer(hlac::HiseSampleBuffer&& bufferToUse) :
+			buffer(std::move(bufferToUse))
+		{};
+
+		const hlac::HiseSampleBuffer buffer;
+	};
+
+	typedef ReferenceCountedObjectPtr<MonolithInfoToUse> MonolithPtr;
+
+	SharedSampleDataStore() {};
+
+	/** Returns the preload buffer with the given key or nullptr if it doesn't exist. */
+	PreloadBuffer::Ptr getPreloadBuffer(int64 key) const;
+
+	/** Adds the buffer to the store and returns the shared version.
+	*
+	*	If another instance has added a buffer with the same key in the meantime, this one is discarded and the 
+	*	existing buffer is returned.
+	*/
+	PreloadBuffer::Ptr addPreloadBuffer(int64 key, hlac::HiseSampleBuffer&& buffer);
+
+	/** Returns the monolith info with the given key or nullptr if it doesn't exist. 
+	*
+	*	If the info exists, the calling pool is registered as user and must call releaseMonolithInfo() when it 
+	*	removes its reference.
+	*/
+	MonolithPtr acquireMonolithInfo(int64 key);
+
+	/** Adds a monolith info with its metadata already loaded and returns the shared version. 
+	*
+	*	If another instance has added an info with the same key in the meantime, this one is discarded and the
+	*	existing info is returned. The calling pool is registered as user of the returned info.
+	*/
+	MonolithPtr addMonolithInfo(int64 key, MonolithInfoToUse* info);
+
+	/** Unregisters a pool that doesn't use the monolith info anymore. */
+	void releaseMonolithInfo(const MonolithInfoToUse* info);
+
+	/** Returns the amount of references that the store and the registered pools keep to the monolith info.
+	*
+	*	A pool can compare this with the reference count of the info to find out whether any sound still uses it. 
+	*	Returns zero if the info isn't in the store.
+	*/
+	int getNumPoolReferences(const MonolithInfoToUse* info) const;
+
+	/** Removes all entries that are not used by any sound. */
+	void clearUnusedData();
+
+	/** Returns the amount of preload buffers in the store. */
+	int getNumPreloadBuffers() const;
+
+	/** Creates the key for a monolith from its files and the sample map that contains the metadata. */
+	static int64 createMonolithKey(const Array<File>& monolithicFiles, const ValueTree& sampleMap);
+
+	/** Creates a string that identifies the file and its version. */
+	static String getFileIdentifier(const File& f);
+
+private:
+
+	CriticalSection lock;
+
+	HashMap<int64, PreloadBuffer::Ptr> preloadBuffers;
+
+	struct MonolithEntry
+	{
+		MonolithPtr info;
+		int numPools = 0;
+	};
+
+	HashMap<int64, MonolithEntry> monoliths;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedSampleDataStore)
+};
+
+} // namespace hise
+
+#endif  // SHAREDSAMPLEDATA_H_INCLUDED
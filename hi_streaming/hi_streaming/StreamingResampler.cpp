@@ -0,0 +1,844 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#if JUCE_USE_SSE_INTRINSICS
+#include <immintrin.h>
+
+#if JUCE_MSVC
+#define STREAMING_AVX2_TARGET
+#else
+#define STREAMING_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+#elif JUCE_USE_ARM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace hise { using namespace juce;
+
+struct StreamingResampler::Kernels
+{
+	template <typename SignalType> using Function = void(*)(const SignalType*, const SignalType*, const float*, float*, float*, uint64, uint64, int, float);
+
+	template <typename SignalType> static float getGainFactor()
+	{
+		return std::is_same<SignalType, float>::value ? 1.0f : (1.0f / (float)INT16_MAX);
+	}
+
+	// ======================================================================================================== Fixed point helpers
+
+	static constexpr double FixedOne = 4294967296.0;
+
+	static forcedinline uint64 toFixed(double v) noexcept { return (uint64)(v * FixedOne + 0.5); }
+	static forcedinline int getIntegerPart(uint64 pos) noexcept { return (int)(pos >> 32); }
+	static forcedinline float getFraction(uint64 pos) noexcept { return (float)(uint32)pos * (float)(1.0 / FixedOne); }
+
+	// ======================================================================================================== Sinc table
+
+	struct SincTable
+	{
+		enum
+		{
+			NumTaps = 8,
+			NumPhases = 256
+		};
+
+		SincTable()
+		{
+			const double cutoff = 0.9;
+
+			for (int p = 0; p <= NumPhases; p++)
+			{
+				const double fraction = (double)p / (double)NumPhases;
+				float* row = data + p * NumTaps;
+				double sum = 0.0;
+
+				for (int i = 0; i < NumTaps; i++)
+				{
+					// tap 0 is three samples before the read position
+					const double x = (double)(i - 3) - fraction;
+					const double sincValue = x == 0.0 ? 1.0 : std::sin(double_Pi * cutoff * x) / (double_Pi * cutoff * x);
+					const double w = x / (double)(NumTaps / 2);
+					const double window = std::abs(w) >= 1.0 ? 0.0 : 0.42 + 0.5 * std::cos(double_Pi * w) + 0.08 * std::cos(2.0 * double_Pi * w);
+
+					row[i] = (float)(sincValue * window);
+					sum += row[i];
+				}
+
+				// normalise every phase to unity gain at DC
+				for (int i = 0; i < NumTaps; i++)
+					row[i] = (float)(row[i] / sum);
+			}
+		}
+
+		forcedinline const float* getRow(float fraction, float& rowAlpha) const noexcept
+		{
+			const float phase = fraction * (float)NumPhases;
+			const int index = jmin<int>(NumPhases - 1, (int)phase);
+
+			rowAlpha = phase - (float)index;
+			return data + index * NumTaps;
+		}
+
+		alignas(32) float data[(NumPhases + 1) * NumTaps];
+	};
+
+	static const SincTable& getSincTable()
+	{
+		static SincTable table;
+		return table;
+	}
+
+	// ======================================================================================================== Linear
+
+	struct Linear
+	{
+		static constexpr int NumLeading = 0;
+		static constexpr int NumTrailing = 1;
+
+		template <typename SignalType> static forcedinline float interpolate(const SignalType* in, float alpha)
+		{
+			return (float)in[0] * (1.0f - alpha) + (float)in[1] * alpha;
+		}
+
+#if JUCE_USE_SSE_INTRINSICS
+		template <typename SignalType> static forcedinline void processSSE2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m128 pos, __m128 gain);
+		template <typename SignalType> STREAMING_AVX2_TARGET static forcedinline void processAVX2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m256 pos, __m256 gain);
+#elif JUCE_USE_ARM_NEON
+		template <typename SignalType> static forcedinline void processNeon(const SignalType* inL, const SignalType* inR, float* outL, float* outR, float32x4_t pos, float32x4_t gain);
+#endif
+	};
+
+	// ======================================================================================================== Hermite
+
+	struct Hermite
+	{
+		static constexpr int NumLeading = 1;
+		static constexpr int NumTrailing = 2;
+
+		static forcedinline float calculate(float xm1, float x0, float x1, float x2, float t)
+		{
+			const float c1 = 0.5f * (x1 - xm1);
+			const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+			const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+
+			return ((c3 * t + c2) * t + c1) * t + x0;
+		}
+
+		template <typename SignalType> static forcedinline float interpolate(const SignalType* in, float alpha)
+		{
+			return calculate((float)in[-1], (float)in[0], (float)in[1], (float)in[2], alpha);
+		}
+
+#if JUCE_USE_SSE_INTRINSICS
+		template <typename SignalType> static forcedinline void processSSE2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m128 pos, __m128 gain);
+		template <typename SignalType> STREAMING_AVX2_TARGET static forcedinline void processAVX2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m256 pos, __m256 gain);
+#elif JUCE_USE_ARM_NEON
+		template <typename SignalType> static forcedinline void processNeon(const SignalType* inL, const SignalType* inR, float* outL, float* outR, float32x4_t pos, float32x4_t gain);
+#endif
+	};
+
+	// ======================================================================================================== Sinc
+
+	/** The sinc interpolation is vectorised over the filter taps instead of the output samples. 
+	*
+	*	The cutoff is not adapted to the pitch ratio, so pitching up will still produce aliasing
+	*	(like with the other modes), but the passband is much flatter and the imaging is much lower.
+	*/
+	struct Sinc
+	{
+		static constexpr int NumLeading = 3;
+		static constexpr int NumTrailing = 4;
+
+		template <typename SignalType> static forcedinline float interpolate(const SignalType* in, float alpha)
+		{
+			float rowAlpha;
+			const float* row = getSincTable().getRow(alpha, rowAlpha);
+			const float* nextRow = row + SincTable::NumTaps;
+
+			float sum = 0.0f;
+
+			for (int i = 0; i < SincTable::NumTaps; i++)
+				sum += (float)in[i - NumLeading] * (row[i] + rowAlpha * (nextRow[i] - row[i]));
+
+			return sum;
+		}
+
+#if JUCE_USE_SSE_INTRINSICS
+		template <typename SignalType> static forcedinline void processSSE2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m128 pos, __m128 gain);
+		template <typename SignalType> STREAMING_AVX2_TARGET static forcedinline void processAVX2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m256 pos, __m256 gain);
+#elif JUCE_USE_ARM_NEON
+		template <typename SignalType> static forcedinline void processNeon(const SignalType* inL, const SignalType* inR, float* outL, float* outR, float32x4_t pos, float32x4_t gain);
+#endif
+	};
+
+	// ======================================================================================================== Scalar
+
+	template <typename Core, typename SignalType> static void processScalar(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, uint64 pos, uint64 delta, int numSamples, float gainFactor)
+	{
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int index = getIntegerPart(pos);
+			const float alpha = getFraction(pos);
+
+			outL[i] = Core::interpolate(inL + index, alpha) * gainFactor;
+			outR[i] = Core::interpolate(inR + index, alpha) * gainFactor;
+
+			if (pitchData != nullptr)
+			{
+				jassert(pitchData[i] <= (float)MAX_SAMPLER_PITCH);
+				pos += toFixed((double)pitchData[i]);
+			}
+			else
+				pos += delta;
+		}
+	}
+
+#if JUCE_USE_SSE_INTRINSICS
+
+	// ======================================================================================================== SSE2
+
+	static forcedinline __m128 gather4(const float* in, const int* p, int offset)
+	{
+		return _mm_setr_ps(in[p[0] + offset], in[p[1] + offset], in[p[2] + offset], in[p[3] + offset]);
+	}
+
+	static forcedinline __m128 gather4(const int16* in, const int* p, int offset)
+	{
+		return _mm_setr_ps((float)in[p[0] + offset], (float)in[p[1] + offset], (float)in[p[2] + offset], (float)in[p[3] + offset]);
+	}
+
+	static forcedinline void loadTaps(const float* in, __m128& lo, __m128& hi)
+	{
+		lo = _mm_loadu_ps(in);
+		hi = _mm_loadu_ps(in + 4);
+	}
+
+	static forcedinline void loadTaps(const int16* in, __m128& lo, __m128& hi)
+	{
+		const __m128i x = _mm_loadu_si128((const __m128i*)in);
+
+		lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+		hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+	}
+
+	static forcedinline float sum4(__m128 x)
+	{
+		x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+		x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(x);
+	}
+
+	/** Calculates the positions of the next four samples relative to the integer part of pos and advances pos. */
+	static forcedinline __m128 getPositionsSSE2(const float* pitchData, uint64& pos, uint64 delta, __m128 deltaRamp)
+	{
+		const __m128 fraction = _mm_set1_ps(getFraction(pos));
+
+		if (pitchData != nullptr)
+		{
+			// inclusive prefix sum of the pitch values: [p0, p0+p1, p0+p1+p2, p0+p1+p2+p3]
+			const __m128 p = _mm_loadu_ps(pitchData);
+			__m128 sum = _mm_add_ps(p, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(p), 4)));
+			sum = _mm_add_ps(sum, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(sum), 8)));
+
+			pos += toFixed((double)_mm_cvtss_f32(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3))));
+
+			return _mm_add_ps(fraction, _mm_sub_ps(sum, p));
+		}
+		else
+		{
+			pos += 4 * delta;
+			return _mm_add_ps(fraction, deltaRamp);
+		}
+	}
+
+	template <typename Core, typename SignalType> static void processSSE2(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, uint64 pos, uint64 delta, int numSamples, float gainFactor)
+	{
+		const __m128 gain = _mm_set1_ps(gainFactor);
+		const float deltaFloat = (float)((double)delta / FixedOne);
+		const __m128 deltaRamp = _mm_mul_ps(_mm_set1_ps(deltaFloat), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+		const int numVectorised = numSamples & ~3;
+
+		for (int i = 0; i < numVectorised; i += 4)
+		{
+			const int index = getIntegerPart(pos);
+			const __m128 relativePositions = getPositionsSSE2(pitchData != nullptr ? pitchData + i : nullptr, pos, delta, deltaRamp);
+
+			Core::processSSE2(inL + index, inR + index, outL + i, outR + i, relativePositions, gain);
+		}
+
+		processScalar<Core>(inL, inR, pitchData != nullptr ? pitchData + numVectorised : nullptr, outL + numVectorised, outR + numVectorised, pos, delta, numSamples - numVectorised, gainFactor);
+	}
+
+	// ======================================================================================================== AVX2
+
+	// Reads two adjacent 16 bit samples with one 32 bit gather and splits them into two float vectors
+	STREAMING_AVX2_TARGET static forcedinline void gather8(const int16* in, __m256i pos, __m256& a, __m256& b)
+	{
+		const __m256i x = _mm256_i32gather_epi32((const int*)in, pos, 2);
+
+		a = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16));
+		b = _mm256_cvtepi32_ps(_mm256_srai_epi32(x, 16));
+	}
+
+	STREAMING_AVX2_TARGET static forcedinline void gather8(const float* in, __m256i pos, __m256& a, __m256& b)
+	{
+		a = _mm256_i32gather_ps(in, pos, 4);
+		b = _mm256_i32gather_ps(in + 1, pos, 4);
+	}
+
+	STREAMING_AVX2_TARGET static forcedinline __m256 loadTaps(const float* in)
+	{
+		return _mm256_loadu_ps(in);
+	}
+
+	STREAMING_AVX2_TARGET static forcedinline __m256 loadTaps(const int16* in)
+	{
+		return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)in)));
+	}
+
+	STREAMING_AVX2_TARGET static forcedinline float sum8(__m256 x)
+	{
+		return sum4(_mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1)));
+	}
+
+	STREAMING_AVX2_TARGET static forcedinline __m256 getPositionsAVX2(const float* pitchData, uint64& pos, uint64 delta, __m256 deltaRamp)
+	{
+		const __m256 fraction = _mm256_set1_ps(getFraction(pos));
+
+		if (pitchData != nullptr)
+		{
+			// inclusive prefix sum within each 128 bit lane...
+			const __m256 p = _mm256_loadu_ps(pitchData);
+			__m256 sum = _mm256_add_ps(p, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(p), 4)));
+			sum = _mm256_add_ps(sum, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(sum), 8)));
+
+			// ... then carry the total of the lower lane into the upper lane
+			const __m256 lowTotal = _mm256_permutevar8x32_ps(sum, _mm256_set1_epi32(3));
+			sum = _mm256_add_ps(sum, _mm256_blend_ps(_mm256_setzero_ps(), lowTotal, 0xF0));
+
+			pos += toFixed((double)_mm_cvtss_f32(_mm256_castps256_ps128(_mm256_permutevar8x32_ps(sum, _mm256_set1_epi32(7)))));
+
+			return _mm256_add_ps(fraction, _mm256_sub_ps(sum, p));
+		}
+		else
+		{
+			pos += 8 * delta;
+			return _mm256_add_ps(fraction, deltaRamp);
+		}
+	}
+
+	template <typename Core, typename SignalType> STREAMING_AVX2_TARGET static void processAVX2(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, uint64 pos, uint64 delta, int numSamples, float gainFactor)
+	{
+		const __m256 gain = _mm256_set1_ps(gainFactor);
+		const float deltaFloat = (float)((double)delta / FixedOne);
+		const __m256 deltaRamp = _mm256_mul_ps(_mm256_set1_ps(deltaFloat), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+		const int numVectorised = numSamples & ~7;
+
+		for (int i = 0; i < numVectorised; i += 8)
+		{
+			const int index = getIntegerPart(pos);
+			const __m256 relativePositions = getPositionsAVX2(pitchData != nullptr ? pitchData + i : nullptr, pos, delta, deltaRamp);
+
+			Core::processAVX2(inL + index, inR + index, outL + i, outR + i, relativePositions, gain);
+		}
+
+		processScalar<Core>(inL, inR, pitchData != nullptr ? pitchData + numVectorised : nullptr, outL + numVectorised, outR + numVectorised, pos, delta, numSamples - numVectorised, gainFactor);
+	}
+
+#elif JUCE_USE_ARM_NEON
+
+	// ======================================================================================================== NEON
+
+	template <typename SignalType> static forcedinline float32x4_t gather4(const SignalType* in, const int* p, int offset)
+	{
+		alignas(16) const float v[4] = { (float)in[p[0] + offset], (float)in[p[1] + offset], (float)in[p[2] + offset], (float)in[p[3] + offset] };
+		return vld1q_f32(v);
+	}
+
+	static forcedinline void loadTaps(const float* in, float32x4_t& lo, float32x4_t& hi)
+	{
+		lo = vld1q_f32(in);
+		hi = vld1q_f32(in + 4);
+	}
+
+	static forcedinline void loadTaps(const int16* in, float32x4_t& lo, float32x4_t& hi)
+	{
+		const int16x8_t x = vld1q_s16(in);
+
+		lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+		hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x)));
+	}
+
+	static forcedinline float sum4(float32x4_t x)
+	{
+		const float32x2_t s = vadd_f32(vget_low_f32(x), vget_high_f32(x));
+		return vget_lane_f32(vpadd_f32(s, s), 0);
+	}
+
+	static forcedinline float32x4_t getPositionsNeon(const float* pitchData, uint64& pos, uint64 delta, float32x4_t deltaRamp)
+	{
+		const float32x4_t fraction = vdupq_n_f32(getFraction(pos));
+
+		if (pitchData != nullptr)
+		{
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			const float32x4_t p = vld1q_f32(pitchData);
+			float32x4_t sum = vaddq_f32(p, vextq_f32(zero, p, 3));
+			sum = vaddq_f32(sum, vextq_f32(zero, sum, 2));
+
+			pos += toFixed((double)vgetq_lane_f32(sum, 3));
+
+			return vaddq_f32(fraction, vsubq_f32(sum, p));
+		}
+		else
+		{
+			pos += 4 * delta;
+			return vaddq_f32(fraction, deltaRamp);
+		}
+	}
+
+	template <typename Core, typename SignalType> static void processNeon(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, uint64 pos, uint64 delta, int numSamples, float gainFactor)
+	{
+		alignas(16) const float ramp[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+
+		const float32x4_t gain = vdupq_n_f32(gainFactor);
+		const float deltaFloat = (float)((double)delta / FixedOne);
+		const float32x4_t deltaRamp = vmulq_n_f32(vld1q_f32(ramp), deltaFloat);
+		const int numVectorised = numSamples & ~3;
+
+		for (int i = 0; i < numVectorised; i += 4)
+		{
+			const int index = getIntegerPart(pos);
+			const float32x4_t relativePositions = getPositionsNeon(pitchData != nullptr ? pitchData + i : nullptr, pos, delta, deltaRamp);
+
+			Core::processNeon(inL + index, inR + index, outL + i, outR + i, relativePositions, gain);
+		}
+
+		processScalar<Core>(inL, inR, pitchData != nullptr ? pitchData + numVectorised : nullptr, outL + numVectorised, outR + numVectorised, pos, delta, numSamples - numVectorised, gainFactor);
+	}
+
+#endif
+
+	// ======================================================================================================== Dispatch
+
+	template <typename Core, typename SignalType> static Function<SignalType> getFunction(InstructionSet s)
+	{
+		switch (s)
+		{
+#if JUCE_USE_SSE_INTRINSICS
+		case InstructionSet::SSE2: return processSSE2<Core, SignalType>;
+		case InstructionSet::AVX2: return processAVX2<Core, SignalType>;
+#elif JUCE_USE_ARM_NEON
+		case InstructionSet::Neon: return processNeon<Core, SignalType>;
+#endif
+		default: return processScalar<Core, SignalType>;
+		}
+	}
+
+	struct Table
+	{
+		Table()
+		{
+			setInstructionSet(getBestInstructionSet());
+		}
+
+		void setInstructionSet(InstructionSet s)
+		{
+			currentSet = s;
+
+			floatFunctions[(int)InterpolationMode::Linear] = getFunction<Linear, float>(s);
+			floatFunctions[(int)InterpolationMode::Hermite] = getFunction<Hermite, float>(s);
+			floatFunctions[(int)InterpolationMode::Sinc] = getFunction<Sinc, float>(s);
+
+			int16Functions[(int)InterpolationMode::Linear] = getFunction<Linear, int16>(s);
+			int16Functions[(int)InterpolationMode::Hermite] = getFunction<Hermite, int16>(s);
+			int16Functions[(int)InterpolationMode::Sinc] = getFunction<Sinc, int16>(s);
+		}
+
+		InstructionSet currentSet;
+
+		Function<float> floatFunctions[(int)InterpolationMode::numInterpolationModes];
+		Function<int16> int16Functions[(int)InterpolationMode::numInterpolationModes];
+	};
+
+	static Table& getTable()
+	{
+		// Make sure that the sinc table is created before the first voice is rendered
+		getSincTable();
+
+		static Table table;
+		return table;
+	}
+};
+
+// ============================================================================================================ Vectorised cores
+
+#if JUCE_USE_SSE_INTRINSICS
+
+template <typename SignalType> void StreamingResampler::Kernels::Linear::processSSE2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m128 pos, __m128 gain)
+{
+	alignas(16) int p[4];
+
+	const __m128i index = _mm_cvttps_epi32(pos);
+	_mm_store_si128((__m128i*)p, index);
+
+	const __m128 alpha = _mm_sub_ps(pos, _mm_cvtepi32_ps(index));
+
+	const __m128 l0 = gather4(inL, p, 0);
+	const __m128 l1 = gather4(inL, p, 1);
+	const __m128 r0 = gather4(inR, p, 0);
+	const __m128 r1 = gather4(inR, p, 1);
+
+	_mm_storeu_ps(outL, _mm_mul_ps(_mm_add_ps(l0, _mm_mul_ps(alpha, _mm_sub_ps(l1, l0))), gain));
+	_mm_storeu_ps(outR, _mm_mul_ps(_mm_add_ps(r0, _mm_mul_ps(alpha, _mm_sub_ps(r1, r0))), gain));
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Linear::processAVX2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m256 pos, __m256 gain)
+{
+	const __m256i index = _mm256_cvttps_epi32(pos);
+	const __m256 alpha = _mm256_sub_ps(pos, _mm256_cvtepi32_ps(index));
+
+	__m256 l0, l1, r0, r1;
+
+	gather8(inL, index, l0, l1);
+	gather8(inR, index, r0, r1);
+
+	_mm256_storeu_ps(outL, _mm256_mul_ps(_mm256_add_ps(l0, _mm256_mul_ps(alpha, _mm256_sub_ps(l1, l0))), gain));
+	_mm256_storeu_ps(outR, _mm256_mul_ps(_mm256_add_ps(r0, _mm256_mul_ps(alpha, _mm256_sub_ps(r1, r0))), gain));
+}
+
+static forcedinline __m128 hermiteSSE2(__m128 xm1, __m128 x0, __m128 x1, __m128 x2, __m128 t)
+{
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	const __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(x1, xm1));
+	const __m128 c2 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(xm1, _mm_mul_ps(_mm_set1_ps(2.5f), x0)), _mm_add_ps(x1, x1)), _mm_mul_ps(half, x2));
+	const __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(x2, xm1)), _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(x0, x1)));
+
+	return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c3, t), c2), t), c1), t), x0);
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Hermite::processSSE2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m128 pos, __m128 gain)
+{
+	alignas(16) int p[4];
+
+	const __m128i index = _mm_cvttps_epi32(pos);
+	_mm_store_si128((__m128i*)p, index);
+
+	const __m128 t = _mm_sub_ps(pos, _mm_cvtepi32_ps(index));
+
+	const __m128 l = hermiteSSE2(gather4(inL, p, -1), gather4(inL, p, 0), gather4(inL, p, 1), gather4(inL, p, 2), t);
+	const __m128 r = hermiteSSE2(gather4(inR, p, -1), gather4(inR, p, 0), gather4(inR, p, 1), gather4(inR, p, 2), t);
+
+	_mm_storeu_ps(outL, _mm_mul_ps(l, gain));
+	_mm_storeu_ps(outR, _mm_mul_ps(r, gain));
+}
+
+STREAMING_AVX2_TARGET static forcedinline __m256 hermiteAVX2(__m256 xm1, __m256 x0, __m256 x1, __m256 x2, __m256 t)
+{
+	const __m256 half = _mm256_set1_ps(0.5f);
+
+	const __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(x1, xm1));
+	const __m256 c2 = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(xm1, _mm256_mul_ps(_mm256_set1_ps(2.5f), x0)), _mm256_add_ps(x1, x1)), _mm256_mul_ps(half, x2));
+	const __m256 c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(x2, xm1)), _mm256_mul_ps(_mm256_set1_ps(1.5f), _mm256_sub_ps(x0, x1)));
+
+	return _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(c3, t), c2), t), c1), t), x0);
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Hermite::processAVX2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m256 pos, __m256 gain)
+{
+	const __m256i index = _mm256_cvttps_epi32(pos);
+	const __m256 t = _mm256_sub_ps(pos, _mm256_cvtepi32_ps(index));
+
+	__m256 lm1, l0, l1, l2, rm1, r0, r1, r2;
+
+	gather8(inL - 1, index, lm1, l0);
+	gather8(inL + 1, index, l1, l2);
+	gather8(inR - 1, index, rm1, r0);
+	gather8(inR + 1, index, r1, r2);
+
+	_mm256_storeu_ps(outL, _mm256_mul_ps(hermiteAVX2(lm1, l0, l1, l2, t), gain));
+	_mm256_storeu_ps(outR, _mm256_mul_ps(hermiteAVX2(rm1, r0, r1, r2, t), gain));
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Sinc::processSSE2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m128 pos, __m128 gain)
+{
+	alignas(16) float positions[4];
+	alignas(16) float l[4];
+	alignas(16) float r[4];
+
+	_mm_store_ps(positions, pos);
+
+	const auto& table = getSincTable();
+
+	for (int i = 0; i < 4; i++)
+	{
+		const int index = (int)positions[i];
+
+		float rowAlpha;
+		const float* row = table.getRow(positions[i] - (float)index, rowAlpha);
+		const __m128 a = _mm_set1_ps(rowAlpha);
+
+		const __m128 c0 = _mm_load_ps(row);
+		const __m128 c1 = _mm_load_ps(row + 4);
+		const __m128 coeffLo = _mm_add_ps(c0, _mm_mul_ps(a, _mm_sub_ps(_mm_load_ps(row + SincTable::NumTaps), c0)));
+		const __m128 coeffHi = _mm_add_ps(c1, _mm_mul_ps(a, _mm_sub_ps(_mm_load_ps(row + SincTable::NumTaps + 4), c1)));
+
+		__m128 lo, hi;
+
+		loadTaps(inL + index - NumLeading, lo, hi);
+		l[i] = sum4(_mm_add_ps(_mm_mul_ps(lo, coeffLo), _mm_mul_ps(hi, coeffHi)));
+
+		loadTaps(inR + index - NumLeading, lo, hi);
+		r[i] = sum4(_mm_add_ps(_mm_mul_ps(lo, coeffLo), _mm_mul_ps(hi, coeffHi)));
+	}
+
+	_mm_storeu_ps(outL, _mm_mul_ps(_mm_load_ps(l), gain));
+	_mm_storeu_ps(outR, _mm_mul_ps(_mm_load_ps(r), gain));
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Sinc::processAVX2(const SignalType* inL, const SignalType* inR, float* outL, float* outR, __m256 pos, __m256 gain)
+{
+	alignas(32) float positions[8];
+	alignas(32) float l[8];
+	alignas(32) float r[8];
+
+	_mm256_store_ps(positions, pos);
+
+	const auto& table = getSincTable();
+
+	for (int i = 0; i < 8; i++)
+	{
+		const int index = (int)positions[i];
+
+		float rowAlpha;
+		const float* row = table.getRow(positions[i] - (float)index, rowAlpha);
+
+		const __m256 c0 = _mm256_load_ps(row);
+		const __m256 coeff = _mm256_add_ps(c0, _mm256_mul_ps(_mm256_set1_ps(rowAlpha), _mm256_sub_ps(_mm256_load_ps(row + SincTable::NumTaps), c0)));
+
+		l[i] = sum8(_mm256_mul_ps(loadTaps(inL + index - NumLeading), coeff));
+		r[i] = sum8(_mm256_mul_ps(loadTaps(inR + index - NumLeading), coeff));
+	}
+
+	_mm256_storeu_ps(outL, _mm256_mul_ps(_mm256_load_ps(l), gain));
+	_mm256_storeu_ps(outR, _mm256_mul_ps(_mm256_load_ps(r), gain));
+}
+
+#elif JUCE_USE_ARM_NEON
+
+template <typename SignalType> void StreamingResampler::Kernels::Linear::processNeon(const SignalType* inL, const SignalType* inR, float* outL, float* outR, float32x4_t pos, float32x4_t gain)
+{
+	alignas(16) int p[4];
+
+	const int32x4_t index = vcvtq_s32_f32(pos);
+	vst1q_s32(p, index);
+
+	const float32x4_t alpha = vsubq_f32(pos, vcvtq_f32_s32(index));
+
+	const float32x4_t l0 = gather4(inL, p, 0);
+	const float32x4_t l1 = gather4(inL, p, 1);
+	const float32x4_t r0 = gather4(inR, p, 0);
+	const float32x4_t r1 = gather4(inR, p, 1);
+
+	vst1q_f32(outL, vmulq_f32(vmlaq_f32(l0, alpha, vsubq_f32(l1, l0)), gain));
+	vst1q_f32(outR, vmulq_f32(vmlaq_f32(r0, alpha, vsubq_f32(r1, r0)), gain));
+}
+
+static forcedinline float32x4_t hermiteNeon(float32x4_t xm1, float32x4_t x0, float32x4_t x1, float32x4_t x2, float32x4_t t)
+{
+	const float32x4_t c1 = vmulq_n_f32(vsubq_f32(x1, xm1), 0.5f);
+	const float32x4_t c2 = vsubq_f32(vaddq_f32(vmlsq_n_f32(xm1, x0, 2.5f), vaddq_f32(x1, x1)), vmulq_n_f32(x2, 0.5f));
+	const float32x4_t c3 = vmlaq_n_f32(vmulq_n_f32(vsubq_f32(x2, xm1), 0.5f), vsubq_f32(x0, x1), 1.5f);
+
+	return vmlaq_f32(x0, vmlaq_f32(c1, vmlaq_f32(c2, c3, t), t), t);
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Hermite::processNeon(const SignalType* inL, const SignalType* inR, float* outL, float* outR, float32x4_t pos, float32x4_t gain)
+{
+	alignas(16) int p[4];
+
+	const int32x4_t index = vcvtq_s32_f32(pos);
+	vst1q_s32(p, index);
+
+	const float32x4_t t = vsubq_f32(pos, vcvtq_f32_s32(index));
+
+	const float32x4_t l = hermiteNeon(gather4(inL, p, -1), gather4(inL, p, 0), gather4(inL, p, 1), gather4(inL, p, 2), t);
+	const float32x4_t r = hermiteNeon(gather4(inR, p, -1), gather4(inR, p, 0), gather4(inR, p, 1), gather4(inR, p, 2), t);
+
+	vst1q_f32(outL, vmulq_f32(l, gain));
+	vst1q_f32(outR, vmulq_f32(r, gain));
+}
+
+template <typename SignalType> void StreamingResampler::Kernels::Sinc::processNeon(const SignalType* inL, const SignalType* inR, float* outL, float* outR, float32x4_t pos, float32x4_t gain)
+{
+	alignas(16) float positions[4];
+	alignas(16) float l[4];
+	alignas(16) float r[4];
+
+	vst1q_f32(positions, pos);
+
+	const auto& table = getSincTable();
+
+	for (int i = 0; i < 4; i++)
+	{
+		const int index = (int)positions[i];
+
+		float rowAlpha;
+		const float* row = table.getRow(positions[i] - (float)index, rowAlpha);
+
+		const float32x4_t c0 = vld1q_f32(row);
+		const float32x4_t c1 = vld1q_f32(row + 4);
+		const float32x4_t coeffLo = vmlaq_n_f32(c0, vsubq_f32(vld1q_f32(row + SincTable::NumTaps), c0), rowAlpha);
+		const float32x4_t coeffHi = vmlaq_n_f32(c1, vsubq_f32(vld1q_f32(row + SincTable::NumTaps + 4), c1), rowAlpha);
+
+		float32x4_t lo, hi;
+
+		loadTaps(inL + index - NumLeading, lo, hi);
+		l[i] = sum4(vmlaq_f32(vmulq_f32(lo, coeffLo), hi, coeffHi));
+
+		loadTaps(inR + index - NumLeading, lo, hi);
+		r[i] = sum4(vmlaq_f32(vmulq_f32(lo, coeffLo), hi, coeffHi));
+	}
+
+	vst1q_f32(outL, vmulq_f32(vld1q_f32(l), gain));
+	vst1q_f32(outR, vmulq_f32(vld1q_f32(r), gain));
+}
+
+#endif
+
+// ============================================================================================================ StreamingResampler
+
+StreamingResampler::InstructionSet StreamingResampler::getBestInstructionSet()
+{
+	if (isAvailable(InstructionSet::AVX2))
+		return InstructionSet::AVX2;
+
+	if (isAvailable(InstructionSet::SSE2))
+		return InstructionSet::SSE2;
+
+	if (isAvailable(InstructionSet::Neon))
+		return InstructionSet::Neon;
+
+	return InstructionSet::Scalar;
+}
+
+bool StreamingResampler::isAvailable(InstructionSet s)
+{
+	switch (s)
+	{
+	case InstructionSet::Scalar: return true;
+#if JUCE_USE_SSE_INTRINSICS
+	case InstructionSet::SSE2:	 return SystemStats::hasSSE2();
+	case InstructionSet::AVX2:	 return SystemStats::hasAVX2();
+#elif JUCE_USE_ARM_NEON
+	case InstructionSet::Neon:	 return SystemStats::hasNeon();
+#endif
+	default:					 return false;
+	}
+}
+
+void StreamingResampler::setInstructionSet(InstructionSet s)
+{
+	if (isAvailable(s))
+		Kernels::getTable().setInstructionSet(s);
+	else
+		jassertfalse;
+}
+
+StreamingResampler::InstructionSet StreamingResampler::getInstructionSet()
+{
+	return Kernels::getTable().currentSet;
+}
+
+String StreamingResampler::getInstructionSetName(InstructionSet s)
+{
+	switch (s)
+	{
+	case InstructionSet::Scalar: return "Scalar";
+	case InstructionSet::SSE2:	 return "SSE2";
+	case InstructionSet::AVX2:	 return "AVX2";
+	case InstructionSet::Neon:	 return "NEON";
+	default:					 return "Unknown";
+	}
+}
+
+String StreamingResampler::getInterpolationModeName(InterpolationMode m)
+{
+	switch (m)
+	{
+	case InterpolationMode::Linear:  return "Linear";
+	case InterpolationMode::Hermite: return "Hermite";
+	case InterpolationMode::Sinc:	 return "Sinc";
+	default:						 return "Unknown";
+	}
+}
+
+int StreamingResampler::getNumLeadingSamples(InterpolationMode m)
+{
+	switch (m)
+	{
+	case InterpolationMode::Hermite: return Kernels::Hermite::NumLeading;
+	case InterpolationMode::Sinc:	 return Kernels::Sinc::NumLeading;
+	default:						 return Kernels::Linear::NumLeading;
+	}
+}
+
+int StreamingResampler::getNumTrailingSamples(InterpolationMode m)
+{
+	switch (m)
+	{
+	case InterpolationMode::Hermite: return Kernels::Hermite::NumTrailing;
+	case InterpolationMode::Sinc:	 return Kernels::Sinc::NumTrailing;
+	default:						 return Kernels::Linear::NumTrailing;
+	}
+}
+
+void StreamingResampler::interpolateStereo(InterpolationMode m, const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	jassert(indexInBuffer >= 0.0);
+
+	auto f = Kernels::getTable().floatFunctions[jlimit<int>(0, (int)InterpolationMode::numInterpolationModes - 1, (int)m)];
+	f(inL, inR, pitchData, outL, outR, Kernels::toFixed(indexInBuffer), Kernels::toFixed(uptimeDelta), numSamples, Kernels::getGainFactor<float>());
+}
+
+void StreamingResampler::interpolateStereo(InterpolationMode m, const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	jassert(indexInBuffer >= 0.0);
+
+	auto f = Kernels::getTable().int16Functions[jlimit<int>(0, (int)InterpolationMode::numInterpolationModes - 1, (int)m)];
+	f(inL, inR, pitchData, outL, outR, Kernels::toFixed(indexInBuffer), Kernels::toFixed(uptimeDelta), numSamples, Kernels::getGainFactor<int16>());
+}
+
+} // namespace hise
@@ -0,0 +1,114 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef STREAMINGRESAMPLER_H_INCLUDED
+#define STREAMINGRESAMPLER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** The resampling kernels of the StreamingSamplerVoice.
+*
+*	This contains vectorised versions of the stereo interpolation loop for SSE2, AVX2 and NEON.
+*	The best instruction set that is supported by the CPU will be picked at runtime, but you
+*	can override it (eg. for benchmarking or if you suspect a bug in one of the kernels).
+*
+*	The read position is tracked as 32.32 fixed point number so that there is no drift
+*	within the block, no matter how long it is or how high the pitch ratio is.
+*/
+struct StreamingResampler
+{
+	enum class InstructionSet
+	{
+		Scalar = 0,
+		SSE2,
+		AVX2,
+		Neon,
+		numInstructionSets
+	};
+
+	enum class InterpolationMode
+	{
+		Linear = 0, ///< 2-point linear interpolation (the cheapest mode)
+		Hermite, ///< 4-point, 3rd order Hermite interpolation
+		Sinc, ///< 8-point polyphase windowed sinc interpolation (using a precomputed table)
+		numInterpolationModes
+	};
+
+	/** Returns the fastest instruction set that is available on this machine. */
+	static InstructionSet getBestInstructionSet();
+
+	/** Checks if the instruction set was compiled in and is supported by the CPU. */
+	static bool isAvailable(InstructionSet s);
+
+	/** Changes the instruction set that is used by all voices. Don't call this while the audio is running. */
+	static void setInstructionSet(InstructionSet s);
+
+	/** Returns the instruction set that is currently used. */
+	static InstructionSet getInstructionSet();
+
+	static String getInstructionSetName(InstructionSet s);
+
+	static String getInterpolationModeName(InterpolationMode m);
+
+	/** Returns the number of samples before the read position that the interpolation needs. */
+	static int getNumLeadingSamples(InterpolationMode m);
+
+	/** Returns the number of samples after the read position that the interpolation needs. */
+	static int getNumTrailingSamples(InterpolationMode m);
+
+	/** The maximum amount of leading samples for all interpolation modes. */
+	static constexpr int MaxLeadingSamples = 3;
+
+	/** The maximum amount of trailing samples for all interpolation modes. */
+	static constexpr int MaxTrailingSamples = 4;
+
+	/** Resamples the given stereo data.
+	*
+	*	The input data must contain getNumLeadingSamples() before and getNumTrailingSamples() after the read range.
+	*
+	*	@param pitchData	if not nullptr, this is used as sample-wise uptime delta, otherwise uptimeDelta is used.
+	*	@param indexInBuffer the (fractional) start position in the input data.
+	*/
+	static void interpolateStereo(InterpolationMode m, const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples);
+
+	/** Resamples the given 16 bit stereo data and converts it to float. */
+	static void interpolateStereo(InterpolationMode m, const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples);
+
+private:
+
+	struct Kernels;
+};
+
+} // namespace hise
+
+#endif  // STREAMINGRESAMPLER_H_INCLUDED
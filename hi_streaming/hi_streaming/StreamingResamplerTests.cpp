@@ -0,0 +1,234 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+/** Checks the vectorised resampling kernels against the scalar version and reports how many voices
+*	one core could render (only counting the resampling, so it's an upper bound).
+*/
+class StreamingResamplerTest : public UnitTest
+{
+public:
+
+	StreamingResamplerTest() :
+		UnitTest("Testing streaming resampler kernels")
+	{};
+
+	void runTest() override
+	{
+		const auto previousSet = StreamingResampler::getInstructionSet();
+
+		testIntegerPositions();
+
+		for (int m = 0; m < (int)StreamingResampler::InterpolationMode::numInterpolationModes; m++)
+		{
+			testKernels<float>((StreamingResampler::InterpolationMode)m);
+			testKernels<int16>((StreamingResampler::InterpolationMode)m);
+		}
+
+		for (int m = 0; m < (int)StreamingResampler::InterpolationMode::numInterpolationModes; m++)
+		{
+			runBenchmark<float>((StreamingResampler::InterpolationMode)m);
+			runBenchmark<int16>((StreamingResampler::InterpolationMode)m);
+		}
+
+		StreamingResampler::setInstructionSet(previousSet);
+	}
+
+private:
+
+	enum
+	{
+		blockSize = 512,
+		inputSize = blockSize * MAX_SAMPLER_PITCH + 16,
+		offset = StreamingResampler::MaxLeadingSamples
+	};
+
+	template <typename SignalType> void fillInput(HeapBlock<SignalType>& data)
+	{
+		data.calloc(inputSize);
+
+		for (int i = 0; i < inputSize; i++)
+		{
+			const float v = r.nextFloat() * 2.0f - 1.0f;
+			data[i] = std::is_same<SignalType, float>::value ? (SignalType)v : (SignalType)(v * (float)INT16_MAX);
+		}
+	}
+
+	static bool isCompareable(StreamingResampler::InstructionSet s)
+	{
+		return s != StreamingResampler::InstructionSet::Scalar && StreamingResampler::isAvailable(s);
+	}
+
+	static String getSuffix(StreamingResampler::InterpolationMode m, bool isFloat)
+	{
+		return " - " + StreamingResampler::getInterpolationModeName(m) + (isFloat ? " (float)" : " (int16)");
+	}
+
+	/** The polynomial modes must return the input if the read position is not fractional. */
+	void testIntegerPositions()
+	{
+		beginTest("Testing integer positions");
+
+		HeapBlock<float> inL, inR;
+		fillInput(inL);
+		fillInput(inR);
+
+		AudioSampleBuffer output(2, blockSize);
+
+		for (int i = 0; i < (int)StreamingResampler::InstructionSet::numInstructionSets; i++)
+		{
+			auto s = (StreamingResampler::InstructionSet)i;
+
+			if (!StreamingResampler::isAvailable(s))
+				continue;
+
+			StreamingResampler::setInstructionSet(s);
+
+			for (auto m : { StreamingResampler::InterpolationMode::Linear, StreamingResampler::InterpolationMode::Hermite })
+			{
+				StreamingResampler::interpolateStereo(m, inL.getData() + offset, inR.getData() + offset, nullptr, output.getWritePointer(0), output.getWritePointer(1), 0.0, 1.0, blockSize);
+
+				float maxError = 0.0f;
+
+				for (int j = 0; j < blockSize; j++)
+					maxError = jmax<float>(maxError, std::abs(output.getSample(0, j) - inL[j + offset]));
+
+				expect(maxError < 0.0001f, StreamingResampler::getInstructionSetName(s) + getSuffix(m, true) + " error: " + String(maxError));
+			}
+		}
+	}
+
+	template <typename SignalType> void testKernels(StreamingResampler::InterpolationMode m)
+	{
+		HeapBlock<SignalType> inL, inR;
+		fillInput(inL);
+		fillInput(inR);
+
+		HeapBlock<float> pitchData;
+		pitchData.calloc(blockSize);
+
+		for (int i = 0; i < blockSize; i++)
+			pitchData[i] = 0.5f + r.nextFloat();
+
+		AudioSampleBuffer expected(2, blockSize);
+		AudioSampleBuffer actual(2, blockSize);
+
+		for (int i = 1; i < (int)StreamingResampler::InstructionSet::numInstructionSets; i++)
+		{
+			auto s = (StreamingResampler::InstructionSet)i;
+
+			if (!isCompareable(s))
+				continue;
+
+			beginTest("Testing " + StreamingResampler::getInstructionSetName(s) + getSuffix(m, std::is_same<SignalType, float>::value));
+
+			for (int usePitchData = 0; usePitchData < 2; usePitchData++)
+			{
+				// use an odd number of samples to test the scalar tail
+				const int numSamples = blockSize - 3;
+				const double startIndex = r.nextDouble();
+				const double delta = 0.25 + r.nextDouble() * 3.0;
+				const float* pd = usePitchData == 1 ? pitchData.getData() : nullptr;
+
+				StreamingResampler::setInstructionSet(StreamingResampler::InstructionSet::Scalar);
+				StreamingResampler::interpolateStereo(m, inL.getData() + offset, inR.getData() + offset, pd, expected.getWritePointer(0), expected.getWritePointer(1), startIndex, delta, numSamples);
+
+				StreamingResampler::setInstructionSet(s);
+				StreamingResampler::interpolateStereo(m, inL.getData() + offset, inR.getData() + offset, pd, actual.getWritePointer(0), actual.getWritePointer(1), startIndex, delta, numSamples);
+
+				float maxError = 0.0f;
+
+				for (int c = 0; c < 2; c++)
+				{
+					for (int j = 0; j < numSamples; j++)
+						maxError = jmax<float>(maxError, std::abs(expected.getSample(c, j) - actual.getSample(c, j)));
+				}
+
+				// The positions are accumulated in a different order, so there might be a tiny difference
+				expect(maxError < 0.001f, String(usePitchData == 1 ? "Pitch data" : "Constant pitch") + " error: " + String(maxError));
+			}
+		}
+	}
+
+	template <typename SignalType> void runBenchmark(StreamingResampler::InterpolationMode m)
+	{
+		beginTest("Benchmarking resampling kernels" + getSuffix(m, std::is_same<SignalType, float>::value));
+
+		HeapBlock<SignalType> inL, inR;
+		fillInput(inL);
+		fillInput(inR);
+
+		HeapBlock<float> pitchData;
+		pitchData.calloc(blockSize);
+
+		for (int i = 0; i < blockSize; i++)
+			pitchData[i] = 1.0f + 0.01f * (float)std::sin((double)i * 0.1);
+
+		AudioSampleBuffer output(2, blockSize);
+
+		const int numIterations = m == StreamingResampler::InterpolationMode::Sinc ? 2000 : 20000;
+		const double blockDuration = (double)blockSize / 44100.0;
+
+		for (int i = 0; i < (int)StreamingResampler::InstructionSet::numInstructionSets; i++)
+		{
+			auto s = (StreamingResampler::InstructionSet)i;
+
+			if (!StreamingResampler::isAvailable(s))
+				continue;
+
+			StreamingResampler::setInstructionSet(s);
+
+			for (int usePitchData = 0; usePitchData < 2; usePitchData++)
+			{
+				const float* pd = usePitchData == 1 ? pitchData.getData() : nullptr;
+
+				const double start = Time::getMillisecondCounterHiRes();
+
+				for (int j = 0; j < numIterations; j++)
+					StreamingResampler::interpolateStereo(m, inL.getData() + offset, inR.getData() + offset, pd, output.getWritePointer(0), output.getWritePointer(1), 0.5, 1.0594631, blockSize);
+
+				const double secondsPerBlock = (Time::getMillisecondCounterHiRes() - start) * 0.001 / (double)numIterations;
+
+				logMessage(StreamingResampler::getInstructionSetName(s) + (usePitchData == 1 ? " (pitch data): " : " (constant pitch): ") + 
+						   String(roundToInt(blockDuration / secondsPerBlock)) + " voices per core");
+			}
+		}
+	}
+
+	Random r;
+};
+
+static StreamingResamplerTest streamingResamplerTest;
+
+} // namespace hise
@@ -95,7 +95,7 @@ public:
 
 private:
 
-	int numOpenFileHandles = 0;
+	std::atomic<int> numOpenFileHandles { 0 };
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingSamplerSoundPool);
 };
@@ -99,6 +99,7 @@ void StreamingSamplerSound::setReversed(bool shouldBeReversed)
 		if (shouldBeReversed)
 		{
 			loadEntireSample();
+			detachSharedPreloadBuffer();
 			preloadBuffer.reverse(0, preloadBuffer.getNumSamples());
 			reversed = true;
 		}
@@ -137,6 +138,8 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 
 
+	sharedPreloadBuffer = nullptr;
+
 	if (sampleDeactivated)
 	{
 		internalPreloadSize = 0;
@@ -164,8 +167,31 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	fileReader.openFileHandles();
 
+	if (sampleRate <= 0.0)
+	{
+		if (AudioFormatReader *reader = fileReader.getReader())
+		{
+			sampleRate = reader->sampleRate;
+			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
+			sampleLength = jmax<int>(0, sampleEnd - sampleStart);
+			loopEnd = jmin(loopEnd, sampleEnd);
+		}
+	}
+
 	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
 
+#if HISE_SHARE_SAMPLE_DATA
+
+	// Look for an existing buffer before the preload buffer is allocated and cleared
+	const int64 preloadKey = createPreloadBufferKey();
+
+	if (auto existingBuffer = sharedData->getPreloadBuffer(preloadKey))
+	{
+		sharedPreloadBuffer = existingBuffer;
+		return;
+	}
+#endif
+
 	try
 	{
 		preloadBuffer.setSize(fileReader.isStereo() ? 2 : 1, internalPreloadSize);
@@ -184,17 +210,6 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	preloadBuffer.clear();
 
-	if (sampleRate <= 0.0)
-	{
-		if (AudioFormatReader *reader = fileReader.getReader())
-		{
-			sampleRate = reader->sampleRate;
-			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
-			sampleLength = jmax<int>(0, sampleEnd - sampleStart);
-			loopEnd = jmin(loopEnd, sampleEnd);
-		}
-	}
-
 	if (loopEnabled && (loopEnd - loopStart > 0) && sampleLength < internalPreloadSize)
 	{
 		int samplesToFill = internalPreloadSize;
@@ -233,6 +248,38 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 		if(samplesToRead > 0)
 			fileReader.readFromDisk(preloadBuffer, 0, samplesToRead, sampleStart + monolithOffset, true);
 	}
+
+#if HISE_SHARE_SAMPLE_DATA
+	sharedPreloadBuffer = sharedData->addPreloadBuffer(preloadKey, std::move(preloadBuffer));
+	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+#endif
+}
+
+int64 StreamingSamplerSound::createPreloadBufferKey() const
+{
+	String key;
+
+	key << fileReader.getSourceIdentifier() << ";";
+	key << (fileReader.isStereo() ? 2 : 1) << ";" << sampleStart << ";" << sampleLength << ";" << internalPreloadSize << ";";
+	key << monolithOffset << ";" << (loopEnabled ? 1 : 0) << ";" << loopStart << ";" << loopEnd;
+
+	return key.hashCode64();
+}
+
+void StreamingSamplerSound::detachSharedPreloadBuffer()
+{
+	if (sharedPreloadBuffer == nullptr)
+		return;
+
+	const auto& source = sharedPreloadBuffer->buffer;
+
+	hlac::HiseSampleBuffer copy(source.isFloatingPoint(), source.getNumChannels(), source.getNumSamples());
+	hlac::HiseSampleBuffer::copy(copy, source, 0, 0, source.getNumSamples());
+
+	ScopedLock sl(getSampleLock());
+
+	preloadBuffer = std::move(copy);
+	sharedPreloadBuffer = nullptr;
 }
 
 
@@ -241,7 +288,7 @@ size_t StreamingSamplerSound::getActualPreloadSize() const
 {
 	auto bytesPerSample = fileReader.isMonolithic() ? sizeof(int16) : sizeof(float);
 
-	return hasActiveState() ? (size_t)(internalPreloadSize *preloadBuffer.getNumChannels()) * bytesPerSample + (size_t)(loopBuffer.getNumSamples() *loopBuffer.getNumChannels()) * bytesPerSample : 0;
+	return hasActiveState() ? (size_t)(internalPreloadSize *getPreloadBuffer().getNumChannels()) * bytesPerSample + (size_t)(loopBuffer.getNumSamples() *loopBuffer.getNumChannels()) * bytesPerSample : 0;
 }
 
 void StreamingSamplerSound::loadEntireSample() { setPreloadSize(-1); }
@@ -641,9 +688,11 @@ void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, i
 
 		jassert(indexInPreloadBuffer >= 0);
 
-		if (indexInPreloadBuffer + samplesToCopy < preloadBuffer.getNumSamples())
+		const auto& buffer = getPreloadBuffer();
+
+		if (indexInPreloadBuffer + samplesToCopy < buffer.getNumSamples())
 		{
-			hlac::HiseSampleBuffer::copy(sampleBuffer, preloadBuffer, offsetInBuffer, indexInPreloadBuffer, samplesToCopy);
+			hlac::HiseSampleBuffer::copy(sampleBuffer, buffer, offsetInBuffer, indexInPreloadBuffer, samplesToCopy);
 		}
 		else
 		{
@@ -726,6 +775,18 @@ String StreamingSamplerSound::FileReader::getFileName(bool getFullPath)
 	else return getFullPath ? loadedFile.getFullPathName() : loadedFile.getFileName();
 }
 
+String StreamingSamplerSound::FileReader::getSourceIdentifier() const
+{
+	if (monolithicInfo != nullptr)
+	{
+		String id;
+		id << SharedSampleDataStore::getFileIdentifier(monolithicInfo->getMonolithFile(monolithicChannelIndex)) << ":" << monolithicIndex;
+		return id;
+	}
+
+	return SharedSampleDataStore::getFileIdentifier(loadedFile);
+}
+
 void StreamingSamplerSound::FileReader::checkFileReference()
 {
 	if (monolithicInfo != nullptr) return;
@@ -909,6 +970,7 @@ void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buf
 	if (normalReader != nullptr)
 	{
 		ScopedReadLock sl(fileAccessLock);
+		ScopedLock rl(readerLock);
 
 		if (buffer.isFloatingPoint())
 			normalReader->read(buffer.getFloatBufferForFileReader(), startSample, numSamples, readerPosition, true, true);
@@ -207,6 +207,9 @@ public:
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
+	/** Returns the index of the channel file if the sound is stored in a monolith. All sounds of a channel share the same reader. */
+	int getMonolithChannelIndex() const { return fileReader.getMonolithChannelIndex(); }
+
 	// ==============================================================================================================================================
 
 	String getFileName(bool getFullPath = false) const;
@@ -253,7 +256,7 @@ public:
 		// This should not happen (either its unloaded or it has some samples)...
 		//jassert(preloadBuffer.getNumSamples() != 0);
 
-		return preloadBuffer;
+		return sharedPreloadBuffer != nullptr ? sharedPreloadBuffer->buffer : preloadBuffer;
 	}
 
 	// ==============================================================================================================================================
@@ -296,6 +299,9 @@ private:
 		void checkFileReference();
 		int64 getHashCode() { return hashCode; };
 
+		/** Returns a string that identifies the source file (and the position within the monolith). */
+		String getSourceIdentifier() const;
+
 		/** Refreshes the information about the file (if it is missing, if it supports memory-mapping). */
 		void refreshFileInformation();
 
@@ -354,6 +360,8 @@ private:
 			return sampleLength;
 		}
 
+		int getMonolithChannelIndex() const noexcept { return monolithicChannelIndex; }
+
 		double getMonolithSampleRate() const
 		{
 			if (monolithicInfo != nullptr)
@@ -383,7 +391,9 @@ private:
 		int monolithicChannelIndex = -1;
 		String monolithicName;
 
-		CriticalSection readLock2;
+		/** The jobs of multiple voices that play this sound can run on different workers, but the normal reader
+			keeps its read position (and decoder) state, so it must only be used by one worker at a time. */
+		CriticalSection readerLock;
 
 		ReadWriteLock fileAccessLock;
 
@@ -420,6 +430,12 @@ private:
 	void loopChanged();
 	void lengthChanged();
 
+	/** Creates the key for the shared preload buffer from the file and the current sample settings. */
+	int64 createPreloadBufferKey() const;
+
+	/** Replaces the shared preload buffer with a copy so that it can be modified. */
+	void detachSharedPreloadBuffer();
+
 	/** This fills the supplied AudioSampleBuffer with samples.
 	*
 	*	It copies the samples either from the preload buffer or reads it directly from the file, so don't call this method from the
@@ -443,6 +459,14 @@ private:
 	friend class SampleLoader;
 
 	hlac::HiseSampleBuffer preloadBuffer;
+
+	/** If the sample data is shared, this is used instead of the preload buffer. */
+	SharedSampleDataStore::PreloadBuffer::Ptr sharedPreloadBuffer;
+
+#if HISE_SHARE_SAMPLE_DATA
+	SharedResourcePointer<SharedSampleDataStore> sharedData;
+#endif
+
 	double sampleRate;
 
 	int monolithOffset;
@@ -51,7 +51,8 @@ SampleLoader::SampleLoader(SampleThreadPool *pool_) :
 	diskUsage(0.0),
 	lastCallToRequestData(0.0),
 	b1(true, 2, 0),
-	b2(true, 2, 0)
+	b2(true, 2, 0),
+	historyBuffer(true, 2, StreamingResampler::MaxLeadingSamples)
 {
 	unmapper.setLoader(this);
 
@@ -108,6 +109,8 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 
 	lastSwapPosition = 0.0;
 
+	historyBuffer.clear();
+
 	readIndex = startTime;
 	readIndexDouble = (double)startTime;
 
@@ -174,34 +177,51 @@ void SampleLoader::setStreamingBufferDataType(bool shouldBeFloat)
 
 	b1 = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
 	b2 = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
+	historyBuffer = hlac::HiseSampleBuffer(shouldBeFloat, 2, StreamingResampler::MaxLeadingSamples);
 
 	refreshBufferSizes();
 }
 
-StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const
+StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples, int numLeadingSamples, int numTrailingSamples) const
 {
+	jassert(numLeadingSamples <= StreamingResampler::MaxLeadingSamples);
+
 	auto localReadBuffer = readBuffer.get();
 	auto localWriteBuffer = writeBuffer.get();
 
 	const int numSamplesInBuffer = localReadBuffer->getNumSamples();
-	const int maxSampleIndexForFillOperation = (int)(readIndexDouble + numSamples) + 1; // Round up the samples
+	const int index = (int)readIndexDouble;
+	const int maxSampleIndexForFillOperation = (int)(readIndexDouble + numSamples) + numTrailingSamples; // Round up the samples
 
-	if (maxSampleIndexForFillOperation >= numSamplesInBuffer) // Check because of preloadbuffer style
+	if (index < numLeadingSamples || maxSampleIndexForFillOperation >= numSamplesInBuffer) // Check because of preloadbuffer style
 	{
-		const int indexBeforeWrap = jmax<int>(0, (int)(readIndexDouble));
-		const int numSamplesInFirstBuffer = localReadBuffer->getNumSamples() - indexBeforeWrap;
+		// The samples before the read position that are not in the current read buffer 
+		// are taken from the end of the previous buffer
+		const int numSamplesFromHistory = jmax<int>(0, numLeadingSamples - index);
+
+		if (numSamplesFromHistory > 0 && historyBuffer.isFloatingPoint() == voiceBuffer.isFloatingPoint())
+		{
+			hlac::HiseSampleBuffer::copy(voiceBuffer, historyBuffer, 0, historyBuffer.getNumSamples() - numSamplesFromHistory, numSamplesFromHistory);
+		}
+
+		const int indexBeforeWrap = jmax<int>(0, index - numLeadingSamples);
+		const int numSamplesInFirstBuffer = jmin<int>(localReadBuffer->getNumSamples() - indexBeforeWrap, voiceBuffer.getNumSamples() - numSamplesFromHistory);
 
 		jassert(numSamplesInFirstBuffer >= 0);
 
 		if (numSamplesInFirstBuffer > 0)
 		{
-			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, 0, indexBeforeWrap, numSamplesInFirstBuffer);
+			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, numSamplesFromHistory, indexBeforeWrap, numSamplesInFirstBuffer);
 		}
 
-		const int offset = numSamplesInFirstBuffer;
+		const int offset = numSamplesFromHistory + numSamplesInFirstBuffer;
 		const int numSamplesAvailableInSecondBuffer = localWriteBuffer->getNumSamples() - offset;
 
-		if ((numSamplesAvailableInSecondBuffer > 0) && (numSamplesAvailableInSecondBuffer <= localWriteBuffer->getNumSamples()))
+		if (offset >= voiceBuffer.getNumSamples())
+		{
+			// The voice buffer was filled from the read buffer only
+		}
+		else if ((numSamplesAvailableInSecondBuffer > 0) && (numSamplesAvailableInSecondBuffer <= localWriteBuffer->getNumSamples()))
 		{
 			const int numSamplesToCopyFromSecondBuffer = jmin<int>(numSamplesAvailableInSecondBuffer, voiceBuffer.getNumSamples() - offset);
 
@@ -225,8 +245,8 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 		StereoChannelData returnData;
 
 		returnData.isFloatingPoint = localReadBuffer->isFloatingPoint();
-		returnData.leftChannel = voiceBuffer.getReadPointer(0);
-		returnData.rightChannel = voiceBuffer.getReadPointer(1);
+		returnData.leftChannel = voiceBuffer.getReadPointer(0, numLeadingSamples);
+		returnData.rightChannel = voiceBuffer.getReadPointer(1, numLeadingSamples);
 
 #if USE_SAMPLE_DEBUG_COUNTER
 
@@ -252,8 +272,6 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 	}
 	else
 	{
-		const int index = (int)readIndexDouble;
-
 		StereoChannelData returnData;
 
 		returnData.isFloatingPoint = localReadBuffer->isFloatingPoint();
@@ -302,13 +320,19 @@ int SampleLoader::getNumSamplesForStreamingBuffers() const
 
 bool SampleLoader::requestNewData()
 {
+	// The write buffer must be filled before the voice has consumed the rest of the read buffer
+	const double numSamplesLeft = jmax<double>(0.0, (double)readBuffer.get()->getNumSamples() - readIndexDouble);
+	const double secondsLeft = readSpeed > 0.0 ? numSamplesLeft / readSpeed : 0.0;
+
+	setDeadline(Time::getHighResolutionTicks() + Time::secondsToHighResolutionTicks(secondsLeft));
+
 #if KILL_VOICES_WHEN_STREAMING_IS_BLOCKED
 	if (this->isQueued())
 	{
 		writeBuffer.get()->clear();
 
 		cancelled = true;
-		backgroundPool->notify();
+		backgroundPool->notifyWorkers();
 		return false;
 	}
 	else
@@ -352,6 +376,13 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 
 	writeBufferIsBeingFilled = false;
 
+	if (localSound != nullptr)
+	{
+		auto b = writeBuffer.get();
+		const int64 bytesPerSample = b->isFloatingPoint() ? sizeof(float) : sizeof(int16);
+		backgroundPool->addStreamedBytes((int64)getNumSamplesForStreamingBuffers() * (int64)b->getNumChannels() * bytesPerSample);
+	}
+
 	const double readStop = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
 	const double readTime = (readStop - readStart);
 	const double timeSinceLastCall = readStop - lastCallToRequestData;
@@ -443,6 +474,12 @@ bool SampleLoader::swapBuffers()
 {
 	auto localReadBuffer = readBuffer.get();
 
+	// Keep the last samples so that the interpolation can look behind the start of the next buffer
+	const int numHistorySamples = jmin<int>(historyBuffer.getNumSamples(), localReadBuffer->getNumSamples());
+
+	if (localReadBuffer->isFloatingPoint() == historyBuffer.isFloatingPoint())
+		hlac::HiseSampleBuffer::copy(historyBuffer, *localReadBuffer, historyBuffer.getNumSamples() - numHistorySamples, localReadBuffer->getNumSamples() - numHistorySamples, numHistorySamples);
+
 	if (localReadBuffer == &b1)
 	{
 		readBuffer = &b2;
@@ -478,13 +515,6 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 	if (sound != nullptr && sound->getSampleLength() > 0)
 	{
-		loader.startNote(sound, sampleStartModValue);
-
-		jassert(sound != nullptr);
-		sound->wakeSound();
-
-		voiceUptime = (double)sampleStartModValue;
-
 		// You have to call setPitchFactor() before startNote().
 		jassert(uptimeDelta != 0.0);
 
@@ -494,6 +524,14 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 		constUptimeDelta = uptimeDelta;
 
+		loader.setReadSpeed(uptimeDelta * getSampleRate());
+		loader.startNote(sound, sampleStartModValue);
+
+		jassert(sound != nullptr);
+		sound->wakeSound();
+
+		voiceUptime = (double)sampleStartModValue;
+
 		isActive = true;
 
 	}
@@ -525,59 +563,6 @@ void StreamingSamplerVoice::setDebugLogger(DebugLogger* newLogger)
 	loader.setLogger(logger);
 }
 
-template <typename SignalType> void interpolateStereoSamples(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, bool isFloat)
-{
-	const float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
-
-	if (pitchData != nullptr)
-	{
-		pitchData += startSample;
-
-		float indexInBufferFloat = (float)indexInBuffer;
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			outL[i] = l * gainFactor;
-			outR[i] = r * gainFactor;
-
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
-
-			indexInBufferFloat += pitchData[i];
-		}
-	}
-	else
-	{
-
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
-
-		while (numSamples > 0)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			*outL++ = l * gainFactor;
-			*outR++ = r * gainFactor;
-
-			indexInBufferFloat += uptimeDeltaFloat;
-
-			numSamples--;
-		}
-	}
-}
-
-
 void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int startSample, int numSamples)
 {
 	const StreamingSamplerSound *sound = loader.getLoadedSound();
@@ -600,7 +585,9 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 		tempVoiceBuffer->clear();
 
 		// Copy the not resampled values into the voice buffer.
-		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha);
+		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha,
+														StreamingResampler::getNumLeadingSamples(interpolationMode),
+														StreamingResampler::getNumTrailingSamples(interpolationMode));
 
 		float* outL = outputBuffer.getWritePointer(0, startSample);
 		float* outR = outputBuffer.getWritePointer(1, startSample);
@@ -615,20 +602,21 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 		double indexInBuffer = startAlpha;
 
+		const float* pitchDataForBlock = pitchData != nullptr ? pitchData + startSample : nullptr;
+
 		if (data.isFloatingPoint)
 		{
 			const float* const inL = static_cast<const float*>(data.leftChannel);
 			const float* const inR = static_cast<const float*>(data.rightChannel);
 
-			interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, true);
+			StreamingResampler::interpolateStereo(interpolationMode, inL, inR, pitchDataForBlock, outL, outR, indexInBuffer, uptimeDelta, numSamples);
 		}
 		else
 		{
 			const int16* const inL = static_cast<const int16*>(data.leftChannel);
 			const int16* const inR = static_cast<const int16*>(data.rightChannel);
 
-			interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, false);
-
+			StreamingResampler::interpolateStereo(interpolationMode, inL, inR, pitchDataForBlock, outL, outR, indexInBuffer, uptimeDelta, numSamples);
 		}
 
 #if USE_SAMPLE_DEBUG_COUNTER 
@@ -650,6 +638,9 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 		voiceUptime += pitchCounter;
 #endif
 
+		if (numSamplesFixed > 0)
+			loader.setReadSpeed(pitchCounter / (double)numSamplesFixed * getSampleRate());
+
 		if (!loader.advanceReadIndex(voiceUptime))
 		{
 #if LOG_SAMPLE_RENDERING
@@ -732,9 +723,12 @@ void StreamingSamplerVoice::initTemporaryVoiceBuffer(hlac::HiseSampleBuffer* buf
 	// The channel amount must be set correctly in the constructor
 	jassert(bufferToUse->getNumChannels() > 0);
 
-	if (bufferToUse->getNumSamples() < samplesPerBlock*MAX_SAMPLER_PITCH)
+	// Add some padding for the samples that the interpolation needs around the read range
+	const int numSamplesToUse = samplesPerBlock * MAX_SAMPLER_PITCH + StreamingResampler::MaxLeadingSamples + StreamingResampler::MaxTrailingSamples;
+
+	if (bufferToUse->getNumSamples() < numSamplesToUse)
 	{
-		bufferToUse->setSize(bufferToUse->getNumChannels(), samplesPerBlock*MAX_SAMPLER_PITCH);
+		bufferToUse->setSize(bufferToUse->getNumChannels(), numSamplesToUse);
 		bufferToUse->clear();
 	}
 }
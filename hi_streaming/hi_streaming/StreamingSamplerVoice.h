@@ -73,7 +73,12 @@ public:
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
-	StereoChannelData fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const;
+	/** Returns the sample data for the next block.
+	*
+	*	If the range (including the samples that the interpolation needs around it) is not inside the current read buffer,
+	*	the data will be copied into the given voice buffer. The returned pointers point to the sample at the read position.
+	*/
+	StereoChannelData fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples, int numLeadingSamples, int numTrailingSamples) const;
 
 	/** Advances the read index and returns `false` if the streaming thread is blocked. */
 	bool advanceReadIndex(double uptime);
@@ -87,6 +92,12 @@ public:
 	/** Returns the loaded sound. */
 	inline const StreamingSamplerSound *getLoadedSound() const { return sound.get(); };
 
+	/** Sets the speed (in source samples per second) with which the voice reads the sample data.
+	*
+	*	This is used to calculate the deadline for the background thread.
+	*/
+	void setReadSpeed(double samplesPerSecond) noexcept { readSpeed = samplesPerSecond; }
+
 	class Unmapper : public SampleThreadPoolJob
 	{
 	public:
@@ -185,6 +196,8 @@ private:
 	Atomic<float> diskUsage;
 	double lastCallToRequestData;
 
+	double readSpeed = 0.0;
+
 	// just a pointer to the used pool
 	SampleThreadPool *backgroundPool;
 
@@ -192,6 +205,9 @@ private:
 
 	hlac::HiseSampleBuffer b1, b2;
 
+	// the last samples of the previous read buffer
+	hlac::HiseSampleBuffer historyBuffer;
+
 	bool cancelled = false;
 };
 
@@ -285,8 +301,13 @@ public:
 	/** Set this to false if you're using HLAC compressed monoliths. */
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Sets the interpolation algorithm that is used for the resampling. */
+	void setInterpolationMode(StreamingResampler::InterpolationMode newMode) noexcept { interpolationMode = newMode; }
+
 private:
 
+	StreamingResampler::InterpolationMode interpolationMode = StreamingResampler::InterpolationMode::Linear;
+
 	double pitchCounter = 0.0;
 
 	hlac::HiseSampleBuffer* tvb = nullptr;
@@ -127,6 +127,20 @@ public:
 		print("");
 		print("create-win-installer" );
 		print("Creates a template install script for Inno Setup for the project" );
+		print("");
+		print("benchmark FILE [OPTIONS]");
+		print("Renders the preset offline with a MIDI file and prints the performance report.");
+		print("FILE       The absolute path to the preset file (.xml or .hip).");
+		print("-m:{PATH}  the MIDI file that will be played.");
+		print("-o:{PATH}  writes the rendered audio to this .wav file.");
+		print("-r:{PATH}  writes the report as JSON to this file.");
+		print("-s:{VALUE} the sample rate (default: 44100).");
+		print("-b:{VALUE} the block size (default: 512).");
+		print("-t:{VALUE} the time in seconds that is rendered after the last MIDI event (default: 2).");
+		print("");
+		print("benchmark_samplemap [-n:{VALUES}]");
+		print("Measures the time it takes to add sample maps to the sample pool.");
+		print("-n:{VALUES} a comma separated list of zone counts (default: 1000,10000,100000).");
 
 		exit(0);
 	}
@@ -266,6 +280,107 @@ public:
 	}
 	
 
+	static void runBenchmark(const String& commandLine)
+	{
+		auto args = getCommandLineArgs(commandLine);
+
+		OfflineRenderBenchmark::Settings settings;
+
+		settings.presetFile = File(args[0].unquoted());
+
+		auto getFile = [&args](const String& prefix)
+		{
+			auto s = getArgument(args, prefix);
+			return (s.isNotEmpty() && File::isAbsolutePath(s)) ? File(s) : File();
+		};
+
+		settings.midiFile = getFile("-m:");
+		settings.outputFile = getFile("-o:");
+		settings.reportFile = getFile("-r:");
+
+		auto sampleRate = getArgument(args, "-s:");
+		auto blockSize = getArgument(args, "-b:");
+		auto tail = getArgument(args, "-t:");
+
+		if (sampleRate.isNotEmpty()) settings.sampleRate = sampleRate.getDoubleValue();
+		if (blockSize.isNotEmpty()) settings.blockSize = blockSize.getIntValue();
+		if (tail.isNotEmpty()) settings.tailSeconds = tail.getDoubleValue();
+
+		if (!settings.presetFile.existsAsFile())
+			throwErrorAndQuit("`" + args[0] + "` is not a valid preset file");
+
+		if (settings.sampleRate <= 0.0 || settings.blockSize <= 0)
+			throwErrorAndQuit("Invalid sample rate or block size");
+
+		CompileExporter::setExportingFromCommandLine();
+
+		ScopedPointer<StandaloneProcessor> sp = new StandaloneProcessor();
+		ScopedPointer<BackendProcessor> bp = dynamic_cast<BackendProcessor*>(sp->createProcessor());
+
+		print("Loading " + settings.presetFile.getFullPathName() + "...");
+
+		String report;
+		Result r = Result::ok();
+
+		{
+			OfflineRenderBenchmark benchmark(bp, settings);
+
+			r = benchmark.runBenchmark();
+
+			if (r.wasOk())
+				report = benchmark.createReport();
+		}
+
+		bp = nullptr;
+		sp = nullptr;
+
+		if (r.failed())
+			throwErrorAndQuit(r.getErrorMessage());
+
+		print(report);
+		exit(0);
+	}
+
+	static void runSampleMapBenchmark(const String& commandLine)
+	{
+		auto args = getCommandLineArgs(commandLine);
+
+		auto sizeList = getArgument(args, "-n:");
+
+		if (sizeList.isEmpty())
+			sizeList = "1000,10000,100000";
+
+		auto sizes = StringArray::fromTokens(sizeList, ",", "");
+
+		CompileExporter::setExportingFromCommandLine();
+
+		ScopedPointer<StandaloneProcessor> sp = new StandaloneProcessor();
+		ScopedPointer<BackendProcessor> bp = dynamic_cast<BackendProcessor*>(sp->createProcessor());
+
+		Array<SampleMapLoadBenchmark::Result> results;
+
+		{
+			SampleMapLoadBenchmark benchmark(bp);
+
+			for (const auto& s : sizes)
+			{
+				const int numZones = s.getIntValue();
+
+				if (numZones <= 0)
+					throwErrorAndQuit("`" + s + "` is not a valid zone count");
+
+				print("Loading " + String(numZones) + " zones...");
+				results.add(benchmark.run(numZones));
+			}
+		}
+
+		bp = nullptr;
+		sp = nullptr;
+
+		print(SampleMapLoadBenchmark::createReport(results));
+		exit(0);
+	}
+
 	static void setHiseFolder(const String& commandLine)
 	{
 		auto args = getCommandLineArgs(commandLine);
@@ -423,6 +538,18 @@ public:
 			quit();
 			return;
 		}
+		else if (commandLine.startsWith("benchmark_samplemap"))
+		{
+			CommandLineActions::runSampleMapBenchmark(commandLine);
+			quit();
+			return;
+		}
+		else if (commandLine.startsWith("benchmark"))
+		{
+			CommandLineActions::runBenchmark(commandLine);
+			quit();
+			return;
+		}
 		else if (commandLine.startsWith("set_hise_folder"))
 		{
 			CommandLineActions::setHiseFolder(commandLine);
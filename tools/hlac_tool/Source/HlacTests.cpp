@@ -50,6 +50,15 @@ void BitCompressors::UnitTests::runTest()
 	testCompressor(compressor = new FourteenBit());
 	testCompressor(compressor = new SixteenBit());
 
+	testSimdUnpacking(compressor = new OneBit());
+	testSimdUnpacking(compressor = new TwoBit());
+	testSimdUnpacking(compressor = new FourBit());
+	testSimdUnpacking(compressor = new SixBit());
+	testSimdUnpacking(compressor = new EightBit());
+	testSimdUnpacking(compressor = new TenBit());
+	testSimdUnpacking(compressor = new TwelveBit());
+	testSimdUnpacking(compressor = new FourteenBit());
+
 	testAutomaticCompression(1);
 	testAutomaticCompression(2);
 	testAutomaticCompression(3);
@@ -258,6 +267,48 @@ void BitCompressors::UnitTests::testCompressor(Base* compressor)
 	free(decompressedData);
 }
 
+void BitCompressors::UnitTests::testSimdUnpacking(Base* compressor)
+{
+	beginTest("Testing SIMD unpacking with bit rate " + String(compressor->getAllowedBitRange()));
+
+	const auto defaultMode = getSimdMode();
+
+	Random r;
+
+	for (int i = 0; i < 16; i++)
+	{
+		// Use odd sizes to check the remainder handling and the bounds of the vector loads
+		const int numToCompress = r.nextInt(Range<int>(1, 4100));
+		const int byteSize = compressor->getByteAmount(numToCompress);
+
+		HeapBlock<int16> uncompressedData(numToCompress);
+		HeapBlock<uint8> compressedData(byteSize);
+		HeapBlock<int16> scalarData(numToCompress);
+		HeapBlock<int16> simdData(numToCompress);
+
+		fillDataWithAllowedBitRange(uncompressedData, numToCompress, compressor->getAllowedBitRange());
+		compressor->compress(compressedData, uncompressedData, numToCompress);
+
+		setSimdMode(SimdMode::Scalar);
+		compressor->decompress(scalarData, compressedData, numToCompress);
+
+		for (int m = 1; m < (int)SimdMode::numSimdModes; m++)
+		{
+			if (!setSimdMode((SimdMode)m))
+				continue;
+
+			compressor->decompress(simdData, compressedData, numToCompress);
+
+			for (int j = 0; j < numToCompress; j++)
+			{
+				expectEquals<int16>(simdData[j], scalarData[j], getSimdModeName((SimdMode)m) + " mismatch at position " + String(j));
+			}
+		}
+	}
+
+	setSimdMode(defaultMode);
+}
+
 #endif
 
 CodecTest::CodecTest() :
@@ -274,6 +325,9 @@ void CodecTest::runTest()
 
 	testHiseSampleBuffer();
 
+	for (int i = 0; i < (int)Option::numCompressorOptions; i++)
+		testFloatDecoding((Option)i);
+
 	SignalType testOnly = SignalType::numSignalTypes;
 	Option soloOption = Option::numCompressorOptions;
 	bool testOnce = false;
@@ -379,6 +433,57 @@ void CodecTest::testHiseSampleBuffer()
 	expectEquals<int>((int)error, 0, "Test HiseSampleBuffer");
 }
 
+void CodecTest::testFloatDecoding(Option option)
+{
+	beginTest("Testing decoding to float using " + getNameForOption(option));
+
+	Random r;
+
+	const int numSamples = CompressionHelpers::getPaddedSampleSize(r.nextInt(Range<int>(8000, 10000)));
+
+	AudioSampleBuffer src = createTestSignal(numSamples, 1, SignalType::DecayingSineWithHarmonic, 0.8f);
+
+	HeapBlock<uint32> blockOffsets;
+	blockOffsets.calloc(10000);
+
+	HlacEncoder encoder;
+	encoder.setOptions(options[(int)option]);
+
+	MemoryOutputStream mos;
+	encoder.compress(src, mos, blockOffsets);
+
+	// The float path adds the delta template during the conversion, the int16 path before it
+	HiseSampleBuffer intBuffer(false, 1, numSamples);
+	HiseSampleBuffer floatBuffer(true, 1, numSamples);
+
+	{
+		HlacDecoder decoder;
+		decoder.setupForDecompression();
+
+		MemoryInputStream mis(mos.getMemoryBlock(), false);
+		decoder.decode(intBuffer, false, mis);
+	}
+
+	{
+		HlacDecoder decoder;
+		decoder.setupForDecompression();
+
+		MemoryInputStream mis(mos.getMemoryBlock(), false);
+		decoder.decode(floatBuffer, false, mis);
+	}
+
+	auto intData = static_cast<const int16*>(intBuffer.getReadPointer(0));
+	auto floatData = floatBuffer.getFloatBufferForFileReader()->getReadPointer(0);
+
+	// Use the same reciprocal multiplication as the decoder (a division can differ by one ulp)
+	const float scale = 1.0f / (float)0x7fff;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		expectEquals<float>(floatData[i], (float)intData[i] * scale, "Float mismatch at position " + String(i));
+	}
+}
+
 void CodecTest::testCodec(SignalType type, Option option, bool /*testStereo*/)
 {
 	
@@ -657,6 +762,9 @@ public:
 
 		testPadding(1);
         testPadding(2);
+
+		testParallelEncoding(1);
+		testParallelEncoding(2);
 	
 		for (int i = 0; i < 5; i++)
 		{
@@ -765,7 +873,7 @@ public:
 		return CodecTest::createTestSignal(r.nextInt(Range<int>((int)lowerLimit, (int)upperLimit)), numChannels, CodecTest::SignalType::DecayingSineWithHarmonic, 0.9f);
 	}
 
-	MemoryBlock writeIntoMemory(Array<AudioSampleBuffer>& buffers)
+	MemoryBlock writeIntoMemory(Array<AudioSampleBuffer>& buffers, ThreadPool* pool=nullptr)
 	{
 		Random r;
 
@@ -778,6 +886,7 @@ public:
 		ScopedPointer<HiseLosslessAudioFormatWriter> writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(hlac.createWriterFor(mos, 44100.0, buffers[0].getNumChannels(), 0, empty, 0));
 
 		writer->setOptions(currentOption);
+		writer->setThreadPool(pool);
 		
 		expect(writer != nullptr);
 
@@ -856,6 +965,33 @@ public:
 		expectEquals<int>(error, 0, "Error after reading");
 	}
 
+	void testParallelEncoding(int numChannels)
+	{
+		beginTest("Testing parallel encoding with " + String(numChannels) + " channels");
+
+		ThreadPool pool(4);
+
+		Array<AudioSampleBuffer> buffers;
+
+		buffers.add(createTestBuffer(numChannels));
+		buffers.add(createTestBuffer(numChannels));
+
+		auto serial = writeIntoMemory(buffers);
+		auto parallel = writeIntoMemory(buffers, &pool);
+
+		// The checksums are random, so the data can only be compared by its size and decoded content
+		expectEquals<int>((int)parallel.getSize(), (int)serial.getSize(), "Size");
+
+		auto b1 = readIntoAudioBuffer(serial, false);
+		auto b2 = readIntoAudioBuffer(parallel, false);
+
+		expectEquals<int>(b2.getNumSamples(), b1.getNumSamples(), "Num samples");
+
+		int error = (int)CompressionHelpers::checkBuffersEqual(b2, b1);
+
+		expectEquals<int>(error, 0, "buffers equal");
+	}
+
 	int randomizeChannelAmount()
 	{
 		Random r;
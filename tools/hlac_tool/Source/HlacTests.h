@@ -46,6 +46,7 @@ struct BitCompressors::UnitTests : public UnitTest
 	void runTest() override;
 	void fillDataWithAllowedBitRange(int16* data, int size, int bitRange);
 	void testCompressor(Base* compressor);
+	void testSimdUnpacking(Base* compressor);
 
 	void testAutomaticCompression(uint8 maxBitSize);
 
@@ -83,6 +84,8 @@ struct CodecTest : public UnitTest
 
 	void testHiseSampleBuffer();
 
+	void testFloatDecoding(Option option);
+
 	static AudioSampleBuffer createTestSignal(int numSamples, int numChannels, SignalType type, float maxAmplitude);
 
 	HlacEncoder::CompressorOptions options[(int)Option::numCompressorOptions];
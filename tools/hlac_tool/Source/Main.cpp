@@ -37,7 +37,7 @@ void printHelp()
 	Logger::writeToLog("Usage: hlac_tool [MODE] [INPUT] [OUTPUT]");
 	Logger::writeToLog("");
 	Logger::writeToLog("modes: 'encode' / 'decode'");
-	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory'");
+	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory', 'benchmark'");
 	Logger::writeToLog("(put '_' before filename to skip samples)");
 	Logger::setCurrentLogger(nullptr);
 }
@@ -97,6 +97,71 @@ void testMemoryMapPerformance(Array<File>& files)
 	}
 }
 
+int benchmarkCompressors()
+{
+	BitCompressors::Collection collection;
+	Random r;
+
+	const int numBlocks = 64;
+	const int numValues = COMPRESSION_BLOCK_SIZE * numBlocks;
+	const int numRuns = 100;
+	const uint8 bitRates[] = { 1, 2, 4, 6, 8, 10, 12, 14, 16 };
+
+	HeapBlock<int16> input(numValues);
+	HeapBlock<int16> output(numValues);
+	HeapBlock<uint8> packed(numValues * sizeof(int16));
+
+	const auto defaultMode = BitCompressors::getSimdMode();
+
+	Logger::writeToLog("Decompression throughput in MB/s of decoded 16 bit samples");
+	Logger::writeToLog("Default instruction set: " + BitCompressors::getSimdModeName(defaultMode));
+	Logger::writeToLog("");
+
+	for (auto bitRate : bitRates)
+	{
+		auto compressor = collection.getSuitableCompressorForBitRate(bitRate);
+		const int maxValue = bitRate == 1 ? 1 : (1 << (bitRate - 1)) - 1;
+
+		for (int i = 0; i < numValues; i++)
+			input[i] = (int16)(bitRate == 1 ? r.nextInt(2) : r.nextInt(Range<int>(-maxValue, maxValue + 1)));
+
+		const int bytesPerBlock = compressor->getByteAmount(COMPRESSION_BLOCK_SIZE);
+
+		for (int b = 0; b < numBlocks; b++)
+			compressor->compress(packed + b * bytesPerBlock, input + b * COMPRESSION_BLOCK_SIZE, COMPRESSION_BLOCK_SIZE);
+
+		String line = String(bitRate).paddedLeft(' ', 2) + " bit:";
+
+		for (int m = 0; m < (int)BitCompressors::SimdMode::numSimdModes; m++)
+		{
+			const auto mode = (BitCompressors::SimdMode)m;
+
+			if (!BitCompressors::setSimdMode(mode))
+				continue;
+
+			const double start = Time::getMillisecondCounterHiRes();
+
+			for (int run = 0; run < numRuns; run++)
+			{
+				for (int b = 0; b < numBlocks; b++)
+					compressor->decompress(output + b * COMPRESSION_BLOCK_SIZE, packed + b * bytesPerBlock, COMPRESSION_BLOCK_SIZE);
+			}
+
+			const double seconds = jmax<double>(0.001, Time::getMillisecondCounterHiRes() - start) * 0.001;
+			const double megaBytes = (double)numRuns * numValues * sizeof(int16) / (1024.0 * 1024.0);
+
+			line << "  " << BitCompressors::getSimdModeName(mode) << ": " << String(megaBytes / seconds, 1);
+		}
+
+		Logger::writeToLog(line);
+	}
+
+	BitCompressors::setSimdMode(defaultMode);
+
+	Logger::setCurrentLogger(nullptr);
+	return 0;
+}
+
 int decode(File input, File output)
 {
 
@@ -215,6 +280,11 @@ int main(int argc, char **argv)
 
 	}
 
+	if (mode == "benchmark")
+	{
+		return benchmarkCompressors();
+	}
+
 	if (mode == "unit_test")
 	{
 		UnitTestRunner runner;